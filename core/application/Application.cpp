@@ -22,6 +22,7 @@
 
 #include "app_config/AppConfig.h"
 #include "checkpoint/CheckPointManager.h"
+#include "checkpoint/CheckpointManagerV2.h"
 #include "collection_pipeline/CollectionPipelineManager.h"
 #include "collection_pipeline/plugin/PluginRegistry.h"
 #include "collection_pipeline/queue/ExactlyOnceQueueManager.h"
@@ -318,11 +319,6 @@ void Application::Start() { // GCOVR_EXCL_START
         // 过渡使用
         EventDispatcher::GetInstance()->DumpCheckPointPeriod(curTime);
 
-        if (ConfigManager::GetInstance()->IsUpdateContainerPaths()) {
-            FileServer::GetInstance()->Pause();
-            FileServer::GetInstance()->Resume();
-        }
-
         // destruct event handlers here so that it will not block file reading task
         ConfigManager::GetInstance()->DeleteHandlers();
         PrometheusInputRunner::GetInstance()->CheckGC();
@@ -354,6 +350,8 @@ void Application::Exit() {
     }
 #endif
 
+    // checkpoint manager v2 is only created when exactly once is enabled by some config
+    bool hasExactlyOnceConfig = !FileServer::GetInstance()->GetExactlyOnceConfigs().empty();
     CollectionPipelineManager::GetInstance()->StopAllPipelines();
 
     PluginRegistry::GetInstance()->UnloadPlugins();
@@ -375,6 +373,10 @@ void Application::Exit() {
 
     FlusherRunner::GetInstance()->Stop();
     HttpSink::GetInstance()->Stop();
+    if (hasExactlyOnceConfig) {
+        // acked ranges are committed asynchronously
+        CheckpointManagerV2::GetInstance()->Flush();
+    }
 
     // TODO: make it common
     FlusherSLS::RecycleResourceIfNotUsed();
@@ -23,12 +23,20 @@
 #include "common/TimeUtil.h"
 #include "logger/Logger.h"
 #include "monitor/AlarmManager.h"
+#include "monitor/metric_constants/MetricConstants.h"
 
 DEFINE_FLAG_INT32(logtail_checkpoint_check_gc_interval_sec, "60 seconds", 60);
 DEFINE_FLAG_INT32(logtail_checkpoint_gc_threshold_sec, "30 minutes", 30 * 60);
 DEFINE_FLAG_DOUBLE(logtail_checkpoint_max_gc_count_ratio_per_round, "10%", 0.1);
 DEFINE_FLAG_INT64(logtail_checkpoint_max_used_time_per_round_in_msec, "500ms", 500);
 DEFINE_FLAG_INT32(logtail_checkpoint_expired_threshold_sec, "6 hours", 6 * 60 * 60);
+DEFINE_FLAG_BOOL(enable_checkpoint_group_commit, "commit exactly once checkpoint updates in batches", true);
+DEFINE_FLAG_INT32(checkpoint_group_commit_window_ms,
+                  "time to collect more updates before committing a batch which updates are waiting for, in ms",
+                  0);
+DEFINE_FLAG_INT32(checkpoint_group_commit_async_interval_ms,
+                  "max delay of committing updates which nobody waits for, in ms",
+                  1000);
 
 DECLARE_FLAG_INT32(max_exactly_once_concurrency);
 
@@ -95,17 +103,41 @@ std::string CheckpointManagerV2::MakeRangeKey(const std::string& primaryKey, uin
 CheckpointManagerV2::CheckpointManagerV2() {
     mDefaultWriteOption.sync = AppConfig::GetInstance()->EnableCheckpointSyncWrite();
 
+    WriteMetrics::GetInstance()->PrepareMetricsRecordRef(
+        mMetricsRecordRef,
+        MetricCategory::METRIC_CATEGORY_RUNNER,
+        {{METRIC_LABEL_KEY_RUNNER_NAME, METRIC_LABEL_VALUE_RUNNER_NAME_CHECKPOINT}});
+    mCommitsTotal = mMetricsRecordRef.CreateCounter(METRIC_RUNNER_CHECKPOINT_COMMITS_TOTAL);
+    mCommittedCheckpointsTotal = mMetricsRecordRef.CreateCounter(METRIC_RUNNER_CHECKPOINT_COMMITTED_CHECKPOINTS_TOTAL);
+    mCommitLatencyMs = mMetricsRecordRef.CreateHistogram(METRIC_RUNNER_CHECKPOINT_COMMIT_LATENCY_MS);
+
     if (open()) {
         mGCThreadPtr.reset(new std::thread([&]() { runGCLoop(); }));
+        if (BOOL_FLAG(enable_checkpoint_group_commit)) {
+            mCommitThreadPtr.reset(new std::thread([&]() { runCommitLoop(); }));
+        }
     }
 }
 
 CheckpointManagerV2::~CheckpointManagerV2() {
-    mStopGCThread = true;
+    {
+        std::lock_guard<std::mutex> lock(mGCMutex);
+        mStopGCThread = true;
+    }
+    mGCCV.notify_one();
     if (mGCThreadPtr) {
         mGCThreadPtr->join();
         mGCThreadPtr.reset();
     }
+    {
+        std::lock_guard<std::mutex> lock(mCommitMutex);
+        mStopCommitThread = true;
+    }
+    mCommitCV.notify_one();
+    if (mCommitThreadPtr) {
+        mCommitThreadPtr->join();
+        mCommitThreadPtr.reset();
+    }
 
     close();
 }
@@ -286,6 +318,8 @@ CheckpointManagerV2::ScanCheckpoints(const std::vector<std::string>& exactlyOnce
         LOG_ERROR(sLogger, ("scan exacly once checkpoints error", "uninitialized"));
         return checkpoints;
     }
+    // primary checkpoints are iterated from database directly
+    Flush();
 
     std::vector<std::string> toDeleteKeys;
     auto scanUsedTimeInMs = scanCheckpoints(exactlyOnceConfigs, &checkpoints, toDeleteKeys);
@@ -307,6 +341,8 @@ uint64_t CheckpointManagerV2::DeleteCheckpoints(const std::vector<std::string>&
     for (auto& k : keys) {
         batch.Delete(k);
     }
+    std::lock_guard<std::mutex> lock(mBatchWriteMutex);
+    dropPendingWrites(keys);
     auto status = mDatabase->Write(mDefaultWriteOption, &batch);
     auto const usedTimeInMs = GetCurrentTimeInMilliSeconds() - startTimeInMs;
     if (status.ok()) {
@@ -322,6 +358,7 @@ uint64_t CheckpointManagerV2::UpdatePrimaryCheckpoints(
 #define METHOD_LOG_PATTERN ("method", "UpdatePrimaryCheckpoints")("count", checkpoints.size())
     auto const startTimeInMs = GetCurrentTimeInMilliSeconds();
     leveldb::WriteBatch batch;
+    std::vector<std::string> keys;
     for (auto& cptPair : checkpoints) {
         auto& key = cptPair->first;
         auto& cpt = cptPair->second;
@@ -331,7 +368,10 @@ uint64_t CheckpointManagerV2::UpdatePrimaryCheckpoints(
             continue;
         }
         batch.Put(key, data);
+        keys.push_back(key);
     }
+    std::lock_guard<std::mutex> lock(mBatchWriteMutex);
+    dropPendingWrites(keys);
     auto status = mDatabase->Write(mDefaultWriteOption, &batch);
     if (status.ok()) {
         return GetCurrentTimeInMilliSeconds() - startTimeInMs;
@@ -391,7 +431,19 @@ bool CheckpointManagerV2::readDatabase(const std::string& key, std::string& valu
 }
 
 bool CheckpointManagerV2::read(const std::string& key, std::string& value) {
-    if (!readDatabase(key, value)) {
+    bool found = false;
+    {
+        std::lock_guard<std::mutex> lock(mCommitMutex);
+        auto iter = mPendingWrites.find(key);
+        if (iter != mPendingWrites.end()) {
+            value = iter->second;
+            found = true;
+        } else if ((iter = mCommittingWrites.find(key)) != mCommittingWrites.end()) {
+            value = iter->second;
+            found = true;
+        }
+    }
+    if (!found && !readDatabase(key, value)) {
         return false;
     }
 
@@ -408,9 +460,20 @@ bool CheckpointManagerV2::read(const std::string& key, std::string& value) {
     return true;
 }
 
-bool CheckpointManagerV2::write(const std::string& key, const std::string& value) {
+bool CheckpointManagerV2::write(const std::string& key, const std::string& value, bool waitForCommit) {
     ASSERT_LEVELDB_STATUS;
 
+    if (mCommitThreadPtr) {
+        std::unique_lock<std::mutex> lock(mCommitMutex);
+        if (!mStopCommitThread) {
+            mPendingWrites[key] = value;
+            if (!waitForCommit) {
+                return true;
+            }
+            return waitForBatch(lock, mPendingBatchNo);
+        }
+    }
+
     leveldb::Status s = mDatabase->Put(mDefaultWriteOption, key, value);
     if (s.ok()) {
         return true;
@@ -419,6 +482,111 @@ bool CheckpointManagerV2::write(const std::string& key, const std::string& value
     return false;
 }
 
+void CheckpointManagerV2::Flush() {
+    if (!mCommitThreadPtr) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(mCommitMutex);
+    if (!mPendingWrites.empty()) {
+        waitForBatch(lock, mPendingBatchNo);
+    } else if (!mCommittingWrites.empty()) {
+        // the batch taken by the commit thread
+        waitForBatch(lock, mPendingBatchNo - 1);
+    }
+}
+
+bool CheckpointManagerV2::waitForBatch(std::unique_lock<std::mutex>& lock, uint64_t batchNo) {
+    // references to elements of unordered_map stay valid until they are erased
+    auto& result = mCommitResults[batchNo];
+    ++result.mWaiterCnt;
+    if (batchNo == mPendingBatchNo) {
+        mHasCommitWaiter = true;
+        mCommitCV.notify_one();
+    }
+    mCommittedCV.wait(lock, [&]() { return mCommittedBatchNo >= batchNo; });
+    bool succeeded = result.mSucceeded;
+    if (--result.mWaiterCnt == 0) {
+        mCommitResults.erase(batchNo);
+    }
+    return succeeded;
+}
+
+void CheckpointManagerV2::runCommitLoop() {
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mCommitMutex);
+            mCommitCV.wait_for(lock,
+                               std::chrono::milliseconds(INT32_FLAG(checkpoint_group_commit_async_interval_ms)),
+                               [&]() { return mHasCommitWaiter || mStopCommitThread; });
+            if (mHasCommitWaiter && !mStopCommitThread && INT32_FLAG(checkpoint_group_commit_window_ms) > 0) {
+                // collect more updates within the durability window
+                mCommitCV.wait_for(lock,
+                                   std::chrono::milliseconds(INT32_FLAG(checkpoint_group_commit_window_ms)),
+                                   [&]() { return mStopCommitThread; });
+            }
+        }
+        commitPendingWrites();
+
+        std::lock_guard<std::mutex> lock(mCommitMutex);
+        if (mStopCommitThread && mPendingWrites.empty()) {
+            break;
+        }
+    }
+    LOG_INFO(sLogger, ("runCommitLoop exit", "done"));
+}
+
+void CheckpointManagerV2::commitPendingWrites() {
+    std::lock_guard<std::mutex> batchLock(mBatchWriteMutex);
+    uint64_t batchNo = 0;
+    {
+        std::lock_guard<std::mutex> lock(mCommitMutex);
+        mHasCommitWaiter = false;
+        batchNo = mPendingBatchNo++;
+        mCommittingWrites.swap(mPendingWrites);
+    }
+
+    // the batch is committed even if it is empty, so that waiters for it can go on
+    bool succeeded = true;
+    if (!mCommittingWrites.empty()) {
+        auto const startTime = std::chrono::steady_clock::now();
+        leveldb::WriteBatch batch;
+        for (auto& item : mCommittingWrites) {
+            batch.Put(item.first, item.second);
+        }
+        auto status = mDatabase->Write(mDefaultWriteOption, &batch);
+        mCommitLatencyMs->Record(std::chrono::steady_clock::now() - startTime);
+        mCommitsTotal->Add(1);
+        mCommittedCheckpointsTotal->Add(mCommittingWrites.size());
+        if (!status.ok()) {
+            succeeded = false;
+            detail::logDatabaseError("group_commit", std::to_string(mCommittingWrites.size()), status);
+        }
+    }
+
+    finishCommit(batchNo, succeeded);
+}
+
+void CheckpointManagerV2::finishCommit(uint64_t batchNo, bool succeeded) {
+    std::lock_guard<std::mutex> lock(mCommitMutex);
+    mCommittingWrites.clear();
+    mCommittedBatchNo = batchNo;
+    auto iter = mCommitResults.find(batchNo);
+    if (iter != mCommitResults.end()) {
+        iter->second.mSucceeded = succeeded;
+    }
+    mCommittedCV.notify_all();
+}
+
+void CheckpointManagerV2::dropPendingWrites(const std::vector<std::string>& keys) {
+    std::lock_guard<std::mutex> lock(mCommitMutex);
+    if (mPendingWrites.empty()) {
+        return;
+    }
+    for (auto& key : keys) {
+        mPendingWrites.erase(key);
+    }
+}
+
 void CheckpointManagerV2::MarkGC(const std::string& primaryKey) {
     {
         std::lock_guard<std::mutex> lock(mMutex);
@@ -476,13 +644,16 @@ void CheckpointManagerV2::checkGCItems() {
 }
 
 void CheckpointManagerV2::runGCLoop() {
-    if (nullptr == mDatabase) {
-        LOG_ERROR(sLogger, ("runGCLoop exit", "checkpoint database is closed"));
-        return;
-    }
-
-    while (!mStopGCThread) {
-        std::this_thread::sleep_for(std::chrono::seconds(INT32_FLAG(logtail_checkpoint_check_gc_interval_sec)));
+    // a GC round runs with mGCMutex held, so that the database can not be closed during it
+    std::unique_lock<std::mutex> lock(mGCMutex);
+    while (true) {
+        auto interval = std::chrono::seconds(INT32_FLAG(logtail_checkpoint_check_gc_interval_sec));
+        if (mGCCV.wait_for(lock, interval, [&]() { return mStopGCThread; })) {
+            break;
+        }
+        if (nullptr == mDatabase) {
+            continue;
+        }
 
         checkGCItems();
 
@@ -500,6 +671,9 @@ void CheckpointManagerV2::runGCLoop() {
 
 #ifdef APSARA_UNIT_TEST_MAIN
 void CheckpointManagerV2::rebuild() {
+    Flush();
+    std::lock_guard<std::mutex> gcLock(mGCMutex);
+    std::lock_guard<std::mutex> batchLock(mBatchWriteMutex);
     bool opened = close();
     leveldb::DestroyDB(detail::getDatabasePath(), leveldb::Options());
     if (opened) {
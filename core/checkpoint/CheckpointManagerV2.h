@@ -17,6 +17,7 @@
 #pragma once
 #include <leveldb/db.h>
 
+#include <condition_variable>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -24,6 +25,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "monitor/MetricManager.h"
 #include "plugin/input/InputFile.h"
 #include "protobuf/sls/checkpoint.pb.h"
 
@@ -47,6 +49,13 @@ namespace logtail {
 //  range checkpoints, that is why we call N concurrency.
 // - If order is import, the 1 primary checkpoint + N range checkpoints model downgrades
 //  to 1 primary + 1 range, ie. there is only one concurrency for the file.
+//
+// Checkpoint updates are group committed: updates from all readers and sender acks are
+//  collected and written to the database in one batch by the commit thread, so that
+//  the cost of a sync write is shared by all updates in the batch. An update which must
+//  be durable before going on, such as preparing a range before sending it, waits for
+//  its batch to be committed. Other updates, such as committing a range after it is
+//  acked, are committed with the next batch, at most a few moments later.
 class CheckpointManagerV2 {
 public:
     static std::string MakeRangeKey(const std::string& primaryKey, uint32_t idx);
@@ -86,16 +95,20 @@ public:
         return value.ParseFromString(data);
     }
 
+    // @waitForCommit: if false, return without waiting for the update to be committed.
     template <class PBType>
-    bool SetPB(const std::string& key, const PBType& value) {
+    bool SetPB(const std::string& key, const PBType& value, bool waitForCommit = true) {
         std::string data;
         if (!value.SerializeToString(&data)) {
             return false;
         }
 
-        return write(key, data);
+        return write(key, data, waitForCommit);
     }
 
+    // Commit all pending updates and wait until those being committed are done, called before exit.
+    void Flush();
+
     // Add primaryKey to GC list, called in destructor of LogFileReader.
     //
     // GetPB will remove primaryKey from GC list, so for config update case, primary
@@ -131,10 +144,25 @@ private:
 
     bool readDatabase(const std::string& key, std::string& value);
 
-    // Read/Write checkpoints by key.
+    // Read/Write checkpoints by key, pending updates are visible to read.
     // @return true if succeed.
     bool read(const std::string& key, std::string& value);
-    bool write(const std::string& key, const std::string& value);
+    bool write(const std::string& key, const std::string& value, bool waitForCommit = true);
+
+    // Routine of commit thread.
+    void runCommitLoop();
+
+    // Write pending updates to database in one batch.
+    void commitPendingWrites();
+    // Mark batch @batchNo committed and wake up its waiters.
+    void finishCommit(uint64_t batchNo, bool succeeded);
+    // Wait until batch @batchNo is committed, must be called with mCommitMutex held by @lock.
+    // @return true if the batch is written to database.
+    bool waitForBatch(std::unique_lock<std::mutex>& lock, uint64_t batchNo);
+
+    // Drop pending updates of keys which are going to be written or deleted directly,
+    //  must be called with mBatchWriteMutex held.
+    void dropPendingWrites(const std::vector<std::string>& keys);
 
     // Routine of GC thread.
     void runGCLoop();
@@ -172,16 +200,48 @@ private:
     leveldb::WriteOptions mDefaultWriteOption;
 
     volatile bool mStopGCThread = false;
+    // guards GC rounds, and wakes the GC thread up from its interval wait on stop
+    std::mutex mGCMutex;
+    std::condition_variable mGCCV;
     std::unique_ptr<std::thread> mGCThreadPtr;
     std::mutex mMutex;
     std::unordered_map<std::string, /* primary key */
                        time_t /* create time */>
         mGCItems;
 
+    // Lock order: mBatchWriteMutex -> mCommitMutex.
+    // mBatchWriteMutex serializes batch writes, so that a pending update is never
+    //  written after a direct write or deletion of the same key.
+    std::mutex mBatchWriteMutex;
+    std::mutex mCommitMutex;
+    std::condition_variable mCommitCV;
+    std::condition_variable mCommittedCV;
+    std::unordered_map<std::string, std::string> mPendingWrites;
+    // updates being written by the commit thread, still visible to read
+    std::unordered_map<std::string, std::string> mCommittingWrites;
+    // batches are numbered, an update belongs to the batch mPendingBatchNo when written
+    uint64_t mPendingBatchNo = 1;
+    uint64_t mCommittedBatchNo = 0;
+    struct CommitResult {
+        size_t mWaiterCnt = 0;
+        bool mSucceeded = true;
+    };
+    // results of batches being waited for, by batch number
+    std::unordered_map<uint64_t, CommitResult> mCommitResults;
+    bool mHasCommitWaiter = false;
+    bool mStopCommitThread = false;
+    std::unique_ptr<std::thread> mCommitThreadPtr;
+
+    MetricsRecordRef mMetricsRecordRef;
+    CounterPtr mCommitsTotal;
+    CounterPtr mCommittedCheckpointsTotal;
+    HistogramPtr mCommitLatencyMs;
+
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class CheckpointManagerV2Unittest;
     friend class ExactlyOnceReaderUnittest;
     friend class SenderUnittest;
+    friend class CheckpointGroupCommitUnittest;
 
     void rebuild();
 #endif
@@ -18,10 +18,10 @@
 
 namespace logtail {
 
-void RangeCheckpoint::save() {
+void RangeCheckpoint::save(bool waitForCommit) {
     static auto sCptM = CheckpointManagerV2::GetInstance();
     data.set_update_time(time(NULL));
-    sCptM->SetPB(key, data);
+    sCptM->SetPB(key, data, waitForCommit);
 }
 
 } // namespace logtail
@@ -31,14 +31,16 @@ public:
     QueueKey fbKey;
     RangeCheckpointPB data;
 
+    // the range must be persisted before it is sent
     inline void Prepare() {
         data.set_committed(false);
-        save();
+        save(true);
     }
 
+    // losing a commit only causes the range to be resent with the same sequence id, so it need not be waited for
     inline void Commit() {
         data.set_committed(true);
-        save();
+        save(false);
     }
 
     inline void IncreaseSequenceID() { data.set_sequence_id(data.sequence_id() + 1); }
@@ -46,7 +48,7 @@ public:
     inline bool IsComplete() const { return data.has_hash_key(); }
 
 private:
-    void save();
+    void save(bool waitForCommit);
 };
 
 typedef std::shared_ptr<RangeCheckpoint> RangeCheckpointPtr;
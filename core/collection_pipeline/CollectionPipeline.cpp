@@ -350,20 +350,29 @@ bool CollectionPipeline::Init(CollectionConfig&& config) {
                                                           {METRIC_LABEL_KEY_PIPELINE_NAME, mName},
                                                           {METRIC_LABEL_KEY_LOGSTORE, mContext.GetLogstoreName()}});
     mStartTime = mMetricsRecordRef.CreateIntGauge(METRIC_PIPELINE_START_TIME);
-    mProcessorsInEventsTotal = mMetricsRecordRef.CreateCounter(METRIC_PIPELINE_PROCESSORS_IN_EVENTS_TOTAL);
-    mProcessorsInGroupsTotal = mMetricsRecordRef.CreateCounter(METRIC_PIPELINE_PROCESSORS_IN_EVENT_GROUPS_TOTAL);
-    mProcessorsInSizeBytes = mMetricsRecordRef.CreateCounter(METRIC_PIPELINE_PROCESSORS_IN_SIZE_BYTES);
+    // updated by all processor threads for each event group
+    mProcessorsInEventsTotal = mMetricsRecordRef.CreateShardedCounter(METRIC_PIPELINE_PROCESSORS_IN_EVENTS_TOTAL);
+    mProcessorsInGroupsTotal
+        = mMetricsRecordRef.CreateShardedCounter(METRIC_PIPELINE_PROCESSORS_IN_EVENT_GROUPS_TOTAL);
+    mProcessorsInSizeBytes = mMetricsRecordRef.CreateShardedCounter(METRIC_PIPELINE_PROCESSORS_IN_SIZE_BYTES);
     mProcessorsTotalProcessTimeMs
-        = mMetricsRecordRef.CreateTimeCounter(METRIC_PIPELINE_PROCESSORS_TOTAL_PROCESS_TIME_MS);
-    mFlushersInGroupsTotal = mMetricsRecordRef.CreateCounter(METRIC_PIPELINE_FLUSHERS_IN_EVENT_GROUPS_TOTAL);
-    mFlushersInEventsTotal = mMetricsRecordRef.CreateCounter(METRIC_PIPELINE_FLUSHERS_IN_EVENTS_TOTAL);
-    mFlushersInSizeBytes = mMetricsRecordRef.CreateCounter(METRIC_PIPELINE_FLUSHERS_IN_SIZE_BYTES);
-    mFlushersTotalPackageTimeMs = mMetricsRecordRef.CreateTimeCounter(METRIC_PIPELINE_FLUSHERS_TOTAL_PACKAGE_TIME_MS);
+        = mMetricsRecordRef.CreateShardedTimeCounter(METRIC_PIPELINE_PROCESSORS_TOTAL_PROCESS_TIME_MS);
+    mFlushersInGroupsTotal = mMetricsRecordRef.CreateShardedCounter(METRIC_PIPELINE_FLUSHERS_IN_EVENT_GROUPS_TOTAL);
+    mFlushersInEventsTotal = mMetricsRecordRef.CreateShardedCounter(METRIC_PIPELINE_FLUSHERS_IN_EVENTS_TOTAL);
+    mFlushersInSizeBytes = mMetricsRecordRef.CreateShardedCounter(METRIC_PIPELINE_FLUSHERS_IN_SIZE_BYTES);
+    mFlushersTotalPackageTimeMs
+        = mMetricsRecordRef.CreateShardedTimeCounter(METRIC_PIPELINE_FLUSHERS_TOTAL_PACKAGE_TIME_MS);
 
     return true;
 }
 
 void CollectionPipeline::Start() {
+    StartProcessing();
+    StartInputs();
+    LOG_INFO(sLogger, ("pipeline start", "succeeded")("config", mName));
+}
+
+void CollectionPipeline::StartProcessing() {
     // #ifndef APSARA_UNIT_TEST_MAIN
     //  TODO: 应该保证指定时间内返回，如果无法返回，将配置放入startDisabled里
     for (const auto& flusher : mFlushers) {
@@ -380,13 +389,14 @@ void CollectionPipeline::Start() {
         LogtailPlugin::GetInstance()->Start(GetConfigNameOfGoPipelineWithInput());
     }
 
+    mStartTime->Set(chrono::duration_cast<chrono::seconds>(chrono::system_clock::now().time_since_epoch()).count());
+    // #endif
+}
+
+void CollectionPipeline::StartInputs() {
     for (const auto& input : mInputs) {
         input->Start();
     }
-
-    mStartTime->Set(chrono::duration_cast<chrono::seconds>(chrono::system_clock::now().time_since_epoch()).count());
-    // #endif
-    LOG_INFO(sLogger, ("pipeline start", "succeeded")("config", mName));
 }
 
 void CollectionPipeline::Process(vector<PipelineEventGroup>& logGroupList, size_t inputIndex) {
@@ -448,6 +458,12 @@ bool CollectionPipeline::FlushBatch() {
 }
 
 void CollectionPipeline::Stop(bool isRemoving) {
+    StopInputs(isRemoving);
+    StopProcessing(isRemoving);
+    LOG_INFO(sLogger, ("pipeline stop", "succeeded")("config", mName));
+}
+
+void CollectionPipeline::StopInputs(bool isRemoving) {
     // TODO: 应该保证指定时间内返回，如果无法返回，将配置放入stopDisabled里
     for (const auto& input : mInputs) {
         input->Stop(isRemoving);
@@ -458,7 +474,12 @@ void CollectionPipeline::Stop(bool isRemoving) {
         LogtailPlugin::GetInstance()->Stop(GetConfigNameOfGoPipelineWithInput(), isRemoving);
     }
 
+    // items left in the queue are bound to this pipeline, so they are processed by the old processors even if a new
+    // pipeline takes over the queue
     ProcessQueueManager::GetInstance()->DisablePop(mName, isRemoving);
+}
+
+void CollectionPipeline::StopProcessing(bool isRemoving) {
     WaitAllItemsInProcessFinished();
 
     FlushBatch();
@@ -471,7 +492,6 @@ void CollectionPipeline::Stop(bool isRemoving) {
     for (const auto& flusher : mFlushers) {
         flusher->Stop(isRemoving);
     }
-    LOG_INFO(sLogger, ("pipeline stop", "succeeded")("config", mName));
 }
 
 void CollectionPipeline::RemoveProcessQueue() const {
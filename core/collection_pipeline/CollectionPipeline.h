@@ -42,6 +42,14 @@ public:
     bool Init(CollectionConfig&& config);
     void Start();
     void Stop(bool isRemoving);
+    // Start and Stop are split into two halves, so that the inputs of a pipeline can be swapped while the file server
+    // is paused, and the rest of the pipeline can be drained and started after the file server has been resumed.
+    // StopInputs also disables popping from the process queue, so that the new pipeline sharing the same queue can be
+    // started with StartInputs before the old one is drained.
+    void StartProcessing();
+    void StartInputs();
+    void StopInputs(bool isRemoving);
+    void StopProcessing(bool isRemoving);
     void Process(std::vector<PipelineEventGroup>& logGroupList, size_t inputIndex);
     bool Send(std::vector<PipelineEventGroup>&& groupList);
     bool FlushBatch();
@@ -109,14 +117,14 @@ private:
 
     mutable MetricsRecordRef mMetricsRecordRef;
     IntGaugePtr mStartTime;
-    CounterPtr mProcessorsInEventsTotal;
-    CounterPtr mProcessorsInGroupsTotal;
-    CounterPtr mProcessorsInSizeBytes;
-    TimeCounterPtr mProcessorsTotalProcessTimeMs;
-    CounterPtr mFlushersInGroupsTotal;
-    CounterPtr mFlushersInEventsTotal;
-    CounterPtr mFlushersInSizeBytes;
-    TimeCounterPtr mFlushersTotalPackageTimeMs;
+    ShardedCounterPtr mProcessorsInEventsTotal;
+    ShardedCounterPtr mProcessorsInGroupsTotal;
+    ShardedCounterPtr mProcessorsInSizeBytes;
+    ShardedTimeCounterPtr mProcessorsTotalProcessTimeMs;
+    ShardedCounterPtr mFlushersInGroupsTotal;
+    ShardedCounterPtr mFlushersInEventsTotal;
+    ShardedCounterPtr mFlushersInSizeBytes;
+    ShardedTimeCounterPtr mFlushersTotalPackageTimeMs;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class PipelineMock;
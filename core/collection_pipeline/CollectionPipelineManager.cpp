@@ -59,19 +59,10 @@ void logtail::CollectionPipelineManager::UpdatePipelines(CollectionConfigDiff& d
     }
 #endif
 #endif
-    if (isFileServerStarted && isFileServerInputChanged) {
-        FileServer::GetInstance()->Pause();
-    }
-
-    for (const auto& name : diff.mRemoved) {
-        auto iter = mPipelineNameEntityMap.find(name);
-        iter->second->Stop(true);
-        DecreasePluginUsageCnt(iter->second->GetPluginStatistics());
-        iter->second->RemoveProcessQueue();
-        mPipelineNameEntityMap.erase(iter);
-        ConfigFeedbackReceiver::GetInstance().FeedbackContinuousPipelineConfigStatus(name,
-                                                                                     ConfigFeedbackStatus::DELETED);
-    }
+    // New pipelines are built alongside the old ones before the file server is paused, so that the pause only covers
+    // swapping the inputs, which is what the readers depend on. The old pipelines are drained after the file server is
+    // resumed, while the new ones keep their input data in the shared process queue until they are started.
+    vector<shared_ptr<CollectionPipeline>> modifiedPipelines;
     for (auto& config : diff.mModified) {
         auto p = BuildPipeline(std::move(config)); // auto reuse old pipeline's process queue and sender queue
         if (!p) {
@@ -91,16 +82,9 @@ void logtail::CollectionPipelineManager::UpdatePipelines(CollectionConfigDiff& d
         LOG_INFO(sLogger,
                  ("pipeline building for existing config succeeded",
                   "stop the old pipeline and start the new one")("config", config.mName));
-        auto iter = mPipelineNameEntityMap.find(config.mName);
-        iter->second->Stop(false);
-        DecreasePluginUsageCnt(iter->second->GetPluginStatistics());
-
-        mPipelineNameEntityMap[config.mName] = p;
-        IncreasePluginUsageCnt(p->GetPluginStatistics());
-        p->Start();
-        ConfigFeedbackReceiver::GetInstance().FeedbackContinuousPipelineConfigStatus(config.mName,
-                                                                                     ConfigFeedbackStatus::APPLIED);
+        modifiedPipelines.emplace_back(std::move(p));
     }
+    vector<shared_ptr<CollectionPipeline>> addedPipelines;
     for (auto& config : diff.mAdded) {
         auto p = BuildPipeline(std::move(config));
         if (!p) {
@@ -118,16 +102,40 @@ void logtail::CollectionPipelineManager::UpdatePipelines(CollectionConfigDiff& d
         }
         LOG_INFO(sLogger,
                  ("pipeline building for new config succeeded", "begin to start pipeline")("config", config.mName));
-        mPipelineNameEntityMap[config.mName] = p;
+        addedPipelines.emplace_back(std::move(p));
+    }
+
+    if (isFileServerStarted && isFileServerInputChanged) {
+        FileServer::GetInstance()->Pause();
+    }
+
+    vector<shared_ptr<CollectionPipeline>> removedPipelines;
+    for (const auto& name : diff.mRemoved) {
+        auto iter = mPipelineNameEntityMap.find(name);
+        iter->second->StopInputs(true);
+        DecreasePluginUsageCnt(iter->second->GetPluginStatistics());
+        removedPipelines.emplace_back(std::move(iter->second));
+        mPipelineNameEntityMap.erase(iter);
+    }
+    vector<shared_ptr<CollectionPipeline>> oldPipelines;
+    for (auto& p : modifiedPipelines) {
+        auto& entry = mPipelineNameEntityMap[p->Name()];
+        entry->StopInputs(false);
+        DecreasePluginUsageCnt(entry->GetPluginStatistics());
+        oldPipelines.emplace_back(std::move(entry));
+
+        entry = p;
+        IncreasePluginUsageCnt(p->GetPluginStatistics());
+        p->StartInputs();
+    }
+    for (auto& p : addedPipelines) {
+        mPipelineNameEntityMap[p->Name()] = p;
         IncreasePluginUsageCnt(p->GetPluginStatistics());
         p->Start();
-        ConfigFeedbackReceiver::GetInstance().FeedbackContinuousPipelineConfigStatus(config.mName,
+        ConfigFeedbackReceiver::GetInstance().FeedbackContinuousPipelineConfigStatus(p->Name(),
                                                                                      ConfigFeedbackStatus::APPLIED);
     }
 
-    // 在Flusher改造完成前，先不执行如下步骤，不会造成太大影响
-    // Sender::CleanUnusedAk();
-
     if (isFileServerInputChanged) {
         if (isFileServerStarted) {
             FileServer::GetInstance()->Resume();
@@ -137,6 +145,24 @@ void logtail::CollectionPipelineManager::UpdatePipelines(CollectionConfigDiff& d
         }
     }
 
+    for (auto& p : removedPipelines) {
+        p->StopProcessing(true);
+        p->RemoveProcessQueue();
+        LOG_INFO(sLogger, ("pipeline stop", "succeeded")("config", p->Name()));
+        ConfigFeedbackReceiver::GetInstance().FeedbackContinuousPipelineConfigStatus(p->Name(),
+                                                                                     ConfigFeedbackStatus::DELETED);
+    }
+    for (size_t i = 0; i < modifiedPipelines.size(); ++i) {
+        oldPipelines[i]->StopProcessing(false);
+        modifiedPipelines[i]->StartProcessing();
+        LOG_INFO(sLogger, ("pipeline hot swap", "succeeded")("config", modifiedPipelines[i]->Name()));
+        ConfigFeedbackReceiver::GetInstance().FeedbackContinuousPipelineConfigStatus(modifiedPipelines[i]->Name(),
+                                                                                     ConfigFeedbackStatus::APPLIED);
+    }
+
+    // 在Flusher改造完成前，先不执行如下步骤，不会造成太大影响
+    // Sender::CleanUnusedAk();
+
 #ifndef APSARA_UNIT_TEST_MAIN
 #if defined(__ENTERPRISE__) && defined(__linux__) && !defined(__ANDROID__)
     if (AppConfig::GetInstance()->ShennongSocketEnabled()) {
@@ -0,0 +1,118 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "collection_pipeline/batch/AdaptiveBatchTuner.h"
+
+#include <algorithm>
+
+#include "common/Flags.h"
+
+DEFINE_FLAG_INT32(adaptive_batch_adjust_interval_ms, "interval of adjusting adaptive batch size, in ms", 1000);
+DEFINE_FLAG_INT32(adaptive_batch_queue_time_threshold_ms,
+                  "sink is considered under pressure if items wait longer than this in sender queue on average, in ms",
+                  1000);
+DEFINE_FLAG_INT32(adaptive_batch_response_time_threshold_ms,
+                  "sink is considered under pressure if responses are slower than this on average, in ms",
+                  1000);
+
+using namespace std;
+
+namespace logtail {
+
+AdaptiveBatchTuner::AdaptiveBatchTuner(uint32_t minSizeBytes, uint32_t maxSizeBytes, uint32_t initialSizeBytes)
+    : mMinSizeBytes(minSizeBytes),
+      mMaxSizeBytes(max(minSizeBytes, maxSizeBytes)),
+      mTargetSizeBytes(clamp(initialSizeBytes, mMinSizeBytes, mMaxSizeBytes)),
+      mLastAdjustTime(chrono::steady_clock::now()) {
+    // compression ratio is regarded as 1 until observed
+    mCompressedTargetSizeBytes = mTargetSizeBytes;
+}
+
+void AdaptiveBatchTuner::OnCompressed(size_t rawSize, size_t compressedSize) {
+    if (rawSize == 0 || compressedSize == 0) {
+        return;
+    }
+    double ratio = static_cast<double>(rawSize) / compressedSize;
+    lock_guard<mutex> lock(mMux);
+    if (mCompressionRatio == 0.0) {
+        // keep the raw target unchanged on first observation
+        mCompressionRatio = ratio;
+        mCompressedTargetSizeBytes = mTargetSizeBytes / ratio;
+    } else {
+        mCompressionRatio = 0.9 * mCompressionRatio + 0.1 * ratio;
+    }
+}
+
+void AdaptiveBatchTuner::OnSendDone(chrono::milliseconds responseTime, chrono::milliseconds queueTime, bool throttled) {
+    lock_guard<mutex> lock(mMux);
+    ++mSendCnt;
+    if (throttled) {
+        ++mThrottledCnt;
+    }
+    mTotalResponseTimeMs += max<int64_t>(responseTime.count(), 0);
+    mTotalQueueTimeMs += max<int64_t>(queueTime.count(), 0);
+}
+
+bool AdaptiveBatchTuner::Adjust(chrono::steady_clock::time_point now, uint32_t& targetSizeBytes) {
+    lock_guard<mutex> lock(mMux);
+    if (now - mLastAdjustTime < chrono::milliseconds(INT32_FLAG(adaptive_batch_adjust_interval_ms))) {
+        return false;
+    }
+    mLastAdjustTime = now;
+
+    int64_t avgQueueTimeMs = 0;
+    int64_t avgResponseTimeMs = 0;
+    if (mSendCnt > 0) {
+        avgQueueTimeMs = mTotalQueueTimeMs / mSendCnt;
+        avgResponseTimeMs = mTotalResponseTimeMs / mSendCnt;
+    }
+    bool underPressure = mThrottledCnt > 0 || avgQueueTimeMs >= INT32_FLAG(adaptive_batch_queue_time_threshold_ms)
+        || avgResponseTimeMs >= INT32_FLAG(adaptive_batch_response_time_threshold_ms);
+    // items hardly wait in sender queue, so smaller batches can be sent without hurting throughput
+    bool isIdle = !underPressure && avgQueueTimeMs < INT32_FLAG(adaptive_batch_queue_time_threshold_ms) / 4;
+    mSendCnt = 0;
+    mThrottledCnt = 0;
+    mTotalResponseTimeMs = 0;
+    mTotalQueueTimeMs = 0;
+
+    double ratio = mCompressionRatio == 0.0 ? 1.0 : mCompressionRatio;
+    if (underPressure) {
+        mCompressedTargetSizeBytes = min(mCompressedTargetSizeBytes * 2, mMaxSizeBytes / ratio);
+    } else if (isIdle) {
+        mCompressedTargetSizeBytes = max(mCompressedTargetSizeBytes * 0.75, mMinSizeBytes / ratio);
+    }
+
+    uint32_t target = CalculateTargetSizeBytes();
+    if (target == mTargetSizeBytes) {
+        return false;
+    }
+    mTargetSizeBytes = target;
+    targetSizeBytes = target;
+    return true;
+}
+
+uint32_t AdaptiveBatchTuner::GetTargetSizeBytes() const {
+    lock_guard<mutex> lock(mMux);
+    return mTargetSizeBytes;
+}
+
+uint32_t AdaptiveBatchTuner::CalculateTargetSizeBytes() const {
+    double ratio = mCompressionRatio == 0.0 ? 1.0 : mCompressionRatio;
+    double target = clamp(mCompressedTargetSizeBytes * ratio,
+                          static_cast<double>(mMinSizeBytes),
+                          static_cast<double>(mMaxSizeBytes));
+    return static_cast<uint32_t>(target);
+}
+
+} // namespace logtail
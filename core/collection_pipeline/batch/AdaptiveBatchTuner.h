@@ -0,0 +1,71 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <chrono>
+#include <mutex>
+
+namespace logtail {
+
+// Tunes the min size of a batch from the feedback of the sink.
+//
+// The tuner aims at a compressed request size, which is doubled when the sink is under pressure, i.e. requests are
+// throttled, or items wait too long in the sender queue, or responses are too slow, so that fewer but larger requests
+// are sent at peak. Otherwise, the target is shrunk gradually, so that batches are sent sooner off peak. The raw size
+// target given to the batcher is the compressed one multiplied by the observed compression ratio, bounded by
+// [minSizeBytes, maxSizeBytes].
+class AdaptiveBatchTuner {
+public:
+    AdaptiveBatchTuner(uint32_t minSizeBytes, uint32_t maxSizeBytes, uint32_t initialSizeBytes);
+
+    void OnCompressed(size_t rawSize, size_t compressedSize);
+    void OnSendDone(std::chrono::milliseconds responseTime, std::chrono::milliseconds queueTime, bool throttled);
+    // @return true if the target is changed
+    bool Adjust(std::chrono::steady_clock::time_point now, uint32_t& targetSizeBytes);
+
+    uint32_t GetTargetSizeBytes() const;
+    uint32_t GetMinSizeBytes() const { return mMinSizeBytes; }
+    uint32_t GetMaxSizeBytes() const { return mMaxSizeBytes; }
+
+private:
+    uint32_t CalculateTargetSizeBytes() const;
+
+    const uint32_t mMinSizeBytes;
+    const uint32_t mMaxSizeBytes;
+
+    mutable std::mutex mMux;
+    // raw size / compressed size, 0 if not observed yet
+    double mCompressionRatio = 0.0;
+    double mCompressedTargetSizeBytes = 0.0;
+    uint32_t mTargetSizeBytes = 0;
+    std::chrono::steady_clock::time_point mLastAdjustTime;
+
+    // feedback since last adjustment
+    uint32_t mSendCnt = 0;
+    uint32_t mThrottledCnt = 0;
+    int64_t mTotalResponseTimeMs = 0;
+    int64_t mTotalQueueTimeMs = 0;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class AdaptiveBatchTunerUnittest;
+    friend class BatcherUnittest;
+#endif
+};
+
+} // namespace logtail
@@ -20,6 +20,7 @@
 #include <ctime>
 
 #include "collection_pipeline/batch/BatchedEvents.h"
+#include "common/TimeUtil.h"
 #include "models/PipelineEventPtr.h"
 
 namespace logtail {
@@ -31,12 +32,12 @@ public:
     virtual void Reset() {
         mCnt = 0;
         mSizeBytes = 0;
-        mCreateTime = 0;
+        mCreateTimeMs = 0;
     }
 
     virtual void Update(const PipelineEventPtr& e) {
-        if (mCreateTime == 0) {
-            mCreateTime = time(nullptr);
+        if (mCreateTimeMs == 0) {
+            mCreateTimeMs = GetCoarseSteadyTimeInMilliSeconds();
         }
         mSizeBytes += e->DataSize();
         ++mCnt;
@@ -44,12 +45,13 @@ public:
 
     uint32_t GetCnt() const { return mCnt; }
     uint32_t GetSize() const { return mSizeBytes; }
-    time_t GetCreateTime() const { return mCreateTime; }
+    // in coarse steady time
+    uint64_t GetCreateTimeMs() const { return mCreateTimeMs; }
 
 protected:
     uint32_t mCnt = 0;
     uint32_t mSizeBytes = 0;
-    time_t mCreateTime = 0;
+    uint64_t mCreateTimeMs = 0;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class EventFlushStrategyUnittest;
@@ -60,22 +62,23 @@ class GroupBatchStatus {
 public:
     void Reset() {
         mSizeBytes = 0;
-        mCreateTime = 0;
+        mCreateTimeMs = 0;
     }
 
     void Update(const BatchedEvents& g) {
-        if (mCreateTime == 0) {
-            mCreateTime = time(nullptr);
+        if (mCreateTimeMs == 0) {
+            mCreateTimeMs = GetCoarseSteadyTimeInMilliSeconds();
         }
         mSizeBytes += g.mSizeBytes;
     }
 
     uint32_t GetSize() const { return mSizeBytes; }
-    time_t GetCreateTime() const { return mCreateTime; }
+    // in coarse steady time
+    uint64_t GetCreateTimeMs() const { return mCreateTimeMs; }
 
 private:
     uint32_t mSizeBytes = 0;
-    time_t mCreateTime = 0;
+    uint64_t mCreateTimeMs = 0;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class GroupFlushStrategyUnittest;
@@ -90,8 +93,8 @@ public:
     }
 
     void Update(const PipelineEventPtr& e) override {
-        if (mCreateTime == 0) {
-            mCreateTime = time(nullptr);
+        if (mCreateTimeMs == 0) {
+            mCreateTimeMs = GetCoarseSteadyTimeInMilliSeconds();
             mCreateTimeMinute = e->GetTimestamp() / 60;
         }
         mSizeBytes += e->DataSize();
@@ -18,6 +18,8 @@
 
 #include <cstdint>
 
+#include <algorithm>
+#include <chrono>
 #include <map>
 #include <mutex>
 #include <optional>
@@ -26,6 +28,7 @@
 #include "json/json.h"
 
 #include "collection_pipeline/CollectionPipelineContext.h"
+#include "collection_pipeline/batch/AdaptiveBatchTuner.h"
 #include "collection_pipeline/batch/BatchItem.h"
 #include "collection_pipeline/batch/BatchStatus.h"
 #include "collection_pipeline/batch/FlushStrategy.h"
@@ -87,18 +90,76 @@ public:
                                   ctx.GetRegion());
         }
 
+        // TimeoutMs takes precedence over TimeoutSecs, which allows sub-second timeouts
+        uint32_t timeoutMs = timeoutSecs * 1000;
+        if (!GetOptionalUIntParam(config, "TimeoutMs", timeoutMs, errorMsg)) {
+            PARAM_WARNING_DEFAULT(ctx.GetLogger(),
+                                  ctx.GetAlarm(),
+                                  errorMsg,
+                                  timeoutMs,
+                                  flusher->Name(),
+                                  ctx.GetConfigName(),
+                                  ctx.GetProjectName(),
+                                  ctx.GetLogstoreName(),
+                                  ctx.GetRegion());
+        }
+
         if (enableGroupBatch) {
-            uint32_t groupTimeout = timeoutSecs / 2;
-            mGroupFlushStrategy = GroupFlushStrategy(minSizeBytes, groupTimeout);
+            uint32_t groupTimeoutMs = timeoutMs / 2;
+            mGroupFlushStrategy = GroupFlushStrategy(minSizeBytes, groupTimeoutMs);
             mGroupQueue = GroupBatchItem();
-            mEventFlushStrategy.SetTimeoutSecs(timeoutSecs - groupTimeout);
+            mEventFlushStrategy.SetTimeoutMs(timeoutMs - groupTimeoutMs);
         } else {
-            mEventFlushStrategy.SetTimeoutSecs(timeoutSecs);
+            mEventFlushStrategy.SetTimeoutMs(timeoutMs);
         }
         mEventFlushStrategy.SetMaxSizeBytes(strategy.mMaxSizeBytes);
         mEventFlushStrategy.SetMinSizeBytes(minSizeBytes);
         mEventFlushStrategy.SetMinCnt(minCnt);
 
+        bool enableAdaptiveSize = false;
+        if (!GetOptionalBoolParam(config, "EnableAdaptiveSize", enableAdaptiveSize, errorMsg)) {
+            PARAM_WARNING_DEFAULT(ctx.GetLogger(),
+                                  ctx.GetAlarm(),
+                                  errorMsg,
+                                  enableAdaptiveSize,
+                                  flusher->Name(),
+                                  ctx.GetConfigName(),
+                                  ctx.GetProjectName(),
+                                  ctx.GetLogstoreName(),
+                                  ctx.GetRegion());
+        }
+        if (enableAdaptiveSize) {
+            uint32_t adaptiveMinSizeBytes = minSizeBytes / 4;
+            if (!GetOptionalUIntParam(config, "AdaptiveMinSizeBytes", adaptiveMinSizeBytes, errorMsg)) {
+                PARAM_WARNING_DEFAULT(ctx.GetLogger(),
+                                      ctx.GetAlarm(),
+                                      errorMsg,
+                                      adaptiveMinSizeBytes,
+                                      flusher->Name(),
+                                      ctx.GetConfigName(),
+                                      ctx.GetProjectName(),
+                                      ctx.GetLogstoreName(),
+                                      ctx.GetRegion());
+            }
+            uint32_t adaptiveMaxSizeBytes = static_cast<uint32_t>(
+                std::min<uint64_t>(strategy.mMaxSizeBytes, std::max<uint64_t>(minSizeBytes, 1) * 8));
+            if (!GetOptionalUIntParam(config, "AdaptiveMaxSizeBytes", adaptiveMaxSizeBytes, errorMsg)) {
+                PARAM_WARNING_DEFAULT(ctx.GetLogger(),
+                                      ctx.GetAlarm(),
+                                      errorMsg,
+                                      adaptiveMaxSizeBytes,
+                                      flusher->Name(),
+                                      ctx.GetConfigName(),
+                                      ctx.GetProjectName(),
+                                      ctx.GetLogstoreName(),
+                                      ctx.GetRegion());
+            }
+            adaptiveMaxSizeBytes = std::min(adaptiveMaxSizeBytes, strategy.mMaxSizeBytes);
+            mAdaptiveTuner.emplace(adaptiveMinSizeBytes, adaptiveMaxSizeBytes, minSizeBytes);
+        }
+        mInitialMinSizeBytes = minSizeBytes;
+        mInitialMinCnt = minCnt;
+
         mFlusher = flusher;
 
         std::vector<std::pair<std::string, std::string>> labels{
@@ -122,10 +183,35 @@ public:
         mBufferedEventsTotal = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_BATCHER_BUFFERED_EVENTS_TOTAL);
         mBufferedDataSizeByte = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_BATCHER_BUFFERED_SIZE_BYTES);
         mTotalAddTimeMs = mMetricsRecordRef.CreateTimeCounter(METRIC_COMPONENT_BATCHER_TOTAL_ADD_TIME_MS);
+        mAddLatencyMs = mMetricsRecordRef.CreateHistogram(METRIC_COMPONENT_BATCHER_ADD_LATENCY_MS);
+        mTargetSizeBytes = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_BATCHER_TARGET_SIZE_BYTES);
+        mTargetCnt = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_BATCHER_TARGET_CNT);
+        mTargetSizeBytes->Set(minSizeBytes);
+        mTargetCnt->Set(minCnt);
 
         return true;
     }
 
+    // feedback from the sink, which is ignored unless adaptive size is enabled
+    void OnCompressed(size_t rawSize, size_t compressedSize) {
+        if (mAdaptiveTuner) {
+            mAdaptiveTuner->OnCompressed(rawSize, compressedSize);
+        }
+    }
+
+    void OnSendDone(std::chrono::milliseconds responseTime, std::chrono::milliseconds queueTime, bool throttled) {
+        if (!mAdaptiveTuner) {
+            return;
+        }
+        mAdaptiveTuner->OnSendDone(responseTime, queueTime, throttled);
+        uint32_t targetSizeBytes = 0;
+        if (!mAdaptiveTuner->Adjust(std::chrono::steady_clock::now(), targetSizeBytes)) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mMux);
+        SetTargetSizeBytes(targetSizeBytes);
+    }
+
     // when group level batch is disabled, there should be only 1 element in BatchedEventsList
     void Add(PipelineEventGroup&& g, std::vector<BatchedEventsList>& res) {
         auto before = std::chrono::system_clock::now();
@@ -179,7 +265,7 @@ public:
                             TimeoutFlushManager::GetInstance()->UpdateRecord(mFlusher->GetContext().GetConfigName(),
                                                                              mFlusher->GetFlusherIndex(),
                                                                              0,
-                                                                             mGroupFlushStrategy->GetTimeoutSecs(),
+                                                                             mGroupFlushStrategy->GetTimeoutMs(),
                                                                              mFlusher);
                         }
                         item.Flush(mGroupQueue.value());
@@ -197,7 +283,7 @@ public:
                     TimeoutFlushManager::GetInstance()->UpdateRecord(mFlusher->GetContext().GetConfigName(),
                                                                      mFlusher->GetFlusherIndex(),
                                                                      key,
-                                                                     mEventFlushStrategy.GetTimeoutSecs(),
+                                                                     mEventFlushStrategy.GetTimeoutMs(),
                                                                      mFlusher);
                     mBufferedGroupsTotal->Add(1);
                     mBufferedDataSizeByte->Add(item.DataSize());
@@ -214,7 +300,9 @@ public:
                 }
             }
         }
-        mTotalAddTimeMs->Add(std::chrono::system_clock::now() - before);
+        auto cost = std::chrono::system_clock::now() - before;
+        mTotalAddTimeMs->Add(cost);
+        mAddLatencyMs->Record(cost);
     }
 
     // key != 0: event level queue
@@ -250,7 +338,7 @@ public:
             TimeoutFlushManager::GetInstance()->UpdateRecord(mFlusher->GetContext().GetConfigName(),
                                                              mFlusher->GetFlusherIndex(),
                                                              0,
-                                                             mGroupFlushStrategy->GetTimeoutSecs(),
+                                                             mGroupFlushStrategy->GetTimeoutMs(),
                                                              mFlusher);
         }
         iter->second.Flush(mGroupQueue.value());
@@ -294,6 +382,23 @@ public:
 #endif
 
 private:
+    // the min cnt is scaled together with the min size, so that batches grown under pressure are not cut short by cnt
+    void SetTargetSizeBytes(uint32_t sizeBytes) {
+        uint32_t cnt = mInitialMinCnt;
+        if (mInitialMinCnt > 0 && mInitialMinSizeBytes > 0) {
+            cnt = static_cast<uint32_t>(std::min<uint64_t>(
+                UINT32_MAX,
+                std::max<uint64_t>(1, static_cast<uint64_t>(mInitialMinCnt) * sizeBytes / mInitialMinSizeBytes)));
+        }
+        mEventFlushStrategy.SetMinSizeBytes(sizeBytes);
+        mEventFlushStrategy.SetMinCnt(cnt);
+        if (mGroupFlushStrategy) {
+            mGroupFlushStrategy->SetMinSizeBytes(sizeBytes);
+        }
+        mTargetSizeBytes->Set(sizeBytes);
+        mTargetCnt->Set(cnt);
+    }
+
     void UpdateMetricsOnFlushingEventQueue(const EventBatchItem<T>& item) {
         mOutEventsTotal->Add(item.EventSize());
         // mTotalDelayMs->Add(
@@ -327,6 +432,10 @@ private:
     std::optional<GroupBatchItem> mGroupQueue;
     std::optional<GroupFlushStrategy> mGroupFlushStrategy;
 
+    std::optional<AdaptiveBatchTuner> mAdaptiveTuner;
+    uint32_t mInitialMinSizeBytes = 0;
+    uint32_t mInitialMinCnt = 0;
+
     Flusher* mFlusher = nullptr;
 
     mutable MetricsRecordRef mMetricsRecordRef;
@@ -339,6 +448,9 @@ private:
     IntGaugePtr mBufferedEventsTotal;
     IntGaugePtr mBufferedDataSizeByte;
     TimeCounterPtr mTotalAddTimeMs;
+    HistogramPtr mAddLatencyMs;
+    IntGaugePtr mTargetSizeBytes;
+    IntGaugePtr mTargetCnt;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class BatcherUnittest;
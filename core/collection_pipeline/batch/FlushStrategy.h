@@ -24,6 +24,7 @@
 #include "json/json.h"
 
 #include "collection_pipeline/batch/BatchStatus.h"
+#include "common/TimeUtil.h"
 #include "models/PipelineEventPtr.h"
 
 namespace logtail {
@@ -41,18 +42,21 @@ public:
     void SetMaxSizeBytes(uint32_t size) { mMaxSizeBytes = size; }
     void SetMinSizeBytes(uint32_t size) { mMinSizeBytes = size; }
     void SetMinCnt(uint32_t cnt) { mMinCnt = cnt; }
-    void SetTimeoutSecs(uint32_t secs) { mTimeoutSecs = secs; }
+    void SetTimeoutSecs(uint32_t secs) { mTimeoutMs = secs * 1000; }
+    void SetTimeoutMs(uint32_t ms) { mTimeoutMs = ms; }
     uint32_t GetMaxSizeBytes() const { return mMaxSizeBytes; }
     uint32_t GetMinSizeBytes() const { return mMinSizeBytes; }
     uint32_t GetMinCnt() const { return mMinCnt; }
-    uint32_t GetTimeoutSecs() const { return mTimeoutSecs; }
+    uint32_t GetTimeoutSecs() const { return mTimeoutMs / 1000; }
+    uint32_t GetTimeoutMs() const { return mTimeoutMs; }
 
     // should be called after event is added
     bool NeedFlushBySize(const T& status) { return status.GetSize() >= mMinSizeBytes; }
-    bool NeedFlushByCnt(const T& status) { return status.GetCnt() == mMinCnt; }
+    // >= rather than ==, since min cnt may be lowered by adaptive batching while the batch is being filled
+    bool NeedFlushByCnt(const T& status) { return mMinCnt > 0 && status.GetCnt() >= mMinCnt; }
     // should be called before event is added
     bool NeedFlushByTime(const T& status, const PipelineEventPtr& e) {
-        return time(nullptr) - status.GetCreateTime() >= mTimeoutSecs;
+        return GetCoarseSteadyTimeInMilliSeconds() - status.GetCreateTimeMs() >= mTimeoutMs;
     }
     bool SizeReachingUpperLimit(const T& status) { return status.GetSize() >= mMaxSizeBytes; }
 
@@ -60,28 +64,30 @@ private:
     uint32_t mMaxSizeBytes = 0;
     uint32_t mMinSizeBytes = 0;
     uint32_t mMinCnt = 0;
-    uint32_t mTimeoutSecs = 0;
+    uint32_t mTimeoutMs = 0;
 };
 
 class GroupFlushStrategy {
 public:
-    GroupFlushStrategy(uint32_t size, uint32_t timeout) : mMinSizeBytes(size), mTimeoutSecs(timeout) {}
+    GroupFlushStrategy(uint32_t size, uint32_t timeoutMs) : mMinSizeBytes(size), mTimeoutMs(timeoutMs) {}
 
     void SetMinSizeBytes(uint32_t size) { mMinSizeBytes = size; }
-    void SetTimeoutSecs(uint32_t secs) { mTimeoutSecs = secs; }
+    void SetTimeoutSecs(uint32_t secs) { mTimeoutMs = secs * 1000; }
+    void SetTimeoutMs(uint32_t ms) { mTimeoutMs = ms; }
     uint32_t GetMinSizeBytes() const { return mMinSizeBytes; }
-    uint32_t GetTimeoutSecs() const { return mTimeoutSecs; }
+    uint32_t GetTimeoutSecs() const { return mTimeoutMs / 1000; }
+    uint32_t GetTimeoutMs() const { return mTimeoutMs; }
 
     // should be called after event is added
     bool NeedFlushBySize(const GroupBatchStatus& status) { return status.GetSize() >= mMinSizeBytes; }
     // should be called before event is added
     bool NeedFlushByTime(const GroupBatchStatus& status) {
-        return time(nullptr) - status.GetCreateTime() >= mTimeoutSecs;
+        return GetCoarseSteadyTimeInMilliSeconds() - status.GetCreateTimeMs() >= mTimeoutMs;
     }
 
 private:
     uint32_t mMinSizeBytes = 0;
-    uint32_t mTimeoutSecs = 0;
+    uint32_t mTimeoutMs = 0;
 };
 
 template <>
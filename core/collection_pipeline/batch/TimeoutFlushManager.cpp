@@ -14,37 +14,84 @@
 
 #include "collection_pipeline/batch/TimeoutFlushManager.h"
 
+#include "common/Flags.h"
+#include "logger/Logger.h"
+
+DEFINE_FLAG_INT32(timeout_flush_manager_exit_timeout_sec, "max time to wait for timeout flush thread to exit", 3);
+
 using namespace std;
 
 namespace logtail {
 
+void TimeoutFlushManager::Init() {
+    {
+        lock_guard<mutex> lock(mMux);
+        if (mIsThreadRunning) {
+            return;
+        }
+        mIsThreadRunning = true;
+    }
+    mThreadRes = async(launch::async, &TimeoutFlushManager::Run, this);
+}
+
+void TimeoutFlushManager::Stop() {
+    {
+        lock_guard<mutex> lock(mMux);
+        if (!mIsThreadRunning) {
+            return;
+        }
+        mIsThreadRunning = false;
+    }
+    mCond.notify_all();
+    if (!mThreadRes.valid()) {
+        return;
+    }
+    future_status s = mThreadRes.wait_for(chrono::seconds(INT32_FLAG(timeout_flush_manager_exit_timeout_sec)));
+    if (s == future_status::ready) {
+        LOG_INFO(sLogger, ("timeout flush manager", "stopped successfully"));
+    } else {
+        LOG_WARNING(sLogger, ("timeout flush manager", "forced to stopped"));
+    }
+}
+
 void TimeoutFlushManager::UpdateRecord(
-    const string& config, size_t index, size_t key, uint32_t timeoutSecs, Flusher* f) {
+    const string& config, size_t index, size_t key, uint32_t timeoutMs, Flusher* f) {
     lock_guard<mutex> lock(mMux);
     auto& item = mTimeoutRecords[config];
     auto it = item.find({index, key});
     if (it == item.end()) {
-        item.try_emplace({index, key}, f, key, timeoutSecs);
+        it = item.try_emplace({index, key}, f, key, timeoutMs).first;
     } else {
         it->second.Update();
     }
+    uint64_t deadline = it->second.GetDeadline();
+    bool isEarliest = mDeadlines.empty() || deadline < mDeadlines.top().mTimeMs;
+    mDeadlines.push({deadline, config, {index, key}});
+    if (isEarliest) {
+        mCond.notify_one();
+    }
 }
 
 void TimeoutFlushManager::FlushTimeoutBatch() {
     vector<pair<Flusher*, size_t>> records;
+    lock_guard<mutex> flushLock(mFlushMux);
     {
         lock_guard<mutex> lock(mMux);
-        for (auto& item : mTimeoutRecords) {
-            for (auto it = item.second.begin(); it != item.second.end();) {
-                if (time(nullptr) - it->second.mUpdateTime >= it->second.mTimeoutSecs) {
+        uint64_t now = GetCoarseSteadyTimeInMilliSeconds();
+        while (!mDeadlines.empty() && mDeadlines.top().mTimeMs <= now) {
+            const auto& deadline = mDeadlines.top();
+            auto item = mTimeoutRecords.find(deadline.mConfig);
+            if (item != mTimeoutRecords.end()) {
+                auto it = item->second.find(deadline.mId);
+                // the record may have been updated after the deadline is pushed, in which case it has a later entry
+                if (it != item->second.end() && it->second.GetDeadline() <= now) {
                     // cannot flush here, since flush may also update record, which will lead to both deadlock and map
                     // iterator invalidation problems
                     records.emplace_back(it->second.mFlusher, it->second.mKey);
-                    it = item.second.erase(it);
-                } else {
-                    ++it;
+                    item->second.erase(it);
                 }
             }
+            mDeadlines.pop();
         }
     }
     for (auto& item : records) {
@@ -53,8 +100,30 @@ void TimeoutFlushManager::FlushTimeoutBatch() {
 }
 
 void TimeoutFlushManager::ClearRecords(const string& config) {
+    lock_guard<mutex> flushLock(mFlushMux);
     lock_guard<mutex> lock(mMux);
     mTimeoutRecords.erase(config);
 }
 
+void TimeoutFlushManager::Run() {
+    LOG_INFO(sLogger, ("timeout flush manager", "started"));
+    unique_lock<mutex> lock(mMux);
+    while (mIsThreadRunning) {
+        if (mDeadlines.empty()) {
+            mCond.wait(lock);
+        } else {
+            uint64_t now = GetCoarseSteadyTimeInMilliSeconds();
+            if (mDeadlines.top().mTimeMs > now) {
+                mCond.wait_for(lock, chrono::milliseconds(mDeadlines.top().mTimeMs - now));
+            }
+        }
+        if (!mIsThreadRunning) {
+            break;
+        }
+        lock.unlock();
+        FlushTimeoutBatch();
+        lock.lock();
+    }
+}
+
 } // namespace logtail
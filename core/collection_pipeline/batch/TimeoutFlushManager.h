@@ -17,29 +17,40 @@
 #pragma once
 
 #include <cstdint>
-#include <ctime>
 
+#include <condition_variable>
+#include <future>
 #include <map>
 #include <mutex>
+#include <queue>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "collection_pipeline/plugin/interface/Flusher.h"
+#include "common/TimeUtil.h"
 
 namespace logtail {
 
 struct TimeoutRecord {
     Flusher* mFlusher = nullptr;
     size_t mKey;
-    time_t mUpdateTime = 0;
-    uint32_t mTimeoutSecs = 0;
+    // in coarse steady time
+    uint64_t mUpdateTimeMs = 0;
+    uint32_t mTimeoutMs = 0;
 
-    TimeoutRecord(Flusher* flusher, size_t key, uint32_t timeoutSecs)
-        : mFlusher(flusher), mKey(key), mUpdateTime(time(nullptr)), mTimeoutSecs(timeoutSecs) {}
+    TimeoutRecord(Flusher* flusher, size_t key, uint32_t timeoutMs)
+        : mFlusher(flusher), mKey(key), mUpdateTimeMs(GetCoarseSteadyTimeInMilliSeconds()), mTimeoutMs(timeoutMs) {}
 
-    void Update() { mUpdateTime = time(nullptr); }
+    void Update() { mUpdateTimeMs = GetCoarseSteadyTimeInMilliSeconds(); }
+    uint64_t GetDeadline() const { return mUpdateTimeMs + mTimeoutMs; }
 };
 
+// Flushes batches on timeout in a dedicated thread.
+//
+// Deadlines of all records are kept in a min-heap, so the thread sleeps exactly until the earliest deadline instead
+// of polling. Heap entries are not removed when the record is updated or cleared, instead they are checked against
+// the record when popped.
 class TimeoutFlushManager {
 public:
     TimeoutFlushManager(const TimeoutFlushManager&) = delete;
@@ -50,16 +61,38 @@ public:
         return &instance;
     }
 
-    void UpdateRecord(const std::string& config, size_t index, size_t key, uint32_t timeoutSecs, Flusher* f);
+    void Init();
+    void Stop();
+
+    void UpdateRecord(const std::string& config, size_t index, size_t key, uint32_t timeoutMs, Flusher* f);
     void FlushTimeoutBatch();
+    // no batch of the config is being flushed on timeout after return
     void ClearRecords(const std::string& config);
 
 private:
+    struct Deadline {
+        uint64_t mTimeMs = 0;
+        std::string mConfig;
+        std::pair<size_t, size_t> mId;
+
+        bool operator>(const Deadline& rhs) const { return mTimeMs > rhs.mTimeMs; }
+    };
+
     TimeoutFlushManager() = default;
     ~TimeoutFlushManager() = default;
 
+    void Run();
+
     std::mutex mMux;
     std::map<std::string, std::map<std::pair<size_t, size_t>, TimeoutRecord>> mTimeoutRecords;
+    std::priority_queue<Deadline, std::vector<Deadline>, std::greater<Deadline>> mDeadlines;
+
+    // held while flushing, so that flushers of a removed pipeline are never flushed after ClearRecords
+    std::mutex mFlushMux;
+
+    std::future<void> mThreadRes;
+    std::condition_variable mCond;
+    bool mIsThreadRunning = false;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class PipelineUnittest;
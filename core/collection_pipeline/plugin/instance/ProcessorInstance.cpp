@@ -39,6 +39,7 @@ bool ProcessorInstance::Init(const Json::Value& config, CollectionPipelineContex
     mInSizeBytes = mPlugin->GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_IN_SIZE_BYTES);
     mOutSizeBytes = mPlugin->GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_OUT_SIZE_BYTES);
     mTotalProcessTimeMs = mPlugin->GetMetricsRecordRef().CreateTimeCounter(METRIC_PLUGIN_TOTAL_PROCESS_TIME_MS);
+    mProcessLatencyMs = mPlugin->GetMetricsRecordRef().CreateHistogram(METRIC_PLUGIN_PROCESS_LATENCY_MS);
 
     return true;
 }
@@ -54,7 +55,9 @@ void ProcessorInstance::Process(vector<PipelineEventGroup>& eventGroupList) {
 
     auto before = chrono::system_clock::now();
     mPlugin->Process(eventGroupList);
-    mTotalProcessTimeMs->Add(chrono::system_clock::now() - before);
+    auto cost = chrono::system_clock::now() - before;
+    mTotalProcessTimeMs->Add(cost);
+    mProcessLatencyMs->Record(cost);
 
     for (const auto& eventGroup : eventGroupList) {
         mOutEventsTotal->Add(eventGroup.GetEvents().size());
@@ -45,6 +45,7 @@ private:
     CounterPtr mInSizeBytes;
     CounterPtr mOutSizeBytes;
     TimeCounterPtr mTotalProcessTimeMs;
+    HistogramPtr mProcessLatencyMs;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class ProcessorInstanceUnittest;
@@ -16,6 +16,7 @@
 
 #include "collection_pipeline/queue/QueueKeyManager.h"
 #include "collection_pipeline/queue/SenderQueueManager.h"
+#include "runner/SerializerRunner.h"
 // TODO: temporarily used here
 #include "collection_pipeline/CollectionPipelineManager.h"
 
@@ -29,6 +30,8 @@ bool Flusher::Start() {
 }
 
 bool Flusher::Stop(bool isPipelineRemoving) {
+    // batches flushed before stop must reach the sender queue before it is deleted
+    SerializerRunner::GetInstance()->WaitForFlusher(this);
     // TODO: temporarily used here
     SetPipelineForItemsWhenStop();
     SenderQueueManager::GetInstance()->DeleteQueue(mQueueKey);
@@ -37,6 +37,9 @@ public:
     virtual bool Init(const Json::Value& config, Json::Value& optionalGoPipeline) = 0;
     virtual bool Start();
     virtual bool Stop(bool isPipelineRemoving);
+    // Send, Flush and FlushAll return false if data is discarded before reaching the sender queue. When serialization
+    // is handed over to SerializerRunner, true only means the data is submitted, and later failures are counted in the
+    // failed_items_total metric of the runner instead.
     virtual bool Send(PipelineEventGroup&& g) = 0;
     virtual bool Flush(size_t key) = 0;
     virtual bool FlushAll() = 0;
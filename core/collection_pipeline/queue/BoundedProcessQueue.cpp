@@ -65,7 +65,9 @@ bool BoundedProcessQueue::Pop(unique_ptr<ProcessQueueItem>& item) {
     }
 
     mOutItemsTotal->Add(1);
-    mTotalDelayMs->Add(chrono::system_clock::now() - item->mEnqueTime);
+    auto delay = chrono::system_clock::now() - item->mEnqueTime;
+    mTotalDelayMs->Add(delay);
+    mDelayLatencyMs->Record(delay);
     mQueueSizeTotal->Set(Size());
     mQueueDataSizeByte->Sub(item->mEventGroup.DataSize());
     mValidToPushFlag->Set(IsValidToPush());
@@ -73,7 +73,9 @@ bool CircularProcessQueue::Pop(unique_ptr<ProcessQueueItem>& item) {
     mEventCnt -= item->mEventGroup.GetEvents().size();
 
     mOutItemsTotal->Add(1);
-    mTotalDelayMs->Add(std::chrono::system_clock::now() - item->mEnqueTime);
+    auto delay = std::chrono::system_clock::now() - item->mEnqueTime;
+    mTotalDelayMs->Add(delay);
+    mDelayLatencyMs->Record(delay);
     mQueueSizeTotal->Set(Size());
     mQueueDataSizeByte->Sub(item->mEventGroup.DataSize());
     return true;
@@ -89,7 +89,9 @@ bool SenderQueue::Remove(SenderQueueItem* item) {
     --mSize;
 
     mOutItemsTotal->Add(1);
-    mTotalDelayMs->Add(chrono::system_clock::now() - enQueuTime);
+    auto delay = chrono::system_clock::now() - enQueuTime;
+    mTotalDelayMs->Add(delay);
+    mDelayLatencyMs->Record(delay);
     mQueueDataSizeByte->Sub(size);
 
     if (!mExtraBuffer.empty()) {
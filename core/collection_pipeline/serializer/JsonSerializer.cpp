@@ -14,6 +14,9 @@
 
 #include "collection_pipeline/serializer/JsonSerializer.h"
 
+#include <algorithm>
+
+#include "common/JsonWriter.h"
 #include "constants/SpanConstants.h"
 // TODO: the following dependencies should be removed
 #include "protobuf/sls/LogGroupSerializer.h"
@@ -37,66 +40,102 @@ bool JsonEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, str
         return false;
     }
 
-    Json::Value groupTags;
-    for (const auto& tag : group.mTags.mInner) {
-        groupTags[tag.first.to_string()] = tag.second.to_string();
-    }
+    // group tags are encoded only once, and those overwritten by reserved keys of the event type are dropped
+    JsonWriter tagWriter, writer;
+    // reuse the buffer of the caller
+    res.clear();
+    writer.GetResult().swap(res);
+    auto encodeTags = [&](const initializer_list<StringView>& reservedKeys) {
+        for (const auto& tag : group.mTags.mInner) {
+            if (find(reservedKeys.begin(), reservedKeys.end(), tag.first) == reservedKeys.end()) {
+                tagWriter.Key(tag.first);
+                tagWriter.String(tag.second);
+            }
+        }
+        writer.Reserve(group.mSizeBytes + group.mEvents.size() * (tagWriter.GetResult().size() + 32));
+    };
 
     // TODO: should support nano second
-    ostringstream oss;
     switch (eventType) {
         case PipelineEvent::Type::LOG:
+            encodeTags({JSON_KEY_TIME});
             for (const auto& item : group.mEvents) {
                 const auto& e = item.Cast<LogEvent>();
-                Json::Value eventJson;
-                // tags
-                eventJson.copy(groupTags);
+                writer.StartObject();
+                // tags, which are overwritten by contents with the same key
+                bool tagOverwritten = false;
+                for (const auto& tag : group.mTags.mInner) {
+                    if (e.HasContent(tag.first)) {
+                        tagOverwritten = true;
+                        break;
+                    }
+                }
+                if (!tagOverwritten) {
+                    writer.RawMembers(tagWriter.GetResult());
+                } else {
+                    for (const auto& tag : group.mTags.mInner) {
+                        if (tag.first != JSON_KEY_TIME && !e.HasContent(tag.first)) {
+                            writer.Key(tag.first);
+                            writer.String(tag.second);
+                        }
+                    }
+                }
                 // time
-                eventJson[JSON_KEY_TIME] = e.GetTimestamp();
+                if (!e.HasContent(JSON_KEY_TIME)) {
+                    writer.Key(JSON_KEY_TIME);
+                    writer.Int(e.GetTimestamp());
+                }
                 // contents
                 for (const auto& kv : e) {
-                    eventJson[kv.first.to_string()] = kv.second.to_string();
+                    writer.Key(kv.first);
+                    writer.String(kv.second);
                 }
-                Json::StreamWriterBuilder writer;
-                writer["indentation"] = "";
-                oss << Json::writeString(writer, eventJson) << endl;
+                writer.EndObject();
+                writer.NewLine();
             }
             break;
         case PipelineEvent::Type::METRIC:
+            encodeTags({JSON_KEY_TIME, METRIC_RESERVED_KEY_LABELS, METRIC_RESERVED_KEY_NAME, METRIC_RESERVED_KEY_VALUE});
             // TODO: key should support custom key
             for (const auto& item : group.mEvents) {
                 const auto& e = item.Cast<MetricEvent>();
                 if (e.Is<std::monostate>()) {
                     continue;
                 }
-                Json::Value eventJson;
+                writer.StartObject();
                 // tags
-                eventJson.copy(groupTags);
+                writer.RawMembers(tagWriter.GetResult());
                 // time
-                eventJson[JSON_KEY_TIME] = e.GetTimestamp();
+                writer.Key(JSON_KEY_TIME);
+                writer.Int(e.GetTimestamp());
                 // __labels__
-                eventJson[METRIC_RESERVED_KEY_LABELS] = Json::objectValue;
-                auto& labels = eventJson[METRIC_RESERVED_KEY_LABELS];
+                writer.Key(METRIC_RESERVED_KEY_LABELS);
+                writer.StartObject();
                 for (auto tag = e.TagsBegin(); tag != e.TagsEnd(); tag++) {
-                    labels[tag->first.to_string()] = tag->second.to_string();
+                    writer.Key(tag->first);
+                    writer.String(tag->second);
                 }
+                writer.EndObject();
                 // __name__
-                eventJson[METRIC_RESERVED_KEY_NAME] = e.GetName().to_string();
+                writer.Key(METRIC_RESERVED_KEY_NAME);
+                writer.String(e.GetName());
                 // __value__
                 if (e.Is<UntypedSingleValue>()) {
-                    eventJson[METRIC_RESERVED_KEY_VALUE] = e.GetValue<UntypedSingleValue>()->mValue;
+                    writer.Key(METRIC_RESERVED_KEY_VALUE);
+                    writer.Double(e.GetValue<UntypedSingleValue>()->mValue);
                 } else if (e.Is<UntypedMultiDoubleValues>()) {
-                    eventJson[METRIC_RESERVED_KEY_VALUE] = Json::objectValue;
-                    auto& values = eventJson[METRIC_RESERVED_KEY_VALUE];
+                    writer.Key(METRIC_RESERVED_KEY_VALUE);
+                    writer.StartObject();
                     for (auto value = e.GetValue<UntypedMultiDoubleValues>()->ValuesBegin();
                          value != e.GetValue<UntypedMultiDoubleValues>()->ValuesEnd();
                          value++) {
-                        values[value->first.to_string()] = value->second.Value;
+                        writer.Key(value->first);
+                        writer.Double(value->second.Value);
                     }
+                    writer.EndObject();
                 }
-                Json::StreamWriterBuilder writer;
-                writer["indentation"] = "";
-                oss << Json::writeString(writer, eventJson) << endl;
+                writer.EndObject();
+                writer.NewLine();
             }
             break;
         case PipelineEvent::Type::SPAN:
@@ -106,24 +145,26 @@ bool JsonEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, str
                 ("invalid event type", "span type is not supported")("config", mFlusher->GetContext().GetConfigName()));
             break;
         case PipelineEvent::Type::RAW:
+            encodeTags({JSON_KEY_TIME, DEFAULT_CONTENT_KEY});
             for (const auto& item : group.mEvents) {
                 const auto& e = item.Cast<RawEvent>();
-                Json::Value eventJson;
+                writer.StartObject();
                 // tags
-                eventJson.copy(groupTags);
+                writer.RawMembers(tagWriter.GetResult());
                 // time
-                eventJson[JSON_KEY_TIME] = e.GetTimestamp();
+                writer.Key(JSON_KEY_TIME);
+                writer.Int(e.GetTimestamp());
                 // content
-                eventJson[DEFAULT_CONTENT_KEY] = e.GetContent().to_string();
-                Json::StreamWriterBuilder writer;
-                writer["indentation"] = "";
-                oss << Json::writeString(writer, eventJson) << endl;
+                writer.Key(DEFAULT_CONTENT_KEY);
+                writer.String(e.GetContent());
+                writer.EndObject();
+                writer.NewLine();
             }
             break;
         default:
             break;
     }
-    res = oss.str();
+    res = std::move(writer.GetResult());
     return true;
 }
 
@@ -69,7 +69,9 @@ bool Serializer<vector<CompressedLogGroup>>::DoSerialize(vector<CompressedLogGro
 
     auto before = std::chrono::system_clock::now();
     auto res = Serialize(std::move(p), output, errorMsg);
-    mTotalProcessMs->Add(std::chrono::system_clock::now() - before);
+    auto cost = std::chrono::system_clock::now() - before;
+    mTotalProcessMs->Add(cost);
+    mProcessLatencyMs->Record(cost);
 
     if (res) {
         mOutItemsTotal->Add(1);
@@ -60,6 +60,7 @@ public:
         mOutItemsTotal = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_OUT_ITEMS_TOTAL);
         mOutItemSizeBytes = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_OUT_SIZE_BYTES);
         mTotalProcessMs = mMetricsRecordRef.CreateTimeCounter(METRIC_COMPONENT_TOTAL_PROCESS_TIME_MS);
+        mProcessLatencyMs = mMetricsRecordRef.CreateHistogram(METRIC_COMPONENT_PROCESS_LATENCY_MS);
         mDiscardedItemsTotal = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_DISCARDED_ITEMS_TOTAL);
         mDiscardedItemSizeBytes = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_DISCARDED_SIZE_BYTES);
     }
@@ -72,7 +73,9 @@ public:
 
         auto before = std::chrono::system_clock::now();
         auto res = Serialize(std::move(p), output, errorMsg);
-        mTotalProcessMs->Add(std::chrono::system_clock::now() - before);
+        auto cost = std::chrono::system_clock::now() - before;
+        mTotalProcessMs->Add(cost);
+        mProcessLatencyMs->Record(cost);
 
         if (res) {
             mOutItemsTotal->Add(1);
@@ -96,6 +99,7 @@ protected:
     CounterPtr mDiscardedItemsTotal;
     CounterPtr mDiscardedItemSizeBytes;
     TimeCounterPtr mTotalProcessMs;
+    HistogramPtr mProcessLatencyMs;
 
 private:
     virtual bool Serialize(T&& p, std::string& res, std::string& errorMsg) = 0;
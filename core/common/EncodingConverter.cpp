@@ -18,39 +18,136 @@
 #include "logger/Logger.h"
 #if defined(__linux__)
 #include <iconv.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 #elif defined(_MSC_VER)
 #include <Windows.h>
 #endif
 
+#include <cerrno>
+#include <cstring>
+
 namespace logtail {
 
 #if defined(__linux__)
-static iconv_t mGbk2Utf8Cd = (iconv_t)-1;
+// AsciiPrefixLength returns the length of the leading run of 7-bit bytes in @s.
+static size_t AsciiPrefixLength(const char* s, size_t len) {
+    size_t i = 0;
+#if defined(__SSE2__)
+    for (; i + 16 <= len; i += 16) {
+        int mask = _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i)));
+        if (mask != 0) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+#else
+    for (; i + 8 <= len; i += 8) {
+        uint64_t word;
+        memcpy(&word, s + i, sizeof(word));
+        if (word & 0x8080808080808080ULL) {
+            break;
+        }
+    }
+#endif
+    while (i < len && (static_cast<unsigned char>(s[i]) & 0x80) == 0) {
+        ++i;
+    }
+    return i;
+}
 #endif
 
 EncodingConverter::EncodingConverter() {
 #if defined(__linux__)
-    mGbk2Utf8Cd = iconv_open("UTF-8", "GBK");
-    if (mGbk2Utf8Cd == (iconv_t)(-1))
+    iconv_t cd = iconv_open("UTF-8", "GBK");
+    if (cd == (iconv_t)(-1)) {
         LOG_ERROR(sLogger, ("create Gbk2Utf8 iconv descriptor fail, errno", strerror(errno)));
-    else
-        iconv(mGbk2Utf8Cd, NULL, NULL, NULL, NULL);
+        return;
+    }
+    // The tables are built from iconv itself, so that the result is exactly the same as converting with iconv.
+    // @return errno of iconv, 0 if converted successfully.
+    auto probe = [cd](const char* in, size_t inLen, Utf8Char& res) {
+        char* inPtr = const_cast<char*>(in);
+        char* outPtr = res.mBytes;
+        size_t outLen = sizeof(res.mBytes);
+        res.mLen = 0;
+        if (iconv(cd, &inPtr, &inLen, &outPtr, &outLen) == (size_t)(-1)) {
+            int err = errno;
+            iconv(cd, NULL, NULL, NULL, NULL);
+            return err;
+        }
+        res.mLen = sizeof(res.mBytes) - outLen;
+        return 0;
+    };
+    for (int i = 0; i < 256; ++i) {
+        char c = static_cast<char>(i);
+        if (probe(&c, 1, mSingleByteTable[i]) == EINVAL && i >= 0x80) {
+            mLeadByte[i] = true;
+        }
+    }
+    mDoubleByteTable.resize(128 * 256);
+    for (int lead = 0x80; lead < 256; ++lead) {
+        if (!mLeadByte[lead]) {
+            continue;
+        }
+        for (int trail = 0; trail < 256; ++trail) {
+            char buf[2] = {static_cast<char>(lead), static_cast<char>(trail)};
+            probe(buf, 2, mDoubleByteTable[(lead - 0x80) * 256 + trail]);
+        }
+    }
+    iconv_close(cd);
+    mTableReady = true;
 #endif
 }
 
 EncodingConverter::~EncodingConverter() {
+}
+
 #if defined(__linux__)
-    if (mGbk2Utf8Cd != (iconv_t)(-1))
-        iconv_close(mGbk2Utf8Cd);
-#endif
+bool EncodingConverter::ConvertLine(
+    const char* src, size_t srcLength, char* des, size_t desLength, size_t& written) const {
+    size_t i = 0;
+    written = 0;
+    while (i < srcLength) {
+        size_t run = AsciiPrefixLength(src + i, srcLength - i);
+        if (run > 0) {
+            if (written + run > desLength) {
+                return false;
+            }
+            memcpy(des + written, src + i, run);
+            i += run;
+            written += run;
+            continue;
+        }
+        unsigned char c = static_cast<unsigned char>(src[i]);
+        const Utf8Char* ch = nullptr;
+        if (mLeadByte[c]) {
+            if (i + 1 == srcLength) {
+                return false;
+            }
+            ch = &mDoubleByteTable[(c - 0x80) * 256 + static_cast<unsigned char>(src[i + 1])];
+            i += 2;
+        } else {
+            ch = &mSingleByteTable[c];
+            i += 1;
+        }
+        if (ch->mLen == 0 || written + ch->mLen > desLength) {
+            return false;
+        }
+        for (uint8_t j = 0; j < ch->mLen; ++j) {
+            des[written++] = ch->mBytes[j];
+        }
+    }
+    return true;
 }
+#endif
 
 // TODO: Refactor it, do not use the output params to do calculations, set them before return.
 size_t EncodingConverter::ConvertGbk2Utf8(
     const char* src, size_t* srcLength, char* desOut, size_t desLength, const std::vector<long>& linePosVec) const {
 #if defined(__linux__)
-    if (src == NULL || *srcLength == 0 || mGbk2Utf8Cd == (iconv_t)(-1)) {
-        LOG_ERROR(sLogger, ("invalid iconv descriptor fail or invalid buffer pointer, cd", mGbk2Utf8Cd));
+    if (src == NULL || *srcLength == 0 || !mTableReady) {
+        LOG_ERROR(sLogger, ("invalid conversion table or invalid buffer pointer, table ready", mTableReady));
         return 0;
     }
     size_t maxRequire = *srcLength * 2;
@@ -60,31 +157,25 @@ size_t EncodingConverter::ConvertGbk2Utf8(
     if (desLength < maxRequire + 1) {
         return 0;
     }
-    char* des = desOut;
-    des[*srcLength * 2] = '\0';
-    const char* originSrc = src;
-    char* originDes = des;
+    desOut[*srcLength * 2] = '\0';
     size_t beginIndex = 0;
     size_t endIndex = *srcLength;
     size_t destIndex = 0;
-    size_t maxDestSize = desLength;
     for (size_t i = 0; i < linePosVec.size(); ++i) {
         endIndex = linePosVec[i];
-        src = originSrc + beginIndex;
-        des = originDes + destIndex;
         // include '\n'
-        *srcLength = endIndex - beginIndex + 1;
-        desLength = maxDestSize - destIndex;
-        size_t ret = iconv(mGbk2Utf8Cd, const_cast<char**>(&src), srcLength, &des, &desLength);
-        if (ret == (size_t)(-1)) {
-            LOG_ERROR(sLogger, ("convert GBK to UTF8 fail, errno", strerror(errno)));
-            iconv(mGbk2Utf8Cd, NULL, NULL, NULL, NULL); // Clear status.
+        size_t lineLength = endIndex - beginIndex + 1;
+        size_t written = 0;
+        if (ConvertLine(src + beginIndex, lineLength, desOut + destIndex, desLength - destIndex, written)) {
+            destIndex += written;
+            *srcLength = 0;
+        } else {
+            LOG_ERROR(sLogger, ("convert GBK to UTF8 fail, line length", lineLength));
             AlarmManager::GetInstance()->SendAlarm(ENCODING_CONVERT_ALARM, "convert GBK to UTF8 fail");
             // use memcpy
-            memcpy(originDes + destIndex, originSrc + beginIndex, endIndex - beginIndex + 1);
-            destIndex += endIndex - beginIndex + 1;
-        } else {
-            destIndex = des - originDes;
+            memcpy(desOut + destIndex, src + beginIndex, lineLength);
+            destIndex += lineLength;
+            *srcLength = lineLength;
         }
         beginIndex = endIndex + 1;
     }
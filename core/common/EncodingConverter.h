@@ -18,6 +18,7 @@
 #define __SLS_ILOGTAIL_ENCODING_CONVERTER_H__
 
 #include <cstddef>
+#include <cstdint>
 
 #include <string>
 #include <vector>
@@ -33,7 +34,6 @@ private:
     ~EncodingConverter();
 
 public:
-    // notice: this is not thread-safe !
     static EncodingConverter* GetInstance() {
         static EncodingConverter* ptr = new EncodingConverter();
         return ptr;
@@ -50,7 +50,8 @@ public:
     // Different platforms have different implementations:
     // - For Linux, ConvertGbk2Utf8 converts line by line according to @linePosVec.
     //   If there is error happened during converting, corresponding line will be copied
-    //   to @des without converting.
+    //   to @des without converting. The conversion is table driven and reentrant, so it can be called
+    //   concurrently.
     // - For Windows, ConvertGbk2Utf8 converts whole @src, if any errors happened,
     //   0 will be returned (ignore @linePosVec).
     size_t ConvertGbk2Utf8(
@@ -64,6 +65,27 @@ public:
     // FromACPToUTF8 converts @s encoded in ACP (locale) to UTF8.
     std::string FromACPToUTF8(const std::string& s) const;
 #endif
+
+private:
+#if defined(__linux__)
+    // UTF-8 bytes of a GBK character, mLen is 0 if the GBK sequence is invalid.
+    struct Utf8Char {
+        char mBytes[3];
+        uint8_t mLen = 0;
+    };
+
+    // ConvertLine converts the whole @src to @des.
+    // @return false if @src contains invalid or incomplete sequence, or @desLength is not enough.
+    bool ConvertLine(const char* src, size_t srcLength, char* des, size_t desLength, size_t& written) const;
+
+    bool mTableReady = false;
+    // indexed by single byte
+    Utf8Char mSingleByteTable[256];
+    // whether the byte starts a double byte character
+    bool mLeadByte[256] = {};
+    // indexed by (lead byte - 0x80) * 256 + trail byte
+    std::vector<Utf8Char> mDoubleByteTable;
+#endif
 };
 
 } // namespace logtail
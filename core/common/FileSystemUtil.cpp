@@ -529,6 +529,16 @@ void Dir::Close() {
 #endif
 }
 
+bool Dir::Stat(const std::string& name, PathStat& ps) const {
+#if defined(__linux__)
+    if (IsOpened()) {
+        ps.mPath = PathJoin(mDirPath, name);
+        return (0 == ::fstatat(dirfd(mDir), name.c_str(), &(ps.mRawStat), 0));
+    }
+#endif
+    return PathStat::stat(PathJoin(mDirPath, name), ps);
+}
+
 PathStat::PathStat() {
 }
 
@@ -121,6 +121,8 @@ void Chmod(const char* filePath, mode_t mode);
 
 namespace fsutil {
 
+class PathStat;
+
 class Entry {
 public:
     enum class Type { UNKNOWN, DIR, REG_FILE };
@@ -186,6 +188,11 @@ public:
     //   this and let caller to call something else to deal it.
     Entry ReadNext(bool resolveWithStat = true);
 
+    // Stat wrappers ::fstatat relative to the opened directory (Linux), which saves
+    // the path lookup of each entry compared with PathStat::stat. Symbolic links
+    // are followed as PathStat::stat does.
+    bool Stat(const std::string& name, PathStat& ps) const;
+
     void Close();
 
 private:
@@ -210,6 +217,8 @@ class PathStat {
     std::string mPath;
     RawStatType mRawStat;
 
+    friend class Dir;
+
 public:
     PathStat();
     ~PathStat();
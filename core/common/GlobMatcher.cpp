@@ -0,0 +1,93 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/GlobMatcher.h"
+
+#if defined(__linux__)
+#include <fnmatch.h>
+#endif
+
+#include "common/StringTools.h"
+
+using namespace std;
+
+namespace logtail {
+
+GlobMatcher::GlobMatcher(const string& pattern) : mPattern(pattern) {
+#if defined(_MSC_VER)
+    // PathMatchSpec is case insensitive
+    mKind = Kind::FNMATCH;
+    return;
+#endif
+    if (pattern.find_first_of("?[\\") != string::npos) {
+        mKind = Kind::FNMATCH;
+        return;
+    }
+    size_t first = pattern.find('*');
+    if (first == string::npos) {
+        mKind = Kind::EXACT;
+        return;
+    }
+    size_t last = pattern.rfind('*');
+    // consecutive stars are the same as a single one
+    size_t middleFirst = pattern.find_first_not_of('*', first);
+    if (middleFirst != string::npos && middleFirst < last) {
+        // stars separated by literals, only *literal* is handled here
+        if (first != 0 || last != pattern.size() - 1 || pattern.find('*', middleFirst) != last
+            || pattern.find_first_not_of('*', last) != string::npos) {
+            mKind = Kind::FNMATCH;
+            return;
+        }
+        size_t middleLast = pattern.find_last_not_of('*', last);
+        mKind = Kind::CONTAINS;
+        mPrefix = pattern.substr(middleFirst, middleLast - middleFirst + 1);
+        return;
+    }
+    mPrefix = pattern.substr(0, first);
+    mSuffix = pattern.substr(last + 1);
+    if (mPrefix.empty() && mSuffix.empty()) {
+        mKind = Kind::ALL;
+    } else if (mSuffix.empty()) {
+        mKind = Kind::PREFIX;
+    } else if (mPrefix.empty()) {
+        mKind = Kind::SUFFIX;
+    } else {
+        mKind = Kind::PREFIX_SUFFIX;
+    }
+}
+
+bool GlobMatcher::Match(const string& str) const {
+    switch (mKind) {
+        case Kind::ALL:
+            return true;
+        case Kind::EXACT:
+            return str == mPattern;
+        case Kind::PREFIX:
+            return str.compare(0, mPrefix.size(), mPrefix) == 0;
+        case Kind::SUFFIX:
+            return str.size() >= mSuffix.size()
+                && str.compare(str.size() - mSuffix.size(), mSuffix.size(), mSuffix) == 0;
+        case Kind::PREFIX_SUFFIX:
+            return str.size() >= mPrefix.size() + mSuffix.size() && str.compare(0, mPrefix.size(), mPrefix) == 0
+                && str.compare(str.size() - mSuffix.size(), mSuffix.size(), mSuffix) == 0;
+        case Kind::CONTAINS:
+            return str.find(mPrefix) != string::npos;
+        default:
+            return fnmatch(mPattern.c_str(), str.c_str(), 0) == 0;
+    }
+}
+
+} // namespace logtail
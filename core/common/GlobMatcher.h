@@ -0,0 +1,48 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <string>
+
+namespace logtail {
+
+// Glob pattern compiled once and matched many times, with the same result as fnmatch(pattern, str, 0).
+//
+// Common file name patterns, such as *, *.log, access.log* and app*log, are matched by plain string comparison.
+// Other patterns, and all patterns on Windows, fall back to fnmatch.
+class GlobMatcher {
+public:
+    GlobMatcher() = default;
+    explicit GlobMatcher(const std::string& pattern);
+
+    bool Match(const std::string& str) const;
+    const std::string& GetPattern() const { return mPattern; }
+
+private:
+    enum class Kind { ALL, EXACT, PREFIX, SUFFIX, PREFIX_SUFFIX, CONTAINS, FNMATCH };
+
+    std::string mPattern;
+    Kind mKind = Kind::EXACT;
+    std::string mPrefix;
+    std::string mSuffix;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class GlobMatcherUnittest;
+#endif
+};
+
+} // namespace logtail
@@ -0,0 +1,200 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/JsonWriter.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+
+using namespace std;
+
+namespace logtail {
+
+static const char HEX_DIGITS[] = "0123456789abcdef";
+
+static void AppendUnicodeEscape(string& res, unsigned int codepoint) {
+    char buf[6] = {'\\',
+                   'u',
+                   HEX_DIGITS[(codepoint >> 12) & 0xf],
+                   HEX_DIGITS[(codepoint >> 8) & 0xf],
+                   HEX_DIGITS[(codepoint >> 4) & 0xf],
+                   HEX_DIGITS[codepoint & 0xf]};
+    res.append(buf, sizeof(buf));
+}
+
+// Utf8ToCodepoint decodes the character starting at @s and moves @s to its last byte. Invalid sequence is decoded as
+// U+FFFD, the same as jsoncpp.
+static unsigned int Utf8ToCodepoint(const char*& s, const char* e) {
+    const unsigned int replacement = 0xFFFD;
+    unsigned int first = static_cast<unsigned char>(*s);
+    if (first < 0x80) {
+        return first;
+    }
+    if (first < 0xE0) {
+        if (e - s < 2) {
+            return replacement;
+        }
+        unsigned int res = ((first & 0x1F) << 6) | (static_cast<unsigned char>(s[1]) & 0x3F);
+        s += 1;
+        return res < 0x80 ? replacement : res;
+    }
+    if (first < 0xF0) {
+        if (e - s < 3) {
+            return replacement;
+        }
+        unsigned int res = ((first & 0x0F) << 12) | ((static_cast<unsigned char>(s[1]) & 0x3F) << 6)
+            | (static_cast<unsigned char>(s[2]) & 0x3F);
+        s += 2;
+        if (res >= 0xD800 && res <= 0xDFFF) {
+            return replacement;
+        }
+        return res < 0x800 ? replacement : res;
+    }
+    if (first < 0xF8) {
+        if (e - s < 4) {
+            return replacement;
+        }
+        unsigned int res = ((first & 0x07) << 18) | ((static_cast<unsigned char>(s[1]) & 0x3F) << 12)
+            | ((static_cast<unsigned char>(s[2]) & 0x3F) << 6) | (static_cast<unsigned char>(s[3]) & 0x3F);
+        s += 3;
+        return res < 0x10000 ? replacement : res;
+    }
+    return replacement;
+}
+
+static inline bool NeedEscape(char c) {
+    unsigned char u = static_cast<unsigned char>(c);
+    return u < 0x20 || u >= 0x80 || c == '"' || c == '\\';
+}
+
+void JsonWriter::Clear() {
+    mRes.clear();
+    mNeedComma = false;
+}
+
+void JsonWriter::StartObject() {
+    mRes.push_back('{');
+    mNeedComma = false;
+}
+
+void JsonWriter::EndObject() {
+    mRes.push_back('}');
+    mNeedComma = true;
+}
+
+void JsonWriter::Key(StringView key) {
+    if (mNeedComma) {
+        mRes.push_back(',');
+    }
+    String(key);
+    mRes.push_back(':');
+    mNeedComma = false;
+}
+
+void JsonWriter::String(StringView value) {
+    mRes.push_back('"');
+    const char* cur = value.data();
+    const char* end = cur + value.size();
+    while (cur != end) {
+        const char* begin = cur;
+        while (cur != end && !NeedEscape(*cur)) {
+            ++cur;
+        }
+        mRes.append(begin, cur - begin);
+        if (cur == end) {
+            break;
+        }
+        switch (*cur) {
+            case '"':
+                mRes.append("\\\"");
+                break;
+            case '\\':
+                mRes.append("\\\\");
+                break;
+            case '\b':
+                mRes.append("\\b");
+                break;
+            case '\f':
+                mRes.append("\\f");
+                break;
+            case '\n':
+                mRes.append("\\n");
+                break;
+            case '\r':
+                mRes.append("\\r");
+                break;
+            case '\t':
+                mRes.append("\\t");
+                break;
+            default: {
+                unsigned int codepoint = Utf8ToCodepoint(cur, end);
+                if (codepoint < 0x10000) {
+                    AppendUnicodeEscape(mRes, codepoint);
+                } else {
+                    // surrogate pair
+                    codepoint -= 0x10000;
+                    AppendUnicodeEscape(mRes, 0xD800 + ((codepoint >> 10) & 0x3FF));
+                    AppendUnicodeEscape(mRes, 0xDC00 + (codepoint & 0x3FF));
+                }
+                break;
+            }
+        }
+        ++cur;
+    }
+    mRes.push_back('"');
+    mNeedComma = true;
+}
+
+void JsonWriter::Int(int64_t value) {
+    char buf[24];
+    auto res = to_chars(buf, buf + sizeof(buf), value);
+    mRes.append(buf, res.ptr - buf);
+    mNeedComma = true;
+}
+
+void JsonWriter::Double(double value) {
+    mNeedComma = true;
+    if (!isfinite(value)) {
+        mRes.append(isnan(value) ? "null" : (value < 0 ? "-1e+9999" : "1e+9999"));
+        return;
+    }
+    char buf[32];
+#if defined(__cpp_lib_to_chars)
+    size_t len = to_chars(buf, buf + sizeof(buf), value, chars_format::general, 17).ptr - buf;
+#else
+    size_t len = snprintf(buf, sizeof(buf), "%.17g", value);
+    // decimal point of some locales is ','
+    replace(buf, buf + len, ',', '.');
+#endif
+    mRes.append(buf, len);
+    // keep the value a double when parsed back
+    if (find_if(buf, buf + len, [](char c) { return c == '.' || c == 'e'; }) == buf + len) {
+        mRes.append(".0");
+    }
+}
+
+void JsonWriter::RawMembers(StringView members) {
+    if (members.empty()) {
+        return;
+    }
+    if (mNeedComma) {
+        mRes.push_back(',');
+    }
+    mRes.append(members.data(), members.size());
+    mNeedComma = true;
+}
+
+} // namespace logtail
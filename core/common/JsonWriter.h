@@ -0,0 +1,53 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <string>
+
+#include "models/StringView.h"
+
+namespace logtail {
+
+// JsonWriter writes compact JSON into one buffer without building Json::Value. Strings are escaped and numbers are
+// formatted the same way as Json::StreamWriterBuilder with empty indentation, so the output can be parsed back into
+// the same values.
+class JsonWriter {
+public:
+    void Reserve(size_t size) { mRes.reserve(size); }
+    void Clear();
+
+    void StartObject();
+    void EndObject();
+    void Key(StringView key);
+    void String(StringView value);
+    void Int(int64_t value);
+    void Double(double value);
+    // RawMembers appends members already encoded by another JsonWriter, e.g. "k1":"v1","k2":"v2".
+    void RawMembers(StringView members);
+    // NewLine separates top level values, as in JSON Lines.
+    void NewLine() { mRes.push_back('\n'); }
+
+    std::string& GetResult() { return mRes; }
+
+private:
+    std::string mRes;
+    bool mNeedComma = false;
+};
+
+} // namespace logtail
@@ -109,6 +109,16 @@ int LogFileOperator::Pread(void* ptr, size_t size, size_t count, int64_t offset)
 #endif
 }
 
+void LogFileOperator::AdviseSequentialRead(int64_t offset, int64_t len) {
+    if (!IsOpen() || len <= 0) {
+        return;
+    }
+#if defined(__linux__)
+    posix_fadvise(mFd, offset, 0, POSIX_FADV_SEQUENTIAL);
+    posix_fadvise(mFd, offset, len, POSIX_FADV_WILLNEED);
+#endif
+}
+
 int64_t LogFileOperator::GetFileSize() const {
     if (!IsOpen()) {
         return -1;
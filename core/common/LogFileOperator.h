@@ -49,6 +49,10 @@ public:
 
     int Pread(void* ptr, size_t size, size_t count, int64_t offset);
 
+    // Hint the kernel that the file is read sequentially from offset and that the following len bytes will be read
+    // soon. It is a no-op on platforms without posix_fadvise.
+    void AdviseSequentialRead(int64_t offset, int64_t len);
+
     // GetFileSize gets the size of current file.
     int64_t GetFileSize() const;
 
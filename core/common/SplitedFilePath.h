@@ -51,6 +51,13 @@ struct SplitedFilePath {
     }
 };
 
+struct SplitedFilePathHash {
+    size_t operator()(const SplitedFilePath& key) const {
+        size_t seed = std::hash<std::string>()(key.mFileDir);
+        return seed ^ (std::hash<std::string>()(key.mFileName) + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+    }
+};
+
 } // namespace logtail
 
 #endif //_LOG_SPLITED_FILE_PATH_H__
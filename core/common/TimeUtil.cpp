@@ -66,6 +66,18 @@ uint64_t GetCurrentTimeInMilliSeconds() {
         .count();
 }
 
+uint64_t GetCoarseSteadyTimeInMilliSeconds() {
+#if defined(__linux__)
+    // read from vdso without syscall
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000 + ts.tv_nsec / 1000000;
+#else
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+#endif
+}
+
 int GetLocalTimeZoneOffsetSecond() {
     time_t nowTime = time(NULL);
     tm timeInfo;
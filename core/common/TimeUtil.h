@@ -48,6 +48,10 @@ uint64_t GetCurrentTimeInMicroSeconds();
 uint64_t GetCurrentTimeInMilliSeconds();
 uint64_t GetCurrentTimeInNanoSeconds();
 
+// Get monotonic time in ms with a resolution of a few ms, cheap enough to be called for each event.
+// It has nothing to do with wall time, so it can only be used to measure elapsed time.
+uint64_t GetCoarseSteadyTimeInMilliSeconds();
+
 // Get offset between current time zone and UTC in seconds.
 // For example, for UTC+8, returns 8*60*60.
 int GetLocalTimeZoneOffsetSecond();
@@ -22,6 +22,7 @@
 #include "app_config/AppConfig.h"
 #include "common/DNSCache.h"
 #include "common/StringTools.h"
+#include "common/http/CurlHandlerPool.h"
 #include "common/http/HttpResponse.h"
 #include "logger/Logger.h"
 
@@ -116,7 +117,7 @@ CURL* CreateCurlHandler(const string& method,
                         optional<CurlTLS> tls) {
     static DnsCache* dnsCache = DnsCache::GetInstance();
 
-    CURL* curl = curl_easy_init();
+    CURL* curl = CurlHandlerPool::GetInstance()->Acquire(httpsFlag, host, port);
     if (curl == nullptr) {
         return nullptr;
     }
@@ -242,7 +243,7 @@ bool SendHttpRequest(unique_ptr<HttpRequest>&& request, HttpResponse& response)
     if (headers != NULL) {
         curl_slist_free_all(headers);
     }
-    curl_easy_cleanup(curl);
+    CurlHandlerPool::GetInstance()->Release(curl);
     return success;
 }
 
@@ -281,7 +282,7 @@ bool AddRequestToMultiCurlHandler(CURLM* multiCurl, unique_ptr<AsynHttpRequest>&
                   ("failed to send request", "failed to add the easy curl handle to multi_handle")(
                       "errMsg", curl_multi_strerror(res))("request address", request.get()));
         request->OnSendDone(request->mResponse);
-        curl_easy_cleanup(curl);
+        CurlHandlerPool::GetInstance()->Release(curl);
         return false;
     }
     // let callback destruct the request
@@ -344,7 +345,7 @@ void HandleCompletedAsynRequests(CURLM* multiCurl, int& runningHandlers) {
             }
 
             curl_multi_remove_handle(multiCurl, handler);
-            curl_easy_cleanup(handler);
+            CurlHandlerPool::GetInstance()->Release(handler);
             if (!requestReused) {
                 if (request->mPrivateData) {
                     curl_slist_free_all((curl_slist*)request->mPrivateData);
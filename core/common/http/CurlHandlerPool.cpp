@@ -0,0 +1,166 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/http/CurlHandlerPool.h"
+
+#include "common/Flags.h"
+#include "logger/Logger.h"
+
+DEFINE_FLAG_INT32(curl_handler_pool_max_idle_per_host, "max idle curl handlers kept for each host", 8);
+DEFINE_FLAG_INT32(curl_handler_pool_max_idle_total, "max idle curl handlers kept for all hosts", 128);
+DEFINE_FLAG_INT32(curl_handler_pool_idle_timeout_sec,
+                  "idle curl handlers, together with their connections, are cleaned up after the timeout",
+                  60);
+
+using namespace std;
+
+namespace logtail {
+
+CurlHandlerPool::CurlHandlerPool() {
+    mShare = curl_share_init();
+    if (mShare == nullptr) {
+        LOG_WARNING(sLogger, ("failed to init curl share handler", "dns cache and tls sessions will not be shared"));
+        return;
+    }
+    curl_share_setopt(mShare, CURLSHOPT_LOCKFUNC, LockShare);
+    curl_share_setopt(mShare, CURLSHOPT_UNLOCKFUNC, UnlockShare);
+    curl_share_setopt(mShare, CURLSHOPT_USERDATA, this);
+    curl_share_setopt(mShare, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    curl_share_setopt(mShare, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+}
+
+void CurlHandlerPool::LockShare(CURL* handle, curl_lock_data data, curl_lock_access access, void* userptr) {
+    static_cast<CurlHandlerPool*>(userptr)->mShareMuxes[data].lock();
+}
+
+void CurlHandlerPool::UnlockShare(CURL* handle, curl_lock_data data, void* userptr) {
+    static_cast<CurlHandlerPool*>(userptr)->mShareMuxes[data].unlock();
+}
+
+CURL* CurlHandlerPool::Acquire(bool httpsFlag, const string& host, int32_t port) {
+    string key = (httpsFlag ? "https://" : "http://") + host + ":" + to_string(port);
+    CURL* curl = nullptr;
+    vector<CURL*> expired;
+    {
+        lock_guard<mutex> lock(mMux);
+        TakeExpiredHandlers(chrono::steady_clock::now(), expired);
+        auto it = mIdleHandlers.find(key);
+        if (it != mIdleHandlers.end()) {
+            // the most recently released handler is the most likely to have a live connection
+            curl = it->second.back().mCurl;
+            it->second.pop_back();
+            if (it->second.empty()) {
+                mIdleHandlers.erase(it);
+            }
+            --mIdleCnt;
+        }
+    }
+    for (auto handler : expired) {
+        curl_easy_cleanup(handler);
+    }
+
+    if (curl != nullptr) {
+        // live connections, dns cache and tls sessions are kept on reset
+        curl_easy_reset(curl);
+    } else {
+        curl = curl_easy_init();
+        if (curl == nullptr) {
+            return nullptr;
+        }
+    }
+    if (mShare != nullptr) {
+        curl_easy_setopt(curl, CURLOPT_SHARE, mShare);
+    }
+
+    lock_guard<mutex> lock(mMux);
+    mBusyHandlers[curl] = std::move(key);
+    return curl;
+}
+
+void CurlHandlerPool::Release(CURL* curl) {
+    if (curl == nullptr) {
+        return;
+    }
+    bool pooled = false;
+    vector<CURL*> expired;
+    {
+        lock_guard<mutex> lock(mMux);
+        auto now = chrono::steady_clock::now();
+        TakeExpiredHandlers(now, expired);
+        auto it = mBusyHandlers.find(curl);
+        if (it != mBusyHandlers.end()) {
+            if (mIdleCnt < static_cast<size_t>(INT32_FLAG(curl_handler_pool_max_idle_total))) {
+                auto& handlers = mIdleHandlers[it->second];
+                if (handlers.size() < static_cast<size_t>(INT32_FLAG(curl_handler_pool_max_idle_per_host))) {
+                    handlers.push_back({curl, now});
+                    ++mIdleCnt;
+                    pooled = true;
+                }
+            }
+            mBusyHandlers.erase(it);
+        }
+    }
+    for (auto handler : expired) {
+        curl_easy_cleanup(handler);
+    }
+    if (!pooled) {
+        curl_easy_cleanup(curl);
+    }
+}
+
+size_t CurlHandlerPool::IdleSize() const {
+    lock_guard<mutex> lock(mMux);
+    return mIdleCnt;
+}
+
+void CurlHandlerPool::Clear() {
+    vector<CURL*> handlers;
+    {
+        lock_guard<mutex> lock(mMux);
+        for (auto& item : mIdleHandlers) {
+            for (auto& handler : item.second) {
+                handlers.push_back(handler.mCurl);
+            }
+        }
+        mIdleHandlers.clear();
+        mIdleCnt = 0;
+    }
+    for (auto handler : handlers) {
+        curl_easy_cleanup(handler);
+    }
+}
+
+void CurlHandlerPool::TakeExpiredHandlers(chrono::steady_clock::time_point now, vector<CURL*>& expired) {
+    if (now - mLastEvictTime < chrono::seconds(1)) {
+        return;
+    }
+    mLastEvictTime = now;
+    auto deadline = now - chrono::seconds(INT32_FLAG(curl_handler_pool_idle_timeout_sec));
+    for (auto it = mIdleHandlers.begin(); it != mIdleHandlers.end();) {
+        // handlers are released in time order, so the expired ones are at the front
+        auto& handlers = it->second;
+        while (!handlers.empty() && handlers.front().mReleaseTime <= deadline) {
+            expired.push_back(handlers.front().mCurl);
+            handlers.pop_front();
+            --mIdleCnt;
+        }
+        if (handlers.empty()) {
+            it = mIdleHandlers.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+} // namespace logtail
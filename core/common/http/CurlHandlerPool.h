@@ -0,0 +1,86 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <array>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "curl/curl.h"
+
+namespace logtail {
+
+// Pool of curl easy handlers keyed by scheme, host and port.
+//
+// An easy handler keeps its connections alive after a transfer, so a synchronous request sent with a handler reused
+// from the pool skips the TCP and TLS handshakes with the same host. All handlers are attached to a share object, so
+// DNS results and TLS sessions are also shared among hosts and with handlers driven by multi handles, whose connections
+// are cached by the multi handle itself. Connections are not put into the share object, since libcurl does not support
+// sharing them among concurrent threads.
+class CurlHandlerPool {
+public:
+    CurlHandlerPool(const CurlHandlerPool&) = delete;
+    CurlHandlerPool& operator=(const CurlHandlerPool&) = delete;
+
+    static CurlHandlerPool* GetInstance() {
+        static CurlHandlerPool instance;
+        return &instance;
+    }
+
+    // the returned handler is in the default state, and must be given back by Release
+    CURL* Acquire(bool httpsFlag, const std::string& host, int32_t port);
+    // the handler is cleaned up instead if it has not been acquired from the pool, or the pool is full
+    void Release(CURL* curl);
+    size_t IdleSize() const;
+    void Clear();
+
+private:
+    struct IdleHandler {
+        CURL* mCurl = nullptr;
+        std::chrono::steady_clock::time_point mReleaseTime;
+    };
+
+    CurlHandlerPool();
+    ~CurlHandlerPool() = default;
+
+    static void LockShare(CURL* handle, curl_lock_data data, curl_lock_access access, void* userptr);
+    static void UnlockShare(CURL* handle, curl_lock_data data, void* userptr);
+
+    // must be called with mMux held, the expired handlers are returned to be cleaned up outside the lock
+    void TakeExpiredHandlers(std::chrono::steady_clock::time_point now, std::vector<CURL*>& expired);
+
+    CURLSH* mShare = nullptr;
+    std::array<std::mutex, CURL_LOCK_DATA_LAST> mShareMuxes;
+
+    mutable std::mutex mMux;
+    std::unordered_map<std::string, std::deque<IdleHandler>> mIdleHandlers;
+    std::unordered_map<CURL*, std::string> mBusyHandlers;
+    size_t mIdleCnt = 0;
+    std::chrono::steady_clock::time_point mLastEvictTime;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class CurlUnittest;
+#endif
+};
+
+} // namespace logtail
@@ -20,6 +20,7 @@
 #include <cstdint>
 
 #include <map>
+#include <optional>
 #include <string>
 #include <utility>
 
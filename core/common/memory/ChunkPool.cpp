@@ -0,0 +1,169 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/memory/ChunkPool.h"
+
+#include <algorithm>
+
+#include "common/Flags.h"
+
+DEFINE_FLAG_BOOL(enable_chunk_pool, "whether to recycle the memory chunks of source buffers", true);
+DEFINE_FLAG_INT32(chunk_pool_max_cached_size_mb, "max size of chunks kept in the shared chunk pool, in MB", 64);
+DEFINE_FLAG_INT32(chunk_pool_thread_cached_size_kb, "max size of chunks kept by each thread, in KB", 2048);
+
+using namespace std;
+
+namespace logtail {
+
+ChunkPool::ThreadCache::~ThreadCache() {
+    auto pool = ChunkPool::GetInstance();
+    for (size_t idx = 0; idx < kSizeClassCnt; ++idx) {
+        if (!mChunks[idx].empty()) {
+            pool->ReturnToSharedCache(idx, *this, mChunks[idx].size());
+        }
+    }
+}
+
+uint8_t* ChunkPool::Acquire(size_t& size) {
+    mAcquireCnt.fetch_add(1, memory_order_relaxed);
+    if (!BOOL_FLAG(enable_chunk_pool) || size > kMaxChunkSize) {
+        mAcquireMissCnt.fetch_add(1, memory_order_relaxed);
+        mInUseSize.fetch_add(size, memory_order_relaxed);
+        return new uint8_t[size];
+    }
+
+    size_t idx = GetSizeClass(size);
+    size = GetSizeClassCapacity(idx);
+    mInUseSize.fetch_add(size, memory_order_relaxed);
+
+    auto& cache = GetThreadCache();
+    auto& chunks = cache.mChunks[idx];
+    if (chunks.empty() && !FetchFromSharedCache(idx, cache)) {
+        mAcquireMissCnt.fetch_add(1, memory_order_relaxed);
+        return new uint8_t[size];
+    }
+    uint8_t* chunk = chunks.back();
+    chunks.pop_back();
+    cache.mCachedSize -= size;
+    mCachedSize.fetch_sub(size, memory_order_relaxed);
+    return chunk;
+}
+
+void ChunkPool::Release(uint8_t* chunk, size_t size) {
+    mInUseSize.fetch_sub(size, memory_order_relaxed);
+    if (!BOOL_FLAG(enable_chunk_pool) || size > kMaxChunkSize) {
+        delete[] chunk;
+        return;
+    }
+    size_t idx = GetSizeClass(size);
+    if (GetSizeClassCapacity(idx) != size) {
+        // not acquired from the pool
+        delete[] chunk;
+        return;
+    }
+
+    auto& cache = GetThreadCache();
+    auto& chunks = cache.mChunks[idx];
+    chunks.push_back(chunk);
+    cache.mCachedSize += size;
+    mCachedSize.fetch_add(size, memory_order_relaxed);
+    if (cache.mCachedSize > static_cast<size_t>(INT32_FLAG(chunk_pool_thread_cached_size_kb)) * 1024) {
+        // hand over half of the chunks at once, so that the shared cache is not visited for every release
+        ReturnToSharedCache(idx, cache, (chunks.size() + 1) / 2);
+    }
+}
+
+void ChunkPool::Trim() {
+    for (size_t idx = 0; idx < kSizeClassCnt; ++idx) {
+        size_t cap = GetSizeClassCapacity(idx);
+        auto& shared = mSharedCaches[idx];
+        lock_guard<mutex> lock(shared.mMux);
+        for (auto chunk : shared.mChunks) {
+            delete[] chunk;
+        }
+        mSharedCachedSize.fetch_sub(cap * shared.mChunks.size(), memory_order_relaxed);
+        mCachedSize.fetch_sub(cap * shared.mChunks.size(), memory_order_relaxed);
+        shared.mChunks.clear();
+    }
+}
+
+size_t ChunkPool::GetSizeClass(size_t size) {
+    if (size <= kMaxSmallChunkSize) {
+        size_t idx = 0;
+        size_t cap = kMinChunkSize;
+        while (cap < size) {
+            cap <<= 1;
+            ++idx;
+        }
+        return idx;
+    }
+    return kSmallSizeClassCnt - 1 + (size - kMaxSmallChunkSize + kLargeChunkStep - 1) / kLargeChunkStep;
+}
+
+size_t ChunkPool::GetSizeClassCapacity(size_t idx) {
+    if (idx < kSmallSizeClassCnt) {
+        return kMinChunkSize << idx;
+    }
+    return kMaxSmallChunkSize + (idx - kSmallSizeClassCnt + 1) * kLargeChunkStep;
+}
+
+ChunkPool::ThreadCache& ChunkPool::GetThreadCache() {
+    static thread_local ThreadCache sCache;
+    return sCache;
+}
+
+bool ChunkPool::FetchFromSharedCache(size_t idx, ThreadCache& cache) {
+    size_t cap = GetSizeClassCapacity(idx);
+    // fetch up to half of the thread cache budget at once
+    size_t maxCnt = max<size_t>(1, static_cast<size_t>(INT32_FLAG(chunk_pool_thread_cached_size_kb)) * 1024 / cap / 2);
+
+    auto& shared = mSharedCaches[idx];
+    lock_guard<mutex> lock(shared.mMux);
+    if (shared.mChunks.empty()) {
+        return false;
+    }
+    size_t cnt = min(maxCnt, shared.mChunks.size());
+    auto& chunks = cache.mChunks[idx];
+    chunks.insert(chunks.end(), shared.mChunks.end() - cnt, shared.mChunks.end());
+    shared.mChunks.resize(shared.mChunks.size() - cnt);
+    cache.mCachedSize += cnt * cap;
+    mSharedCachedSize.fetch_sub(cnt * cap, memory_order_relaxed);
+    return true;
+}
+
+void ChunkPool::ReturnToSharedCache(size_t idx, ThreadCache& cache, size_t cnt) {
+    size_t cap = GetSizeClassCapacity(idx);
+    uint64_t maxSharedSize = static_cast<uint64_t>(INT32_FLAG(chunk_pool_max_cached_size_mb)) * 1024 * 1024;
+    auto& chunks = cache.mChunks[idx];
+    cnt = min(cnt, chunks.size());
+
+    auto& shared = mSharedCaches[idx];
+    lock_guard<mutex> lock(shared.mMux);
+    for (size_t i = 0; i < cnt; ++i) {
+        uint8_t* chunk = chunks.back();
+        chunks.pop_back();
+        if (mSharedCachedSize.load(memory_order_relaxed) + cap <= maxSharedSize) {
+            shared.mChunks.push_back(chunk);
+            mSharedCachedSize.fetch_add(cap, memory_order_relaxed);
+        } else {
+            delete[] chunk;
+            mCachedSize.fetch_sub(cap, memory_order_relaxed);
+        }
+    }
+    cache.mCachedSize -= cnt * cap;
+}
+
+} // namespace logtail
@@ -0,0 +1,103 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace logtail {
+
+// Process-wide cache of the memory chunks used by BufferAllocator.
+//
+// Chunks are grouped into size classes: powers of two from 4KB to 128KB (the normal growth path of
+// BufferAllocator), followed by 128KB steps up to 1MB (large blocks such as reader buffers). Larger requests bypass
+// the pool. Each thread keeps a small cache of its own and exchanges chunks with the shared cache in batches, since
+// groups are usually created on one thread and destroyed on another. The total size of the shared cache is bounded.
+class ChunkPool {
+public:
+    static constexpr size_t kMinChunkSize = 4096;
+    static constexpr size_t kMaxSmallChunkSize = 128 * 1024;
+    static constexpr size_t kLargeChunkStep = 128 * 1024;
+    static constexpr size_t kMaxChunkSize = 1024 * 1024;
+    static constexpr size_t kSmallSizeClassCnt = 6; // 4K, 8K, 16K, 32K, 64K, 128K
+    static constexpr size_t kSizeClassCnt
+        = kSmallSizeClassCnt + (kMaxChunkSize - kMaxSmallChunkSize) / kLargeChunkStep; // 256K, 384K, ..., 1M
+
+    ChunkPool(const ChunkPool&) = delete;
+    ChunkPool& operator=(const ChunkPool&) = delete;
+
+    static ChunkPool* GetInstance() {
+        static ChunkPool* ptr = new ChunkPool();
+        return ptr;
+    }
+
+    // size is rounded up to the capacity of the returned chunk, which must be passed back to Release.
+    uint8_t* Acquire(size_t& size);
+    void Release(uint8_t* chunk, size_t size);
+
+    uint64_t GetCachedSize() const { return mCachedSize.load(std::memory_order_relaxed); }
+    uint64_t GetInUseSize() const { return mInUseSize.load(std::memory_order_relaxed); }
+    uint64_t GetAcquireCnt() const { return mAcquireCnt.load(std::memory_order_relaxed); }
+    uint64_t GetAcquireMissCnt() const { return mAcquireMissCnt.load(std::memory_order_relaxed); }
+
+    // release all chunks cached in the shared cache back to the system
+    void Trim();
+
+private:
+    struct SizeClassCache {
+        std::mutex mMux;
+        std::vector<uint8_t*> mChunks;
+    };
+
+    struct ThreadCache {
+        ~ThreadCache();
+
+        std::array<std::vector<uint8_t*>, kSizeClassCnt> mChunks;
+        size_t mCachedSize = 0;
+    };
+
+    ChunkPool() = default;
+    ~ChunkPool() = default;
+
+    static size_t GetSizeClass(size_t size);
+    static size_t GetSizeClassCapacity(size_t idx);
+    static ThreadCache& GetThreadCache();
+
+    bool FetchFromSharedCache(size_t idx, ThreadCache& cache);
+    void ReturnToSharedCache(size_t idx, ThreadCache& cache, size_t cnt);
+
+    std::array<SizeClassCache, kSizeClassCnt> mSharedCaches;
+    std::atomic_uint64_t mSharedCachedSize = 0;
+
+    // chunks held by the shared cache and by all thread caches
+    std::atomic_uint64_t mCachedSize = 0;
+    // chunks currently owned by BufferAllocator
+    std::atomic_uint64_t mInUseSize = 0;
+    std::atomic_uint64_t mAcquireCnt = 0;
+    std::atomic_uint64_t mAcquireMissCnt = 0;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class ChunkPoolUnittest;
+#endif
+};
+
+} // namespace logtail
@@ -18,7 +18,10 @@
 
 #include <list>
 #include <memory>
+#include <utility>
+#include <vector>
 
+#include "common/memory/ChunkPool.h"
 #include "models/StringView.h"
 
 namespace logtail {
@@ -47,8 +50,7 @@ private:
 public:
     explicit BufferAllocator(uint32_t firstChunkSize = 4096, uint32_t chunkSizeLimit = 1024 * 128)
         : mFirstChunkSize(firstChunkSize), mChunkSizeLimit(chunkSizeLimit), mChunkSize(firstChunkSize) {
-        mAllocPtr = new uint8_t[mChunkSize];
-        mAllocatedChunks.push_back(mAllocPtr);
+        mAllocPtr = NewChunk(mChunkSize);
         mFreeBytesInChunk = mChunkSize;
         mAllocated = mChunkSize;
     }
@@ -59,18 +61,19 @@ public:
     BufferAllocator(BufferAllocator&&) = default;
     BufferAllocator& operator=(BufferAllocator&&) = default;
 
+    // chunks are returned to the chunk pool, so that they can be reused by the next event group
     ~BufferAllocator() {
         for (size_t i = 0; i < mAllocatedChunks.size(); i++) {
-            delete[] mAllocatedChunks[i];
+            ReleaseChunk(mAllocatedChunks[i]);
         }
     }
 
     void Reset(void) {
         for (size_t i = 1; i < mAllocatedChunks.size(); i++) {
-            delete[] mAllocatedChunks[i];
+            ReleaseChunk(mAllocatedChunks[i]);
         }
         mAllocatedChunks.resize(1);
-        mAllocPtr = mAllocatedChunks[0];
+        mAllocPtr = mAllocatedChunks[0].first;
         mChunkSize = mFirstChunkSize;
         mFreeBytesInChunk = mChunkSize;
         mAllocated = mChunkSize;
@@ -106,8 +109,7 @@ private:
              * will not be so large. Thus, it is wise to allocate it directly
              * from heap in order to avoid polluting chunk size.
              */
-            mem = new uint8_t[bytes];
-            mAllocatedChunks.push_back(mem);
+            mem = NewChunk(bytes);
             mAllocated += bytes;
         } else {
             /*
@@ -116,8 +118,7 @@ private:
             if (mChunkSize < mChunkSizeLimit) {
                 mChunkSize *= 2;
             }
-            mem = new uint8_t[mChunkSize];
-            mAllocatedChunks.push_back(mem);
+            mem = NewChunk(mChunkSize);
             mAllocPtr = mem + bytes;
             mFreeBytesInChunk = mChunkSize - bytes;
             mAllocated += mChunkSize;
@@ -127,12 +128,22 @@ private:
         return mem;
     }
 
+    uint8_t* NewChunk(size_t bytes) {
+        uint8_t* chunk = ChunkPool::GetInstance()->Acquire(bytes);
+        mAllocatedChunks.emplace_back(chunk, bytes);
+        return chunk;
+    }
+
+    static void ReleaseChunk(const std::pair<uint8_t*, size_t>& chunk) {
+        ChunkPool::GetInstance()->Release(chunk.first, chunk.second);
+    }
+
 private:
     uint32_t mFirstChunkSize = 4096;
     uint32_t mChunkSizeLimit = 1024 * 128;
 
-    // The allocated memory chunks
-    std::vector<uint8_t*> mAllocatedChunks;
+    // The allocated memory chunks, along with their capacity in the chunk pool
+    std::vector<std::pair<uint8_t*, size_t>> mAllocatedChunks;
     // Statistics data
     uint64_t mAllocated = 0;
     uint64_t mUsed = 0;
@@ -14,23 +14,36 @@
 
 #include "common/timer/Timer.h"
 
+#include <random>
+
+#include "common/Flags.h"
 #include "logger/Logger.h"
 
+DEFINE_FLAG_INT32(timer_worker_thread_num, "number of threads executing expired timer events", 2);
+
 using namespace std;
 
 namespace logtail {
 
+Timer::Timer() : mStartTime(chrono::steady_clock::now()) {
+    for (size_t level = 0; level < kLevelCnt; ++level) {
+        mWheels[level].resize(GetSlotCnt(level));
+    }
+}
+
 void Timer::Init() {
     {
-        lock_guard<mutex> lock(mThreadRunningMux);
+        lock_guard<mutex> lock(mMux);
         mIsThreadRunning = true;
     }
+    mWorkers = make_unique<ThreadPool>(max(1, INT32_FLAG(timer_worker_thread_num)));
+    mWorkers->Start();
     mThreadRes = async(launch::async, &Timer::Run, this);
 }
 
 void Timer::Stop() {
     {
-        lock_guard<mutex> lock(mThreadRunningMux);
+        lock_guard<mutex> lock(mMux);
         mIsThreadRunning = false;
     }
     mCV.notify_one();
@@ -43,49 +56,165 @@ void Timer::Stop() {
     } else {
         LOG_WARNING(sLogger, ("timer", "forced to stopped"));
     }
+    if (mWorkers) {
+        mWorkers->Stop();
+    }
 }
 
-void Timer::PushEvent(unique_ptr<TimerEvent>&& e) {
-    lock_guard<mutex> lock(mQueueMux);
-    if (mQueue.empty() || e->GetExecTime() < mQueue.top()->GetExecTime()) {
-        mQueue.push(std::move(e));
+TimerEventId Timer::PushEvent(unique_ptr<TimerEvent>&& e, chrono::milliseconds maxJitter) {
+    auto fireTime = e->GetExecTime();
+    if (maxJitter.count() > 0) {
+        static thread_local minstd_rand sRand(random_device{}());
+        fireTime += chrono::milliseconds(sRand() % maxJitter.count());
+    }
+
+    Slot tmp;
+    auto it = tmp.emplace(tmp.end());
+    it->mEvent = std::move(e);
+
+    lock_guard<mutex> lock(mMux);
+    if (mEventIndex.empty()) {
+        // the timer thread does not advance the tick while the wheel is empty, so catch up here, otherwise the timer
+        // thread would have to advance through all idle ticks while holding the lock
+        mCurrentTick = max(mCurrentTick, GetNowTick());
+    }
+    it->mId = mNextEventId++;
+    it->mExpireTick = GetTick(fireTime);
+    Place(tmp, it, mCurrentTick + 1);
+    mEventIndex.emplace(it->mId, it);
+    if (it->mExpireTick < mWakeUpTick) {
         mCV.notify_one();
+    }
+    return it->mId;
+}
+
+bool Timer::CancelEvent(TimerEventId id) {
+    unique_ptr<TimerEvent> e;
+    {
+        lock_guard<mutex> lock(mMux);
+        auto it = mEventIndex.find(id);
+        if (it == mEventIndex.end()) {
+            return false;
+        }
+        auto entry = it->second;
+        // destroy the event outside the lock
+        e = std::move(entry->mEvent);
+        mWheels[entry->mLevel][entry->mSlot].erase(entry);
+        mEventIndex.erase(it);
+    }
+    return true;
+}
+
+size_t Timer::GetEventCnt() const {
+    lock_guard<mutex> lock(mMux);
+    return mEventIndex.size();
+}
+
+void Timer::ExecuteEvent(TimerEvent& e) {
+    if (!e.IsValid()) {
+        LOG_INFO(sLogger, ("invalid timer event", "task is cancelled"));
     } else {
-        mQueue.push(std::move(e));
+        e.Execute();
     }
 }
 
 void Timer::Run() {
     LOG_INFO(sLogger, ("timer", "started"));
-    unique_lock<mutex> threadLock(mThreadRunningMux);
+    vector<unique_ptr<TimerEvent>> expired;
+    unique_lock<mutex> lock(mMux);
     while (mIsThreadRunning) {
-        unique_lock<mutex> queueLock(mQueueMux);
-        if (mQueue.empty()) {
-            queueLock.unlock();
-            mCV.wait(threadLock, [this]() { return !mIsThreadRunning || !mQueue.empty(); });
-        } else {
-            auto now = chrono::steady_clock::now();
-            while (!mQueue.empty()) {
-                auto& e = mQueue.top();
-                if (now < e->GetExecTime()) {
-                    auto timeout = e->GetExecTime() - now + chrono::milliseconds(1);
-                    queueLock.unlock();
-                    mCV.wait_for(threadLock, timeout);
-                    break;
-                } else {
-                    auto e = std::move(const_cast<unique_ptr<TimerEvent>&>(mQueue.top()));
-                    mQueue.pop();
-                    queueLock.unlock();
-                    if (!e->IsValid()) {
-                        LOG_INFO(sLogger, ("invalid timer event", "task is cancelled"));
-                    } else {
-                        e->Execute();
-                    }
-                    queueLock.lock();
-                }
+        auto nowTick = GetNowTick();
+        while (mCurrentTick < nowTick && !mEventIndex.empty()) {
+            Advance(expired);
+        }
+        if (mEventIndex.empty()) {
+            // no cascade is needed when the wheel is empty
+            mCurrentTick = max(mCurrentTick, nowTick);
+        }
+
+        if (!expired.empty()) {
+            lock.unlock();
+            for (auto& e : expired) {
+                // std::function requires a copyable callable
+                shared_ptr<TimerEvent> event(std::move(e));
+                mWorkers->Add([event]() { ExecuteEvent(*event); });
             }
+            expired.clear();
+            lock.lock();
+            continue;
         }
+
+        if (mEventIndex.empty()) {
+            mWakeUpTick = UINT64_MAX;
+            mCV.wait(lock, [this]() { return !mIsThreadRunning || !mEventIndex.empty(); });
+        } else {
+            mWakeUpTick = GetNextTick();
+            mCV.wait_until(lock, mStartTime + kTickInterval * mWakeUpTick);
+        }
+    }
+}
+
+uint64_t Timer::GetTick(chrono::steady_clock::time_point t) const {
+    if (t <= mStartTime) {
+        return 0;
+    }
+    // round up, so that an event is never fired before its exec time
+    auto elapsed = chrono::duration_cast<chrono::nanoseconds>(t - mStartTime).count();
+    auto interval = chrono::duration_cast<chrono::nanoseconds>(kTickInterval).count();
+    return static_cast<uint64_t>((elapsed + interval - 1) / interval);
+}
+
+uint64_t Timer::GetNowTick() const {
+    return static_cast<uint64_t>((chrono::steady_clock::now() - mStartTime) / kTickInterval);
+}
+
+uint64_t Timer::GetNextTick() const {
+    // events beyond the current rotation of the first level are handled by the cascade at its end
+    uint64_t end = (mCurrentTick | (GetSlotCnt(0) - 1)) + 1;
+    for (uint64_t tick = mCurrentTick + 1; tick < end; ++tick) {
+        if (!mWheels[0][tick & (GetSlotCnt(0) - 1)].empty()) {
+            return tick;
+        }
+    }
+    return end;
+}
+
+void Timer::Place(Slot& from, Slot::iterator it, uint64_t baseTick) {
+    uint64_t tick = max(it->mExpireTick, baseTick);
+    uint64_t delta = tick - baseTick;
+    size_t level = 0;
+    while (level + 1 < kLevelCnt && delta >= GetLevelRange(level)) {
+        ++level;
+    }
+    if (delta >= GetLevelRange(level)) {
+        // beyond the range of the wheel, placed again when cascaded
+        tick = baseTick + GetLevelRange(level) - 1;
+    }
+    it->mLevel = level;
+    it->mSlot = (tick >> GetLevelShift(level)) & (GetSlotCnt(level) - 1);
+    auto& to = mWheels[level][it->mSlot];
+    to.splice(to.end(), from, it);
+}
+
+void Timer::Advance(vector<unique_ptr<TimerEvent>>& expired) {
+    uint64_t tick = ++mCurrentTick;
+    for (size_t level = kLevelCnt - 1; level > 0; --level) {
+        size_t shift = GetLevelShift(level);
+        if ((tick & ((1ULL << shift) - 1)) != 0) {
+            continue;
+        }
+        auto& slot = mWheels[level][(tick >> shift) & (GetSlotCnt(level) - 1)];
+        while (!slot.empty()) {
+            Place(slot, slot.begin(), tick);
+        }
+    }
+
+    auto& slot = mWheels[0][tick & (GetSlotCnt(0) - 1)];
+    for (auto& entry : slot) {
+        expired.emplace_back(std::move(entry.mEvent));
+        mEventIndex.erase(entry.mId);
     }
+    slot.clear();
 }
 
 } // namespace logtail
@@ -16,37 +16,87 @@
 
 #pragma once
 
+#include <cstdint>
+
+#include <array>
+#include <chrono>
 #include <condition_variable>
 #include <future>
+#include <list>
 #include <memory>
 #include <mutex>
-#include <queue>
+#include <unordered_map>
+#include <vector>
 
+#include "common/ThreadPool.h"
 #include "common/timer/TimerEvent.h"
 
 namespace logtail {
 
-struct TimerEventCompare {
-    bool operator()(const std::unique_ptr<TimerEvent>& lhs, const std::unique_ptr<TimerEvent>& rhs) const {
-        return lhs->GetExecTime() > rhs->GetExecTime();
-    }
-};
+using TimerEventId = uint64_t;
 
+// Hierarchical timing wheel.
+//
+// Time is divided into ticks of kTickInterval. The first level has 256 slots of one tick each, and every following
+// level has 64 slots, each covering a whole rotation of the previous level. Pushing and cancelling an event are O(1).
+// When a rotation of a level completes, the events in the next slot of the upper level are cascaded down. Events are
+// fired at the first tick not earlier than their exec time, and are executed by a pool of worker threads so that a slow
+// event does not delay the others.
 class Timer {
 public:
+    static constexpr std::chrono::milliseconds kTickInterval{10};
+    static constexpr size_t kLevelCnt = 4;
+    static constexpr size_t kFirstLevelBits = 8;
+    static constexpr size_t kLevelBits = 6;
+
+    Timer();
+
     void Init();
     void Stop();
-    void PushEvent(std::unique_ptr<TimerEvent>&& e);
+    // When maxJitter is not zero, the event is fired at a random time within [exec time, exec time + maxJitter), so
+    // that events sharing the same exec time are spread out. The exec time of the event itself is not changed.
+    TimerEventId PushEvent(std::unique_ptr<TimerEvent>&& e,
+                           std::chrono::milliseconds maxJitter = std::chrono::milliseconds(0));
+    // returns false if the event has been fired or cancelled already
+    bool CancelEvent(TimerEventId id);
+    size_t GetEventCnt() const;
 
 private:
+    struct Entry {
+        TimerEventId mId = 0;
+        uint64_t mExpireTick = 0;
+        size_t mLevel = 0;
+        size_t mSlot = 0;
+        std::unique_ptr<TimerEvent> mEvent;
+    };
+    using Slot = std::list<Entry>;
+
+    static size_t GetSlotCnt(size_t level) { return level == 0 ? (1 << kFirstLevelBits) : (1 << kLevelBits); }
+    static size_t GetLevelShift(size_t level) { return level == 0 ? 0 : kFirstLevelBits + (level - 1) * kLevelBits; }
+    // ticks covered by all slots of the level
+    static uint64_t GetLevelRange(size_t level) { return 1ULL << (kFirstLevelBits + level * kLevelBits); }
+    static void ExecuteEvent(TimerEvent& e);
+
     void Run();
+    uint64_t GetTick(std::chrono::steady_clock::time_point t) const;
+    // the last tick not later than now
+    uint64_t GetNowTick() const;
+    uint64_t GetNextTick() const;
+    void Place(Slot& from, Slot::iterator it, uint64_t baseTick);
+    void Advance(std::vector<std::unique_ptr<TimerEvent>>& expired);
 
-    mutable std::mutex mQueueMux;
-    std::priority_queue<std::unique_ptr<TimerEvent>, std::vector<std::unique_ptr<TimerEvent>>, TimerEventCompare>
-        mQueue;
+    mutable std::mutex mMux;
+    std::array<std::vector<Slot>, kLevelCnt> mWheels;
+    std::unordered_map<TimerEventId, Slot::iterator> mEventIndex;
+    TimerEventId mNextEventId = 1;
+    std::chrono::steady_clock::time_point mStartTime;
+    // all ticks up to and including this one have been fired
+    uint64_t mCurrentTick = 0;
+    // the tick the timer thread will wake up at
+    uint64_t mWakeUpTick = UINT64_MAX;
 
+    std::unique_ptr<ThreadPool> mWorkers;
     std::future<void> mThreadRes;
-    mutable std::mutex mThreadRunningMux;
     bool mIsThreadRunning = true;
     mutable std::condition_variable mCV;
 
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <string>
 
 #include "json/json.h"
@@ -26,6 +27,7 @@ struct ConfigContainerInfoUpdateCmd {
     std::string mConfigName; // config name
     bool mDeleteFlag = false; // if this flag is true, delete the container from this config's ContainerInfo array
     Json::Value mJsonParams; // jsonParams, json string.
+    std::chrono::steady_clock::time_point mCreateTime = std::chrono::steady_clock::now();
 
     ConfigContainerInfoUpdateCmd(const std::string& configName, bool delFlag, const Json::Value& jsonParams)
         : mConfigName(configName), mDeleteFlag(delFlag), mJsonParams(jsonParams) {}
@@ -24,7 +24,9 @@
 #endif
 #include <limits.h>
 
+#include <chrono>
 #include <fstream>
+#include <map>
 #include <set>
 #include <unordered_map>
 #include <unordered_set>
@@ -49,6 +51,7 @@
 #include "file_server/FileServer.h"
 #include "file_server/event_handler/EventHandler.h"
 #include "monitor/AlarmManager.h"
+#include "monitor/metric_models/MetricTypes.h"
 
 using namespace std;
 
@@ -606,16 +609,17 @@ FileDiscoveryConfig ConfigManager::FindBestMatch(const string& path, const strin
             }
         }
     }
-    const auto& nameConfigMap = FileServer::GetInstance()->GetAllFileDiscoveryConfigs();
-    auto itr = nameConfigMap.begin();
+    static thread_local vector<FileDiscoveryConfig> sCandidates;
+    sCandidates.clear();
+    mConfigMatchIndex.FindCandidates(path, sCandidates);
     FileDiscoveryConfig prevMatch(nullptr, nullptr);
     size_t prevLen = 0;
     size_t curLen = 0;
     uint32_t nameRepeat = 0;
     string logNameList;
     vector<FileDiscoveryConfig> multiConfigs;
-    for (; itr != nameConfigMap.end(); ++itr) {
-        const FileDiscoveryOptions* config = itr->second.first;
+    for (const auto& candidate : sCandidates) {
+        const FileDiscoveryOptions* config = candidate.first;
         // // exclude __FUSE_CONFIG__
         // if (itr->first == STRING_FLAG(fuse_customized_config_name)) {
         //     continue;
@@ -627,21 +631,21 @@ FileDiscoveryConfig ConfigManager::FindBestMatch(const string& path, const strin
             if (!name.empty() && !config->mAllowingIncludedByMultiConfigs) {
                 nameRepeat++;
                 logNameList.append("logstore:");
-                logNameList.append(itr->second.second->GetLogstoreName());
+                logNameList.append(candidate.second->GetLogstoreName());
                 logNameList.append(",config:");
-                logNameList.append(itr->second.second->GetConfigName());
+                logNameList.append(candidate.second->GetConfigName());
                 logNameList.append(" ");
-                multiConfigs.push_back(itr->second);
+                multiConfigs.push_back(candidate);
             }
 
             // note: best config is the one which length is longest and create time is nearest
             curLen = config->GetBasePath().size();
             if (prevLen < curLen) {
-                prevMatch = itr->second;
+                prevMatch = candidate;
                 prevLen = curLen;
             } else if (prevLen == curLen && prevMatch.first) {
-                if (prevMatch.second->GetCreateTime() > itr->second.second->GetCreateTime()) {
-                    prevMatch = itr->second;
+                if (prevMatch.second->GetCreateTime() > candidate.second->GetCreateTime()) {
+                    prevMatch = candidate;
                     prevLen = curLen;
                 }
             }
@@ -695,10 +699,11 @@ int32_t ConfigManager::FindAllMatch(vector<FileDiscoveryConfig>& allConfig,
         }
     }
     bool alarmFlag = false;
-    auto nameConfigMap = FileServer::GetInstance()->GetAllFileDiscoveryConfigs();
-    auto itr = nameConfigMap.begin();
-    for (; itr != nameConfigMap.end(); ++itr) {
-        const FileDiscoveryOptions* config = itr->second.first;
+    static thread_local vector<FileDiscoveryConfig> sCandidates;
+    sCandidates.clear();
+    mConfigMatchIndex.FindCandidates(path, sCandidates);
+    for (const auto& candidate : sCandidates) {
+        const FileDiscoveryOptions* config = candidate.first;
         // // exclude __FUSE_CONFIG__
         // if (itr->first == STRING_FLAG(fuse_customized_config_name)) {
         //     continue;
@@ -706,7 +711,7 @@ int32_t ConfigManager::FindAllMatch(vector<FileDiscoveryConfig>& allConfig,
 
         bool match = config->IsMatch(path, name);
         if (match) {
-            allConfig.push_back(itr->second);
+            allConfig.push_back(candidate);
         }
     }
 
@@ -743,16 +748,16 @@ int32_t ConfigManager::FindMatchWithForceFlag(std::vector<FileDiscoveryConfig>&
             }
         }
     }
-    auto nameConfigMap = FileServer::GetInstance()->GetAllFileDiscoveryConfigs();
-    auto itr = nameConfigMap.begin();
+    static thread_local vector<FileDiscoveryConfig> sCandidates;
+    sCandidates.clear();
+    mConfigMatchIndex.FindCandidates(path, sCandidates);
     FileDiscoveryConfig prevMatch = make_pair(nullptr, nullptr);
     size_t prevLen = 0;
     size_t curLen = 0;
     uint32_t nameRepeat = 0;
     string logNameList;
     vector<FileDiscoveryConfig> multiConfigs;
-    for (; itr != nameConfigMap.end(); ++itr) {
-        FileDiscoveryConfig config = itr->second;
+    for (const auto& config : sCandidates) {
         // // exclude __FUSE_CONFIG__
         // if (itr->first == STRING_FLAG(fuse_customized_config_name)) {
         //     continue;
@@ -864,10 +869,11 @@ void ConfigManager::DeleteHandlers() {
 // 1. No wildcard path: the base path of Config is the prefix of @path and within depth.
 // 2. Wildcard path: @path matches and within depth.
 void ConfigManager::GetRelatedConfigs(const std::string& path, std::vector<FileDiscoveryConfig>& configs) {
-    const auto& nameConfigMap = FileServer::GetInstance()->GetAllFileDiscoveryConfigs();
-    for (auto iter = nameConfigMap.begin(); iter != nameConfigMap.end(); ++iter) {
-        if (iter->second.first->IsMatch(path, "")) {
-            configs.push_back(iter->second);
+    vector<FileDiscoveryConfig> candidates;
+    mConfigMatchIndex.FindCandidates(path, candidates);
+    for (const auto& candidate : candidates) {
+        if (candidate.first->IsMatch(path, "")) {
+            configs.push_back(candidate);
         }
     }
 }
@@ -886,95 +892,124 @@ bool ConfigManager::DoUpdateContainerPaths() {
     mContainerInfoCmdLock.unlock();
     LOG_INFO(sLogger, ("update container path", tmpPathCmdVec.size()));
     for (size_t i = 0; i < tmpPathCmdVec.size(); ++i) {
-        FileDiscoveryConfig config = FileServer::GetInstance()->GetFileDiscoveryConfig(tmpPathCmdVec[i]->mConfigName);
-        if (!config.first) {
-            LOG_ERROR(sLogger,
-                      ("invalid container path update cmd",
-                       tmpPathCmdVec[i]->mConfigName)("params", tmpPathCmdVec[i]->mJsonParams.toStyledString()));
-            continue;
-        }
-        if (tmpPathCmdVec[i]->mDeleteFlag) {
-            if (config.first->DeleteContainerInfo(tmpPathCmdVec[i]->mJsonParams)) {
-                LOG_DEBUG(sLogger,
-                          ("container path delete cmd success",
-                           tmpPathCmdVec[i]->mConfigName)("params", tmpPathCmdVec[i]->mJsonParams.toStyledString()));
-            } else {
-                LOG_ERROR(sLogger,
-                          ("container path delete cmd fail",
-                           tmpPathCmdVec[i]->mConfigName)("params", tmpPathCmdVec[i]->mJsonParams.toStyledString()));
-            }
-        } else {
-            if (config.first->UpdateContainerInfo(tmpPathCmdVec[i]->mJsonParams, config.second)) {
-                LOG_DEBUG(sLogger,
-                          ("container path update cmd success",
-                           tmpPathCmdVec[i]->mConfigName)("params", tmpPathCmdVec[i]->mJsonParams.toStyledString()));
-            } else {
-                LOG_ERROR(sLogger,
-                          ("container path update cmd fail",
-                           tmpPathCmdVec[i]->mConfigName)("params", tmpPathCmdVec[i]->mJsonParams.toStyledString()));
-            }
-        }
+        ApplyContainerPathCmd(*tmpPathCmdVec[i]);
         delete tmpPathCmdVec[i];
     }
     return true;
 }
 
-bool ConfigManager::IsUpdateContainerPaths() {
-    mContainerInfoCmdLock.lock();
-    bool rst = false;
-    for (size_t i = 0; i < mContainerInfoCmdVec.size(); ++i) {
-        ConfigContainerInfoUpdateCmd* pCmd = mContainerInfoCmdVec[i];
-        if (pCmd->mDeleteFlag) {
-            rst = true;
-            break;
+void ConfigManager::ApplyContainerPathUpdates(std::vector<Event*>& eventVec, Histogram* latency) {
+    std::vector<ConfigContainerInfoUpdateCmd*> cmdVec;
+    {
+        PTScopedLock lock(mContainerInfoCmdLock);
+        cmdVec.swap(mContainerInfoCmdVec);
+    }
+    if (cmdVec.empty()) {
+        return;
+    }
+
+    // the full container list is resent periodically, so most cmds change nothing
+    std::vector<ConfigContainerInfoUpdateCmd*> changedCmdVec;
+    std::map<std::string, std::set<std::string>> oldBaseDirs;
+    for (auto cmd : cmdVec) {
+        FileDiscoveryConfig config = FileServer::GetInstance()->GetFileDiscoveryConfig(cmd->mConfigName);
+        if (config.first && !cmd->mDeleteFlag && config.first->IsSameContainerInfo(cmd->mJsonParams, config.second)) {
+            continue;
         }
-        FileDiscoveryConfig pConfig = FileServer::GetInstance()->GetFileDiscoveryConfig(pCmd->mConfigName);
-        if (!pConfig.first) {
+        changedCmdVec.push_back(cmd);
+        if (!config.first || !config.first->GetContainerInfo()) {
             continue;
         }
-        if (!pConfig.first->IsSameContainerInfo(pCmd->mJsonParams, pConfig.second)) {
-            rst = true;
-            break;
+        auto res = oldBaseDirs.try_emplace(cmd->mConfigName);
+        if (res.second) {
+            for (const auto& info : *config.first->GetContainerInfo()) {
+                res.first->second.insert(info.mRealBaseDir);
+            }
         }
     }
-    if (mContainerInfoCmdVec.size() > 0) {
-        LOG_INFO(sLogger, ("check container path update flag", rst)("size", mContainerInfoCmdVec.size()));
+
+    if (!changedCmdVec.empty()) {
+        for (auto cmd : changedCmdVec) {
+            ApplyContainerPathCmd(*cmd);
+        }
+
+        std::set<std::string> removedDirs;
+        for (const auto& item : oldBaseDirs) {
+            FileDiscoveryConfig config = FileServer::GetInstance()->GetFileDiscoveryConfig(item.first);
+            std::set<std::string> newDirs;
+            for (const auto& info : *config.first->GetContainerInfo()) {
+                newDirs.insert(info.mRealBaseDir);
+            }
+            for (const auto& dir : newDirs) {
+                if (item.second.find(dir) != item.second.end()) {
+                    continue;
+                }
+                if (config.first->GetWildcardPaths().empty()) {
+                    RegisterHandlers(dir, config);
+                } else {
+                    RegisterWildcardPath(config, dir, 0);
+                }
+            }
+            for (const auto& dir : item.second) {
+                if (newDirs.find(dir) == newDirs.end()) {
+                    removedDirs.insert(dir);
+                }
+            }
+        }
+        // a base dir may be shared by containers of other configs
+        for (const auto& dir : removedDirs) {
+            std::vector<FileDiscoveryConfig> configs;
+            GetRelatedConfigs(dir, configs);
+            if (configs.empty()) {
+                eventVec.push_back(new Event(dir, "", EVENT_ISDIR | EVENT_CONTAINER_STOPPED, -1, 0));
+            }
+        }
+        SaveDockerConfig();
     }
-    if (rst == false) {
-        for (size_t i = 0; i < mContainerInfoCmdVec.size(); ++i) {
-            delete mContainerInfoCmdVec[i];
+
+    auto now = std::chrono::steady_clock::now();
+    for (auto cmd : cmdVec) {
+        if (latency) {
+            latency->Record(now - cmd->mCreateTime);
         }
-        mContainerInfoCmdVec.clear();
+        delete cmd;
     }
-    mContainerInfoCmdLock.unlock();
+    LOG_INFO(sLogger, ("update container path", cmdVec.size())("changed", changedCmdVec.size()));
+}
 
-    /********** qps limit : only update docker config INT32_FLAG(max_docker_config_update_times) times in 3 minutes
-     * ********/
-    static int32_t s_lastUpdateTime = 0;
-    static int32_t s_lastUpdateCount = 0;
-    if (!rst) {
-        return rst;
-    }
-    int32_t nowTime = time(NULL);
-    // not in 3 minutes window
-    if (nowTime / 180 != s_lastUpdateTime / 180) {
-        s_lastUpdateCount = 1;
-        s_lastUpdateTime = nowTime;
-        return rst;
-    }
-    // this window's update times < INT32_FLAG(max_docker_config_update_times)
-    // min interval : 10 seconds
-    // For case with frequent container update (eg. K8s short job), adjust this parameter.
-    if (s_lastUpdateCount < INT32_FLAG(max_docker_config_update_times)
-        && nowTime - s_lastUpdateTime >= INT32_FLAG(docker_config_update_interval)) {
-        ++s_lastUpdateCount;
-        s_lastUpdateTime = nowTime;
-        return rst;
-    }
-    // return false if s_lastUpdateCount >= INT32_FLAG(max_docker_config_update_times) and last update time is in same
-    // window
-    return false;
-    /************************************************************************************************************************/
+bool ConfigManager::ApplyContainerPathCmd(const ConfigContainerInfoUpdateCmd& cmd) {
+    FileDiscoveryConfig config = FileServer::GetInstance()->GetFileDiscoveryConfig(cmd.mConfigName);
+    if (!config.first) {
+        LOG_ERROR(sLogger,
+                  ("invalid container path update cmd", cmd.mConfigName)("params", cmd.mJsonParams.toStyledString()));
+        return false;
+    }
+    bool res = false;
+    {
+        WriteLock lock(mContainerInfoRWL);
+        res = cmd.mDeleteFlag ? config.first->DeleteContainerInfo(cmd.mJsonParams)
+                              : config.first->UpdateContainerInfo(cmd.mJsonParams, config.second);
+    }
+    if (cmd.mDeleteFlag) {
+        if (!res) {
+            LOG_ERROR(sLogger,
+                      ("container path delete cmd fail", cmd.mConfigName)("params", cmd.mJsonParams.toStyledString()));
+            return false;
+        }
+        UpdateFileDiscoveryConfig(cmd.mConfigName, config);
+        LOG_DEBUG(sLogger,
+                  ("container path delete cmd success", cmd.mConfigName)("params", cmd.mJsonParams.toStyledString()));
+    } else {
+        if (!res) {
+            LOG_ERROR(sLogger,
+                      ("container path update cmd fail", cmd.mConfigName)("params", cmd.mJsonParams.toStyledString()));
+            return false;
+        }
+        UpdateFileDiscoveryConfig(cmd.mConfigName, config);
+        LOG_DEBUG(sLogger,
+                  ("container path update cmd success", cmd.mConfigName)("params", cmd.mJsonParams.toStyledString()));
+    }
+    return true;
 }
 
 bool ConfigManager::UpdateContainerStopped(ConfigContainerInfoUpdateCmd* cmd) {
@@ -1113,6 +1148,59 @@ void ConfigManager::ClearFilePipelineMatchCache() {
     mCacheFileAllConfigMap.clear();
 }
 
+void ConfigManager::UpdateFileDiscoveryConfig(const string& name, const FileDiscoveryConfig& config) {
+    vector<string> anchors;
+    bool bounded = mConfigMatchIndex.Update(name, config, anchors);
+    InvalidateConfigMatchCache(anchors, bounded);
+}
+
+void ConfigManager::RemoveFileDiscoveryConfig(const string& name) {
+    vector<string> anchors;
+    bool bounded = mConfigMatchIndex.Remove(name, anchors);
+    InvalidateConfigMatchCache(anchors, bounded);
+}
+
+void ConfigManager::InvalidateConfigMatchCache(const vector<string>& anchors, bool bounded) {
+    if (!bounded) {
+        ClearFilePipelineMatchCache();
+        return;
+    }
+    if (anchors.empty()) {
+        return;
+    }
+    // the cache key is path<name, and the name may contain the separator as well, so a key is dropped whenever it
+    // could be a path under one of the anchors
+    auto isAffected = [&anchors](const string& key) {
+        for (const auto& anchor : anchors) {
+            if (key.size() > anchor.size() && key.compare(0, anchor.size(), anchor) == 0
+                && (key[anchor.size()] == PATH_SEPARATOR[0] || key[anchor.size()] == '<')) {
+                return true;
+            }
+        }
+        return false;
+    };
+    {
+        ScopedSpinLock lock(mCacheFileConfigMapLock);
+        for (auto it = mCacheFileConfigMap.begin(); it != mCacheFileConfigMap.end();) {
+            if (isAffected(it->first)) {
+                it = mCacheFileConfigMap.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    {
+        ScopedSpinLock lock(mCacheFileAllConfigMapLock);
+        for (auto it = mCacheFileAllConfigMap.begin(); it != mCacheFileAllConfigMap.end();) {
+            if (isAffected(it->first)) {
+                it = mCacheFileAllConfigMap.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+}
+
 #ifdef APSARA_UNIT_TEST_MAIN
 void ConfigManager::CleanEnviroments() {
     for (std::unordered_map<std::string, EventHandler*>::iterator iter = mDirEventHandlerMap.begin();
@@ -25,12 +25,14 @@
 
 #include "common/Lock.h"
 #include "container_manager/ConfigContainerInfoUpdateCmd.h"
+#include "file_server/ConfigMatchIndex.h"
 #include "file_server/FileDiscoveryOptions.h"
 #include "file_server/event/Event.h"
 
 namespace logtail {
 
 class EventHandler;
+class Histogram;
 
 enum ParseConfResult { CONFIG_OK, CONFIG_NOT_EXIST, CONFIG_INVALID_FORMAT };
 ParseConfResult ParseConfig(const std::string& configName, Json::Value& jsonRoot);
@@ -157,7 +159,11 @@ protected:
     SpinLock mCacheFileAllConfigMapLock;
     std::unordered_map<std::string, std::pair<std::vector<FileDiscoveryConfig>, int32_t>> mCacheFileAllConfigMap;
 
+    // candidates of the configs matching a path, kept in sync with the file discovery configs in FileServer
+    ConfigMatchIndex mConfigMatchIndex;
+
     PTMutex mContainerInfoCmdLock;
+    ReadWriteLock mContainerInfoRWL;
     std::vector<ConfigContainerInfoUpdateCmd*> mContainerInfoCmdVec;
 
     PTMutex mDockerContainerStoppedCmdLock;
@@ -423,6 +429,11 @@ public:
 
     void ClearConfigMatchCache();
 
+    // Called when a file discovery config is added, removed, or its containers are changed. Only the cached match
+    // results under the directories the config can match are invalidated.
+    void UpdateFileDiscoveryConfig(const std::string& name, const FileDiscoveryConfig& config);
+    void RemoveFileDiscoveryConfig(const std::string& name);
+
     // 废弃，路径映射
     // bool NeedReloadMappingConfig() { return mHaveMappingPathConfig && mMappingPathsChanged; }
     // void SetMappingPathsChanged() { mMappingPathsChanged = true; }
@@ -443,8 +454,15 @@ public:
     // std::string GetAllProjectsSet();
 
     bool UpdateContainerPath(ConfigContainerInfoUpdateCmd* cmd);
-    bool IsUpdateContainerPaths();
     bool DoUpdateContainerPaths();
+    /**
+     * apply pending container path updates within the event loop. Only the base dirs of added containers are
+     * registered, and stopped events are generated for the base dirs no longer covered by any config.
+     * @param latency records the time from each cmd being received to being applied, could be null
+     */
+    void ApplyContainerPathUpdates(std::vector<Event*>& eventVec, Histogram* latency);
+    // container infos are modified within the event loop, so other threads must hold this lock when reading them
+    ReadWriteLock& GetContainerInfoRWL() { return mContainerInfoRWL; }
 
     bool UpdateContainerStopped(ConfigContainerInfoUpdateCmd* cmd);
     void GetContainerStoppedEvents(std::vector<Event*>& eventVec);
@@ -516,6 +534,8 @@ private:
                                      int preservedDirDepth,
                                      int maxDepth);
     bool RegisterDescendants(const std::string& path, const FileDiscoveryConfig& config, int withinDepth);
+    void InvalidateConfigMatchCache(const std::vector<std::string>& anchors, bool bounded);
+    bool ApplyContainerPathCmd(const ConfigContainerInfoUpdateCmd& cmd);
     // bool CheckLogType(const std::string& logTypeStr, LogType& logType);
     // 废弃
     // std::vector<std::string> GetStringVector(const Json::Value& value);
@@ -588,6 +608,7 @@ private:
     friend class CreateModifyHandlerUnittest;
     friend class ProcessorDesensitizeNativeUnittest;
     friend class ConfigContainerUnittest;
+    friend class ContainerPathUpdateUnittest;
 #endif
 };
 
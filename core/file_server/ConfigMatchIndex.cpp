@@ -0,0 +1,230 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "file_server/ConfigMatchIndex.h"
+
+#include <algorithm>
+
+#include "common/FileSystemUtil.h"
+
+using namespace std;
+
+namespace logtail {
+
+namespace {
+
+// trailing separators are removed, so that the root dir becomes an empty string
+bool NormalizeAnchor(const string& path, string& anchor) {
+    if (path.empty()) {
+        return false;
+    }
+    // fnmatch treats these as special characters, so the prefix is not a literal one
+    if (path.find('[') != string::npos || (PATH_SEPARATOR[0] != '\\' && path.find('\\') != string::npos)) {
+        return false;
+    }
+    size_t end = path.find_last_not_of(PATH_SEPARATOR[0]);
+    anchor = end == string::npos ? string() : path.substr(0, end + 1);
+    return true;
+}
+
+// calls f on each component of the path, including the empty one before the leading separator
+template <typename F>
+void ForEachComponent(const string& path, F f) {
+    size_t begin = 0;
+    while (true) {
+        size_t end = path.find(PATH_SEPARATOR[0], begin);
+        if (!f(end == string::npos ? path.substr(begin) : path.substr(begin, end - begin))) {
+            return;
+        }
+        if (end == string::npos) {
+            return;
+        }
+        begin = end + 1;
+    }
+}
+
+} // namespace
+
+bool ConfigMatchIndex::GetAnchors(const FileDiscoveryOptions& opts, vector<string>& anchors) {
+    string anchor;
+    if (opts.IsContainerDiscoveryEnabled()) {
+        const auto& containerInfos = opts.GetContainerInfo();
+        if (!containerInfos) {
+            // matches nothing
+            return true;
+        }
+        for (const auto& info : *containerInfos) {
+            if (!NormalizeAnchor(info.mRealBaseDir, anchor)) {
+                return false;
+            }
+            anchors.emplace_back(std::move(anchor));
+        }
+        return true;
+    }
+    const auto& path = opts.GetWildcardPaths().empty() ? opts.GetBasePath() : opts.GetWildcardPaths()[0];
+    if (!NormalizeAnchor(path, anchor)) {
+        return false;
+    }
+    anchors.emplace_back(std::move(anchor));
+    return true;
+}
+
+bool ConfigMatchIndex::IsUnderAnchor(const string& anchor, const string& path) {
+    if (path.size() < anchor.size() || path.compare(0, anchor.size(), anchor) != 0) {
+        return false;
+    }
+    return path.size() == anchor.size() || path[anchor.size()] == PATH_SEPARATOR[0];
+}
+
+bool ConfigMatchIndex::Update(const string& name, const FileDiscoveryConfig& config, vector<string>& affected) {
+    ConfigItem item;
+    item.mConfig = config;
+    item.mIndexed = GetAnchors(*config.first, item.mAnchors);
+
+    WriteLock lock(mLock);
+    bool bounded = true;
+    RemoveLocked(name, affected, bounded);
+    if (item.mIndexed) {
+        for (const auto& anchor : item.mAnchors) {
+            Insert(anchor, name, config);
+        }
+        affected.insert(affected.end(), item.mAnchors.begin(), item.mAnchors.end());
+    } else {
+        mUnindexedConfigs.emplace_back(name, config);
+        bounded = false;
+    }
+    mConfigs[name] = std::move(item);
+    return bounded;
+}
+
+bool ConfigMatchIndex::Remove(const string& name, vector<string>& affected) {
+    WriteLock lock(mLock);
+    bool bounded = true;
+    RemoveLocked(name, affected, bounded);
+    return bounded;
+}
+
+void ConfigMatchIndex::Clear() {
+    WriteLock lock(mLock);
+    mRoot.mChildren.clear();
+    mRoot.mConfigs.clear();
+    mConfigs.clear();
+    mUnindexedConfigs.clear();
+}
+
+void ConfigMatchIndex::FindCandidates(const string& path, vector<FileDiscoveryConfig>& candidates) const {
+    ReadLock lock(mLock);
+    for (const auto& item : mUnindexedConfigs) {
+        AppendCandidate(item.second, candidates);
+    }
+    const Node* node = &mRoot;
+    ForEachComponent(path, [&](const string& component) {
+        auto it = node->mChildren.find(component);
+        if (it == node->mChildren.end()) {
+            return false;
+        }
+        node = it->second.get();
+        for (const auto& item : node->mConfigs) {
+            AppendCandidate(item.second, candidates);
+        }
+        return true;
+    });
+}
+
+size_t ConfigMatchIndex::GetConfigCnt() const {
+    ReadLock lock(mLock);
+    return mConfigs.size();
+}
+
+void ConfigMatchIndex::AppendCandidate(const FileDiscoveryConfig& config, vector<FileDiscoveryConfig>& candidates) {
+    // a container config is indexed once for each container, and the real base dirs may be nested
+    for (const auto& candidate : candidates) {
+        if (candidate.first == config.first) {
+            return;
+        }
+    }
+    candidates.push_back(config);
+}
+
+void ConfigMatchIndex::RemoveLocked(const string& name, vector<string>& affected, bool& bounded) {
+    auto it = mConfigs.find(name);
+    if (it == mConfigs.end()) {
+        return;
+    }
+    if (it->second.mIndexed) {
+        for (const auto& anchor : it->second.mAnchors) {
+            Erase(anchor, name);
+        }
+        affected.insert(affected.end(), it->second.mAnchors.begin(), it->second.mAnchors.end());
+    } else {
+        mUnindexedConfigs.erase(remove_if(mUnindexedConfigs.begin(),
+                                          mUnindexedConfigs.end(),
+                                          [&name](const pair<string, FileDiscoveryConfig>& item) {
+                                              return item.first == name;
+                                          }),
+                                mUnindexedConfigs.end());
+        bounded = false;
+    }
+    mConfigs.erase(it);
+}
+
+void ConfigMatchIndex::Insert(const string& anchor, const string& name, const FileDiscoveryConfig& config) {
+    Node* node = &mRoot;
+    ForEachComponent(anchor, [&](const string& component) {
+        auto& child = node->mChildren[component];
+        if (!child) {
+            child = make_unique<Node>();
+        }
+        node = child.get();
+        return true;
+    });
+    node->mConfigs.emplace_back(name, config);
+}
+
+void ConfigMatchIndex::Erase(const string& anchor, const string& name) {
+    vector<pair<Node*, string>> nodes;
+    Node* node = &mRoot;
+    ForEachComponent(anchor, [&](const string& component) {
+        auto it = node->mChildren.find(component);
+        if (it == node->mChildren.end()) {
+            node = nullptr;
+            return false;
+        }
+        nodes.emplace_back(node, component);
+        node = it->second.get();
+        return true;
+    });
+    if (!node) {
+        return;
+    }
+    auto& configs = node->mConfigs;
+    auto it = find_if(configs.begin(), configs.end(), [&name](const pair<string, FileDiscoveryConfig>& item) {
+        return item.first == name;
+    });
+    if (it != configs.end()) {
+        configs.erase(it);
+    }
+    // remove the nodes no longer used, from the leaf up
+    for (auto parent = nodes.rbegin(); parent != nodes.rend(); ++parent) {
+        auto child = parent->first->mChildren.find(parent->second);
+        if (!child->second->mConfigs.empty() || !child->second->mChildren.empty()) {
+            break;
+        }
+        parent->first->mChildren.erase(child);
+    }
+}
+
+} // namespace logtail
@@ -0,0 +1,82 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "common/Lock.h"
+#include "file_server/FileDiscoveryOptions.h"
+
+namespace logtail {
+
+// Index of file discovery configs by the directories they can match.
+//
+// A config can only match paths under its anchors: the base path for normal configs, the constant prefix of the base
+// path for wildcard configs, and the real base dirs of the containers for container configs. Anchors are kept in a
+// prefix tree of path components, so that the candidates of a path are found by walking the components of the path
+// once, instead of calling FileDiscoveryOptions::IsMatch on every config. Configs without a usable anchor are always
+// returned as candidates.
+class ConfigMatchIndex {
+public:
+    // returns false if the config cannot be indexed, i.e., it may match any path
+    static bool GetAnchors(const FileDiscoveryOptions& opts, std::vector<std::string>& anchors);
+    // whether the path equals the anchor or lies under it
+    static bool IsUnderAnchor(const std::string& anchor, const std::string& path);
+
+    // Add or replace the config. The anchors of both the previous and the new version are appended to affected, so
+    // that only the match results under them need to be invalidated. Returns false if all results are affected.
+    bool Update(const std::string& name, const FileDiscoveryConfig& config, std::vector<std::string>& affected);
+    bool Remove(const std::string& name, std::vector<std::string>& affected);
+    void Clear();
+
+    // Configs which may match the path. IsMatch must still be called on each of them.
+    void FindCandidates(const std::string& path, std::vector<FileDiscoveryConfig>& candidates) const;
+    size_t GetConfigCnt() const;
+
+private:
+    struct Node {
+        std::unordered_map<std::string, std::unique_ptr<Node>> mChildren;
+        std::vector<std::pair<std::string, FileDiscoveryConfig>> mConfigs;
+    };
+
+    struct ConfigItem {
+        FileDiscoveryConfig mConfig;
+        std::vector<std::string> mAnchors;
+        bool mIndexed = true;
+    };
+
+    static void AppendCandidate(const FileDiscoveryConfig& config, std::vector<FileDiscoveryConfig>& candidates);
+
+    void RemoveLocked(const std::string& name, std::vector<std::string>& affected, bool& bounded);
+    void Insert(const std::string& anchor, const std::string& name, const FileDiscoveryConfig& config);
+    void Erase(const std::string& anchor, const std::string& name);
+
+    mutable ReadWriteLock mLock;
+    Node mRoot;
+    std::unordered_map<std::string, ConfigItem> mConfigs;
+    std::vector<std::pair<std::string, FileDiscoveryConfig>> mUnindexedConfigs;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class ConfigMatchIndexUnittest;
+#endif
+};
+
+} // namespace logtail
@@ -174,6 +174,7 @@ bool FileDiscoveryOptions::Init(const Json::Value& config,
     mBasePath = EncodingConverter::GetInstance()->FromUTF8ToACP(mBasePath);
     mFilePattern = EncodingConverter::GetInstance()->FromUTF8ToACP(mFilePattern);
 #endif
+    mFilePatternMatcher = GlobMatcher(mFilePattern);
     size_t len = mBasePath.size();
     if (len > 2 && mBasePath[len - 1] == '*' && mBasePath[len - 2] == '*'
         && mBasePath[len - 3] == filesystem::path::preferred_separator) {
@@ -489,7 +490,7 @@ bool FileDiscoveryOptions::IsFileNameInBlacklist(const string& fileName) const {
 bool FileDiscoveryOptions::IsMatch(const string& path, const string& name) const {
     // Check if the file name is matched or blacklisted.
     if (!name.empty()) {
-        if (fnmatch(mFilePattern.c_str(), name.c_str(), 0) != 0)
+        if (!mFilePatternMatcher.Match(name))
             return false;
         if (IsFileNameInBlacklist(name)) {
             return false;
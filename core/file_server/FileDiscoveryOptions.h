@@ -26,6 +26,7 @@
 #include "json/json.h"
 
 #include "collection_pipeline/CollectionPipelineContext.h"
+#include "common/GlobMatcher.h"
 #include "file_server/ContainerInfo.h"
 
 namespace logtail {
@@ -83,6 +84,7 @@ private:
 
     std::string mBasePath;
     std::string mFilePattern;
+    GlobMatcher mFilePatternMatcher;
     std::vector<std::string> mConstWildcardPaths;
     std::vector<std::string> mWildcardPaths;
     uint16_t mWildcardDepth;
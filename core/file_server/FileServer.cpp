@@ -37,6 +37,7 @@ FileServer::FileServer() {
         mMetricsRecordRef,
         MetricCategory::METRIC_CATEGORY_RUNNER,
         {{METRIC_LABEL_KEY_RUNNER_NAME, METRIC_LABEL_VALUE_RUNNER_NAME_FILE_SERVER}});
+    mConfigUpdatePauseMs = mMetricsRecordRef.CreateHistogram(METRIC_RUNNER_FILE_CONFIG_UPDATE_PAUSE_MS);
 }
 
 // 启动文件服务，包括加载配置、处理检查点、注册事件等
@@ -67,13 +68,14 @@ void FileServer::Start() {
 
 // 暂停文件服务，根据配置更新标志来决定是否要执行相关的清理和保存操作
 void FileServer::Pause(bool isConfigUpdate) {
+    mPauseStartTime = chrono::steady_clock::now();
     PauseInner();
     if (isConfigUpdate) {
         EventDispatcher::GetInstance()->DumpAllHandlersMeta(true);
         CheckPointManager::Instance()->DumpCheckPointToLocal();
         EventDispatcher::GetInstance()->ClearBrokenLinkSet();
         PollingDirFile::GetInstance()->ClearCache();
-        ConfigManager::GetInstance()->ClearFilePipelineMatchCache();
+        // the match cache is invalidated by the changed configs only, see ConfigManager::UpdateFileDiscoveryConfig
     }
 }
 
@@ -114,6 +116,9 @@ void FileServer::Resume(bool isConfigUpdate) {
         PollingModify::GetInstance()->Resume();
         PollingDirFile::GetInstance()->Resume();
     }
+    if (isConfigUpdate) {
+        mConfigUpdatePauseMs->Record(chrono::steady_clock::now() - mPauseStartTime);
+    }
     LOG_INFO(sLogger, ("file server resume", "succeeded"));
 }
 
@@ -138,14 +143,20 @@ FileDiscoveryConfig FileServer::GetFileDiscoveryConfig(const string& name) const
 void FileServer::AddFileDiscoveryConfig(const string& name,
                                         FileDiscoveryOptions* opts,
                                         const CollectionPipelineContext* ctx) {
-    WriteLock lock(mReadWriteLock);
-    mPipelineNameFileDiscoveryConfigsMap[name] = make_pair(opts, ctx);
+    {
+        WriteLock lock(mReadWriteLock);
+        mPipelineNameFileDiscoveryConfigsMap[name] = make_pair(opts, ctx);
+    }
+    ConfigManager::GetInstance()->UpdateFileDiscoveryConfig(name, make_pair(opts, ctx));
 }
 
 // 移除给定名称的文件发现配置
 void FileServer::RemoveFileDiscoveryConfig(const string& name) {
-    WriteLock lock(mReadWriteLock);
-    mPipelineNameFileDiscoveryConfigsMap.erase(name);
+    {
+        WriteLock lock(mReadWriteLock);
+        mPipelineNameFileDiscoveryConfigsMap.erase(name);
+    }
+    ConfigManager::GetInstance()->RemoveFileDiscoveryConfig(name);
 }
 
 // 获取给定名称的文件读取器配置
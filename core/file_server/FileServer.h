@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -108,6 +109,7 @@ private:
     void PauseInner();
 
     mutable ReadWriteLock mReadWriteLock;
+    std::chrono::steady_clock::time_point mPauseStartTime;
 
     std::unordered_map<std::string, FileDiscoveryConfig> mPipelineNameFileDiscoveryConfigsMap;
     std::unordered_map<std::string, FileReaderConfig> mPipelineNameFileReaderConfigsMap;
@@ -119,6 +121,7 @@ private:
     std::unordered_map<std::string, uint32_t> mPipelineNameEOConcurrencyMap;
 
     mutable MetricsRecordRef mMetricsRecordRef;
+    HistogramPtr mConfigUpdatePauseMs;
 };
 
 } // namespace logtail
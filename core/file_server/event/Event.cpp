@@ -0,0 +1,72 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "file_server/event/Event.h"
+
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include "common/Flags.h"
+
+DEFINE_FLAG_INT32(file_event_pool_max_size, "max number of idle file events kept for reuse", 10000);
+
+using namespace std;
+
+namespace logtail {
+
+namespace {
+
+struct EventPool {
+    mutex mMux;
+    vector<void*> mFreeEvents;
+};
+
+EventPool& GetEventPool() {
+    // never destroyed, since events may be deleted by other static objects on exit
+    static auto* sPool = new EventPool;
+    return *sPool;
+}
+
+} // namespace
+
+void* Event::operator new(size_t size) {
+    if (size == sizeof(Event)) {
+        auto& pool = GetEventPool();
+        lock_guard<mutex> lock(pool.mMux);
+        if (!pool.mFreeEvents.empty()) {
+            void* p = pool.mFreeEvents.back();
+            pool.mFreeEvents.pop_back();
+            return p;
+        }
+    }
+    return ::operator new(size);
+}
+
+void Event::operator delete(void* p, size_t size) {
+    if (p == nullptr) {
+        return;
+    }
+    if (size == sizeof(Event)) {
+        auto& pool = GetEventPool();
+        lock_guard<mutex> lock(pool.mMux);
+        if (pool.mFreeEvents.size() < static_cast<size_t>(INT32_FLAG(file_event_pool_max_size))) {
+            pool.mFreeEvents.push_back(p);
+            return;
+        }
+    }
+    ::operator delete(p);
+}
+
+} // namespace logtail
@@ -15,6 +15,7 @@
  */
 
 #pragma once
+#include <stddef.h>
 #include <stdint.h>
 
 #include <string>
@@ -53,6 +54,10 @@ private:
     int64_t mLastFilePos;
 
 public:
+    // events are created and destroyed at a high rate under heavy writes, so their memory is recycled in a pool
+    static void* operator new(size_t size);
+    static void operator delete(void* p, size_t size);
+
     Event(const std::string& source, const std::string& object, EventType type, int wd, uint32_t cookie = 0)
         : mSource(source),
           mObject(object),
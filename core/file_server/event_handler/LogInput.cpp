@@ -90,6 +90,8 @@ void LogInput::Start() {
         = FileServer::GetInstance()->GetMetricsRecordRef().CreateIntGauge(METRIC_RUNNER_FILE_ACTIVE_READERS_TOTAL);
     mEnableFileIncludedByMultiConfigs = FileServer::GetInstance()->GetMetricsRecordRef().CreateIntGauge(
         METRIC_RUNNER_FILE_ENABLE_FILE_INCLUDED_BY_MULTI_CONFIGS_FLAG);
+    mContainerPathUpdateLatencyMs = FileServer::GetInstance()->GetMetricsRecordRef().CreateHistogram(
+        METRIC_RUNNER_FILE_CONTAINER_PATH_UPDATE_LATENCY_MS);
 
     mThreadRes = async(launch::async, &LogInput::ProcessLoop, this);
 }
@@ -376,6 +378,13 @@ void LogInput::ProcessLoop() {
     while (true) {
         ReadLock lock(mAccessMainThreadRWL);
         TryReadEvents(false);
+        // container paths are updated here rather than in TryReadEvents, which may be called within event handling
+        vector<Event*> containerPathEvents;
+        ConfigManager::GetInstance()->ApplyContainerPathUpdates(containerPathEvents,
+                                                                mContainerPathUpdateLatencyMs.get());
+        if (!containerPathEvents.empty()) {
+            PushEventQueue(containerPathEvents);
+        }
         Event* ev = PopEventQueue();
         if (ev != NULL) {
             ++mEventProcessCount;
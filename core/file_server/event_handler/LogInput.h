@@ -86,6 +86,7 @@ private:
     IntGaugePtr mRegisterdHandlersTotal;
     IntGaugePtr mActiveReadersTotal;
     IntGaugePtr mEnableFileIncludedByMultiConfigs;
+    HistogramPtr mContainerPathUpdateLatencyMs;
 
     std::atomic_int mLastReadEventTime{0};
     std::future<void> mThreadRes;
@@ -18,6 +18,10 @@
 #include <sys/ioctl.h>
 #include <unistd.h>
 
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+
 #include "common/ErrorUtil.h"
 #include "common/Flags.h"
 #include "file_server/EventDispatcher.h"
@@ -26,6 +30,9 @@
 #include "monitor/AlarmManager.h"
 
 DEFINE_FLAG_BOOL(fs_events_inotify_enable, "", true);
+DEFINE_FLAG_BOOL(fs_events_inotify_coalesce_modify,
+                 "coalesce repeated modify events of the same file read at once into one",
+                 true);
 
 namespace logtail {
 
@@ -77,6 +84,10 @@ int32_t logtail::EventListener::ReadEvents(std::vector<logtail::Event*>& eventVe
     s_lastHalfEventSize = 0;
     if (BOOL_FLAG(fs_events_inotify_enable)) {
         static EventDispatcher* dispatcher = EventDispatcher::GetInstance();
+        // files with a pending modify event in eventVec, keyed by wd and file name, which points into buffer. Further
+        // modify events of these files are redundant, since one modify event triggers reading to the end of the file.
+        std::unordered_map<int, std::unordered_set<std::string_view>> modifiedFiles;
+        size_t coalescedCnt = 0;
         int n = 0;
         struct inotify_event* event;
         while (n < len) {
@@ -111,6 +122,26 @@ int32_t logtail::EventListener::ReadEvents(std::vector<logtail::Event*>& eventVe
                 etype |= event->mask & IN_MOVED_FROM ? EVENT_MOVE_FROM : 0;
                 etype |= event->mask & IN_MOVED_TO ? EVENT_MOVE_TO : 0;
                 etype |= event->mask & IN_DELETE ? EVENT_DELETE : 0;
+                if (BOOL_FLAG(fs_events_inotify_coalesce_modify) && etype != 0) {
+                    std::string_view name(event->len > 0 ? event->name : "");
+                    if (etype == EVENT_MODIFY) {
+                        if (!modifiedFiles[event->wd].insert(name).second) {
+                            ++coalescedCnt;
+                            n += sizeof(struct inotify_event) + event->len;
+                            continue;
+                        }
+                    } else {
+                        // modify events after other events of the same file must not be merged into earlier ones
+                        auto it = modifiedFiles.find(event->wd);
+                        if (it != modifiedFiles.end()) {
+                            if (name.empty()) {
+                                modifiedFiles.erase(it);
+                            } else {
+                                it->second.erase(name);
+                            }
+                        }
+                    }
+                }
                 std::string path;
                 if (etype != 0 && dispatcher->IsRegistered(event->wd, path))
                     eventVec.push_back(
@@ -118,6 +149,9 @@ int32_t logtail::EventListener::ReadEvents(std::vector<logtail::Event*>& eventVe
             }
             n += sizeof(struct inotify_event) + event->len;
         }
+        if (coalescedCnt > 0) {
+            LOG_DEBUG(sLogger, ("coalesced inotify modify events", coalescedCnt)("remaining events", eventVec.size()));
+        }
     }
     delete[] buffer;
     return (int32_t)eventVec.size();
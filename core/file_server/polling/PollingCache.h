@@ -18,7 +18,7 @@
 #include <ctime>
 
 #include <deque>
-#include <map>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -27,6 +27,26 @@
 
 namespace logtail {
 
+class FileDiscoveryOptions;
+
+// DirListing records entries of a directory which passed the filters of a config, so that
+// the directory needs not to be listed and matched again while it is unchanged.
+struct DirListing {
+    struct Entry {
+        std::string mName;
+        // Same as the flags in PollingDirFile::PollingNormalConfigPath, both are true for symbolic links.
+        bool mNeedCheckDirMatch = true;
+        bool mNeedFindBestMatch = true;
+    };
+
+    std::vector<Entry> mEntries;
+    // The config which filtered the entries, blacklist differs among configs.
+    const FileDiscoveryOptions* mConfig = nullptr;
+    // Modified time of the directory in nanoseconds when it was listed.
+    int64_t mModifyTime = 0;
+    uint64_t mListRound = 0;
+};
+
 struct DirFileCache {
     DirFileCache() {}
     DirFileCache(bool configMatched) : mConfigMatched(configMatched) {}
@@ -50,6 +70,10 @@ struct DirFileCache {
     void SetLastEventTime(int32_t curTime) { mLastEventTime = curTime; }
     int32_t GetLastEventTime() const { return mLastEventTime; }
 
+    // Only used by directories.
+    void SetListing(const std::shared_ptr<const DirListing>& listing) { mListing = listing; }
+    const std::shared_ptr<const DirListing>& GetListing() const { return mListing; }
+
 private:
     // It indicates if the related file/dir has generated event.
     bool mEventFlag = false;
@@ -61,6 +85,7 @@ private:
     uint64_t mLastCheckRound = 0;
     // Last modified time on filesystem in nanoseconds.
     int64_t mLastModifyTime = 0;
+    std::shared_ptr<const DirListing> mListing;
 };
 
 typedef std::unordered_map<std::string, DirFileCache> DirCheckCacheMap;
@@ -86,8 +111,11 @@ struct ModifyCheckCache {
     uint64_t mFileSize;
     timespec mModifyTime;
     int32_t mNotExistTimes;
+    // Rounds skipped before next check, doubled each time the file is found unchanged.
+    uint32_t mBackoffRounds = 0;
+    uint64_t mNextCheckRound = 0;
 };
 
-typedef std::map<SplitedFilePath, ModifyCheckCache> ModifyCheckCacheMap;
+typedef std::unordered_map<SplitedFilePath, ModifyCheckCache, SplitedFilePathHash> ModifyCheckCacheMap;
 
 } // namespace logtail
@@ -59,6 +59,12 @@ DEFINE_FLAG_INT32(polling_max_stat_count, "max stat count in each round", 100000
 DEFINE_FLAG_INT32(polling_max_stat_count_per_dir, "max stat count per dir in each round", 100000);
 DEFINE_FLAG_INT32(polling_max_stat_count_per_config, "max stat count per config in each round", 100000);
 DEFINE_FLAG_INT32(polling_modify_repush_interval, "polling modify event repush interval, seconds", 10);
+DEFINE_FLAG_INT32(polling_dir_file_thread_num,
+                  "number of threads polling directories in parallel, 1 means polling in the polling thread only",
+                  1);
+DEFINE_FLAG_INT32(polling_dir_relist_round,
+                  "rounds to reuse the listing of an unchanged directory, 0 means listing directories every round",
+                  10);
 DECLARE_FLAG_INT32(wildcard_max_sub_dir_count);
 
 using namespace std;
@@ -67,6 +73,14 @@ namespace logtail {
 
 static const int64_t NANO_CONVERTING = 1000000000;
 
+// Container infos are updated within the event loop, so they are copied instead of being iterated during polling.
+static void GetContainerBaseDirs(const FileDiscoveryOptions* config, vector<string>& dirs) {
+    ReadLock lock(ConfigManager::GetInstance()->GetContainerInfoRWL());
+    for (const auto& info : *config->GetContainerInfo()) {
+        dirs.push_back(info.mRealBaseDir);
+    }
+}
+
 void PollingDirFile::Start() {
     ClearCache();
     mPollingDirCacheSize
@@ -74,6 +88,10 @@ void PollingDirFile::Start() {
     mPollingFileCacheSize
         = FileServer::GetInstance()->GetMetricsRecordRef().CreateIntGauge(METRIC_RUNNER_FILE_POLLING_FILE_CACHE_SIZE);
     mRuningFlag = true;
+    if (INT32_FLAG(polling_dir_file_thread_num) > 1) {
+        mWalkerPool = make_unique<ThreadPool>(INT32_FLAG(polling_dir_file_thread_num));
+        mWalkerPool->Start();
+    }
     mThreadPtr = CreateThread([this]() { Polling(); });
 }
 
@@ -86,6 +104,10 @@ void PollingDirFile::Stop() {
             LOG_ERROR(sLogger, ("stop polling dir file thread failed", ToString((int)mThreadPtr->GetState())));
         }
     }
+    if (mWalkerPool) {
+        mWalkerPool->Stop();
+        mWalkerPool.reset();
+    }
     LOG_INFO(sLogger, ("PollingDirFile", "stop"));
 }
 
@@ -106,7 +128,8 @@ void PollingDirFile::Resume() {
 void PollingDirFile::CheckConfigPollingStatCount(const int32_t lastStatCount,
                                                  const FileDiscoveryConfig& config,
                                                  bool isDockerConfig) {
-    auto diffCount = mStatCount - lastStatCount;
+    int32_t statCount = mStatCount;
+    auto diffCount = statCount - lastStatCount;
     if (diffCount <= INT32_FLAG(polling_max_stat_count_per_config))
         return;
 
@@ -116,11 +139,11 @@ void PollingDirFile::CheckConfigPollingStatCount(const int32_t lastStatCount,
     msgBase += "config has exceeded limit";
 
     LOG_WARNING(sLogger,
-                (msgBase, diffCount)(config.first->GetBasePath(), mStatCount)(config.second->GetProjectName(),
-                                                                              config.second->GetLogstoreName()));
+                (msgBase, diffCount)(config.first->GetBasePath(), statCount)(config.second->GetProjectName(),
+                                                                             config.second->GetLogstoreName()));
     AlarmManager::GetInstance()->SendAlarm(STAT_LIMIT_ALARM,
                                            msgBase + ", current count: " + ToString(diffCount) + " total count:"
-                                               + ToString(mStatCount) + " path: " + config.first->GetBasePath(),
+                                               + ToString(statCount) + " path: " + config.first->GetBasePath(),
                                            config.second->GetProjectName(),
                                            config.second->GetLogstoreName(),
                                            config.second->GetRegion());
@@ -191,10 +214,12 @@ void PollingDirFile::PollingIteration() {
                           ("logPath in config not exist", config->GetBasePath())(ctx->GetProjectName(),
                                                                                  ctx->GetLogstoreName()));
             }
+            WaitForPendingDirs();
             CheckConfigPollingStatCount(lastConfigStatCount, *itr, false);
         } else {
-            for (size_t i = 0; i < config->GetContainerInfo()->size(); ++i) {
-                const string& basePath = (*config->GetContainerInfo())[i].mRealBaseDir;
+            vector<string> basePaths;
+            GetContainerBaseDirs(config, basePaths);
+            for (const auto& basePath : basePaths) {
                 fsutil::PathStat baseDirStat;
                 if (!fsutil::PathStat::stat(basePath, baseDirStat)) {
                     LOG_DEBUG(
@@ -208,6 +233,7 @@ void PollingDirFile::PollingIteration() {
                               ("docker logPath in config not exist", basePath)(ctx->GetProjectName(),
                                                                                ctx->GetLogstoreName()));
                 }
+                WaitForPendingDirs();
                 CheckConfigPollingStatCount(lastConfigStatCount, *itr, true);
             }
         }
@@ -229,10 +255,12 @@ void PollingDirFile::PollingIteration() {
                           ("can not find matched path in config, Wildcard begin logPath",
                            config->GetBasePath())(ctx->GetProjectName(), ctx->GetLogstoreName()));
             }
+            WaitForPendingDirs();
             CheckConfigPollingStatCount(lastConfigStatCount, *itr, false);
         } else {
-            for (size_t i = 0; i < config->GetContainerInfo()->size(); ++i) {
-                const string& baseWildcardPath = (*config->GetContainerInfo())[i].mRealBaseDir;
+            vector<string> baseWildcardPaths;
+            GetContainerBaseDirs(config, baseWildcardPaths);
+            for (const auto& baseWildcardPath : baseWildcardPaths) {
                 int32_t lastConfigStatCount = mStatCount;
                 if (!PollingWildcardConfigPath(*itr, baseWildcardPath, 0)) {
                     LOG_DEBUG(sLogger,
@@ -240,6 +268,7 @@ void PollingDirFile::PollingIteration() {
                                "Wildcard begin logPath ",
                                baseWildcardPath)(ctx->GetProjectName(), ctx->GetLogstoreName()));
                 }
+                WaitForPendingDirs();
                 CheckConfigPollingStatCount(lastConfigStatCount, *itr, true);
             }
         }
@@ -307,13 +336,24 @@ bool PollingDirFile::CheckAndUpdateFileMatchCache(const string& fileDir,
 
     bool newFlag = false;
     string filePath = PathJoin(fileDir, fileName);
-    FileCheckCacheMap::iterator iter = mFileCacheMap.find(filePath);
     int32_t curTime = time(NULL);
-    if (iter == mFileCacheMap.end()) {
-        bool matchFlag = needFindBestMatch
-            ? ConfigManager::GetInstance()->FindBestMatch(fileDir, fileName).first != nullptr
-            : true;
+    bool matchFlag = true;
+    if (needFindBestMatch) {
+        bool cached = false;
+        {
+            ScopedSpinLock lock(mCacheLock);
+            cached = mFileCacheMap.find(filePath) != mFileCacheMap.end();
+        }
+        // Matching is costly, do not block other walkers.
+        if (!cached) {
+            ReadLock lock(ConfigManager::GetInstance()->GetContainerInfoRWL());
+            matchFlag = ConfigManager::GetInstance()->FindBestMatch(fileDir, fileName).first != nullptr;
+        }
+    }
 
+    ScopedSpinLock lock(mCacheLock);
+    FileCheckCacheMap::iterator iter = mFileCacheMap.find(filePath);
+    if (iter == mFileCacheMap.end()) {
         DirFileCache& fileCache = mFileCacheMap[filePath];
         fileCache.SetConfigMatched(matchFlag);
         fileCache.SetExceedPreservedDirDepth(exceedPreservedDirDepth);
@@ -403,44 +443,91 @@ bool PollingDirFile::PollingNormalConfigPath(const FileDiscoveryConfig& pConfig,
         return true;
     }
     int32_t nowStatCount = 0;
-    fsutil::Entry ent;
-    while ((ent = dir.ReadNext(false))) {
+    // If the directory is unchanged since last listing, no entry is added, removed or renamed,
+    // so the entries of last listing are checked without reading and matching the directory.
+    auto listing = GetDirListing(pConfig, dirPath, statBuf);
+    bool reuseListing = listing != nullptr;
+    if (!reuseListing) {
+        auto curListing = make_shared<DirListing>();
+        auto listTime = time(nullptr);
+        if (ListDir(pConfig, dirPath, dir, *curListing, nowStatCount)) {
+            int64_t sec = 0, nsec = 0;
+            statBuf.GetLastWriteTime(sec, nsec);
+            // Entries added in the same second as the listing might not update the modified time of
+            // the directory on filesystems with coarse timestamps, so such listing is not reused.
+            if (INT32_FLAG(polling_dir_relist_round) > 0 && listTime - sec > 1) {
+                curListing->mConfig = pConfig.first;
+                curListing->mModifyTime = NANO_CONVERTING * sec + nsec;
+                curListing->mListRound = mCurrentRound;
+                ScopedSpinLock lock(mCacheLock);
+                auto iter = mDirCacheMap.find(dirPath);
+                if (iter != mDirCacheMap.end()) {
+                    iter->second.SetListing(curListing);
+                }
+            }
+        }
+        listing = curListing;
+    }
+
+    for (const auto& entry : listing->mEntries) {
         if (!mRuningFlag || mHoldOnFlag)
             break;
+        // The entries have been counted during listing.
+        if (reuseListing && !IncreaseStatCount(pConfig, dirPath, nowStatCount))
+            break;
 
-        if (++mStatCount % INT32_FLAG(dirfile_stat_count) == 0) {
-            usleep(INT32_FLAG(dirfile_stat_sleep) * 1000);
-        }
+        const string& entName = entry.mName;
+        bool needCheckDirMatch = entry.mNeedCheckDirMatch;
+        bool needFindBestMatch = entry.mNeedFindBestMatch;
 
-        if (mStatCount > INT32_FLAG(polling_max_stat_count)) {
-            LOG_WARNING(sLogger,
-                        ("total dir's polling stat count is exceeded", nowStatCount)(dirPath, mStatCount)(
-                            pConfig.second->GetProjectName(), pConfig.second->GetLogstoreName()));
-            AlarmManager::GetInstance()->SendAlarm(
-                STAT_LIMIT_ALARM,
-                string("total dir's polling stat count is exceeded, now count:") + ToString(nowStatCount)
-                    + " total count:" + ToString(mStatCount) + " path: " + dirPath + " project:"
-                    + pConfig.second->GetProjectName() + " logstore:" + pConfig.second->GetLogstoreName());
-            break;
+        // Mainly for symbolic (Linux), we need to use stat to dig out the real type.
+        fsutil::PathStat buf;
+        if (!dir.Stat(entName, buf)) {
+            LOG_DEBUG(sLogger, ("get file info error", PathJoin(dirPath, entName))("errno", errno));
+            continue;
         }
 
-        if (++nowStatCount > INT32_FLAG(polling_max_stat_count_per_dir)) {
-            LOG_WARNING(sLogger,
-                        ("this dir's polling stat count is exceeded", nowStatCount)(dirPath, mStatCount)(
-                            pConfig.second->GetProjectName(), pConfig.second->GetLogstoreName()));
-            AlarmManager::GetInstance()->SendAlarm(
-                STAT_LIMIT_ALARM,
-                string("this dir's polling stat count is exceeded, now count:") + ToString(nowStatCount)
-                    + " total count:" + ToString(mStatCount) + " path: " + dirPath
-                    + " project:" + pConfig.second->GetProjectName() + " logstore:" + pConfig.second->GetLogstoreName(),
-                pConfig.second->GetRegion());
-            break;
+        // For directory, poll recursively; for file, update cache and add to mNewFileVec so that
+        // it can be pushed to PollingModify at the end of polling.
+        // If needCheckDirMatch or needFindBestMatch is true, that means the item is a symbolic link.
+        // We should check file type again to make sure that the original file which linked by
+        // a symbolic file is DIR or REG.
+        if (buf.IsDir()
+            && (!needCheckDirMatch || !pConfig.first->IsDirectoryInBlacklist(PathJoin(dirPath, entName)))) {
+            PollingSubDir(pConfig, dirPath, entName, buf, depth + 1);
+        } else if (buf.IsRegFile()) {
+            if (CheckAndUpdateFileMatchCache(dirPath, entName, buf, needFindBestMatch, exceedPreservedDirDepth)) {
+                LOG_DEBUG(sLogger, ("add to modify event", entName)("round", mCurrentRound));
+                lock_guard<mutex> lock(mNewFileMux);
+                mNewFileVec.push_back(SplitedFilePath(dirPath, entName));
+            }
+        } else {
+            // Ignore other file type.
+            LOG_DEBUG(sLogger,
+                      ("other type file is linked by a symbolic link, should ignore", PathJoin(dirPath, entName)));
+            continue;
         }
+    }
+
+    return true;
+}
+
+bool PollingDirFile::ListDir(const FileDiscoveryConfig& pConfig,
+                             const string& dirPath,
+                             fsutil::Dir& dir,
+                             DirListing& listing,
+                             int32_t& nowStatCount) {
+    fsutil::Entry ent;
+    while ((ent = dir.ReadNext(false))) {
+        if (!mRuningFlag || mHoldOnFlag)
+            return false;
+
+        if (!IncreaseStatCount(pConfig, dirPath, nowStatCount))
+            return false;
 
         // If the type of item is raw directory or file, use MatchDirPattern or FindBestMatch
         // to check if there are configs that match it.
         auto entName = ent.Name();
-        string item = PathJoin(dirPath, entName);
         bool needCheckDirMatch = true;
         bool needFindBestMatch = true;
         if (ent.IsDir()) {
@@ -448,7 +535,7 @@ bool PollingDirFile::PollingNormalConfigPath(const FileDiscoveryConfig& pConfig,
             // the directory according to cache.
             // TODO: Refactor directory cache, maintain all configs that match the directory.
             needCheckDirMatch = false;
-            if (pConfig.first->IsDirectoryInBlacklist(item)) {
+            if (pConfig.first->IsDirectoryInBlacklist(PathJoin(dirPath, entName))) {
                 continue;
             }
         } else if (ent.IsRegFile()) {
@@ -456,44 +543,129 @@ bool PollingDirFile::PollingNormalConfigPath(const FileDiscoveryConfig& pConfig,
             // and the match flag is false (no config matches it).
             // There is a cache in FindBestMatch, so the overhead is acceptable now.
             needFindBestMatch = false;
+            ReadLock lock(ConfigManager::GetInstance()->GetContainerInfoRWL());
             if (!ConfigManager::GetInstance()->FindBestMatch(dirPath, entName).first) {
                 continue;
             }
         } else {
             // Symbolic link should be passed, while other types file should ignore.
             if (!ent.IsSymbolic()) {
-                LOG_DEBUG(sLogger, ("should ignore, other type file", item.c_str()));
+                LOG_DEBUG(sLogger, ("should ignore, other type file", PathJoin(dirPath, entName)));
                 continue;
             }
         }
+        listing.mEntries.push_back({std::move(entName), needCheckDirMatch, needFindBestMatch});
+    }
+    return true;
+}
 
-        // Mainly for symbolic (Linux), we need to use stat to dig out the real type.
-        fsutil::PathStat buf;
-        if (!fsutil::PathStat::stat(item, buf)) {
-            LOG_DEBUG(sLogger, ("get file info error", item.c_str())("errno", errno));
-            continue;
+shared_ptr<const DirListing> PollingDirFile::GetDirListing(const FileDiscoveryConfig& pConfig,
+                                                           const string& dirPath,
+                                                           const fsutil::PathStat& statBuf) {
+    if (INT32_FLAG(polling_dir_relist_round) <= 0) {
+        return nullptr;
+    }
+    int64_t sec = 0, nsec = 0;
+    statBuf.GetLastWriteTime(sec, nsec);
+    ScopedSpinLock lock(mCacheLock);
+    auto iter = mDirCacheMap.find(dirPath);
+    if (iter == mDirCacheMap.end()) {
+        return nullptr;
+    }
+    const auto& listing = iter->second.GetListing();
+    // List again regularly, in case that the match result of files changes, e.g. containers are updated.
+    if (!listing || listing->mConfig != pConfig.first || listing->mModifyTime != NANO_CONVERTING * sec + nsec
+        || mCurrentRound - listing->mListRound >= static_cast<uint64_t>(INT32_FLAG(polling_dir_relist_round))) {
+        return nullptr;
+    }
+    return listing;
+}
+
+bool PollingDirFile::IncreaseStatCount(const FileDiscoveryConfig& pConfig,
+                                       const string& dirPath,
+                                       int32_t& nowStatCount) {
+    int32_t statCount = ++mStatCount;
+    if (statCount % INT32_FLAG(dirfile_stat_count) == 0) {
+        usleep(INT32_FLAG(dirfile_stat_sleep) * 1000);
+    }
+
+    if (statCount > INT32_FLAG(polling_max_stat_count)) {
+        LOG_WARNING(sLogger,
+                    ("total dir's polling stat count is exceeded", nowStatCount)(dirPath, statCount)(
+                        pConfig.second->GetProjectName(), pConfig.second->GetLogstoreName()));
+        AlarmManager::GetInstance()->SendAlarm(
+            STAT_LIMIT_ALARM,
+            string("total dir's polling stat count is exceeded, now count:") + ToString(nowStatCount)
+                + " total count:" + ToString(statCount) + " path: " + dirPath + " project:"
+                + pConfig.second->GetProjectName() + " logstore:" + pConfig.second->GetLogstoreName());
+        return false;
+    }
+
+    if (++nowStatCount > INT32_FLAG(polling_max_stat_count_per_dir)) {
+        LOG_WARNING(sLogger,
+                    ("this dir's polling stat count is exceeded", nowStatCount)(dirPath, statCount)(
+                        pConfig.second->GetProjectName(), pConfig.second->GetLogstoreName()));
+        AlarmManager::GetInstance()->SendAlarm(
+            STAT_LIMIT_ALARM,
+            string("this dir's polling stat count is exceeded, now count:") + ToString(nowStatCount)
+                + " total count:" + ToString(statCount) + " path: " + dirPath + " project:"
+                + pConfig.second->GetProjectName() + " logstore:" + pConfig.second->GetLogstoreName(),
+            pConfig.second->GetRegion());
+        return false;
+    }
+    return true;
+}
+
+void PollingDirFile::PollingSubDir(const FileDiscoveryConfig& pConfig,
+                                   const string& srcPath,
+                                   const string& obj,
+                                   const fsutil::PathStat& statBuf,
+                                   int depth) {
+    if (!mWalkerPool) {
+        PollingNormalConfigPath(pConfig, srcPath, obj, statBuf, depth);
+        return;
+    }
+    {
+        lock_guard<mutex> lock(mPendingDirMux);
+        mPendingDirs.emplace_back([this, pConfig, srcPath, obj, statBuf, depth]() {
+            PollingNormalConfigPath(pConfig, srcPath, obj, statBuf, depth);
+        });
+        ++mPendingDirCnt;
+    }
+    mPendingDirCV.notify_all();
+    mWalkerPool->Add([this]() { RunPendingDir(); });
+}
+
+bool PollingDirFile::RunPendingDir() {
+    function<void()> task;
+    {
+        lock_guard<mutex> lock(mPendingDirMux);
+        if (mPendingDirs.empty()) {
+            return false;
         }
+        task = std::move(mPendingDirs.front());
+        mPendingDirs.pop_front();
+    }
+    task();
+    lock_guard<mutex> lock(mPendingDirMux);
+    if (--mPendingDirCnt == 0) {
+        mPendingDirCV.notify_all();
+    }
+    return true;
+}
 
-        // For directory, poll recursively; for file, update cache and add to mNewFileVec so that
-        // it can be pushed to PollingModify at the end of polling.
-        // If needCheckDirMatch or needFindBestMatch is true, that means the item is a symbolic link.
-        // We should check file type again to make sure that the original file which linked by
-        // a symbolic file is DIR or REG.
-        if (buf.IsDir() && (!needCheckDirMatch || !pConfig.first->IsDirectoryInBlacklist(item))) {
-            PollingNormalConfigPath(pConfig, dirPath, entName, buf, depth + 1);
-        } else if (buf.IsRegFile()) {
-            if (CheckAndUpdateFileMatchCache(dirPath, entName, buf, needFindBestMatch, exceedPreservedDirDepth)) {
-                LOG_DEBUG(sLogger, ("add to modify event", entName)("round", mCurrentRound));
-                mNewFileVec.push_back(SplitedFilePath(dirPath, entName));
-            }
-        } else {
-            // Ignore other file type.
-            LOG_DEBUG(sLogger, ("other type file is linked by a symbolic link, should ignore", item.c_str()));
+void PollingDirFile::WaitForPendingDirs() {
+    unique_lock<mutex> lock(mPendingDirMux);
+    while (mPendingDirCnt > 0) {
+        if (mPendingDirs.empty()) {
+            // all are being polled by walkers, which may queue more subdirectories
+            mPendingDirCV.wait(lock);
             continue;
         }
+        lock.unlock();
+        RunPendingDir();
+        lock.lock();
     }
-
-    return true;
 }
 
 // PollingWildcardConfigPath will iterate mWildcardPaths one by one, and according to
@@ -587,16 +759,17 @@ bool PollingDirFile::PollingWildcardConfigPath(const FileDiscoveryConfig& pConfi
             break;
         }
 
-        if (++mStatCount % INT32_FLAG(dirfile_stat_count) == 0)
+        int32_t statCount = ++mStatCount;
+        if (statCount % INT32_FLAG(dirfile_stat_count) == 0)
             usleep(INT32_FLAG(dirfile_stat_sleep) * 1000);
 
-        if (mStatCount > INT32_FLAG(polling_max_stat_count)) {
+        if (statCount > INT32_FLAG(polling_max_stat_count)) {
             LOG_WARNING(sLogger,
                         ("total dir's polling stat count is exceeded",
-                         "")(dirPath, mStatCount)(pConfig.second->GetProjectName(), pConfig.second->GetLogstoreName()));
+                         "")(dirPath, statCount)(pConfig.second->GetProjectName(), pConfig.second->GetLogstoreName()));
             AlarmManager::GetInstance()->SendAlarm(
                 STAT_LIMIT_ALARM,
-                string("total dir's polling stat count is exceeded, total count:" + ToString(mStatCount)
+                string("total dir's polling stat count is exceeded, total count:" + ToString(statCount)
                        + " path: " + dirPath + " project:" + pConfig.second->GetProjectName()
                        + " logstore:" + pConfig.second->GetLogstoreName()));
             break;
@@ -15,11 +15,18 @@
  */
 
 #pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
 #include <map>
+#include <memory>
+#include <mutex>
 
 #include "common/Lock.h"
 #include "common/LogRunnable.h"
 #include "common/Thread.h"
+#include "common/ThreadPool.h"
 #include "file_server/FileDiscoveryOptions.h"
 #include "file_server/polling/PollingCache.h"
 #include "monitor/Monitor.h"
@@ -27,6 +34,7 @@
 namespace logtail {
 
 namespace fsutil {
+class Dir;
 class PathStat;
 }
 
@@ -73,6 +81,37 @@ private:
                                  const fsutil::PathStat& statBuf,
                                  int depth);
 
+    // PollingSubDir polls the subdirectory with PollingNormalConfigPath, on the walker
+    // pool if it is enabled (flag polling_dir_file_thread_num), otherwise in place.
+    void PollingSubDir(const FileDiscoveryConfig& config,
+                       const std::string& srcPath,
+                       const std::string& obj,
+                       const fsutil::PathStat& statBuf,
+                       int depth);
+    // RunPendingDir polls one queued subdirectory, if any.
+    // @return false if no subdirectory is queued.
+    bool RunPendingDir();
+    // WaitForPendingDirs polls queued subdirectories in place until all submitted ones are polled,
+    //   so that it only waits for those being polled by walkers.
+    void WaitForPendingDirs();
+
+    // ListDir lists entries of @dirPath which pass the filters of @config.
+    // @return false if the listing is incomplete because polling is stopped or the stat count
+    //   exceeds limit, the listed entries should still be checked.
+    bool ListDir(const FileDiscoveryConfig& config,
+                 const std::string& dirPath,
+                 fsutil::Dir& dir,
+                 DirListing& listing,
+                 int32_t& nowStatCount);
+    // GetDirListing returns the listing of last round if the directory is unchanged since then, otherwise null.
+    std::shared_ptr<const DirListing> GetDirListing(const FileDiscoveryConfig& config,
+                                                    const std::string& dirPath,
+                                                    const fsutil::PathStat& statBuf);
+
+    // IncreaseStatCount counts an entry checked in @dirPath.
+    // @return false if the stat count exceeds limit, and the caller should stop checking the directory.
+    bool IncreaseStatCount(const FileDiscoveryConfig& config, const std::string& dirPath, int32_t& nowStatCount);
+
     // PollingWildcardConfigPath polls config with wildcard base path recursively.
     // It will use PollingNormalConfigPath to poll if the path becomes normal.
     // @return true if at least one directory was found during polling.
@@ -134,9 +173,20 @@ private:
     FileCheckCacheMap mFileCacheMap;
 
     // Record how much times stat is called, if it exceeds limit, stop polling.
-    int32_t mStatCount;
+    std::atomic_int32_t mStatCount;
     // Record new files found in current round, will be pushed to PollingModify.
+    std::mutex mNewFileMux;
     std::vector<SplitedFilePath> mNewFileVec;
+
+    // Walkers polling subdirectories in parallel, null if polling in the polling thread only.
+    std::unique_ptr<ThreadPool> mWalkerPool;
+    // Subdirectories are queued here and the pool is only asked to poll one of them, so that those dropped by a
+    // stopped pool are still polled by the polling thread.
+    std::mutex mPendingDirMux;
+    std::condition_variable mPendingDirCV;
+    std::deque<std::function<void()>> mPendingDirs;
+    // number of queued and being polled subdirectories
+    size_t mPendingDirCnt = 0;
     // The sequence number of current round, uint64_t is used to avoid overflow.
     uint64_t mCurrentRound;
 
@@ -145,6 +195,8 @@ private:
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class PollingUnittest;
+    friend class PollingDirFileUnittest;
+    friend class PollingDirFileBenchmark;
 #endif
 };
 
@@ -20,6 +20,10 @@
 #endif
 #include <sys/stat.h>
 
+#include <atomic>
+#include <chrono>
+#include <future>
+
 #include "common/FileSystemUtil.h"
 #include "common/Flags.h"
 #include "common/StringTools.h"
@@ -38,9 +42,18 @@ DEFINE_FLAG_INT32(modify_stat_count, "sleep when dir file stat count up to", 100
 DEFINE_FLAG_INT32(modify_stat_sleepMs, "sleep time when dir file stat up to 1000, ms", 10);
 DEFINE_FLAG_INT32(modify_cache_max, "max modify chache size, if exceed, delete 0.2 oldest", 100000);
 DEFINE_FLAG_INT32(modify_cache_make_space_interval, "second", 600);
+DEFINE_FLAG_INT32(polling_modify_thread_num,
+                  "number of threads stating files in parallel, 1 means stating in the polling thread only",
+                  1);
+DEFINE_FLAG_INT32(polling_modify_max_backoff_round,
+                  "max rounds to skip checking unchanged files, 0 means checking all files every round",
+                  4);
 
 namespace logtail {
 
+// Sweeping fewer files is not worth the synchronization.
+static const size_t MIN_FILES_PER_SWEEPER = 100;
+
 PollingModify::PollingModify() {
 }
 
@@ -51,8 +64,16 @@ void PollingModify::Start() {
     ClearCache();
     mPollingModifySize
         = FileServer::GetInstance()->GetMetricsRecordRef().CreateIntGauge(METRIC_RUNNER_FILE_POLLING_MODIFY_CACHE_SIZE);
+    mPollingModifyCycleTimeMs = FileServer::GetInstance()->GetMetricsRecordRef().CreateHistogram(
+        METRIC_RUNNER_FILE_POLLING_MODIFY_CYCLE_TIME_MS);
+    mPollingModifyCheckedFilesTotal = FileServer::GetInstance()->GetMetricsRecordRef().CreateCounter(
+        METRIC_RUNNER_FILE_POLLING_MODIFY_CHECKED_FILES_TOTAL);
 
     mRuningFlag = true;
+    if (INT32_FLAG(polling_modify_thread_num) > 1) {
+        mSweeperPool = make_unique<ThreadPool>(INT32_FLAG(polling_modify_thread_num) - 1);
+        mSweeperPool->Start();
+    }
     mThreadPtr = CreateThread([this]() { Polling(); });
 }
 
@@ -65,6 +86,10 @@ void PollingModify::Stop() {
             LOG_ERROR(sLogger, ("stop polling modify thread failed", ToString((int)mThreadPtr->GetState())));
         }
     }
+    if (mSweeperPool) {
+        mSweeperPool->Stop();
+        mSweeperPool.reset();
+    }
     LOG_INFO(sLogger, ("PollingModify", "stop"));
 }
 
@@ -258,22 +283,90 @@ void PollingModify::Polling() {
 void PollingModify::PollingIteration() {
     PTScopedLock threadLock(mPollingThreadLock);
     LoadFileNameInQueues();
+    ++mCurrentRound;
+    auto startTime = chrono::steady_clock::now();
+
+    vector<ModifyCheckCacheMap::value_type*> dueFiles;
+    dueFiles.reserve(mModifyCacheMap.size());
+    for (auto& item : mModifyCacheMap) {
+        if (item.second.mNextCheckRound <= mCurrentRound) {
+            dueFiles.push_back(&item);
+        }
+    }
+    mPollingModifySize->Set(mModifyCacheMap.size());
+
+    // Split due files into contiguous ranges, the polling thread sweeps the first one.
+    size_t sweeperCnt = mSweeperPool ? static_cast<size_t>(INT32_FLAG(polling_modify_thread_num)) : 1;
+    sweeperCnt = min(sweeperCnt, max(static_cast<size_t>(1), dueFiles.size() / MIN_FILES_PER_SWEEPER));
+    size_t rangeSize = (dueFiles.size() + sweeperCnt - 1) / sweeperCnt;
+    vector<vector<Event*>> eventVecs(sweeperCnt);
+    vector<vector<SplitedFilePath>> deletedFileVecs(sweeperCnt);
+    vector<size_t> checkedCnts(sweeperCnt, 0);
+    auto sweepRange = [&](size_t i) {
+        size_t begin = min(dueFiles.size(), i * rangeSize);
+        size_t end = min(dueFiles.size(), begin + rangeSize);
+        checkedCnts[i] = SweepFiles(dueFiles, begin, end, eventVecs[i], deletedFileVecs[i]);
+    };
+    // A range is swept by whoever claims it first. Tasks are dropped once the pool is stopped, and a stale task left
+    // in the queue only finds its range claimed, so it never touches this round's locals.
+    vector<shared_ptr<atomic_bool>> claimed(sweeperCnt);
+    vector<future<void>> sweeperRes(sweeperCnt);
+    for (size_t i = 1; i < sweeperCnt; ++i) {
+        claimed[i] = make_shared<atomic_bool>(false);
+        auto done = make_shared<promise<void>>();
+        sweeperRes[i] = done->get_future();
+        mSweeperPool->Add([claim = claimed[i], done, &sweepRange, i]() {
+            if (!claim->exchange(true)) {
+                sweepRange(i);
+                done->set_value();
+            }
+        });
+    }
+    sweepRange(0);
+    // ranges not picked up by the sweepers yet are swept by the polling thread, so only running tasks are waited for
+    for (size_t i = 1; i < sweeperCnt; ++i) {
+        if (!claimed[i]->exchange(true)) {
+            sweepRange(i);
+        } else {
+            sweeperRes[i].wait();
+        }
+    }
 
-    vector<SplitedFilePath> deletedFileVec;
+    size_t checkedCnt = 0;
     vector<Event*> pollingEventVec;
-    int32_t statCount = 0;
-    mPollingModifySize->Set(mModifyCacheMap.size());
-    for (auto iter = mModifyCacheMap.begin(); iter != mModifyCacheMap.end(); ++iter) {
+    for (size_t i = 0; i < sweeperCnt; ++i) {
+        checkedCnt += checkedCnts[i];
+        pollingEventVec.insert(pollingEventVec.end(), eventVecs[i].begin(), eventVecs[i].end());
+        for (const auto& filePath : deletedFileVecs[i]) {
+            mModifyCacheMap.erase(filePath);
+        }
+    }
+    if (pollingEventVec.size() > 0) {
+        PollingEventQueue::GetInstance()->PushEvent(pollingEventVec);
+    }
+    mPollingModifyCheckedFilesTotal->Add(checkedCnt);
+    mPollingModifyCycleTimeMs->Record(chrono::steady_clock::now() - startTime);
+}
+
+size_t PollingModify::SweepFiles(const vector<ModifyCheckCacheMap::value_type*>& files,
+                                 size_t begin,
+                                 size_t end,
+                                 vector<Event*>& eventVec,
+                                 vector<SplitedFilePath>& deletedFileVec) {
+    size_t statCount = 0;
+    for (size_t i = begin; i < end; ++i) {
         if (!mRuningFlag || mHoldOnFlag)
             break;
 
-        const SplitedFilePath& filePath = iter->first;
-        ModifyCheckCache& modifyCache = iter->second;
+        const SplitedFilePath& filePath = files[i]->first;
+        ModifyCheckCache& modifyCache = files[i]->second;
+        // Files failed to stat are checked every round, so that deletion is detected in time.
+        bool changed = true;
         fsutil::PathStat logFileStat;
         if (!fsutil::PathStat::stat(PathJoin(filePath.mFileDir, filePath.mFileName), logFileStat)) {
             if (errno == ENOENT) {
                 LOG_DEBUG(sLogger, ("file deleted", PathJoin(filePath.mFileDir, filePath.mFileName)));
-                if (UpdateDeletedFile(filePath, modifyCache, pollingEventVec)) {
+                if (UpdateDeletedFile(filePath, modifyCache, eventVec)) {
                     deletedFileVec.push_back(filePath);
                 }
             } else {
@@ -284,22 +377,27 @@ void PollingModify::PollingIteration() {
             logFileStat.GetLastWriteTime(sec, nsec);
             timespec mtim{sec, nsec};
             auto devInode = logFileStat.GetDevInode();
-            UpdateFile(
-                filePath, modifyCache, devInode.dev, devInode.inode, logFileStat.GetFileSize(), mtim, pollingEventVec);
+            changed = UpdateFile(
+                filePath, modifyCache, devInode.dev, devInode.inode, logFileStat.GetFileSize(), mtim, eventVec);
         }
+        ScheduleNextCheck(modifyCache, changed);
 
         ++statCount;
         if (statCount % INT32_FLAG(modify_stat_count) == 0) {
             usleep(1000 * INT32_FLAG(modify_stat_sleepMs));
         }
     }
+    return statCount;
+}
 
-    if (pollingEventVec.size() > 0) {
-        PollingEventQueue::GetInstance()->PushEvent(pollingEventVec);
-    }
-    for (size_t i = 0; i < deletedFileVec.size(); ++i) {
-        mModifyCacheMap.erase(deletedFileVec[i]);
+void PollingModify::ScheduleNextCheck(ModifyCheckCache& modifyCache, bool changed) {
+    if (changed) {
+        modifyCache.mBackoffRounds = 0;
+    } else {
+        modifyCache.mBackoffRounds = min(max(modifyCache.mBackoffRounds * 2, 1U),
+                                         static_cast<uint32_t>(max(INT32_FLAG(polling_modify_max_backoff_round), 0)));
     }
+    modifyCache.mNextCheckRound = mCurrentRound + modifyCache.mBackoffRounds + 1;
 }
 
 #ifdef APSARA_UNIT_TEST_MAIN
@@ -17,11 +17,13 @@
 #pragma once
 #include <deque>
 #include <map>
+#include <memory>
 #include <vector>
 
 #include "common/Lock.h"
 #include "common/LogRunnable.h"
 #include "common/Thread.h"
+#include "common/ThreadPool.h"
 #include "file_server/polling/PollingCache.h"
 #ifdef APSARA_UINT_TEST_MAIN
 #include "common/SplitedFilePath.h"
@@ -88,6 +90,19 @@ private:
     bool
     UpdateDeletedFile(const SplitedFilePath& filePath, ModifyCheckCache& modifyCache, std::vector<Event*>& eventVec);
 
+    // SweepFiles stats files in [@begin, @end) of @files and updates their caches. Sweepers run it
+    // in parallel on disjoint ranges, so that it only touches the caches in the range.
+    // @return the number of files checked.
+    size_t SweepFiles(const std::vector<ModifyCheckCacheMap::value_type*>& files,
+                      size_t begin,
+                      size_t end,
+                      std::vector<Event*>& eventVec,
+                      std::vector<SplitedFilePath>& deletedFileVec);
+
+    // ScheduleNextCheck decides when to check the file again. Files found changed are checked
+    // every round, while unchanged ones are checked with exponential backoff.
+    void ScheduleNextCheck(ModifyCheckCache& modifyCache, bool changed);
+
 private:
     PTMutex mPollingThreadLock;
     volatile bool mRuningFlag;
@@ -101,11 +116,19 @@ private:
     std::deque<SplitedFilePath> mDeletedFileNameQueue;
 
     ModifyCheckCacheMap mModifyCacheMap;
+    // The sequence number of current round, uint64_t is used to avoid overflow.
+    uint64_t mCurrentRound = 0;
+
+    // Sweepers stating files in parallel, null if stating in the polling thread only.
+    std::unique_ptr<ThreadPool> mSweeperPool;
 
     IntGaugePtr mPollingModifySize;
+    HistogramPtr mPollingModifyCycleTimeMs;
+    CounterPtr mPollingModifyCheckedFilesTotal;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class PollingUnittest;
+    friend class PollingModifyUnittest;
     bool FindNewFile(const std::string& dir, const std::string& fileName);
 #endif
 };
@@ -77,6 +77,14 @@ DEFINE_FLAG_INT32(max_fix_pos_bytes, "", 128 * 1024);
 DEFINE_FLAG_INT32(force_release_deleted_file_fd_timeout,
                   "force release fd if file is deleted after specified seconds, no matter read to end or not",
                   -1);
+DEFINE_FLAG_BOOL(enable_reader_adaptive_read_size,
+                 "enlarge the read size of files with a large backlog or a high append rate",
+                 true);
+DEFINE_FLAG_INT32(reader_max_read_buffer_size_kb, "max size of one read when the read size is enlarged, in KB", 4096);
+DEFINE_FLAG_INT32(reader_large_backlog_threshold_kb,
+                  "backlog or append rate per second above which the read size of a file is enlarged, in KB",
+                  2048);
+DEFINE_FLAG_BOOL(enable_reader_read_ahead, "advise the kernel to read ahead files with a large backlog", true);
 #if defined(_MSC_VER)
 // On Windows, if Chinese config base path is used, the log path will be converted to GBK,
 // so the __tag__.__path__ have to be converted back to UTF8 to avoid bad display.
@@ -228,6 +236,7 @@ void LogFileReader::SetMetrics() {
     mOutSizeBytes = mMetricsRecordRef->GetCounter(METRIC_PLUGIN_OUT_SIZE_BYTES);
     mSourceSizeBytes = mMetricsRecordRef->GetIntGauge(METRIC_PLUGIN_SOURCE_SIZE_BYTES);
     mSourceReadOffsetBytes = mMetricsRecordRef->GetIntGauge(METRIC_PLUGIN_SOURCE_READ_OFFSET_BYTES);
+    mSourceLagBytes = mMetricsRecordRef->GetIntGauge(METRIC_PLUGIN_SOURCE_LAG_BYTES);
     mMetricInited = true;
 }
 
@@ -1553,12 +1562,65 @@ size_t LogFileReader::getNextReadSize(int64_t fileEnd, bool& fromCpt) {
         readSize = checkpoint.read_length();
         LOG_INFO(sLogger, ("read specified length", readSize)("offset", mLastFilePos));
     }
-    if (readSize > BUFFER_SIZE && !allowMoreBufferSize) {
-        readSize = BUFFER_SIZE;
+    updateReadSizeLimit(fileEnd);
+    if (readSize > mReadSizeLimit && !allowMoreBufferSize) {
+        readSize = mReadSizeLimit;
     }
     return readSize;
 }
 
+void LogFileReader::updateReadSizeLimit(int64_t fileEnd) {
+    auto now = chrono::steady_clock::now();
+    if (mAppendRateFileSize < 0 || fileEnd < mAppendRateFileSize) {
+        mAppendRate = 0.0;
+        mAppendRateFileSize = fileEnd;
+        mAppendRateTime = now;
+    } else {
+        // sampled at most once per second, so that the rate is not skewed by reads in quick succession
+        double elapsed = chrono::duration<double>(now - mAppendRateTime).count();
+        if (elapsed >= 1.0) {
+            double rate = (fileEnd - mAppendRateFileSize) / elapsed;
+            mAppendRate = (mAppendRate + rate) / 2;
+            mAppendRateFileSize = fileEnd;
+            mAppendRateTime = now;
+        }
+    }
+
+    int64_t backlog = fileEnd - mLastFilePos;
+    int64_t threshold = static_cast<int64_t>(INT32_FLAG(reader_large_backlog_threshold_kb)) * 1024;
+    // container log parsers merge partial lines into buffers of BUFFER_SIZE, and GBK files are split before being
+    // converted, so the read size of them cannot be enlarged
+    if (!BOOL_FLAG(enable_reader_adaptive_read_size)
+        || mReaderConfig.first->mInputType == FileReaderOptions::InputType::InputContainerStdio
+        || mReaderConfig.first->mFileEncoding == FileReaderOptions::Encoding::GBK
+        || (backlog < threshold && mAppendRate < threshold)) {
+        mReadSizeLimit = BUFFER_SIZE;
+        return;
+    }
+    size_t maxSize = max(BUFFER_SIZE, static_cast<size_t>(INT32_FLAG(reader_max_read_buffer_size_kb)) * 1024);
+    // grow geometrically while the file stays behind, and fall back at once when it catches up
+    mReadSizeLimit = min(maxSize, max(BUFFER_SIZE, mReadSizeLimit * 2));
+    if (BOOL_FLAG(enable_reader_read_ahead) && backlog >= threshold) {
+        mLogFileOp.AdviseSequentialRead(GetLastReadPos(), min(backlog, static_cast<int64_t>(mReadSizeLimit) * 2));
+    }
+}
+
+size_t LogFileReader::removeLastIncompleteLogInBlocks(char* buffer, size_t size, bool& longLogFound) {
+    int32_t rollbackLineFeedCount = 0;
+    size_t pos = 0;
+    longLogFound = false;
+    while (size - pos > BUFFER_SIZE) {
+        size_t blockSize = AlignLastCharacter(buffer + pos, BUFFER_SIZE);
+        size_t logSize = RemoveLastIncompleteLog(buffer + pos, blockSize, rollbackLineFeedCount);
+        if (logSize == 0) {
+            longLogFound = true;
+            return pos;
+        }
+        pos += logSize;
+    }
+    return pos + RemoveLastIncompleteLog(buffer + pos, size - pos, rollbackLineFeedCount);
+}
+
 void LogFileReader::setExactlyOnceCheckpointAfterRead(size_t readSize) {
     if (!mEOOption || readSize == 0) {
         return;
@@ -1640,12 +1702,23 @@ void LogFileReader::ReadUTF8(LogBuffer& logBuffer, int64_t end, bool& moreData,
         logBuffer.truncateInfo.reset(truncateInfo);
         lastReadPos = mLastFilePos + nbytes; // this doesn't seem right when ulogfs is used and a hole is skipped
         LOG_DEBUG(sLogger, ("read bytes", nbytes)("last read pos", lastReadPos));
-        moreData = (nbytes == BUFFER_SIZE);
+        moreData = (nbytes == mReadSizeLimit);
         auto alignedBytes = nbytes;
         if (allowRollback) {
             alignedBytes = AlignLastCharacter(stringBuffer, nbytes);
         }
-        if (allowRollback || mReaderConfig.second->RequiringJsonReader()) {
+        bool longLogFound = false;
+        if (allowRollback && alignedBytes > BUFFER_SIZE) {
+            nbytes = removeLastIncompleteLogInBlocks(stringBuffer, alignedBytes, longLogFound);
+            if (longLogFound) {
+                // the log longer than BUFFER_SIZE is split at BUFFER_SIZE, and the rest is read again from the file
+                // rather than cached, as if only BUFFER_SIZE were read
+                moreData = true;
+                if (nbytes == 0) {
+                    alignedBytes = AlignLastCharacter(stringBuffer, BUFFER_SIZE);
+                }
+            }
+        } else if (allowRollback || mReaderConfig.second->RequiringJsonReader()) {
             int32_t rollbackLineFeedCount;
             nbytes = RemoveLastIncompleteLog(stringBuffer, alignedBytes, rollbackLineFeedCount, allowRollback);
         }
@@ -1673,7 +1746,7 @@ void LogFileReader::ReadUTF8(LogBuffer& logBuffer, int64_t end, bool& moreData,
                 return;
             }
         }
-        if (nbytes < stringBufferLen) {
+        if (nbytes < stringBufferLen && !longLogFound) {
             // rollback happend, put rollbacked part in cache
             mCache.assign(stringBuffer + nbytes, stringBufferLen - nbytes);
         } else {
@@ -1770,7 +1843,7 @@ void LogFileReader::ReadGBK(LogBuffer& logBuffer, int64_t end, bool& moreData, b
         logBuffer.truncateInfo.reset(truncateInfo);
         lastReadPos = mLastFilePos + readCharCount;
         originReadCount = readCharCount;
-        moreData = (readCharCount == BUFFER_SIZE);
+        moreData = (readCharCount == mReadSizeLimit);
         auto alignedBytes = readCharCount;
         if (allowRollback) {
             alignedBytes = AlignLastCharacter(gbkBuffer, readCharCount);
@@ -2150,6 +2223,7 @@ void LogFileReader::ReportMetrics(uint64_t readSize) {
         mOutSizeBytes->Add(readSize);
         mSourceReadOffsetBytes->Set(GetLastFilePos());
         mSourceSizeBytes->Set(GetFileSize());
+        mSourceLagBytes->Set(GetFileSize() > GetLastFilePos() ? GetFileSize() - GetLastFilePos() : 0);
     }
 }
 
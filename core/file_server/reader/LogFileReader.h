@@ -17,6 +17,7 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <deque>
 #include <string>
 #include <unordered_map>
@@ -508,6 +509,12 @@ protected:
     // boost::regex* mLogEndRegPtr;
     // int mReaderFlushTimeout;
     bool mLastForceRead = false;
+    // max size of the next read, enlarged when the file falls behind
+    size_t mReadSizeLimit = 0;
+    // append rate of the file, in bytes per second
+    double mAppendRate = 0.0;
+    int64_t mAppendRateFileSize = -1;
+    std::chrono::steady_clock::time_point mAppendRateTime;
     // FileEncoding mFileEncoding;
     // bool mDiscardUnmatch;
     // LogType mLogType;
@@ -569,6 +576,7 @@ protected:
     CounterPtr mOutSizeBytes;
     IntGaugePtr mSourceSizeBytes;
     IntGaugePtr mSourceReadOffsetBytes;
+    IntGaugePtr mSourceLagBytes;
 
 private:
     bool mHasReadContainerBom = false;
@@ -624,6 +632,19 @@ private:
     // @param fromCpt: if the read size is recoveried from checkpoint, set it to true.
     size_t getNextReadSize(int64_t fileEnd, bool& fromCpt);
 
+    // Update mReadSizeLimit before each read. Files which fall behind, either with a large backlog or a high append
+    // rate, are read in larger blocks, up to reader_max_read_buffer_size_kb, so that they are split into fewer groups
+    // and rolled back fewer times. Other files are read in blocks of at most BUFFER_SIZE.
+    void updateReadSizeLimit(int64_t fileEnd);
+
+    // RemoveLastIncompleteLog for reads larger than BUFFER_SIZE. The buffer is split into logs as if the file were read
+    // in blocks of BUFFER_SIZE, so that logs longer than BUFFER_SIZE are still split at BUFFER_SIZE whatever the read
+    // size is.
+    //
+    // @return the size of the complete logs before the last incomplete log or before the first log longer than
+    // BUFFER_SIZE, in which case @longLogFound is set to true.
+    size_t removeLastIncompleteLogInBlocks(char* buffer, size_t size, bool& longLogFound);
+
     LineInfo GetLastLine(StringView buffer, int32_t end, bool needSingleLine = false);
 
     // Update current checkpoint's read offset and length after success read.
@@ -239,9 +239,11 @@ int LogtailPlugin::SendPbV2(const char* configName,
     static FlusherSLS* profileConfig = &(LogtailPlugin::GetInstance()->mPluginProfileConfig);
     static FlusherSLS* containerConfig = &(LogtailPlugin::GetInstance()->mPluginContainerConfig);
 
-    string configNameStr = string(configName, configNameSize);
-
-    string logstore;
+    // called for every log group flushed by Go pipelines, reuse the buffers to avoid allocation
+    static thread_local string configNameStr;
+    static thread_local string logstore;
+    configNameStr.assign(configName, configNameSize);
+    logstore.clear();
     if (logstoreSize > 0 && logstoreName != NULL) {
         logstore.assign(logstoreName, (size_t)logstoreSize);
     }
@@ -461,6 +463,13 @@ bool LogtailPlugin::LoadPluginBase() {
             LOG_ERROR(sLogger, ("load ProcessLogGroup error, Message", error));
             return mPluginValid;
         }
+        // C++批量传递数据到golang插件，旧版本插件不支持
+        mProcessLogGroupsFun = (ProcessLogGroupsFun)loader.LoadMethod("ProcessLogGroups", error);
+        if (!error.empty()) {
+            LOG_WARNING(sLogger, ("load ProcessLogGroups failed", error)("fall back to", "ProcessLogGroup"));
+            mProcessLogGroupsFun = NULL;
+            error.clear();
+        }
         // 获取golang部分指标信息
         mGetGoMetricsFun = (GetGoMetricsFun)loader.LoadMethod("GetGoMetrics", error);
         if (!error.empty()) {
@@ -553,6 +562,82 @@ void LogtailPlugin::ProcessLogGroup(const std::string& configName,
 #endif
 }
 
+void LogtailPlugin::ProcessLogGroups(const std::string& configName, const std::string& batch) {
+#ifndef APSARA_UNIT_TEST_MAIN
+    if (batch.empty() || !(mPluginValid && mProcessLogGroupFun != NULL)) {
+        return;
+    }
+    std::string realConfigName = configName + "/2";
+    GoString goConfigName;
+    goConfigName.n = realConfigName.size();
+    goConfigName.p = realConfigName.c_str();
+    if (mProcessLogGroupsFun != NULL) {
+        GoSlice goBatch;
+        goBatch.len = goBatch.cap = batch.size();
+        goBatch.data = (void*)batch.data();
+        GoInt rst = mProcessLogGroupsFun(goConfigName, goBatch);
+        if (rst != (GoInt)0) {
+            LOG_WARNING(sLogger, ("process loggroups error", configName)("result", rst));
+        }
+        return;
+    }
+
+    std::vector<std::pair<StringView, StringView>> groups;
+    if (!ParseLogGroupBatch(batch, groups)) {
+        LOG_ERROR(sLogger, ("invalid loggroup batch", "discard data")("config", configName));
+        return;
+    }
+    for (const auto& group : groups) {
+        GoSlice goLog;
+        GoString goPackId;
+        goPackId.n = group.first.size();
+        goPackId.p = group.first.data();
+        goLog.len = goLog.cap = group.second.size();
+        goLog.data = (void*)group.second.data();
+        GoInt rst = mProcessLogGroupFun(goConfigName, goLog, goPackId);
+        if (rst != (GoInt)0) {
+            LOG_WARNING(sLogger, ("process loggroup error", configName)("result", rst));
+        }
+    }
+#else
+    LogtailPluginMock::GetInstance()->ProcessLogGroups(configName, batch);
+#endif
+}
+
+bool LogtailPlugin::ParseLogGroupBatch(StringView batch, std::vector<std::pair<StringView, StringView>>& res) {
+    auto readField = [&batch](char tag, StringView& field) {
+        if (batch.empty() || batch[0] != tag) {
+            return false;
+        }
+        size_t pos = 1;
+        uint64_t size = 0;
+        for (size_t shift = 0; shift < 35; shift += 7) {
+            if (pos >= batch.size()) {
+                return false;
+            }
+            uint8_t byte = static_cast<uint8_t>(batch[pos++]);
+            size |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                if (size > batch.size() - pos) {
+                    return false;
+                }
+                field = batch.substr(pos, size);
+                batch = batch.substr(pos + size);
+                return true;
+            }
+        }
+        return false;
+    };
+    while (!batch.empty()) {
+        StringView packId, logGroup;
+        if (!readField(0x0A, packId) || !readField(0x12, logGroup)) {
+            return false;
+        }
+        res.emplace_back(packId, logGroup);
+    }
+    return true;
+}
+
 void LogtailPlugin::GetGoMetrics(std::vector<std::map<std::string, std::string>>& metircsList,
                                  const string& metricType) {
     if (mGetGoMetricsFun != nullptr) {
@@ -29,6 +29,7 @@
 
 #include "json/json.h"
 
+#include "models/StringView.h"
 #include "plugin/flusher/sls/FlusherSLS.h"
 #include "protobuf/sls/sls_logs.pb.h"
 
@@ -143,6 +144,7 @@ typedef GoInt (*InitPluginBaseFun)();
 typedef GoInt (*InitPluginBaseV2Fun)(GoString cfg);
 typedef GoInt (*ProcessLogsFun)(GoString c, GoSlice l, GoString p, GoString t, GoSlice tags);
 typedef GoInt (*ProcessLogGroupFun)(GoString c, GoSlice l, GoString p);
+typedef GoInt (*ProcessLogGroupsFun)(GoString c, GoSlice b);
 typedef struct innerContainerMeta* (*GetContainerMetaFun)(GoString containerID);
 typedef InnerPluginMetrics* (*GetGoMetricsFun)(GoString metricType);
 
@@ -230,6 +232,15 @@ public:
 
     void ProcessLogGroup(const std::string& configName, const std::string& logGroup, const std::string& packId);
 
+    // Pass several log groups to the Go pipeline in one call. The batch is a sequence of
+    //   0x0A varint(len(packIdPrefix)) packIdPrefix 0x12 varint(len(logGroup)) logGroup
+    // written by LogGroupSerializer::StartToAddLogGroup, where logGroup is a serialized sls_logs::LogGroup. The batch
+    // is only borrowed by Go during the call, so it can be reused once the call returns.
+    void ProcessLogGroups(const std::string& configName, const std::string& batch);
+    // split the batch into (packIdPrefix, logGroup) pairs, which point into the batch
+    static bool ParseLogGroupBatch(logtail::StringView batch,
+                                   std::vector<std::pair<logtail::StringView, logtail::StringView>>& res);
+
     static int IsValidToSend(long long logstoreKey);
 
     static int SendPb(const char* configName,
@@ -275,6 +286,8 @@ private:
     logtail::FlusherSLS mPluginContainerConfig;
     ProcessLogsFun mProcessLogsFun;
     ProcessLogGroupFun mProcessLogGroupFun;
+    // optional, not provided by old plugin base
+    ProcessLogGroupsFun mProcessLogGroupsFun = nullptr;
     GetContainerMetaFun mGetContainerMetaFun;
     GetGoMetricsFun mGetGoMetricsFun;
 
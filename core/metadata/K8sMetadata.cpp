@@ -23,11 +23,40 @@
 #include "common/http/HttpRequest.h"
 #include "common/http/HttpResponse.h"
 #include "logger/Logger.h"
+#include "monitor/metric_constants/MetricConstants.h"
+
+DEFINE_FLAG_INT32(k8s_metadata_batch_interval_ms, "interval of sending queued k8s metadata queries, in ms", 100);
+DEFINE_FLAG_INT32(k8s_metadata_max_batch_size, "max number of keys in one k8s metadata query", 200);
+DEFINE_FLAG_INT32(k8s_metadata_negative_cache_ttl_sec,
+                  "time before a key unknown to the operator can be queried again, in seconds",
+                  60);
+DEFINE_FLAG_INT32(k8s_metadata_max_retry_interval_ms,
+                  "max interval before keys of a failed k8s metadata query are queried again, in ms",
+                  30000);
 
 using namespace std;
 
 namespace logtail {
 
+K8sMetadata::K8sMetadata(size_t cacheSize) : containerCache(cacheSize, 0), ipCache(cacheSize, 0) {
+    mServiceHost = STRING_FLAG(operator_service);
+    mServicePort = INT32_FLAG(k8s_meta_service_port);
+
+    WriteMetrics::GetInstance()->PrepareMetricsRecordRef(
+        mMetricsRecordRef,
+        MetricCategory::METRIC_CATEGORY_RUNNER,
+        {{METRIC_LABEL_KEY_RUNNER_NAME, METRIC_LABEL_VALUE_RUNNER_NAME_K8S_METADATA}});
+    mCacheHitTotal = mMetricsRecordRef.CreateCounter(METRIC_RUNNER_METADATA_CACHE_HIT_TOTAL);
+    mCacheMissTotal = mMetricsRecordRef.CreateCounter(METRIC_RUNNER_METADATA_CACHE_MISS_TOTAL);
+    mRequestsTotal = mMetricsRecordRef.CreateCounter(METRIC_RUNNER_METADATA_REQUESTS_TOTAL);
+    mFailedRequestsTotal = mMetricsRecordRef.CreateCounter(METRIC_RUNNER_METADATA_FAILED_REQUESTS_TOTAL);
+    mResolveLatencyMs = mMetricsRecordRef.CreateHistogram(METRIC_RUNNER_METADATA_RESOLVE_LATENCY_MS);
+}
+
+K8sMetadata::~K8sMetadata() {
+    Stop();
+}
+
 size_t WriteCallback(void* contents, size_t size, size_t nmemb, void* userp) {
     ((std::string*)userp)->append((char*)contents, size * nmemb);
     return size * nmemb;
@@ -221,4 +250,179 @@ std::shared_ptr<k8sContainerInfo> K8sMetadata::GetInfoByIpFromCache(const std::s
     return ip_info;
 }
 
+std::shared_ptr<k8sContainerInfo> K8sMetadata::GetInfoByContainerIdAsync(const std::string& containerId) {
+    return GetInfoFromCache(containerId, containerInfoType::ContainerIdInfo);
+}
+
+std::shared_ptr<k8sContainerInfo> K8sMetadata::GetInfoByIpAsync(const std::string& ip) {
+    return GetInfoFromCache(ip, containerInfoType::IpInfo);
+}
+
+std::shared_ptr<k8sContainerInfo> K8sMetadata::GetInfoFromCache(const std::string& key, containerInfoType infoType) {
+    if (key.empty()) {
+        return nullptr;
+    }
+    auto info = infoType == containerInfoType::ContainerIdInfo ? GetInfoByContainerIdFromCache(key)
+                                                               : GetInfoByIpFromCache(key);
+    if (info) {
+        mCacheHitTotal->Add(1);
+        return info;
+    }
+    mCacheMissTotal->Add(1);
+    AsyncQueryMetadata(infoType, key);
+    return nullptr;
+}
+
+void K8sMetadata::AsyncQueryMetadata(containerInfoType infoType, const std::string& key) {
+    if (key.empty()) {
+        return;
+    }
+    auto now = chrono::steady_clock::now();
+    {
+        lock_guard<mutex> lock(mQueryMux);
+        auto& state = mQueryStates[static_cast<size_t>(infoType)];
+        auto missing = state.mMissingKeys.find(key);
+        if (missing != state.mMissingKeys.end()) {
+            if (now < missing->second) {
+                return;
+            }
+            state.mMissingKeys.erase(missing);
+        }
+        // the key is queued or being queried already
+        if (!state.mPendingKeys.emplace(key, now).second) {
+            return;
+        }
+        state.mQueue.push_back(key);
+        if (!mIsQueryThreadRunning && !mIsStopped) {
+            // started on the first miss, since most processes never query k8s metadata
+            mIsQueryThreadRunning = true;
+            mQueryThreadRes = async(launch::async, &K8sMetadata::RunQueryThread, this);
+        }
+    }
+    mQueryCV.notify_all();
+}
+
+void K8sMetadata::Stop() {
+    {
+        lock_guard<mutex> lock(mQueryMux);
+        if (mIsStopped) {
+            return;
+        }
+        mIsStopped = true;
+        mIsQueryThreadRunning = false;
+    }
+    mQueryCV.notify_all();
+    if (mQueryThreadRes.valid()) {
+        mQueryThreadRes.wait();
+    }
+}
+
+void K8sMetadata::RunQueryThread() {
+    array<vector<string>, 2> batches;
+    unique_lock<mutex> lock(mQueryMux);
+    // the earliest time queued keys can be queried, max if no key is queued
+    auto getNextQueryTime = [this]() {
+        auto res = chrono::steady_clock::time_point::max();
+        for (const auto& state : mQueryStates) {
+            if (!state.mQueue.empty()) {
+                res = min(res, state.mNextQueryTime);
+            }
+        }
+        return res;
+    };
+    while (mIsQueryThreadRunning) {
+        auto nextQueryTime = getNextQueryTime();
+        if (nextQueryTime == chrono::steady_clock::time_point::max()) {
+            mQueryCV.wait(lock);
+            continue;
+        }
+        if (nextQueryTime > chrono::steady_clock::now()) {
+            // in backoff after a failed request
+            mQueryCV.wait_until(lock, nextQueryTime);
+            continue;
+        }
+        // wait for a while, so that the misses from different threads are sent in one request
+        mQueryCV.wait_for(lock, chrono::milliseconds(INT32_FLAG(k8s_metadata_batch_interval_ms)), [this]() {
+            return !mIsQueryThreadRunning;
+        });
+        if (!mIsQueryThreadRunning) {
+            break;
+        }
+        auto now = chrono::steady_clock::now();
+        size_t maxBatchSize = static_cast<size_t>(max(1, INT32_FLAG(k8s_metadata_max_batch_size)));
+        for (size_t i = 0; i < mQueryStates.size(); ++i) {
+            auto& state = mQueryStates[i];
+            if (state.mNextQueryTime > now) {
+                continue;
+            }
+            size_t cnt = min(maxBatchSize, state.mQueue.size());
+            batches[i].assign(make_move_iterator(state.mQueue.begin()),
+                              make_move_iterator(state.mQueue.begin() + cnt));
+            state.mQueue.erase(state.mQueue.begin(), state.mQueue.begin() + cnt);
+        }
+        lock.unlock();
+        for (size_t i = 0; i < batches.size(); ++i) {
+            QueryBatch(static_cast<containerInfoType>(i), batches[i]);
+        }
+        lock.lock();
+    }
+}
+
+void K8sMetadata::QueryBatch(containerInfoType infoType, vector<string>& keys) {
+    if (keys.empty()) {
+        return;
+    }
+    mRequestsTotal->Add(1);
+    bool success = infoType == containerInfoType::ContainerIdInfo ? GetByContainerIdsFromServer(keys)
+                                                                   : GetByIpsFromServer(keys);
+    auto now = chrono::steady_clock::now();
+    if (!success) {
+        mFailedRequestsTotal->Add(1);
+        lock_guard<mutex> lock(mQueryMux);
+        auto& state = mQueryStates[static_cast<size_t>(infoType)];
+        // the keys are not known to be missing, so they are queried again with exponential backoff, and kept pending
+        // so that they are not queued twice
+        chrono::milliseconds interval(max(1, INT32_FLAG(k8s_metadata_batch_interval_ms)));
+        interval *= 1 << min(state.mFailedCnt, 16U);
+        state.mNextQueryTime
+            = now + min(interval, chrono::milliseconds(INT32_FLAG(k8s_metadata_max_retry_interval_ms)));
+        ++state.mFailedCnt;
+        state.mQueue.insert(state.mQueue.begin(), make_move_iterator(keys.begin()), make_move_iterator(keys.end()));
+        keys.clear();
+        return;
+    }
+
+    // only keys absent from a successful response are unknown to the operator
+    auto missingExpireTime = now + chrono::seconds(INT32_FLAG(k8s_metadata_negative_cache_ttl_sec));
+    vector<bool> found(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        found[i] = infoType == containerInfoType::ContainerIdInfo ? containerCache.contains(keys[i])
+                                                                  : ipCache.contains(keys[i]);
+    }
+    lock_guard<mutex> lock(mQueryMux);
+    auto& state = mQueryStates[static_cast<size_t>(infoType)];
+    state.mFailedCnt = 0;
+    for (size_t i = 0; i < keys.size(); ++i) {
+        auto it = state.mPendingKeys.find(keys[i]);
+        if (it != state.mPendingKeys.end()) {
+            mResolveLatencyMs->Record(now - it->second);
+            state.mPendingKeys.erase(it);
+        }
+        if (!found[i]) {
+            state.mMissingKeys[keys[i]] = missingExpireTime;
+        }
+    }
+    // drop the expired negative entries, so that the map does not grow with short-lived keys
+    if (state.mMissingKeys.size() > 1024) {
+        for (auto it = state.mMissingKeys.begin(); it != state.mMissingKeys.end();) {
+            if (it->second <= now) {
+                it = state.mMissingKeys.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    keys.clear();
+}
+
 } // namespace logtail
@@ -12,14 +12,22 @@
 // See the License for the specific l
 #pragma once
 
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <future>
 #include <iostream>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "json/json.h"
 
 #include "app_config/AppConfig.h"
 #include "common/Flags.h"
 #include "common/LRUCache.h"
+#include "monitor/MetricManager.h"
 
 DECLARE_FLAG_STRING(operator_service);
 DECLARE_FLAG_INT32(k8s_meta_service_port);
@@ -54,14 +62,41 @@ enum class containerInfoType { ContainerIdInfo, IpInfo };
 
 class K8sMetadata {
 private:
-    lru11::Cache<std::string, std::shared_ptr<k8sContainerInfo>> containerCache;
-    lru11::Cache<std::string, std::shared_ptr<k8sContainerInfo>> ipCache;
+    // state of the asynchronous queries of one info type
+    struct QueryState {
+        // keys queued or being queried, with the time they were first requested
+        std::unordered_map<std::string, std::chrono::steady_clock::time_point> mPendingKeys;
+        std::vector<std::string> mQueue;
+        // keys unknown to the operator, with the time they can be queried again
+        std::unordered_map<std::string, std::chrono::steady_clock::time_point> mMissingKeys;
+        // after a failed request, queued keys are not queried before this time
+        std::chrono::steady_clock::time_point mNextQueryTime;
+        uint32_t mFailedCnt = 0;
+    };
+
+    // caches are filled by the query thread and read by the processor threads
+    lru11::Cache<std::string, std::shared_ptr<k8sContainerInfo>, std::mutex> containerCache;
+    lru11::Cache<std::string, std::shared_ptr<k8sContainerInfo>, std::mutex> ipCache;
     std::string mServiceHost;
     int32_t mServicePort;
-    K8sMetadata(size_t cacheSize) : containerCache(cacheSize, 0), ipCache(cacheSize, 0) {
-        mServiceHost = STRING_FLAG(operator_service);
-        mServicePort = INT32_FLAG(k8s_meta_service_port);
-    }
+
+    std::mutex mQueryMux;
+    std::condition_variable mQueryCV;
+    std::array<QueryState, 2> mQueryStates;
+    bool mIsQueryThreadRunning = false;
+    // the query thread is not started again once stopped
+    bool mIsStopped = false;
+    std::future<void> mQueryThreadRes;
+
+    mutable MetricsRecordRef mMetricsRecordRef;
+    CounterPtr mCacheHitTotal;
+    CounterPtr mCacheMissTotal;
+    CounterPtr mRequestsTotal;
+    CounterPtr mFailedRequestsTotal;
+    HistogramPtr mResolveLatencyMs;
+
+    K8sMetadata(size_t cacheSize);
+    ~K8sMetadata();
     K8sMetadata(const K8sMetadata&) = delete;
     K8sMetadata& operator=(const K8sMetadata&) = delete;
 
@@ -70,6 +105,10 @@ private:
     bool FromInfoJson(const Json::Value& json, k8sContainerInfo& info);
     bool FromContainerJson(const Json::Value& json, std::shared_ptr<ContainerData> data);
 
+    std::shared_ptr<k8sContainerInfo> GetInfoFromCache(const std::string& key, containerInfoType infoType);
+    void RunQueryThread();
+    void QueryBatch(containerInfoType infoType, std::vector<std::string>& keys);
+
 public:
     static K8sMetadata& GetInstance() {
         static K8sMetadata instance(500);
@@ -86,8 +125,18 @@ public:
     std::shared_ptr<k8sContainerInfo> GetInfoByIpFromCache(const std::string& ip);
     bool SendRequestToOperator(const std::string& urlHost, const std::string& output, containerInfoType infoType);
 
+    // Get info from cache without blocking. On a miss, the key is queued and nullptr is returned. Queued keys are
+    // queried by a background thread, in one request for each info type per batch interval. Concurrent misses of the
+    // same key share one query, and keys unknown to the operator are not queried again until the negative cache
+    // expires. Keys of a failed query are queried again with backoff.
+    std::shared_ptr<k8sContainerInfo> GetInfoByContainerIdAsync(const std::string& containerId);
+    std::shared_ptr<k8sContainerInfo> GetInfoByIpAsync(const std::string& ip);
+    void AsyncQueryMetadata(containerInfoType infoType, const std::string& key);
+    void Stop();
+
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class k8sMetadataUnittest;
+    friend class K8sMetadataAsyncUnittest;
 #endif
 };
 
@@ -37,23 +37,11 @@ void LabelingK8sMetadata::AddLabelToLogGroup(PipelineEventGroup& logGroup) {
     EventsContainer& events = logGroup.MutableEvents();
     std::vector<std::string> containerVec;
     std::vector<std::string> remoteIpVec;
-    std::vector<size_t> cotainerNotTag;
+    // metadata not in cache is queried in background, and the events are passed on without the labels, so that the
+    // processor thread is never blocked by the operator
     for (size_t rIdx = 0; rIdx < events.size(); ++rIdx) {
-        if (!ProcessEvent(events[rIdx], containerVec, remoteIpVec)) {
-            cotainerNotTag.push_back(rIdx);
-        }
-    }
-    auto& k8sMetadata = K8sMetadata::GetInstance();
-    if (containerVec.empty() || (!k8sMetadata.GetByContainerIdsFromServer(containerVec))) {
-        return;
-    }
-    if (remoteIpVec.empty() || (!k8sMetadata.GetByIpsFromServer(remoteIpVec))) {
-        return;
-    }
-    for (size_t i = 0; i < cotainerNotTag.size(); ++i) {
-        ProcessEvent(events[i], containerVec, remoteIpVec);
+        ProcessEvent(events[rIdx], containerVec, remoteIpVec);
     }
-    return;
 }
 
 bool LabelingK8sMetadata::ProcessEvent(PipelineEventPtr& e,
@@ -83,7 +71,7 @@ bool LabelingK8sMetadata::AddLabels(Event& e,
     StringView containerIdView = e.HasTag(containerIdViewKey) ? e.GetTag(containerIdViewKey) : StringView{};
     if (!containerIdView.empty()) {
         std::string containerId(containerIdView);
-        std::shared_ptr<k8sContainerInfo> containerInfo = k8sMetadata.GetInfoByContainerIdFromCache(containerId);
+        std::shared_ptr<k8sContainerInfo> containerInfo = k8sMetadata.GetInfoByContainerIdAsync(containerId);
         if (containerInfo == nullptr) {
             containerVec.push_back(containerId);
             res = false;
@@ -99,7 +87,7 @@ bool LabelingK8sMetadata::AddLabels(Event& e,
     StringView remoteIpView = e.HasTag(ipView) ? e.GetTag(ipView) : StringView{};
     if (!remoteIpView.empty()) {
         std::string remoteIp(remoteIpView);
-        std::shared_ptr<k8sContainerInfo> ipInfo = k8sMetadata.GetInfoByIpFromCache(remoteIp);
+        std::shared_ptr<k8sContainerInfo> ipInfo = k8sMetadata.GetInfoByIpAsync(remoteIp);
         if (ipInfo == nullptr) {
             remoteIpVec.push_back(remoteIp);
             res = false;
@@ -30,6 +30,8 @@ const static std::string peerNamespaceKey = "peerNamespace";
 class LabelingK8sMetadata {
 public:
     void AddLabelToLogGroup(PipelineEventGroup& logGroup);
+    // Returns false if some metadata of the event is not in cache yet. The keys are appended to the vectors and are
+    // queried asynchronously, so the caller may hold the event back and process it again later.
     bool
     ProcessEvent(PipelineEventPtr& e, std::vector<std::string>& container_vec, std::vector<std::string>& remote_ip_vec);
     // 声明模板函数
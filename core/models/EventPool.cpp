@@ -16,150 +16,217 @@
 
 #include "models/EventPool.h"
 
+#include <cmath>
+
 #include "common/Flags.h"
 #include "logger/Logger.h"
 
-DEFINE_FLAG_INT32(event_pool_gc_interval_sec, "", 60);
+DEFINE_FLAG_INT32(event_pool_gc_interval_sec, "", 10);
+DEFINE_FLAG_INT32(event_pool_event_lifetime_sec,
+                  "expected time an event stays in the pipeline, used to estimate the number of events in use",
+                  10);
+DEFINE_FLAG_INT32(event_pool_thread_cache_size, "max number of events of each type kept by a threaded pool", 10000);
+DEFINE_FLAG_INT32(event_pool_depot_max_size, "max number of events of each type kept in the shared depot", 100000);
 
 using namespace std;
 
 namespace logtail {
 
+EventBatchStack<LogEvent> EventPool::sLogEventDepot;
+EventBatchStack<MetricEvent> EventPool::sMetricEventDepot;
+EventBatchStack<SpanEvent> EventPool::sSpanEventDepot;
+EventBatchStack<RawEvent> EventPool::sRawEventDepot;
+
 EventPool::~EventPool() {
     if (mEnableLock) {
-        {
-            lock_guard<mutex> lock(mPoolMux);
-            DestroyAllEventPool();
-        }
-        {
-            lock_guard<mutex> lockBak(mPoolBakMux);
-            DestroyAllEventPoolBak();
-        }
+        lock_guard<mutex> lock(mPoolMux);
+        DestroyAllEventPool();
     } else {
         DestroyAllEventPool();
     }
 }
 
+template <class T>
+T* EventPool::AcquireEvent(PipelineEventGroup* ptr,
+                           vector<T*>& pool,
+                           EventBatchStack<T>& returned,
+                           EventBatchStack<T>& depot,
+                           PoolStat& stat) {
+    if (pool.empty()) {
+        if (mEnableLock) {
+            returned.PopAll(pool);
+        } else {
+            depot.PopAll(pool);
+        }
+    }
+    ++stat.mAcquiredCnt;
+    if (pool.empty()) {
+        ++stat.mAllocatedCnt;
+        return new T(ptr);
+    }
+
+    auto obj = pool.back();
+    obj->ResetPipelineEventGroup(ptr);
+    pool.pop_back();
+    return obj;
+}
+
+template <class T>
+void EventPool::ReleaseEvents(vector<T*>&& obj,
+                              vector<T*>& pool,
+                              EventBatchStack<T>& returned,
+                              EventBatchStack<T>& depot) {
+    if (mEnableLock) {
+        returned.Push(std::move(obj));
+        return;
+    }
+
+    pool.insert(pool.end(), obj.begin(), obj.end());
+    size_t limit = INT32_FLAG(event_pool_thread_cache_size);
+    if (pool.size() <= limit) {
+        return;
+    }
+    // hand over the excess to the depot in one batch, so that it can be reused by threads acquiring events
+    size_t cnt = pool.size() - limit / 2;
+    if (depot.Size() + cnt <= static_cast<size_t>(INT32_FLAG(event_pool_depot_max_size))) {
+        depot.Push(vector<T*>(pool.end() - cnt, pool.end()));
+    } else {
+        for (auto it = pool.end() - cnt; it != pool.end(); ++it) {
+            delete *it;
+        }
+    }
+    pool.resize(pool.size() - cnt);
+}
+
 LogEvent* EventPool::AcquireLogEvent(PipelineEventGroup* ptr) {
     if (mEnableLock) {
-        TransferPoolIfEmpty(mLogEventPool, mLogEventPoolBak);
         lock_guard<mutex> lock(mPoolMux);
-        return AcquireEventNoLock(ptr, mLogEventPool, mMinUnusedLogEventsCnt);
+        return AcquireEvent(ptr, mLogEventPool, mReturnedLogEvents, sLogEventDepot, mLogEventStat);
     }
-    return AcquireEventNoLock(ptr, mLogEventPool, mMinUnusedLogEventsCnt);
+    return AcquireEvent(ptr, mLogEventPool, mReturnedLogEvents, sLogEventDepot, mLogEventStat);
 }
 
 MetricEvent* EventPool::AcquireMetricEvent(PipelineEventGroup* ptr) {
     if (mEnableLock) {
-        TransferPoolIfEmpty(mMetricEventPool, mMetricEventPoolBak);
         lock_guard<mutex> lock(mPoolMux);
-        return AcquireEventNoLock(ptr, mMetricEventPool, mMinUnusedMetricEventsCnt);
+        return AcquireEvent(ptr, mMetricEventPool, mReturnedMetricEvents, sMetricEventDepot, mMetricEventStat);
     }
-    return AcquireEventNoLock(ptr, mMetricEventPool, mMinUnusedMetricEventsCnt);
+    return AcquireEvent(ptr, mMetricEventPool, mReturnedMetricEvents, sMetricEventDepot, mMetricEventStat);
 }
 
 SpanEvent* EventPool::AcquireSpanEvent(PipelineEventGroup* ptr) {
     if (mEnableLock) {
-        TransferPoolIfEmpty(mSpanEventPool, mSpanEventPoolBak);
         lock_guard<mutex> lock(mPoolMux);
-        return AcquireEventNoLock(ptr, mSpanEventPool, mMinUnusedSpanEventsCnt);
+        return AcquireEvent(ptr, mSpanEventPool, mReturnedSpanEvents, sSpanEventDepot, mSpanEventStat);
     }
-    return AcquireEventNoLock(ptr, mSpanEventPool, mMinUnusedSpanEventsCnt);
+    return AcquireEvent(ptr, mSpanEventPool, mReturnedSpanEvents, sSpanEventDepot, mSpanEventStat);
 }
 
 RawEvent* EventPool::AcquireRawEvent(PipelineEventGroup* ptr) {
     if (mEnableLock) {
-        TransferPoolIfEmpty(mRawEventPool, mRawEventPoolBak);
         lock_guard<mutex> lock(mPoolMux);
-        return AcquireEventNoLock(ptr, mRawEventPool, mMinUnusedRawEventsCnt);
+        return AcquireEvent(ptr, mRawEventPool, mReturnedRawEvents, sRawEventDepot, mRawEventStat);
     }
-    return AcquireEventNoLock(ptr, mRawEventPool, mMinUnusedRawEventsCnt);
+    return AcquireEvent(ptr, mRawEventPool, mReturnedRawEvents, sRawEventDepot, mRawEventStat);
 }
 
 void EventPool::Release(vector<LogEvent*>&& obj) {
-    if (mEnableLock) {
-        lock_guard<mutex> lock(mPoolBakMux);
-        mLogEventPoolBak.insert(mLogEventPoolBak.end(), obj.begin(), obj.end());
-    } else {
-        mLogEventPool.insert(mLogEventPool.end(), obj.begin(), obj.end());
-    }
+    ReleaseEvents(std::move(obj), mLogEventPool, mReturnedLogEvents, sLogEventDepot);
 }
 
 void EventPool::Release(vector<MetricEvent*>&& obj) {
-    if (mEnableLock) {
-        lock_guard<mutex> lock(mPoolBakMux);
-        mMetricEventPoolBak.insert(mMetricEventPoolBak.end(), obj.begin(), obj.end());
-    } else {
-        mMetricEventPool.insert(mMetricEventPool.end(), obj.begin(), obj.end());
-    }
+    ReleaseEvents(std::move(obj), mMetricEventPool, mReturnedMetricEvents, sMetricEventDepot);
 }
 
 void EventPool::Release(vector<SpanEvent*>&& obj) {
-    if (mEnableLock) {
-        lock_guard<mutex> lock(mPoolBakMux);
-        mSpanEventPoolBak.insert(mSpanEventPoolBak.end(), obj.begin(), obj.end());
-    } else {
-        mSpanEventPool.insert(mSpanEventPool.end(), obj.begin(), obj.end());
-    }
+    ReleaseEvents(std::move(obj), mSpanEventPool, mReturnedSpanEvents, sSpanEventDepot);
 }
 
 void EventPool::Release(vector<RawEvent*>&& obj) {
-    if (mEnableLock) {
-        lock_guard<mutex> lock(mPoolBakMux);
-        mRawEventPoolBak.insert(mRawEventPoolBak.end(), obj.begin(), obj.end());
-    } else {
-        mRawEventPool.insert(mRawEventPool.end(), obj.begin(), obj.end());
-    }
+    ReleaseEvents(std::move(obj), mRawEventPool, mReturnedRawEvents, sRawEventDepot);
 }
 
 template <class T>
-void DoGC(vector<T*>& pool, vector<T*>& poolBak, size_t& minUnusedCnt, mutex* mux, const string& type) {
-    if (minUnusedCnt <= pool.size() || minUnusedCnt == numeric_limits<size_t>::max()) {
-        auto sz = minUnusedCnt == numeric_limits<size_t>::max() ? pool.size() : minUnusedCnt;
-        for (size_t i = 0; i < sz; ++i) {
-            delete pool.back();
-            pool.pop_back();
-        }
-        size_t bakSZ = 0;
-        if (mux) {
-            lock_guard<mutex> lock(*mux);
-            bakSZ = poolBak.size();
-            for (auto& item : poolBak) {
-                delete item;
+void DoGC(vector<T*>& pool,
+          EventBatchStack<T>* returned,
+          size_t& acquiredCnt,
+          size_t& allocatedCnt,
+          double& acquireRate,
+          time_t elapsedSec,
+          const string& type) {
+    if (returned) {
+        returned->PopAll(pool);
+    }
+    double rate = static_cast<double>(acquiredCnt) / elapsedSec;
+    acquireRate = acquireRate == 0.0 ? rate : (acquireRate + rate) / 2;
+
+    // the pool is still growing, no need to shrink
+    if (allocatedCnt == 0) {
+        auto target = static_cast<size_t>(llround(acquireRate * INT32_FLAG(event_pool_event_lifetime_sec)));
+        if (pool.size() > target) {
+            // only release half of the excess each time to avoid oscillation
+            size_t sz = (pool.size() - target + 1) / 2;
+            for (size_t i = 0; i < sz; ++i) {
+                delete pool.back();
+                pool.pop_back();
             }
-            poolBak.clear();
-        }
-        if (sz != 0 || bakSZ != 0) {
-            LOG_INFO(
-                sLogger,
-                ("event pool gc", "done")("event type", type)("gc event cnt", sz + bakSZ)("pool size", pool.size()));
+            LOG_INFO(sLogger,
+                     ("event pool gc", "done")("event type", type)("gc event cnt", sz)("pool size", pool.size())(
+                         "acquire rate", acquireRate));
         }
-    } else {
-        LOG_ERROR(sLogger,
-                  ("unexpected error", "min unused event cnt is greater than pool size")(
-                      "min unused cnt", minUnusedCnt)("pool size", pool.size()));
     }
-    minUnusedCnt = numeric_limits<size_t>::max();
+    acquiredCnt = 0;
+    allocatedCnt = 0;
 }
 
 void EventPool::CheckGC() {
-    if (time(nullptr) - mLastGCTime > INT32_FLAG(event_pool_gc_interval_sec)) {
+    time_t now = time(nullptr);
+    if (mLastGCTime == 0) {
+        mLastGCTime = now;
+        return;
+    }
+    if (now - mLastGCTime > INT32_FLAG(event_pool_gc_interval_sec)) {
         if (mEnableLock) {
             lock_guard<mutex> lock(mPoolMux);
-            DoGC(mLogEventPool, mLogEventPoolBak, mMinUnusedLogEventsCnt, &mPoolBakMux, "log");
-            DoGC(mMetricEventPool, mMetricEventPoolBak, mMinUnusedMetricEventsCnt, &mPoolBakMux, "metric");
-            DoGC(mSpanEventPool, mSpanEventPoolBak, mMinUnusedSpanEventsCnt, &mPoolBakMux, "span");
-            DoGC(mRawEventPool, mRawEventPoolBak, mMinUnusedRawEventsCnt, &mPoolBakMux, "raw");
+            GC(now - mLastGCTime);
         } else {
-            DoGC(mLogEventPool, mLogEventPoolBak, mMinUnusedLogEventsCnt, nullptr, "log");
-            DoGC(mMetricEventPool, mMetricEventPoolBak, mMinUnusedMetricEventsCnt, nullptr, "metric");
-            DoGC(mSpanEventPool, mSpanEventPoolBak, mMinUnusedSpanEventsCnt, nullptr, "span");
-            DoGC(mRawEventPool, mRawEventPoolBak, mMinUnusedRawEventsCnt, nullptr, "raw");
+            GC(now - mLastGCTime);
         }
-        mLastGCTime = time(nullptr);
+        mLastGCTime = now;
     }
 }
 
+void EventPool::GC(time_t elapsedSec) {
+    DoGC(mLogEventPool,
+         mEnableLock ? &mReturnedLogEvents : nullptr,
+         mLogEventStat.mAcquiredCnt,
+         mLogEventStat.mAllocatedCnt,
+         mLogEventStat.mAcquireRate,
+         elapsedSec,
+         "log");
+    DoGC(mMetricEventPool,
+         mEnableLock ? &mReturnedMetricEvents : nullptr,
+         mMetricEventStat.mAcquiredCnt,
+         mMetricEventStat.mAllocatedCnt,
+         mMetricEventStat.mAcquireRate,
+         elapsedSec,
+         "metric");
+    DoGC(mSpanEventPool,
+         mEnableLock ? &mReturnedSpanEvents : nullptr,
+         mSpanEventStat.mAcquiredCnt,
+         mSpanEventStat.mAllocatedCnt,
+         mSpanEventStat.mAcquireRate,
+         elapsedSec,
+         "span");
+    DoGC(mRawEventPool,
+         mEnableLock ? &mReturnedRawEvents : nullptr,
+         mRawEventStat.mAcquiredCnt,
+         mRawEventStat.mAllocatedCnt,
+         mRawEventStat.mAcquireRate,
+         elapsedSec,
+         "raw");
+}
+
 void EventPool::DestroyAllEventPool() {
     for (auto& item : mLogEventPool) {
         delete item;
@@ -175,43 +242,22 @@ void EventPool::DestroyAllEventPool() {
     }
 }
 
-void EventPool::DestroyAllEventPoolBak() {
-    for (auto& item : mLogEventPoolBak) {
-        delete item;
-    }
-    for (auto& item : mMetricEventPoolBak) {
-        delete item;
-    }
-    for (auto& item : mSpanEventPoolBak) {
-        delete item;
-    }
-    for (auto& item : mRawEventPoolBak) {
-        delete item;
-    }
-}
-
 #ifdef APSARA_UNIT_TEST_MAIN
 void EventPool::Clear() {
-    {
-        lock_guard<mutex> lock(mPoolMux);
-        DestroyAllEventPool();
-        mLogEventPool.clear();
-        mMetricEventPool.clear();
-        mSpanEventPool.clear();
-        mRawEventPool.clear();
-        mMinUnusedLogEventsCnt = numeric_limits<size_t>::max();
-        mMinUnusedMetricEventsCnt = numeric_limits<size_t>::max();
-        mMinUnusedSpanEventsCnt = numeric_limits<size_t>::max();
-        mMinUnusedRawEventsCnt = numeric_limits<size_t>::max();
-    }
-    {
-        lock_guard<mutex> lock(mPoolBakMux);
-        DestroyAllEventPoolBak();
-        mLogEventPoolBak.clear();
-        mMetricEventPoolBak.clear();
-        mSpanEventPoolBak.clear();
-        mRawEventPoolBak.clear();
-    }
+    lock_guard<mutex> lock(mPoolMux);
+    mReturnedLogEvents.PopAll(mLogEventPool);
+    mReturnedMetricEvents.PopAll(mMetricEventPool);
+    mReturnedSpanEvents.PopAll(mSpanEventPool);
+    mReturnedRawEvents.PopAll(mRawEventPool);
+    DestroyAllEventPool();
+    mLogEventPool.clear();
+    mMetricEventPool.clear();
+    mSpanEventPool.clear();
+    mRawEventPool.clear();
+    mLogEventStat = PoolStat();
+    mMetricEventStat = PoolStat();
+    mSpanEventStat = PoolStat();
+    mRawEventStat = PoolStat();
     mLastGCTime = 0;
 }
 #endif
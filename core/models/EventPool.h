@@ -17,10 +17,10 @@
 #pragma once
 
 #include <cstdint>
+#include <ctime>
 
-#include <limits>
+#include <atomic>
 #include <mutex>
-#include <optional>
 #include <vector>
 
 #include "models/LogEvent.h"
@@ -31,6 +31,72 @@
 namespace logtail {
 class PipelineEventGroup;
 
+// Lock-free stack of event batches. Any number of threads can push concurrently, while the stack can only be popped
+// as a whole, which keeps it free from the ABA problem.
+template <class T>
+class EventBatchStack {
+public:
+    EventBatchStack() = default;
+    ~EventBatchStack() {
+        std::vector<T*> events;
+        PopAll(events);
+        for (auto& item : events) {
+            delete item;
+        }
+    }
+    EventBatchStack(const EventBatchStack&) = delete;
+    EventBatchStack& operator=(const EventBatchStack&) = delete;
+
+    void Push(std::vector<T*>&& events) {
+        if (events.empty()) {
+            return;
+        }
+        size_t cnt = events.size();
+        auto node = new Node{std::move(events), mHead.load(std::memory_order_relaxed)};
+        mSize.fetch_add(cnt, std::memory_order_relaxed);
+        while (!mHead.compare_exchange_weak(node->mNext, node, std::memory_order_release, std::memory_order_relaxed)) {
+        }
+    }
+
+    // append all events in the stack to events, and return the number of events popped
+    size_t PopAll(std::vector<T*>& events) {
+        if (mHead.load(std::memory_order_relaxed) == nullptr) {
+            return 0;
+        }
+        Node* node = mHead.exchange(nullptr, std::memory_order_acquire);
+        size_t cnt = 0;
+        while (node) {
+            events.insert(events.end(), node->mEvents.begin(), node->mEvents.end());
+            cnt += node->mEvents.size();
+            Node* next = node->mNext;
+            delete node;
+            node = next;
+        }
+        mSize.fetch_sub(cnt, std::memory_order_relaxed);
+        return cnt;
+    }
+
+    size_t Size() const { return mSize.load(std::memory_order_relaxed); }
+
+private:
+    struct Node {
+        std::vector<T*> mEvents;
+        Node* mNext;
+    };
+
+    std::atomic<Node*> mHead = nullptr;
+    std::atomic_size_t mSize = 0;
+};
+
+// There are two kinds of event pools:
+// 1. threaded pool (enableLock = false), which can only be used by the owner thread. Events released by threads that
+// seldom acquire events (e.g., flusher threads) are handed over to a process-wide depot in batches, from which threads
+// with an empty pool refill.
+// 2. shared pool (enableLock = true), which can be used by any thread. Acquisition is protected by a mutex, while
+// release is lock-free, i.e., released events are pushed to a return stack and collected when the pool runs empty.
+//
+// Instead of a fixed interval, the number of events kept in the pool is derived from the acquisition rate: by Little's
+// law, the number of events in use is roughly the acquisition rate multiplied by the lifetime of an event.
 class EventPool {
 public:
     explicit EventPool(bool enableLock = true) : mEnableLock(enableLock) {}
@@ -53,30 +119,29 @@ public:
 #endif
 
 private:
-    template <class T>
-    void TransferPoolIfEmpty(std::vector<T*>& pool, std::vector<T*>& poolBak) {
-        std::lock_guard<std::mutex> lock(mPoolMux);
-        if (pool.empty()) {
-            std::lock_guard<std::mutex> lk(mPoolBakMux);
-            pool.swap(poolBak);
-        }
-    }
+    struct PoolStat {
+        // since last gc
+        size_t mAcquiredCnt = 0;
+        // since last gc, i.e., events acquired when the pool is empty
+        size_t mAllocatedCnt = 0;
+        // smoothed number of events acquired per second
+        double mAcquireRate = 0.0;
+    };
 
     template <class T>
-    T* AcquireEventNoLock(PipelineEventGroup* ptr, std::vector<T*>& pool, size_t& minUnusedCnt) {
-        if (pool.empty()) {
-            return new T(ptr);
-        }
-
-        auto obj = pool.back();
-        obj->ResetPipelineEventGroup(ptr);
-        pool.pop_back();
-        minUnusedCnt = std::min(minUnusedCnt, pool.size());
-        return obj;
-    }
+    T* AcquireEvent(PipelineEventGroup* ptr,
+                    std::vector<T*>& pool,
+                    EventBatchStack<T>& returned,
+                    EventBatchStack<T>& depot,
+                    PoolStat& stat);
+    template <class T>
+    void ReleaseEvents(std::vector<T*>&& obj,
+                       std::vector<T*>& pool,
+                       EventBatchStack<T>& returned,
+                       EventBatchStack<T>& depot);
+    void GC(time_t elapsedSec);
 
     void DestroyAllEventPool();
-    void DestroyAllEventPoolBak();
 
     bool mEnableLock = true;
 
@@ -87,19 +152,24 @@ private:
     std::vector<RawEvent*> mRawEventPool;
 
     // only meaningful when mEnableLock is true
-    std::mutex mPoolBakMux;
-    std::vector<LogEvent*> mLogEventPoolBak;
-    std::vector<MetricEvent*> mMetricEventPoolBak;
-    std::vector<SpanEvent*> mSpanEventPoolBak;
-    std::vector<RawEvent*> mRawEventPoolBak;
+    EventBatchStack<LogEvent> mReturnedLogEvents;
+    EventBatchStack<MetricEvent> mReturnedMetricEvents;
+    EventBatchStack<SpanEvent> mReturnedSpanEvents;
+    EventBatchStack<RawEvent> mReturnedRawEvents;
 
-    size_t mMinUnusedLogEventsCnt = std::numeric_limits<size_t>::max();
-    size_t mMinUnusedMetricEventsCnt = std::numeric_limits<size_t>::max();
-    size_t mMinUnusedSpanEventsCnt = std::numeric_limits<size_t>::max();
-    size_t mMinUnusedRawEventsCnt = std::numeric_limits<size_t>::max();
+    PoolStat mLogEventStat;
+    PoolStat mMetricEventStat;
+    PoolStat mSpanEventStat;
+    PoolStat mRawEventStat;
 
     time_t mLastGCTime = 0;
 
+    // shared by all threaded pools
+    static EventBatchStack<LogEvent> sLogEventDepot;
+    static EventBatchStack<MetricEvent> sMetricEventDepot;
+    static EventBatchStack<SpanEvent> sSpanEventDepot;
+    static EventBatchStack<RawEvent> sRawEventDepot;
+
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class EventPoolUnittest;
     friend class PipelineEventGroupUnittest;
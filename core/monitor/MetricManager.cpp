@@ -72,9 +72,7 @@ void WriteMetrics::Clear() {
     }
 }
 
-MetricsRecord* WriteMetrics::DoSnapshot() {
-    // new read head
-    MetricsRecord* snapshot = nullptr;
+void WriteMetrics::DoSnapshot(std::vector<MetricsRecordSnapshot>& snapshots) {
     MetricsRecord* toDeleteHead = nullptr;
     MetricsRecord* tmp = nullptr;
 
@@ -117,9 +115,10 @@ MetricsRecord* WriteMetrics::DoSnapshot() {
 
     // copy head
     if (preTmp) {
-        MetricsRecord* newMetrics = preTmp->Collect();
-        newMetrics->SetNext(snapshot);
-        snapshot = newMetrics;
+        if (snapshots.size() <= static_cast<size_t>(metricsSnapshotTotal)) {
+            snapshots.emplace_back();
+        }
+        snapshots[metricsSnapshotTotal].Update(*preTmp);
         metricsSnapshotTotal++;
         writeMetricsTotal++;
     }
@@ -132,15 +131,18 @@ MetricsRecord* WriteMetrics::DoSnapshot() {
             toDeleteHead = tmp;
             tmp = preTmp->GetNext();
         } else {
-            MetricsRecord* newMetrics = tmp->Collect();
-            newMetrics->SetNext(snapshot);
-            snapshot = newMetrics;
+            if (snapshots.size() <= static_cast<size_t>(metricsSnapshotTotal)) {
+                snapshots.emplace_back();
+            }
+            snapshots[metricsSnapshotTotal].Update(*tmp);
             preTmp = tmp;
             tmp = tmp->GetNext();
             metricsSnapshotTotal++;
         }
     }
 
+    snapshots.resize(metricsSnapshotTotal);
+
     while (toDeleteHead) {
         MetricsRecord* toDelete = toDeleteHead;
         toDeleteHead = toDeleteHead->GetNext();
@@ -150,20 +152,13 @@ MetricsRecord* WriteMetrics::DoSnapshot() {
     LOG_INFO(sLogger,
              ("writeMetricsTotal", writeMetricsTotal)("writeMetricsDeleteTotal", writeMetricsDeleteTotal)(
                  "metricsSnapshotTotal", metricsSnapshotTotal));
-    return snapshot;
-}
-
-ReadMetrics::~ReadMetrics() {
-    Clear();
 }
 
 void ReadMetrics::ReadAsSelfMonitorMetricEvents(std::vector<SelfMonitorMetricEvent>& metricEventList) const {
     ReadLock lock(mReadWriteLock);
     // c++ metrics
-    MetricsRecord* tmp = mHead;
-    while (tmp) {
-        metricEventList.emplace_back(SelfMonitorMetricEvent(tmp));
-        tmp = tmp->GetNext();
+    for (const auto& snapshot : mSnapshots) {
+        metricEventList.emplace_back(SelfMonitorMetricEvent(snapshot));
     }
     // go metrics
     for (auto metrics : mGoMetrics) {
@@ -187,34 +182,18 @@ void ReadMetrics::UpdateMetrics() {
         }
     }
     // 获取c++指标
-    MetricsRecord* snapshot = WriteMetrics::GetInstance()->DoSnapshot();
-    MetricsRecord* toDelete;
+    WriteMetrics::GetInstance()->DoSnapshot(mBakSnapshots);
     {
-        // Only lock when change head
+        // Only lock when swapping snapshots
         WriteLock lock(mReadWriteLock);
-        toDelete = mHead;
-        mHead = snapshot;
-    }
-    // delete old linklist
-    while (toDelete) {
-        MetricsRecord* obj = toDelete;
-        toDelete = toDelete->GetNext();
-        delete obj;
+        mSnapshots.swap(mBakSnapshots);
     }
 }
 
-MetricsRecord* ReadMetrics::GetHead() {
-    WriteLock lock(mReadWriteLock);
-    return mHead;
-}
-
 void ReadMetrics::Clear() {
     WriteLock lock(mReadWriteLock);
-    while (mHead) {
-        MetricsRecord* toDelete = mHead;
-        mHead = mHead->GetNext();
-        delete toDelete;
-    }
+    mSnapshots.clear();
+    mBakSnapshots.clear();
 }
 
 // metrics from Go that are provided by cpp
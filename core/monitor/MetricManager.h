@@ -55,7 +55,8 @@ public:
                                 MetricLabels&& labels,
                                 DynamicMetricLabels&& dynamicLabels = {});
     void CommitMetricsRecordRef(MetricsRecordRef& ref);
-    MetricsRecord* DoSnapshot();
+    // fill snapshots with the values of all alive records, reusing the existing elements
+    void DoSnapshot(std::vector<MetricsRecordSnapshot>& snapshots);
 
 
 #ifdef APSARA_UNIT_TEST_MAIN
@@ -67,14 +68,15 @@ class ReadMetrics {
 private:
     ReadMetrics() = default;
     mutable ReadWriteLock mReadWriteLock;
-    MetricsRecord* mHead = nullptr;
+    std::vector<MetricsRecordSnapshot> mSnapshots;
+    // the previous snapshots, refilled by the next UpdateMetrics outside the lock
+    std::vector<MetricsRecordSnapshot> mBakSnapshots;
     std::vector<std::map<std::string, std::string>> mGoMetrics;
     void Clear();
-    MetricsRecord* GetHead();
     void UpdateGoCppProvidedMetrics(std::vector<std::map<std::string, std::string>>& metricsList);
 
 public:
-    ~ReadMetrics();
+    ~ReadMetrics() = default;
     static ReadMetrics* GetInstance() {
         static ReadMetrics* ptr = new ReadMetrics();
         return ptr;
@@ -32,6 +32,7 @@
 #include "common/RuntimeUtil.h"
 #include "common/StringTools.h"
 #include "common/TimeUtil.h"
+#include "common/memory/ChunkPool.h"
 #include "common/version.h"
 #include "constants/Constants.h"
 #include "file_server/event_handler/LogInput.h"
@@ -245,6 +246,9 @@ bool LogtailMonitor::SendStatusProfile(bool suicide) {
     LoongCollectorMonitor::GetInstance()->SetAgentCpu(mCpuStat.mCpuUsage);
     // Memory usage of Logtail process.
     LoongCollectorMonitor::GetInstance()->SetAgentMemory(mMemStat.mRss);
+    // Memory chunks of source buffers.
+    LoongCollectorMonitor::GetInstance()->SetAgentChunkPoolCachedSize(ChunkPool::GetInstance()->GetCachedSize());
+    LoongCollectorMonitor::GetInstance()->SetAgentChunkPoolInUseSize(ChunkPool::GetInstance()->GetInUseSize());
 
     return mIsThreadRunning;
 }
@@ -623,6 +627,8 @@ void LoongCollectorMonitor::Init() {
     mAgentGoRoutinesTotal = mMetricsRecordRef.CreateIntGauge(METRIC_AGENT_GO_ROUTINES_TOTAL);
     mAgentOpenFdTotal = mMetricsRecordRef.CreateIntGauge(METRIC_AGENT_OPEN_FD_TOTAL);
     mAgentConfigTotal = mMetricsRecordRef.CreateIntGauge(METRIC_AGENT_PIPELINE_CONFIG_TOTAL);
+    mAgentChunkPoolCachedSize = mMetricsRecordRef.CreateIntGauge(METRIC_AGENT_CHUNK_POOL_CACHED_SIZE_BYTES);
+    mAgentChunkPoolInUseSize = mMetricsRecordRef.CreateIntGauge(METRIC_AGENT_CHUNK_POOL_IN_USE_SIZE_BYTES);
 }
 
 void LoongCollectorMonitor::Stop() {
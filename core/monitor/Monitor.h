@@ -196,6 +196,8 @@ public:
         mAgentOpenFdTotal->Set(total);
 #endif
     }
+    void SetAgentChunkPoolCachedSize(uint64_t size) { mAgentChunkPoolCachedSize->Set(size); }
+    void SetAgentChunkPoolInUseSize(uint64_t size) { mAgentChunkPoolInUseSize->Set(size); }
     void SetAgentConfigTotal(uint64_t total) {
 #ifndef APSARA_UNIT_TEST_MAIN
         mAgentConfigTotal->Set(total);
@@ -222,6 +224,8 @@ private:
     IntGaugePtr mAgentGoRoutinesTotal;
     IntGaugePtr mAgentOpenFdTotal;
     IntGaugePtr mAgentConfigTotal;
+    IntGaugePtr mAgentChunkPoolCachedSize;
+    IntGaugePtr mAgentChunkPoolInUseSize;
 };
 
 } // namespace logtail
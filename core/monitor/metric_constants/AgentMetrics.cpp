@@ -31,6 +31,8 @@ const string METRIC_LABEL_KEY_UUID = "uuid";
 const string METRIC_LABEL_KEY_VERSION = "version";
 
 // metric keys
+const string METRIC_AGENT_CHUNK_POOL_CACHED_SIZE_BYTES = "chunk_pool_cached_size_bytes";
+const string METRIC_AGENT_CHUNK_POOL_IN_USE_SIZE_BYTES = "chunk_pool_in_use_size_bytes";
 const string METRIC_AGENT_CPU = "cpu";
 const string METRIC_AGENT_GO_ROUTINES_TOTAL = "go_routines_total";
 const string METRIC_AGENT_INSTANCE_CONFIG_TOTAL = "instance_config_total"; // Not Implemented
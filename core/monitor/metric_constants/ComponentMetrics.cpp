@@ -53,6 +53,8 @@ const string& METRIC_COMPONENT_TOTAL_DELAY_MS = METRIC_TOTAL_DELAY_MS;
 const string& METRIC_COMPONENT_TOTAL_PROCESS_TIME_MS = METRIC_TOTAL_PROCESS_TIME_MS;
 const string& METRIC_COMPONENT_DISCARDED_ITEMS_TOTAL = METRIC_DISCARDED_ITEMS_TOTAL;
 const string& METRIC_COMPONENT_DISCARDED_SIZE_BYTES = METRIC_DISCARDED_SIZE_BYTES;
+const string METRIC_COMPONENT_DELAY_LATENCY_MS = "delay_latency_ms";
+const string& METRIC_COMPONENT_PROCESS_LATENCY_MS = METRIC_PROCESS_LATENCY_MS;
 
 /**********************************************************
  *   batcher
@@ -62,6 +64,9 @@ const string METRIC_COMPONENT_BATCHER_BUFFERED_GROUPS_TOTAL = "buffered_groups_t
 const string METRIC_COMPONENT_BATCHER_BUFFERED_EVENTS_TOTAL = "buffered_events_total";
 const string METRIC_COMPONENT_BATCHER_BUFFERED_SIZE_BYTES = "buffered_size_bytes";
 const string METRIC_COMPONENT_BATCHER_TOTAL_ADD_TIME_MS = "total_add_time_ms";
+const string METRIC_COMPONENT_BATCHER_ADD_LATENCY_MS = "add_latency_ms";
+const string METRIC_COMPONENT_BATCHER_TARGET_SIZE_BYTES = "target_size_bytes";
+const string METRIC_COMPONENT_BATCHER_TARGET_CNT = "target_cnt";
 
 /**********************************************************
  *   queue
@@ -32,5 +32,6 @@ extern const std::string METRIC_OUT_ITEMS_TOTAL;
 extern const std::string METRIC_OUT_SIZE_BYTES;
 extern const std::string METRIC_TOTAL_DELAY_MS;
 extern const std::string METRIC_TOTAL_PROCESS_TIME_MS;
+extern const std::string METRIC_PROCESS_LATENCY_MS;
 
 } // namespace logtail
@@ -35,6 +35,8 @@ extern const std::string METRIC_LABEL_KEY_UUID;
 extern const std::string METRIC_LABEL_KEY_VERSION;
 
 // metric keys
+extern const std::string METRIC_AGENT_CHUNK_POOL_CACHED_SIZE_BYTES;
+extern const std::string METRIC_AGENT_CHUNK_POOL_IN_USE_SIZE_BYTES;
 extern const std::string METRIC_AGENT_CPU;
 extern const std::string METRIC_AGENT_GO_ROUTINES_TOTAL;
 extern const std::string METRIC_AGENT_INSTANCE_CONFIG_TOTAL;
@@ -80,6 +82,7 @@ extern const std::string& METRIC_PLUGIN_OUT_EVENT_GROUPS_TOTAL;
 extern const std::string& METRIC_PLUGIN_OUT_SIZE_BYTES;
 extern const std::string& METRIC_PLUGIN_TOTAL_DELAY_MS;
 extern const std::string& METRIC_PLUGIN_TOTAL_PROCESS_TIME_MS;
+extern const std::string& METRIC_PLUGIN_PROCESS_LATENCY_MS;
 
 /**********************************************************
  *   input_file
@@ -92,6 +95,7 @@ extern const std::string METRIC_LABEL_KEY_FILE_NAME;
 extern const std::string METRIC_PLUGIN_MONITOR_FILE_TOTAL;
 extern const std::string METRIC_PLUGIN_SOURCE_READ_OFFSET_BYTES;
 extern const std::string METRIC_PLUGIN_SOURCE_SIZE_BYTES;
+extern const std::string METRIC_PLUGIN_SOURCE_LAG_BYTES;
 
 /**********************************************************
  *   input_prometheus
@@ -177,6 +181,7 @@ extern const std::string METRIC_PLUGIN_HISTORY_FAILURE_TOTAL;
 
 /**********************************************************
  *   processor_split_multiline_log_string_native
+ *   processor_filter_regex_native
  **********************************************************/
 extern const std::string METRIC_PLUGIN_MATCHED_EVENTS_TOTAL;
 extern const std::string METRIC_PLUGIN_MATCHED_LINES_TOTAL;
@@ -232,6 +237,8 @@ extern const std::string& METRIC_COMPONENT_TOTAL_DELAY_MS;
 extern const std::string& METRIC_COMPONENT_TOTAL_PROCESS_TIME_MS;
 extern const std::string& METRIC_COMPONENT_DISCARDED_ITEMS_TOTAL;
 extern const std::string& METRIC_COMPONENT_DISCARDED_SIZE_BYTES;
+extern const std::string METRIC_COMPONENT_DELAY_LATENCY_MS;
+extern const std::string& METRIC_COMPONENT_PROCESS_LATENCY_MS;
 
 /**********************************************************
  *   batcher
@@ -241,6 +248,9 @@ extern const std::string METRIC_COMPONENT_BATCHER_BUFFERED_GROUPS_TOTAL;
 extern const std::string METRIC_COMPONENT_BATCHER_BUFFERED_EVENTS_TOTAL;
 extern const std::string METRIC_COMPONENT_BATCHER_BUFFERED_SIZE_BYTES;
 extern const std::string METRIC_COMPONENT_BATCHER_TOTAL_ADD_TIME_MS;
+extern const std::string METRIC_COMPONENT_BATCHER_ADD_LATENCY_MS;
+extern const std::string METRIC_COMPONENT_BATCHER_TARGET_SIZE_BYTES;
+extern const std::string METRIC_COMPONENT_BATCHER_TARGET_CNT;
 
 /**********************************************************
  *   queue
@@ -275,6 +285,9 @@ extern const std::string METRIC_LABEL_VALUE_RUNNER_NAME_HTTP_SINK;
 extern const std::string METRIC_LABEL_VALUE_RUNNER_NAME_PROCESSOR;
 extern const std::string METRIC_LABEL_VALUE_RUNNER_NAME_PROMETHEUS;
 extern const std::string METRIC_LABEL_VALUE_RUNNER_NAME_EBPF_SERVER;
+extern const std::string METRIC_LABEL_VALUE_RUNNER_NAME_K8S_METADATA;
+extern const std::string METRIC_LABEL_VALUE_RUNNER_NAME_CHECKPOINT;
+extern const std::string METRIC_LABEL_VALUE_RUNNER_NAME_SERIALIZER;
 
 // metric keys
 extern const std::string& METRIC_RUNNER_IN_EVENTS_TOTAL;
@@ -295,6 +308,8 @@ extern const std::string METRIC_RUNNER_SINK_OUT_SUCCESSFUL_ITEMS_TOTAL;
 extern const std::string METRIC_RUNNER_SINK_OUT_FAILED_ITEMS_TOTAL;
 extern const std::string METRIC_RUNNER_SINK_SUCCESSFUL_ITEM_TOTAL_RESPONSE_TIME_MS;
 extern const std::string METRIC_RUNNER_SINK_FAILED_ITEM_TOTAL_RESPONSE_TIME_MS;
+extern const std::string METRIC_RUNNER_SINK_RESPONSE_LATENCY_MS;
+extern const std::string METRIC_RUNNER_SINK_DELIVERY_LATENCY_MS;
 extern const std::string METRIC_RUNNER_SINK_SENDING_ITEMS_TOTAL;
 extern const std::string METRIC_RUNNER_SINK_SEND_CONCURRENCY;
 
@@ -304,6 +319,13 @@ extern const std::string METRIC_RUNNER_SINK_SEND_CONCURRENCY;
 extern const std::string METRIC_RUNNER_FLUSHER_IN_RAW_SIZE_BYTES;
 extern const std::string METRIC_RUNNER_FLUSHER_WAITING_ITEMS_TOTAL;
 
+/**********************************************************
+ *   serializer runner
+ **********************************************************/
+extern const std::string METRIC_RUNNER_SERIALIZER_STOLEN_ITEMS_TOTAL;
+extern const std::string METRIC_RUNNER_SERIALIZER_PENDING_ITEMS_TOTAL;
+extern const std::string METRIC_RUNNER_SERIALIZER_FAILED_ITEMS_TOTAL;
+
 /**********************************************************
  *   file server
  **********************************************************/
@@ -311,8 +333,12 @@ extern const std::string METRIC_RUNNER_FILE_WATCHED_DIRS_TOTAL;
 extern const std::string METRIC_RUNNER_FILE_ACTIVE_READERS_TOTAL;
 extern const std::string METRIC_RUNNER_FILE_ENABLE_FILE_INCLUDED_BY_MULTI_CONFIGS_FLAG;
 extern const std::string METRIC_RUNNER_FILE_POLLING_MODIFY_CACHE_SIZE;
+extern const std::string METRIC_RUNNER_FILE_POLLING_MODIFY_CYCLE_TIME_MS;
+extern const std::string METRIC_RUNNER_FILE_POLLING_MODIFY_CHECKED_FILES_TOTAL;
 extern const std::string METRIC_RUNNER_FILE_POLLING_DIR_CACHE_SIZE;
 extern const std::string METRIC_RUNNER_FILE_POLLING_FILE_CACHE_SIZE;
+extern const std::string METRIC_RUNNER_FILE_CONTAINER_PATH_UPDATE_LATENCY_MS;
+extern const std::string METRIC_RUNNER_FILE_CONFIG_UPDATE_PAUSE_MS;
 
 /**********************************************************
  *   ebpf server
@@ -321,4 +347,20 @@ extern const std::string METRIC_RUNNER_EBPF_START_PLUGIN_TOTAL;
 extern const std::string METRIC_RUNNER_EBPF_STOP_PLUGIN_TOTAL;
 extern const std::string METRIC_RUNNER_EBPF_SUSPEND_PLUGIN_TOTAL;
 
+/**********************************************************
+ *   k8s metadata
+ **********************************************************/
+extern const std::string METRIC_RUNNER_METADATA_CACHE_HIT_TOTAL;
+extern const std::string METRIC_RUNNER_METADATA_CACHE_MISS_TOTAL;
+extern const std::string METRIC_RUNNER_METADATA_REQUESTS_TOTAL;
+extern const std::string METRIC_RUNNER_METADATA_FAILED_REQUESTS_TOTAL;
+extern const std::string METRIC_RUNNER_METADATA_RESOLVE_LATENCY_MS;
+
+/**********************************************************
+ *   exactly once checkpoint
+ **********************************************************/
+extern const std::string METRIC_RUNNER_CHECKPOINT_COMMITS_TOTAL;
+extern const std::string METRIC_RUNNER_CHECKPOINT_COMMITTED_CHECKPOINTS_TOTAL;
+extern const std::string METRIC_RUNNER_CHECKPOINT_COMMIT_LATENCY_MS;
+
 } // namespace logtail
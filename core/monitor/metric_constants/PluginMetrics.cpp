@@ -32,6 +32,7 @@ const string& METRIC_PLUGIN_OUT_EVENT_GROUPS_TOTAL = METRIC_OUT_EVENT_GROUPS_TOT
 const string& METRIC_PLUGIN_OUT_SIZE_BYTES = METRIC_OUT_SIZE_BYTES;
 const string& METRIC_PLUGIN_TOTAL_DELAY_MS = METRIC_TOTAL_DELAY_MS;
 const string& METRIC_PLUGIN_TOTAL_PROCESS_TIME_MS = METRIC_TOTAL_PROCESS_TIME_MS;
+const string& METRIC_PLUGIN_PROCESS_LATENCY_MS = METRIC_PROCESS_LATENCY_MS;
 
 /**********************************************************
  *   input_file
@@ -44,6 +45,7 @@ const string METRIC_LABEL_KEY_FILE_NAME = "file_name";
 const string METRIC_PLUGIN_MONITOR_FILE_TOTAL = "monitor_file_total";
 const string METRIC_PLUGIN_SOURCE_READ_OFFSET_BYTES = "read_offset_bytes";
 const string METRIC_PLUGIN_SOURCE_SIZE_BYTES = "size_bytes";
+const string METRIC_PLUGIN_SOURCE_LAG_BYTES = "lag_bytes";
 
 /**********************************************************
  *   input_prometheus
@@ -30,6 +30,9 @@ const string METRIC_LABEL_VALUE_RUNNER_NAME_HTTP_SINK = "http_sink";
 const string METRIC_LABEL_VALUE_RUNNER_NAME_PROCESSOR = "processor_runner";
 const string METRIC_LABEL_VALUE_RUNNER_NAME_PROMETHEUS = "prometheus_runner";
 const string METRIC_LABEL_VALUE_RUNNER_NAME_EBPF_SERVER = "ebpf_server";
+const string METRIC_LABEL_VALUE_RUNNER_NAME_K8S_METADATA = "k8s_metadata";
+const string METRIC_LABEL_VALUE_RUNNER_NAME_CHECKPOINT = "checkpoint_manager";
+const string METRIC_LABEL_VALUE_RUNNER_NAME_SERIALIZER = "serializer_runner";
 
 // metric keys
 const string& METRIC_RUNNER_IN_EVENTS_TOTAL = METRIC_IN_EVENTS_TOTAL;
@@ -50,6 +53,8 @@ const string METRIC_RUNNER_SINK_OUT_SUCCESSFUL_ITEMS_TOTAL = "out_successful_ite
 const string METRIC_RUNNER_SINK_OUT_FAILED_ITEMS_TOTAL = "out_failed_items_total";
 const string METRIC_RUNNER_SINK_SUCCESSFUL_ITEM_TOTAL_RESPONSE_TIME_MS = "successful_response_time_ms";
 const string METRIC_RUNNER_SINK_FAILED_ITEM_TOTAL_RESPONSE_TIME_MS = "failed_response_time_ms";
+const string METRIC_RUNNER_SINK_RESPONSE_LATENCY_MS = "response_latency_ms";
+const string METRIC_RUNNER_SINK_DELIVERY_LATENCY_MS = "delivery_latency_ms";
 const string METRIC_RUNNER_SINK_SENDING_ITEMS_TOTAL = "sending_items_total";
 const string METRIC_RUNNER_SINK_SEND_CONCURRENCY = "send_concurrency";
 
@@ -59,6 +64,13 @@ const string METRIC_RUNNER_SINK_SEND_CONCURRENCY = "send_concurrency";
 const string METRIC_RUNNER_FLUSHER_IN_RAW_SIZE_BYTES = "in_raw_size_bytes";
 const string METRIC_RUNNER_FLUSHER_WAITING_ITEMS_TOTAL = "waiting_items_total";
 
+/**********************************************************
+ *   serializer runner
+ **********************************************************/
+const string METRIC_RUNNER_SERIALIZER_STOLEN_ITEMS_TOTAL = "stolen_items_total";
+const string METRIC_RUNNER_SERIALIZER_PENDING_ITEMS_TOTAL = "pending_items_total";
+const string METRIC_RUNNER_SERIALIZER_FAILED_ITEMS_TOTAL = "failed_items_total";
+
 /**********************************************************
  *   file server
  **********************************************************/
@@ -66,8 +78,12 @@ const string METRIC_RUNNER_FILE_WATCHED_DIRS_TOTAL = "watched_dirs_total";
 const string METRIC_RUNNER_FILE_ACTIVE_READERS_TOTAL = "active_readers_total";
 const string METRIC_RUNNER_FILE_ENABLE_FILE_INCLUDED_BY_MULTI_CONFIGS_FLAG = "enable_multi_configs";
 const string METRIC_RUNNER_FILE_POLLING_MODIFY_CACHE_SIZE = "polling_modify_cache_size";
+const string METRIC_RUNNER_FILE_POLLING_MODIFY_CYCLE_TIME_MS = "polling_modify_cycle_time_ms";
+const string METRIC_RUNNER_FILE_POLLING_MODIFY_CHECKED_FILES_TOTAL = "polling_modify_checked_files_total";
 const string METRIC_RUNNER_FILE_POLLING_DIR_CACHE_SIZE = "polling_dir_cache_size";
 const string METRIC_RUNNER_FILE_POLLING_FILE_CACHE_SIZE = "polling_file_cache_size";
+const string METRIC_RUNNER_FILE_CONTAINER_PATH_UPDATE_LATENCY_MS = "container_path_update_latency_ms";
+const string METRIC_RUNNER_FILE_CONFIG_UPDATE_PAUSE_MS = "config_update_pause_ms";
 
 /**********************************************************
  *   ebpf server
@@ -76,4 +92,20 @@ const string METRIC_RUNNER_EBPF_START_PLUGIN_TOTAL = "start_plugin_total";
 const string METRIC_RUNNER_EBPF_STOP_PLUGIN_TOTAL = "stop_plugin_total";
 const string METRIC_RUNNER_EBPF_SUSPEND_PLUGIN_TOTAL = "suspend_plugin_total";
 
+/**********************************************************
+ *   k8s metadata
+ **********************************************************/
+const string METRIC_RUNNER_METADATA_CACHE_HIT_TOTAL = "cache_hit_total";
+const string METRIC_RUNNER_METADATA_CACHE_MISS_TOTAL = "cache_miss_total";
+const string METRIC_RUNNER_METADATA_REQUESTS_TOTAL = "requests_total";
+const string METRIC_RUNNER_METADATA_FAILED_REQUESTS_TOTAL = "failed_requests_total";
+const string METRIC_RUNNER_METADATA_RESOLVE_LATENCY_MS = "resolve_latency_ms";
+
+/**********************************************************
+ *   exactly once checkpoint
+ **********************************************************/
+const string METRIC_RUNNER_CHECKPOINT_COMMITS_TOTAL = "commits_total";
+const string METRIC_RUNNER_CHECKPOINT_COMMITTED_CHECKPOINTS_TOTAL = "committed_checkpoints_total";
+const string METRIC_RUNNER_CHECKPOINT_COMMIT_LATENCY_MS = "commit_latency_ms";
+
 } // namespace logtail
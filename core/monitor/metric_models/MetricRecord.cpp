@@ -42,6 +42,18 @@ TimeCounterPtr MetricsRecord::CreateTimeCounter(const std::string& name) {
     return counterPtr;
 }
 
+ShardedCounterPtr MetricsRecord::CreateShardedCounter(const std::string& name) {
+    ShardedCounterPtr counterPtr = std::make_shared<ShardedCounter>(name);
+    mShardedCounters.emplace_back(counterPtr);
+    return counterPtr;
+}
+
+ShardedTimeCounterPtr MetricsRecord::CreateShardedTimeCounter(const std::string& name) {
+    ShardedTimeCounterPtr counterPtr = std::make_shared<ShardedTimeCounter>(name);
+    mShardedTimeCounters.emplace_back(counterPtr);
+    return counterPtr;
+}
+
 IntGaugePtr MetricsRecord::CreateIntGauge(const std::string& name) {
     IntGaugePtr gaugePtr = std::make_shared<IntGauge>(name);
     mIntGauges.emplace_back(gaugePtr);
@@ -54,6 +66,12 @@ DoubleGaugePtr MetricsRecord::CreateDoubleGauge(const std::string& name) {
     return gaugePtr;
 }
 
+HistogramPtr MetricsRecord::CreateHistogram(const std::string& name) {
+    HistogramPtr histogramPtr = std::make_shared<Histogram>(name);
+    mHistograms.emplace_back(histogramPtr);
+    return histogramPtr;
+}
+
 void MetricsRecord::MarkDeleted() {
     mDeleted = true;
 }
@@ -82,6 +100,14 @@ const std::vector<TimeCounterPtr>& MetricsRecord::GetTimeCounters() const {
     return mTimeCounters;
 }
 
+const std::vector<ShardedCounterPtr>& MetricsRecord::GetShardedCounters() const {
+    return mShardedCounters;
+}
+
+const std::vector<ShardedTimeCounterPtr>& MetricsRecord::GetShardedTimeCounters() const {
+    return mShardedTimeCounters;
+}
+
 const std::vector<IntGaugePtr>& MetricsRecord::GetIntGauges() const {
     return mIntGauges;
 }
@@ -90,25 +116,8 @@ const std::vector<DoubleGaugePtr>& MetricsRecord::GetDoubleGauges() const {
     return mDoubleGauges;
 }
 
-MetricsRecord* MetricsRecord::Collect() {
-    MetricsRecord* metrics = new MetricsRecord(mCategory, mLabels, mDynamicLabels);
-    for (auto& item : mCounters) {
-        CounterPtr newPtr(item->Collect());
-        metrics->mCounters.emplace_back(newPtr);
-    }
-    for (auto& item : mTimeCounters) {
-        TimeCounterPtr newPtr(item->Collect());
-        metrics->mTimeCounters.emplace_back(newPtr);
-    }
-    for (auto& item : mIntGauges) {
-        IntGaugePtr newPtr(item->Collect());
-        metrics->mIntGauges.emplace_back(newPtr);
-    }
-    for (auto& item : mDoubleGauges) {
-        DoubleGaugePtr newPtr(item->Collect());
-        metrics->mDoubleGauges.emplace_back(newPtr);
-    }
-    return metrics;
+const std::vector<HistogramPtr>& MetricsRecord::GetHistograms() const {
+    return mHistograms;
 }
 
 MetricsRecord* MetricsRecord::GetNext() const {
@@ -119,6 +128,55 @@ void MetricsRecord::SetNext(MetricsRecord* next) {
     mNext = next;
 }
 
+void MetricsRecordSnapshot::Update(MetricsRecord& record) {
+    // assigning to existing strings and vectors reuses their capacity
+    mCategory = record.GetCategory();
+    mLabels = record.GetLabels();
+    mDynamicLabels = record.GetDynamicLabels();
+
+    const auto& counters = record.GetCounters();
+    const auto& timeCounters = record.GetTimeCounters();
+    const auto& shardedCounters = record.GetShardedCounters();
+    const auto& shardedTimeCounters = record.GetShardedTimeCounters();
+    mCounters.resize(counters.size() + timeCounters.size() + shardedCounters.size() + shardedTimeCounters.size());
+    size_t idx = 0;
+    for (const auto& item : counters) {
+        mCounters[idx].first = item->GetName();
+        mCounters[idx++].second = item->Collect();
+    }
+    for (const auto& item : timeCounters) {
+        mCounters[idx].first = item->GetName();
+        mCounters[idx++].second = item->Collect();
+    }
+    for (const auto& item : shardedCounters) {
+        mCounters[idx].first = item->GetName();
+        mCounters[idx++].second = item->Collect();
+    }
+    for (const auto& item : shardedTimeCounters) {
+        mCounters[idx].first = item->GetName();
+        mCounters[idx++].second = item->Collect();
+    }
+
+    const auto& intGauges = record.GetIntGauges();
+    mIntGauges.resize(intGauges.size());
+    for (size_t i = 0; i < intGauges.size(); ++i) {
+        mIntGauges[i].first = intGauges[i]->GetName();
+        mIntGauges[i].second = intGauges[i]->GetValue();
+    }
+    const auto& doubleGauges = record.GetDoubleGauges();
+    mDoubleGauges.resize(doubleGauges.size());
+    for (size_t i = 0; i < doubleGauges.size(); ++i) {
+        mDoubleGauges[i].first = doubleGauges[i]->GetName();
+        mDoubleGauges[i].second = doubleGauges[i]->GetValue();
+    }
+    const auto& histograms = record.GetHistograms();
+    mHistograms.resize(histograms.size());
+    for (size_t i = 0; i < histograms.size(); ++i) {
+        mHistograms[i].first = histograms[i]->GetName();
+        histograms[i]->Collect(mHistograms[i].second);
+    }
+}
+
 MetricsRecordRef::~MetricsRecordRef() {
     if (mMetrics) {
         mMetrics->MarkDeleted();
@@ -149,6 +207,14 @@ TimeCounterPtr MetricsRecordRef::CreateTimeCounter(const std::string& name) {
     return mMetrics->CreateTimeCounter(name);
 }
 
+ShardedCounterPtr MetricsRecordRef::CreateShardedCounter(const std::string& name) {
+    return mMetrics->CreateShardedCounter(name);
+}
+
+ShardedTimeCounterPtr MetricsRecordRef::CreateShardedTimeCounter(const std::string& name) {
+    return mMetrics->CreateShardedTimeCounter(name);
+}
+
 IntGaugePtr MetricsRecordRef::CreateIntGauge(const std::string& name) {
     return mMetrics->CreateIntGauge(name);
 }
@@ -157,6 +223,10 @@ DoubleGaugePtr MetricsRecordRef::CreateDoubleGauge(const std::string& name) {
     return mMetrics->CreateDoubleGauge(name);
 }
 
+HistogramPtr MetricsRecordRef::CreateHistogram(const std::string& name) {
+    return mMetrics->CreateHistogram(name);
+}
+
 const MetricsRecord* MetricsRecordRef::operator->() const {
     return mMetrics;
 }
@@ -37,8 +37,11 @@ private:
     DynamicMetricLabelsPtr mDynamicLabels;
     std::vector<CounterPtr> mCounters;
     std::vector<TimeCounterPtr> mTimeCounters;
+    std::vector<ShardedCounterPtr> mShardedCounters;
+    std::vector<ShardedTimeCounterPtr> mShardedTimeCounters;
     std::vector<IntGaugePtr> mIntGauges;
     std::vector<DoubleGaugePtr> mDoubleGauges;
+    std::vector<HistogramPtr> mHistograms;
 
     std::atomic_bool mDeleted;
     MetricsRecord* mNext = nullptr;
@@ -53,17 +56,47 @@ public:
     const DynamicMetricLabelsPtr& GetDynamicLabels() const;
     const std::vector<CounterPtr>& GetCounters() const;
     const std::vector<TimeCounterPtr>& GetTimeCounters() const;
+    const std::vector<ShardedCounterPtr>& GetShardedCounters() const;
+    const std::vector<ShardedTimeCounterPtr>& GetShardedTimeCounters() const;
     const std::vector<IntGaugePtr>& GetIntGauges() const;
     const std::vector<DoubleGaugePtr>& GetDoubleGauges() const;
+    const std::vector<HistogramPtr>& GetHistograms() const;
     CounterPtr CreateCounter(const std::string& name);
     TimeCounterPtr CreateTimeCounter(const std::string& name);
+    ShardedCounterPtr CreateShardedCounter(const std::string& name);
+    ShardedTimeCounterPtr CreateShardedTimeCounter(const std::string& name);
     IntGaugePtr CreateIntGauge(const std::string& name);
     DoubleGaugePtr CreateDoubleGauge(const std::string& name);
-    MetricsRecord* Collect();
+    HistogramPtr CreateHistogram(const std::string& name);
     void SetNext(MetricsRecord* next);
     MetricsRecord* GetNext() const;
 };
 
+// Values of a MetricsRecord taken by WriteMetrics::DoSnapshot. Counters are reset on each snapshot. Snapshots are
+// reused across collections, so nothing is allocated once the set of records and metrics is stable.
+class MetricsRecordSnapshot {
+public:
+    void Update(MetricsRecord& record);
+
+    const std::string& GetCategory() const { return mCategory; }
+    const MetricLabelsPtr& GetLabels() const { return mLabels; }
+    const DynamicMetricLabelsPtr& GetDynamicLabels() const { return mDynamicLabels; }
+    const std::vector<std::pair<std::string, uint64_t>>& GetCounters() const { return mCounters; }
+    const std::vector<std::pair<std::string, uint64_t>>& GetIntGauges() const { return mIntGauges; }
+    const std::vector<std::pair<std::string, double>>& GetDoubleGauges() const { return mDoubleGauges; }
+    const std::vector<std::pair<std::string, HistogramValue>>& GetHistograms() const { return mHistograms; }
+
+private:
+    std::string mCategory;
+    MetricLabelsPtr mLabels;
+    DynamicMetricLabelsPtr mDynamicLabels;
+    // all kinds of counters are collected together, with time counters in ms
+    std::vector<std::pair<std::string, uint64_t>> mCounters;
+    std::vector<std::pair<std::string, uint64_t>> mIntGauges;
+    std::vector<std::pair<std::string, double>> mDoubleGauges;
+    std::vector<std::pair<std::string, HistogramValue>> mHistograms;
+};
+
 class MetricsRecordRef {
     friend class WriteMetrics;
     friend bool operator==(const MetricsRecordRef& lhs, std::nullptr_t rhs);
@@ -85,8 +118,11 @@ public:
     const DynamicMetricLabelsPtr& GetDynamicLabels() const;
     CounterPtr CreateCounter(const std::string& name);
     TimeCounterPtr CreateTimeCounter(const std::string& name);
+    ShardedCounterPtr CreateShardedCounter(const std::string& name);
+    ShardedTimeCounterPtr CreateShardedTimeCounter(const std::string& name);
     IntGaugePtr CreateIntGauge(const std::string& name);
     DoubleGaugePtr CreateDoubleGauge(const std::string& name);
+    HistogramPtr CreateHistogram(const std::string& name);
     const MetricsRecord* operator->() const;
     // this is not thread-safe, and should be only used before WriteMetrics::CommitMetricsRecordRef
     void AddLabels(MetricLabels&& labels);
@@ -0,0 +1,72 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "monitor/metric_models/MetricTypes.h"
+
+namespace logtail {
+
+void Histogram::Read(HistogramValue& value) const {
+    std::array<uint64_t, kBucketCnt> buckets;
+    for (size_t i = 0; i < kBucketCnt; ++i) {
+        buckets[i] = mBuckets[i].load(std::memory_order_relaxed);
+    }
+    Summarize(buckets, mSumUs.Load(), value);
+}
+
+void Histogram::Collect(HistogramValue& value) {
+    std::array<uint64_t, kBucketCnt> buckets;
+    for (size_t i = 0; i < kBucketCnt; ++i) {
+        buckets[i] = mBuckets[i].exchange(0, std::memory_order_relaxed);
+    }
+    Summarize(buckets, mSumUs.Exchange(), value);
+}
+
+void Histogram::Summarize(const std::array<uint64_t, kBucketCnt>& buckets, uint64_t sumUs, HistogramValue& value) {
+    value = HistogramValue();
+    for (auto cnt : buckets) {
+        value.mCount += cnt;
+    }
+    if (value.mCount == 0) {
+        return;
+    }
+    value.mAvgMs = static_cast<double>(sumUs) / value.mCount / 1000;
+
+    // ranks are 1-based, e.g. p99 of 100 values is the 99th smallest one
+    uint64_t p50Rank = (value.mCount * 50 + 99) / 100;
+    uint64_t p90Rank = (value.mCount * 90 + 99) / 100;
+    uint64_t p99Rank = (value.mCount * 99 + 99) / 100;
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBucketCnt; ++i) {
+        if (buckets[i] == 0) {
+            continue;
+        }
+        uint64_t prev = seen;
+        seen += buckets[i];
+        double bound = static_cast<double>(GetBucketUpperBound(i)) / 1000;
+        if (prev < p50Rank && seen >= p50Rank) {
+            value.mP50Ms = bound;
+        }
+        if (prev < p90Rank && seen >= p90Rank) {
+            value.mP90Ms = bound;
+        }
+        if (prev < p99Rank && seen >= p99Rank) {
+            value.mP99Ms = bound;
+        }
+        value.mMaxMs = bound;
+    }
+}
+
+} // namespace logtail
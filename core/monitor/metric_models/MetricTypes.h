@@ -19,6 +19,7 @@
 #include <chrono>
 #include <cstdint>
 
+#include <array>
 #include <atomic>
 #include <functional>
 #include <memory>
@@ -34,6 +35,7 @@ enum class MetricType {
     METRIC_TYPE_TIME_COUNTER,
     METRIC_TYPE_INT_GAUGE,
     METRIC_TYPE_DOUBLE_GAUGE,
+    METRIC_TYPE_HISTOGRAM,
 };
 
 class Counter {
@@ -46,7 +48,8 @@ public:
     uint64_t GetValue() const { return mVal.load(); }
     const std::string& GetName() const { return mName; }
     void Add(uint64_t val) { mVal.fetch_add(val); }
-    Counter* Collect() { return new Counter(mName, mVal.exchange(0)); }
+    // returns the value accumulated since the last collection
+    uint64_t Collect() { return mVal.exchange(0); }
 };
 
 // input: nanosecond, output: milisecond
@@ -55,7 +58,71 @@ public:
     TimeCounter(const std::string& name, uint64_t val = 0) : Counter(name, val) {}
     uint64_t GetValue() const { return mVal.load() / 1000000; }
     void Add(std::chrono::nanoseconds val) { mVal.fetch_add(val.count()); }
-    TimeCounter* Collect() { return new TimeCounter(mName, mVal.exchange(0)); }
+    uint64_t Collect() { return mVal.exchange(0) / 1000000; }
+};
+
+// To keep threads from contending on one cache line, the value is split into cache-line-aligned shards, and each
+// thread always adds to the same shard. Shards are summed on read.
+class CounterShards {
+public:
+    static constexpr size_t kShardCnt = 8;
+
+    explicit CounterShards(uint64_t val = 0) { mShards[0].mVal.store(val, std::memory_order_relaxed); }
+
+    void Add(uint64_t val) { mShards[GetShardIndex()].mVal.fetch_add(val, std::memory_order_relaxed); }
+    uint64_t Load() const {
+        uint64_t sum = 0;
+        for (const auto& shard : mShards) {
+            sum += shard.mVal.load(std::memory_order_relaxed);
+        }
+        return sum;
+    }
+    uint64_t Exchange() {
+        uint64_t sum = 0;
+        for (auto& shard : mShards) {
+            sum += shard.mVal.exchange(0, std::memory_order_relaxed);
+        }
+        return sum;
+    }
+
+private:
+    struct alignas(64) Shard {
+        std::atomic_uint64_t mVal{0};
+    };
+
+    // threads are assigned to shards in a round-robin manner
+    static size_t GetShardIndex() {
+        static std::atomic_size_t sNextIndex{0};
+        static thread_local size_t sIndex = sNextIndex.fetch_add(1, std::memory_order_relaxed) % kShardCnt;
+        return sIndex;
+    }
+
+    std::array<Shard, kShardCnt> mShards;
+};
+
+// Same as Counter, but kept in CounterShards. It takes kShardCnt cache lines, so it should only be used for counters
+// updated by all processing threads concurrently, e.g. the ones of a pipeline updated for each event group.
+class ShardedCounter {
+protected:
+    std::string mName;
+    CounterShards mVal;
+
+public:
+    ShardedCounter(const std::string& name, uint64_t val = 0) : mName(name), mVal(val) {}
+    uint64_t GetValue() const { return mVal.Load(); }
+    const std::string& GetName() const { return mName; }
+    void Add(uint64_t val) { mVal.Add(val); }
+    // returns the value accumulated since the last collection
+    uint64_t Collect() { return mVal.Exchange(); }
+};
+
+// input: nanosecond, output: milisecond
+class ShardedTimeCounter : public ShardedCounter {
+public:
+    ShardedTimeCounter(const std::string& name, uint64_t val = 0) : ShardedCounter(name, val) {}
+    uint64_t GetValue() const { return mVal.Load() / 1000000; }
+    void Add(std::chrono::nanoseconds val) { mVal.Add(val.count()); }
+    uint64_t Collect() { return mVal.Exchange() / 1000000; }
 };
 
 template <typename T>
@@ -67,7 +134,6 @@ public:
     T GetValue() const { return mVal.load(); }
     const std::string& GetName() const { return mName; }
     void Set(T val) { mVal.store(val); }
-    Gauge* Collect() { return new Gauge<T>(mName, mVal.load()); }
 
 protected:
     std::string mName;
@@ -79,15 +145,86 @@ public:
     IntGauge(const std::string& name, uint64_t val = 0) : Gauge<uint64_t>(name, val) {}
     ~IntGauge() = default;
 
-    IntGauge* Collect() { return new IntGauge(mName, mVal.load()); }
     void Add(uint64_t val) { mVal.fetch_add(val); }
     void Sub(uint64_t val) { mVal.fetch_sub(val); }
 };
 
+struct HistogramValue {
+    uint64_t mCount = 0;
+    double mAvgMs = 0.0;
+    double mP50Ms = 0.0;
+    double mP90Ms = 0.0;
+    double mP99Ms = 0.0;
+    double mMaxMs = 0.0;
+};
+
+// Latency histogram with log-linear buckets in microseconds: 4 linear buckets per power of two, so percentiles are
+// reported with at most 25% relative error. Values of 2^32us (about 71 minutes) or more fall into the last bucket.
+// Recording touches one bucket and the sharded sum, so concurrent threads rarely write to the same cache line.
+class Histogram {
+public:
+    static constexpr size_t kSubBucketBits = 2;
+    static constexpr size_t kSubBucketCnt = 1 << kSubBucketBits;
+    static constexpr size_t kMaxExponent = 32;
+    static constexpr size_t kBucketCnt = kSubBucketCnt * (kMaxExponent - kSubBucketBits + 1);
+
+    Histogram(const std::string& name) : mName(name) {}
+
+    const std::string& GetName() const { return mName; }
+    void Record(std::chrono::nanoseconds val) {
+        uint64_t us = val.count() > 0 ? static_cast<uint64_t>(val.count()) / 1000 : 0;
+        mBuckets[GetBucketIndex(us)].fetch_add(1, std::memory_order_relaxed);
+        mSumUs.Add(us);
+    }
+    void Read(HistogramValue& value) const;
+    // returns the distribution recorded since the last collection
+    void Collect(HistogramValue& value);
+
+    static size_t GetBucketIndex(uint64_t us) {
+        if (us < kSubBucketCnt) {
+            return static_cast<size_t>(us);
+        }
+        size_t exp = Log2(us);
+        if (exp >= kMaxExponent) {
+            return kBucketCnt - 1;
+        }
+        return (exp - kSubBucketBits + 1) * kSubBucketCnt + ((us >> (exp - kSubBucketBits)) & (kSubBucketCnt - 1));
+    }
+    // exclusive upper bound of the values in the bucket
+    static uint64_t GetBucketUpperBound(size_t idx) {
+        if (idx < kSubBucketCnt) {
+            return idx + 1;
+        }
+        size_t exp = idx / kSubBucketCnt + kSubBucketBits - 1;
+        return (kSubBucketCnt + idx % kSubBucketCnt + 1) << (exp - kSubBucketBits);
+    }
+
+private:
+    static size_t Log2(uint64_t val) {
+        size_t res = 0;
+        for (size_t shift = 32; shift > 0; shift >>= 1) {
+            if (val >> shift) {
+                val >>= shift;
+                res += shift;
+            }
+        }
+        return res;
+    }
+
+    static void Summarize(const std::array<uint64_t, kBucketCnt>& buckets, uint64_t sumUs, HistogramValue& value);
+
+    std::string mName;
+    std::array<std::atomic_uint64_t, kBucketCnt> mBuckets{};
+    CounterShards mSumUs;
+};
+
 using CounterPtr = std::shared_ptr<Counter>;
 using TimeCounterPtr = std::shared_ptr<TimeCounter>;
+using ShardedCounterPtr = std::shared_ptr<ShardedCounter>;
+using ShardedTimeCounterPtr = std::shared_ptr<ShardedTimeCounter>;
 using IntGaugePtr = std::shared_ptr<IntGauge>;
 using DoubleGaugePtr = std::shared_ptr<Gauge<double>>;
+using HistogramPtr = std::shared_ptr<Histogram>;
 
 using MetricLabels = std::vector<std::pair<std::string, std::string>>;
 using MetricLabelsPtr = std::shared_ptr<MetricLabels>;
@@ -53,6 +53,12 @@ SelfMonitorMetricEvent::SelfMonitorMetricEvent(MetricsRecord* metricRecord) {
     for (auto& item : metricRecord->GetTimeCounters()) {
         mCounters[item->GetName()] = item->GetValue();
     }
+    for (auto& item : metricRecord->GetShardedCounters()) {
+        mCounters[item->GetName()] = item->GetValue();
+    }
+    for (auto& item : metricRecord->GetShardedTimeCounters()) {
+        mCounters[item->GetName()] = item->GetValue();
+    }
     // gauges
     for (auto& item : metricRecord->GetIntGauges()) {
         mGauges[item->GetName()] = item->GetValue();
@@ -60,6 +66,40 @@ SelfMonitorMetricEvent::SelfMonitorMetricEvent(MetricsRecord* metricRecord) {
     for (auto& item : metricRecord->GetDoubleGauges()) {
         mGauges[item->GetName()] = item->GetValue();
     }
+    // histograms
+    for (auto& item : metricRecord->GetHistograms()) {
+        HistogramValue value;
+        item->Read(value);
+        AddHistogram(item->GetName(), value);
+    }
+    CreateKey();
+}
+
+SelfMonitorMetricEvent::SelfMonitorMetricEvent(const MetricsRecordSnapshot& snapshot) {
+    // category
+    mCategory = snapshot.GetCategory();
+    // labels
+    for (const auto& item : *snapshot.GetLabels()) {
+        mLabels[item.first] = item.second;
+    }
+    for (const auto& item : *snapshot.GetDynamicLabels()) {
+        mLabels[item.first] = item.second();
+    }
+    // counters
+    for (const auto& item : snapshot.GetCounters()) {
+        mCounters[item.first] = item.second;
+    }
+    // gauges
+    for (const auto& item : snapshot.GetIntGauges()) {
+        mGauges[item.first] = item.second;
+    }
+    for (const auto& item : snapshot.GetDoubleGauges()) {
+        mGauges[item.first] = item.second;
+    }
+    // histograms
+    for (const auto& item : snapshot.GetHistograms()) {
+        AddHistogram(item.first, item.second);
+    }
     CreateKey();
 }
 
@@ -130,6 +170,16 @@ void SelfMonitorMetricEvent::CreateKey() {
     mUpdatedFlag = true;
 }
 
+// a histogram is exported as a counter of recorded values and gauges of its distribution
+void SelfMonitorMetricEvent::AddHistogram(const std::string& name, const HistogramValue& value) {
+    mCounters[name + "_count"] = value.mCount;
+    mGauges[name + "_avg"] = value.mAvgMs;
+    mGauges[name + "_p50"] = value.mP50Ms;
+    mGauges[name + "_p90"] = value.mP90Ms;
+    mGauges[name + "_p99"] = value.mP99Ms;
+    mGauges[name + "_max"] = value.mMaxMs;
+}
+
 void SelfMonitorMetricEvent::SetInterval(size_t interval) {
     mLastSendInterval = 0;
     mSendInterval = interval;
@@ -39,6 +39,7 @@ class SelfMonitorMetricEvent {
 public:
     SelfMonitorMetricEvent();
     SelfMonitorMetricEvent(MetricsRecord* metricRecord);
+    SelfMonitorMetricEvent(const MetricsRecordSnapshot& snapshot);
     SelfMonitorMetricEvent(const std::map<std::string, std::string>& metricRecord);
 
     void SetInterval(size_t interval);
@@ -52,6 +53,7 @@ public:
     std::string mCategory; // category
 private:
     void CreateKey();
+    void AddHistogram(const std::string& name, const HistogramValue& value);
 
     std::unordered_map<std::string, std::string> mLabels;
     std::unordered_map<std::string, uint64_t> mCounters;
@@ -36,6 +36,7 @@
 #include "plugin/flusher/sls/SendResult.h"
 #include "provider/Provider.h"
 #include "runner/FlusherRunner.h"
+#include "runner/SerializerRunner.h"
 #include "sls_logs.pb.h"
 #ifdef __ENTERPRISE__
 #include "config/provider/EnterpriseConfigProvider.h"
@@ -697,6 +698,9 @@ void FlusherSLS::OnSendDone(const HttpResponse& response, SenderQueueItem* item)
     bool isProfileData = GetProfileSender()->IsProfileData(mRegion, mProject, data->mLogstore);
     int32_t curTime = time(NULL);
     auto curSystemTime = chrono::system_clock::now();
+    // item may be released below
+    auto responseTime = chrono::duration_cast<chrono::milliseconds>(curSystemTime - item->mLastSendTime);
+    auto queueTime = chrono::duration_cast<chrono::milliseconds>(item->mLastSendTime - item->mFirstEnqueTime);
     SendResult sendResult = SEND_OK;
     if (slsResponse.mStatusCode == 200) {
         auto& cpt = data->mExactlyOnceCheckpoint;
@@ -909,6 +913,7 @@ void FlusherSLS::OnSendDone(const HttpResponse& response, SenderQueueItem* item)
                 break;
         }
     }
+    mBatcher.OnSendDone(responseTime, queueTime, sendResult == SEND_QUOTA_EXCEED);
 #ifdef __ENTERPRISE__
     bool hasNetworkError = sendResult == SEND_NETWORK_ERROR;
     EnterpriseSLSClientManager::GetInstance()->UpdateHostStatus(
@@ -924,6 +929,7 @@ void FlusherSLS::OnSendDone(const HttpResponse& response, SenderQueueItem* item)
 }
 
 bool FlusherSLS::Send(string&& data, const string& shardHashKey, const string& logstore) {
+    size_t rawSize = data.size();
     string compressedData;
     if (mCompressor) {
         string errorMsg;
@@ -940,7 +946,7 @@ bool FlusherSLS::Send(string&& data, const string& shardHashKey, const string& l
             return false;
         }
     } else {
-        compressedData = data;
+        compressedData = std::move(data);
     }
 
     QueueKey key = mQueueKey;
@@ -953,7 +959,7 @@ bool FlusherSLS::Send(string&& data, const string& shardHashKey, const string& l
         }
     }
     return Flusher::PushToQueue(make_unique<SLSSenderQueueItem>(std::move(compressedData),
-                                                                data.size(),
+                                                                rawSize,
                                                                 this,
                                                                 key,
                                                                 logstore.empty() ? mLogstore : logstore,
@@ -1034,6 +1040,25 @@ bool FlusherSLS::SerializeAndPush(BatchedEventsList&& groupList) {
     if (groupList.empty()) {
         return true;
     }
+    // pack ids are assigned in flush order, even if the groups are serialized concurrently
+    for (auto& group : groupList) {
+        AddPackId(group);
+    }
+    if (SerializerRunner::GetInstance()->IsRunning()) {
+        // items of exactly once queues must be pushed in order, since their checkpoints are assigned in order
+        bool ordered = groupList[0].mExactlyOnceCheckpoint != nullptr;
+        QueueKey key = ordered ? groupList[0].mExactlyOnceCheckpoint->fbKey : mQueueKey;
+        auto list = make_shared<BatchedEventsList>(std::move(groupList));
+        if (SerializerRunner::GetInstance()->Submit(
+                this, key, ordered, [this, list]() { return DoSerializeAndPush(std::move(*list)); })) {
+            return true;
+        }
+        groupList = std::move(*list);
+    }
+    return DoSerializeAndPush(std::move(groupList));
+}
+
+bool FlusherSLS::DoSerializeAndPush(BatchedEventsList&& groupList) {
     vector<CompressedLogGroup> compressedLogGroups;
     string shardHashKey, serializedData, compressedData;
     size_t packageSize = 0;
@@ -1044,7 +1069,6 @@ bool FlusherSLS::SerializeAndPush(BatchedEventsList&& groupList) {
         if (!mShardHashKeys.empty()) {
             shardHashKey = GetShardHashKey(group);
         }
-        AddPackId(group);
         string errorMsg;
         if (!mGroupSerializer->DoSerialize(std::move(group), serializedData, errorMsg)) {
             LOG_WARNING(mContext->GetLogger(),
@@ -1075,6 +1099,7 @@ bool FlusherSLS::SerializeAndPush(BatchedEventsList&& groupList) {
                 allSucceeded = false;
                 continue;
             }
+            mBatcher.OnCompressed(serializedData.size(), compressedData.size());
         } else {
             compressedData = serializedData;
         }
@@ -170,6 +170,7 @@ bool InputFile::Init(const Json::Value& config, Json::Value& optionalGoPipeline)
         {METRIC_PLUGIN_OUT_SIZE_BYTES, MetricType::METRIC_TYPE_COUNTER},
         {METRIC_PLUGIN_SOURCE_SIZE_BYTES, MetricType::METRIC_TYPE_INT_GAUGE},
         {METRIC_PLUGIN_SOURCE_READ_OFFSET_BYTES, MetricType::METRIC_TYPE_INT_GAUGE},
+        {METRIC_PLUGIN_SOURCE_LAG_BYTES, MetricType::METRIC_TYPE_INT_GAUGE},
     };
     mPluginMetricManager = std::make_shared<PluginMetricManager>(
         GetMetricsRecordRef()->GetLabels(), inputFileMetricKeys, MetricCategory::METRIC_CATEGORY_PLUGIN_SOURCE);
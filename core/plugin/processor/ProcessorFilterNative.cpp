@@ -16,6 +16,10 @@
 
 #include "plugin/processor/ProcessorFilterNative.h"
 
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <string_view>
 #include <vector>
 
 #include "common/ParamExtractor.h"
@@ -53,7 +57,6 @@ bool ProcessorFilterNative::Init(const Json::Value& config) {
                              mContext->GetRegion());
     } else if (!filterKeys.empty()) {
         bool hasError = false;
-        std::vector<boost::regex> regs;
         for (const auto& reg : filterRegs) {
             if (!IsRegexValid(reg)) {
                 PARAM_WARNING_IGNORE(mContext->GetLogger(),
@@ -67,12 +70,13 @@ bool ProcessorFilterNative::Init(const Json::Value& config) {
                 hasError = true;
                 break;
             }
-            regs.emplace_back(reg);
         }
         if (!hasError) {
             mFilterRule = std::make_shared<LogFilterRule>();
-            mFilterRule->FilterKeys = filterKeys;
-            mFilterRule->FilterRegs = regs;
+            for (size_t i = 0; i < filterKeys.size(); ++i) {
+                mFilterRule->AddCondition(filterKeys[i], filterRegs[i]);
+            }
+            mFilterRule->SortConditions();
             mFilterMode = Mode::RULE_MODE;
         }
     }
@@ -90,8 +94,6 @@ bool ProcessorFilterNative::Init(const Json::Value& config) {
                                  mContext->GetLogstoreName(),
                                  mContext->GetRegion());
         } else if (!mInclude.empty()) {
-            std::vector<std::string> keys;
-            std::vector<boost::regex> regs;
             bool hasError = false;
             for (auto& include : mInclude) {
                 if (!IsRegexValid(include.second)) {
@@ -106,13 +108,13 @@ bool ProcessorFilterNative::Init(const Json::Value& config) {
                     hasError = true;
                     break;
                 }
-                keys.emplace_back(include.first);
-                regs.emplace_back(boost::regex(include.second));
             }
             if (!hasError) {
                 mFilterRule = std::make_shared<LogFilterRule>();
-                mFilterRule->FilterKeys = keys;
-                mFilterRule->FilterRegs = regs;
+                for (const auto& include : mInclude) {
+                    mFilterRule->AddCondition(include.first, include.second);
+                }
+                mFilterRule->SortConditions();
                 mFilterMode = Mode::RULE_MODE;
             }
         }
@@ -181,6 +183,10 @@ bool ProcessorFilterNative::Init(const Json::Value& config) {
                               mContext->GetRegion());
     }
 
+    mDiscardedEventsTotal = GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_DISCARDED_EVENTS_TOTAL);
+    mOutKeyNotFoundEventsTotal = GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_OUT_KEY_NOT_FOUND_EVENTS_TOTAL);
+    mMatchedEventsTotal = GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_MATCHED_EVENTS_TOTAL);
+
     return true;
 }
 
@@ -192,18 +198,25 @@ void ProcessorFilterNative::Process(PipelineEventGroup& logGroup) {
     EventsContainer& events = logGroup.MutableEvents();
 
     size_t wIdx = 0;
+    uint64_t keyNotFoundCnt = 0;
     for (size_t rIdx = 0; rIdx < events.size(); ++rIdx) {
-        if (ProcessEvent(events[rIdx])) {
+        FilterResult result = FilterResult::MATCHED;
+        if (ProcessEvent(events[rIdx], result)) {
             if (wIdx != rIdx) {
                 events[wIdx] = std::move(events[rIdx]);
             }
             ++wIdx;
+        } else if (result == FilterResult::KEY_NOT_FOUND) {
+            ++keyNotFoundCnt;
         }
     }
+    mMatchedEventsTotal->Add(wIdx);
+    mDiscardedEventsTotal->Add(events.size() - wIdx);
+    mOutKeyNotFoundEventsTotal->Add(keyNotFoundCnt);
     events.resize(wIdx);
 }
 
-bool ProcessorFilterNative::ProcessEvent(PipelineEventPtr& e) {
+bool ProcessorFilterNative::ProcessEvent(PipelineEventPtr& e, FilterResult& result) {
     if (!IsSupportedEvent(e)) {
         return true;
     }
@@ -213,8 +226,10 @@ bool ProcessorFilterNative::ProcessEvent(PipelineEventPtr& e) {
 
     if (mFilterMode == Mode::EXPRESSION_MODE) {
         res = FilterExpressionRoot(sourceEvent, mConditionExp);
+        result = res ? FilterResult::MATCHED : FilterResult::UNMATCHED;
     } else if (mFilterMode == Mode::RULE_MODE) {
-        res = FilterFilterRule(sourceEvent, mFilterRule.get());
+        result = FilterFilterRule(sourceEvent, mFilterRule.get());
+        res = result == FilterResult::MATCHED;
     }
     if (res && mDiscardingNonUTF8) {
         std::vector<std::pair<StringView, StringView> > newContents;
@@ -265,34 +280,36 @@ bool ProcessorFilterNative::FilterExpressionRoot(LogEvent& sourceEvent, const Ba
     }
 }
 
-bool ProcessorFilterNative::FilterFilterRule(LogEvent& sourceEvent, const LogFilterRule* filterRule) {
+ProcessorFilterNative::FilterResult ProcessorFilterNative::FilterFilterRule(LogEvent& sourceEvent,
+                                                                           const LogFilterRule* filterRule) {
     if (sourceEvent.Empty()) {
-        return false;
+        return FilterResult::UNMATCHED;
     }
 
     // null filterRule, all logs are passed
     if (filterRule == NULL) {
-        return true;
+        return FilterResult::MATCHED;
     }
 
     try {
         return IsMatched(sourceEvent, *filterRule);
     } catch (...) {
         LOG_ERROR(GetContext().GetLogger(), ("filter error ", ""));
-        return false;
+        return FilterResult::UNMATCHED;
     }
 }
 
-bool ProcessorFilterNative::IsMatched(const LogEvent& contents, const LogFilterRule& rule) {
+ProcessorFilterNative::FilterResult ProcessorFilterNative::IsMatched(const LogEvent& contents,
+                                                                     const LogFilterRule& rule) {
     const std::vector<std::string>& keys = rule.FilterKeys;
-    const std::vector<boost::regex> regs = rule.FilterRegs;
+    const std::vector<FilterMatcher>& matchers = rule.FilterMatchers;
     std::string exception;
     for (uint32_t i = 0; i < keys.size(); ++i) {
         const auto& content = contents.FindContent(keys[i]);
         if (content == contents.end()) {
-            return false;
+            return FilterResult::KEY_NOT_FOUND;
         }
-        if (!BoostRegexMatch(content->second.data(), content->second.size(), regs[i], exception)) {
+        if (!matchers[i].Match(content->second, exception)) {
             if (!exception.empty()) {
                 LOG_ERROR(GetContext().GetLogger(), ("regex_match in Filter fail", exception));
                 if (GetContext().GetAlarm().IsLowLevelAlarmValid()) {
@@ -303,7 +320,104 @@ bool ProcessorFilterNative::IsMatched(const LogEvent& contents, const LogFilterR
                                                       GetContext().GetRegion());
                 }
             }
+            return FilterResult::UNMATCHED;
+        }
+    }
+    return FilterResult::MATCHED;
+}
+
+void ProcessorFilterNative::LogFilterRule::AddCondition(const std::string& key, const std::string& exp) {
+    FilterKeys.emplace_back(key);
+    FilterMatchers.emplace_back(exp);
+}
+
+void ProcessorFilterNative::LogFilterRule::SortConditions() {
+    // all conditions must be met, so the cheapest ones are evaluated first
+    std::vector<size_t> order(FilterKeys.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](size_t lhs, size_t rhs) {
+        return FilterMatchers[lhs].GetType() < FilterMatchers[rhs].GetType();
+    });
+    std::vector<std::string> keys;
+    std::vector<FilterMatcher> matchers;
+    keys.reserve(order.size());
+    matchers.reserve(order.size());
+    for (auto idx : order) {
+        keys.emplace_back(std::move(FilterKeys[idx]));
+        matchers.emplace_back(std::move(FilterMatchers[idx]));
+    }
+    FilterKeys.swap(keys);
+    FilterMatchers.swap(matchers);
+}
+
+FilterMatcher::FilterMatcher(const std::string& exp) {
+    size_t begin = 0, end = exp.size();
+    // regex_match always matches the whole value, so the anchors can be ignored
+    if (begin < end && exp[begin] == '^') {
+        ++begin;
+    }
+    if (end > begin && exp[end - 1] == '$') {
+        --end;
+    }
+    bool anyPrefix = false, anySuffix = false;
+    if (end - begin >= 2 && exp.compare(begin, 2, ".*") == 0) {
+        anyPrefix = true;
+        begin += 2;
+    }
+    if (end - begin >= 2 && exp.compare(end - 2, 2, ".*") == 0) {
+        anySuffix = true;
+        end -= 2;
+    }
+    if (ParseLiteral(exp, begin, end, mLiteral)) {
+        if (anyPrefix && anySuffix) {
+            mType = mLiteral.empty() ? Type::ANY : Type::CONTAINS;
+        } else if (anyPrefix) {
+            mType = mLiteral.empty() ? Type::ANY : Type::SUFFIX;
+        } else if (anySuffix) {
+            mType = mLiteral.empty() ? Type::ANY : Type::PREFIX;
+        } else {
+            mType = Type::EXACT;
+        }
+        return;
+    }
+    mLiteral.clear();
+    mType = Type::REGEX;
+    mReg = std::make_shared<boost::regex>(exp);
+}
+
+bool FilterMatcher::Match(StringView value, std::string& exception) const {
+    switch (mType) {
+        case Type::ANY:
+            return true;
+        case Type::EXACT:
+            return value.size() == mLiteral.size() && memcmp(value.data(), mLiteral.data(), mLiteral.size()) == 0;
+        case Type::PREFIX:
+            return value.size() >= mLiteral.size() && memcmp(value.data(), mLiteral.data(), mLiteral.size()) == 0;
+        case Type::SUFFIX:
+            return value.size() >= mLiteral.size()
+                && memcmp(value.data() + value.size() - mLiteral.size(), mLiteral.data(), mLiteral.size()) == 0;
+        case Type::CONTAINS:
+            return std::string_view(value.data(), value.size()).find(mLiteral) != std::string_view::npos;
+        default:
+            return BoostRegexMatch(value.data(), value.size(), *mReg, exception);
+    }
+}
+
+bool FilterMatcher::ParseLiteral(const std::string& exp, size_t begin, size_t end, std::string& literal) {
+    static const char* kMetaChars = ".[]{}()*+?|^$\\";
+    literal.clear();
+    for (size_t i = begin; i < end; ++i) {
+        char c = exp[i];
+        if (c == '\\') {
+            // only escaped meta chars are literals, since sequences like \d, \< or \' have special meanings
+            if (i + 1 >= end || exp[i + 1] == '\0' || strchr(kMetaChars, exp[i + 1]) == nullptr) {
+                return false;
+            }
+            literal.push_back(exp[++i]);
+        } else if (strchr(kMetaChars, c) != nullptr) {
             return false;
+        } else {
+            literal.push_back(c);
         }
     }
     return true;
@@ -490,7 +604,7 @@ bool RegexFilterValueNode::Match(const LogEvent& contents, const CollectionPipel
     }
 
     std::string exception;
-    bool result = BoostRegexMatch(content->second.data(), content->second.size(), reg, exception);
+    bool result = matcher.Match(content->second, exception);
     if (!result && !exception.empty() && AppConfig::GetInstance()->IsLogParseAlarmValid()) {
         LOG_ERROR(mContext.GetLogger(), ("regex_match in Filter fail", exception));
         if (mContext.GetAlarm().IsLowLevelAlarmValid()) {
@@ -24,6 +24,30 @@
 
 namespace logtail {
 
+// FilterMatcher is compiled once from a filter regex. Patterns that are literals, optionally anchored or surrounded by
+// ".*", are matched by string comparison instead of the regex engine.
+class FilterMatcher {
+public:
+    // ordered by evaluation cost
+    enum class Type { ANY, EXACT, PREFIX, SUFFIX, CONTAINS, REGEX };
+
+    explicit FilterMatcher(const std::string& exp);
+
+    bool Match(StringView value, std::string& exception) const;
+    Type GetType() const { return mType; }
+
+private:
+    static bool ParseLiteral(const std::string& exp, size_t begin, size_t end, std::string& literal);
+
+    Type mType = Type::REGEX;
+    std::string mLiteral;
+    std::shared_ptr<boost::regex> mReg;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class ProcessorFilterNativeUnittest;
+#endif
+};
+
 // BaseFilterNode
 enum FilterOperator { NOT_OPERATOR, AND_OPERATOR, OR_OPERATOR };
 
@@ -68,7 +92,7 @@ private:
 class RegexFilterValueNode : public BaseFilterNode {
 public:
     RegexFilterValueNode(const std::string& key, const std::string& exp)
-        : BaseFilterNode(VALUE_NODE), key(key), reg(exp) {}
+        : BaseFilterNode(VALUE_NODE), key(key), matcher(exp) {}
 
     virtual ~RegexFilterValueNode() {}
 
@@ -77,7 +101,7 @@ public:
 
 private:
     std::string key;
-    boost::regex reg;
+    FilterMatcher matcher;
 };
 
 // UnaryFilterOperatorNode
@@ -118,19 +142,26 @@ protected:
 private:
     enum class Mode { BYPASS_MODE, EXPRESSION_MODE, RULE_MODE };
 
+    // Conditions are sorted by evaluation cost at Init, so that cheap comparisons reject events before any regex is
+    // run.
     struct LogFilterRule {
+        void AddCondition(const std::string& key, const std::string& exp);
+        void SortConditions();
+
         std::vector<std::string> FilterKeys;
-        std::vector<boost::regex> FilterRegs;
+        std::vector<FilterMatcher> FilterMatchers;
     };
 
-    bool ProcessEvent(PipelineEventPtr& e);
+    enum class FilterResult { MATCHED, UNMATCHED, KEY_NOT_FOUND };
+
+    bool ProcessEvent(PipelineEventPtr& e, FilterResult& result);
 
     // Filter logs through ConditionExp
     bool FilterExpressionRoot(LogEvent& sourceEvent, const BaseFilterNodePtr& node);
 
     // Filter logs through FilterRule
-    bool FilterFilterRule(LogEvent& sourceEvent, const LogFilterRule* filterRule);
-    bool IsMatched(const LogEvent& contents, const LogFilterRule& rule);
+    FilterResult FilterFilterRule(LogEvent& sourceEvent, const LogFilterRule* filterRule);
+    FilterResult IsMatched(const LogEvent& contents, const LogFilterRule& rule);
 
     bool noneUtf8(StringView& strSrc, bool modify);
     bool CheckNoneUtf8(const StringView& strSrc);
@@ -140,6 +171,10 @@ private:
 
     std::shared_ptr<LogFilterRule> mFilterRule;
 
+    CounterPtr mDiscardedEventsTotal;
+    CounterPtr mOutKeyNotFoundEventsTotal;
+    CounterPtr mMatchedEventsTotal;
+
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class ProcessorFilterNativeUnittest;
 #endif
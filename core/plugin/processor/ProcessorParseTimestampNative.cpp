@@ -16,6 +16,12 @@
 
 #include "plugin/processor/ProcessorParseTimestampNative.h"
 
+#include <cstring>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
 #include "app_config/AppConfig.h"
 #include "collection_pipeline/plugin/instance/ProcessorInstance.h"
 #include "common/LogtailCommonFlags.h"
@@ -87,6 +93,11 @@ bool ProcessorParseTimestampNative::Init(const Json::Value& config) {
                               mContext->GetRegion());
     }
 
+    const char* nanosecondPos = strstr(mSourceFormat.c_str(), "%f");
+    mHaveNanosecond = nanosecondPos != nullptr;
+    mEndWithNanosecond = nanosecondPos == mSourceFormat.c_str() + mSourceFormat.size() - 2;
+    mIsTimestampFormat = mSourceFormat == "%s";
+
     mDiscardedEventsTotal = GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_DISCARDED_EVENTS_TOTAL);
     mOutFailedEventsTotal = GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_OUT_FAILED_EVENTS_TOTAL);
     mOutKeyNotFoundEventsTotal = GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_OUT_KEY_NOT_FOUND_EVENTS_TOTAL);
@@ -105,16 +116,45 @@ void ProcessorParseTimestampNative::Process(PipelineEventGroup& logGroup) {
     EventsContainer& events = logGroup.MutableEvents();
     LogtailTime logTime = {0, 0};
 
+    // Events are handled in batch. Adjacent events usually share the same second, in which case only the sub-second
+    // part is parsed. Events without a valid time are kept as they are.
+    static thread_local std::vector<time_t> sLogTimes;
+    static thread_local std::vector<uint8_t> sIsValid;
+    sLogTimes.resize(events.size());
+    sIsValid.resize(events.size());
+    for (size_t i = 0; i < events.size(); ++i) {
+        if (ParseEventTime(logPath, events[i], logTime, timeStrCache)) {
+            events[i].Cast<LogEvent>().SetTimestamp(logTime.tv_sec, logTime.tv_nsec);
+            sLogTimes[i] = logTime.tv_sec;
+        } else {
+            sLogTimes[i] = std::numeric_limits<time_t>::max();
+        }
+    }
+    // simple enough to be vectorized by the compiler
+    const time_t minLogTime = GetMinValidLogTime();
+    const time_t* logTimes = sLogTimes.data();
+    uint8_t* isValid = sIsValid.data();
+    for (size_t i = 0; i < events.size(); ++i) {
+        isValid[i] = logTimes[i] >= minLogTime;
+    }
+
     size_t wIdx = 0;
+    uint64_t successCnt = 0;
     for (size_t rIdx = 0; rIdx < events.size(); ++rIdx) {
-        if (ProcessEvent(logPath, events[rIdx], logTime, timeStrCache)) {
-            if (wIdx != rIdx) {
-                events[wIdx] = std::move(events[rIdx]);
-            }
-            ++wIdx;
+        if (!isValid[rIdx]) {
+            DiscardOutdatedEvent(logPath, logTimes[rIdx]);
+            continue;
+        }
+        if (logTimes[rIdx] != std::numeric_limits<time_t>::max()) {
+            ++successCnt;
         }
+        if (wIdx != rIdx) {
+            events[wIdx] = std::move(events[rIdx]);
+        }
+        ++wIdx;
     }
     events.resize(wIdx);
+    mOutSuccessfulEventsTotal->Add(successCnt);
     return;
 }
 
@@ -126,73 +166,91 @@ bool ProcessorParseTimestampNative::ProcessEvent(StringView logPath,
                                                  PipelineEventPtr& e,
                                                  LogtailTime& logTime,
                                                  StringView& timeStrCache) {
+    if (!ParseEventTime(logPath, e, logTime, timeStrCache)) {
+        return true;
+    }
+    if (logTime.tv_sec < GetMinValidLogTime()) {
+        DiscardOutdatedEvent(logPath, logTime.tv_sec);
+        return false;
+    }
+    LogEvent& sourceEvent = e.Cast<LogEvent>();
+    sourceEvent.SetTimestamp(logTime.tv_sec, logTime.tv_nsec);
+    // if (mLegacyPreciseTimestampConfig.enabled) {
+    //     StringBuffer sb = sourceEvent.GetSourceBuffer()->AllocateStringBuffer(20);
+    //     sb.size = std::min(20, snprintf(sb.data, sb.capacity, "%lu", preciseTimestamp));
+    //     sourceEvent.SetContentNoCopy(mLegacyPreciseTimestampConfig.key, StringView(sb.data, sb.size));
+    // }
+    mOutSuccessfulEventsTotal->Add(1);
+    return true;
+}
+
+bool ProcessorParseTimestampNative::ParseEventTime(StringView logPath,
+                                                   PipelineEventPtr& e,
+                                                   LogtailTime& logTime,
+                                                   StringView& timeStrCache) {
     if (!IsSupportedEvent(e)) {
         mOutFailedEventsTotal->Add(1);
-        return true;
+        return false;
     }
     LogEvent& sourceEvent = e.Cast<LogEvent>();
     if (!sourceEvent.HasContent(mSourceKey)) {
         mOutKeyNotFoundEventsTotal->Add(1);
-        return true;
+        return false;
     }
     const StringView& timeStr = sourceEvent.GetContent(mSourceKey);
     uint64_t preciseTimestamp = 0;
     bool parseSuccess = ParseLogTime(timeStr, logPath, logTime, preciseTimestamp, timeStrCache);
     if (!parseSuccess) {
         mOutFailedEventsTotal->Add(1);
-        return true;
-    }
-    if (logTime.tv_sec <= 0
-        || (BOOL_FLAG(ilogtail_discard_old_data)
-            && (time(NULL) - logTime.tv_sec) > INT32_FLAG(ilogtail_discard_interval))) {
-        if (AppConfig::GetInstance()->IsLogParseAlarmValid()) {
-            if (AlarmManager::GetInstance()->IsLowLevelAlarmValid()) {
-                LOG_WARNING(sLogger,
-                            ("drop log event",
-                             "log time falls more than " + ToString(INT32_FLAG(ilogtail_discard_interval))
-                                 + " secs behind current time")("log time", logTime.tv_sec)(
-                                "gap", ToString(time(NULL) - logTime.tv_sec))("project", GetContext().GetProjectName())(
-                                "logstore", GetContext().GetLogstoreName())("config", GetContext().GetConfigName())(
-                                "file", logPath));
-            }
-            AlarmManager::GetInstance()->SendAlarm(OUTDATED_LOG_ALARM,
-                                                   std::string("logTime: ") + ToString(logTime.tv_sec),
-                                                   GetContext().GetProjectName(),
-                                                   GetContext().GetLogstoreName(),
-                                                   GetContext().GetRegion());
-        }
-        mHistoryFailureTotal->Add(1);
-        mDiscardedEventsTotal->Add(1);
         return false;
     }
-    sourceEvent.SetTimestamp(logTime.tv_sec, logTime.tv_nsec);
-    // if (mLegacyPreciseTimestampConfig.enabled) {
-    //     StringBuffer sb = sourceEvent.GetSourceBuffer()->AllocateStringBuffer(20);
-    //     sb.size = std::min(20, snprintf(sb.data, sb.capacity, "%lu", preciseTimestamp));
-    //     sourceEvent.SetContentNoCopy(mLegacyPreciseTimestampConfig.key, StringView(sb.data, sb.size));
-    // }
-    mOutSuccessfulEventsTotal->Add(1);
     return true;
 }
 
+void ProcessorParseTimestampNative::DiscardOutdatedEvent(StringView logPath, time_t logTime) {
+    if (AppConfig::GetInstance()->IsLogParseAlarmValid()) {
+        if (AlarmManager::GetInstance()->IsLowLevelAlarmValid()) {
+            LOG_WARNING(sLogger,
+                        ("drop log event",
+                         "log time falls more than " + ToString(INT32_FLAG(ilogtail_discard_interval))
+                             + " secs behind current time")("log time", logTime)("gap", ToString(time(NULL) - logTime))(
+                            "project", GetContext().GetProjectName())("logstore", GetContext().GetLogstoreName())(
+                            "config", GetContext().GetConfigName())("file", logPath));
+        }
+        AlarmManager::GetInstance()->SendAlarm(OUTDATED_LOG_ALARM,
+                                               std::string("logTime: ") + ToString(logTime),
+                                               GetContext().GetProjectName(),
+                                               GetContext().GetLogstoreName(),
+                                               GetContext().GetRegion());
+    }
+    mHistoryFailureTotal->Add(1);
+    mDiscardedEventsTotal->Add(1);
+}
+
+time_t ProcessorParseTimestampNative::GetMinValidLogTime() {
+    // log time must be positive
+    time_t minLogTime = 1;
+    if (BOOL_FLAG(ilogtail_discard_old_data)) {
+        minLogTime = std::max(minLogTime, time(NULL) - INT32_FLAG(ilogtail_discard_interval));
+    }
+    return minLogTime;
+}
+
 bool ProcessorParseTimestampNative::ParseLogTime(const StringView& curTimeStr, // str to parse
                                                  const StringView& logPath,
                                                  LogtailTime& logTime,
                                                  uint64_t& preciseTimestamp,
                                                  StringView& timeStrCache // cache
 ) {
-    // Second-level cache only work when:
-    // 1. No %f in the time format
-    // 2. The %f is at the end of the time format
-    const char* compareResult = strstr(mSourceFormat.c_str(), "%f");
-    bool haveNanosecond = compareResult != nullptr;
-    bool endWithNanosecond = compareResult == (mSourceFormat.c_str() + mSourceFormat.size() - 2);
     int nanosecondLength = -1;
     const char* strptimeResult = NULL;
-    if ((!haveNanosecond || endWithNanosecond) && IsPrefixString(curTimeStr, timeStrCache)) {
-        bool isTimestampNanosecond = (mSourceFormat == "%s") && (curTimeStr.length() > timeStrCache.length());
-        if (endWithNanosecond || isTimestampNanosecond) {
-            strptimeResult = Strptime(curTimeStr.data() + timeStrCache.length(), "%f", &logTime, nanosecondLength);
+    if ((!mHaveNanosecond || mEndWithNanosecond) && IsPrefixString(curTimeStr, timeStrCache)) {
+        // the second is the same as the last one, only the sub-second part needs to be parsed
+        bool isTimestampNanosecond = mIsTimestampFormat && (curTimeStr.length() > timeStrCache.length());
+        if (mEndWithNanosecond || isTimestampNanosecond) {
+            if (ParseNanosecond(curTimeStr.substr(timeStrCache.length()), logTime.tv_nsec)) {
+                strptimeResult = curTimeStr.data() + timeStrCache.length();
+            }
         } else {
             strptimeResult = curTimeStr.data() + timeStrCache.length();
             logTime.tv_nsec = 0;
@@ -235,10 +293,26 @@ bool ProcessorParseTimestampNative::IsPrefixString(const StringView& all, const
         return false;
     if (prefix.size() == 0)
         return false;
-    for (size_t i = 0; i < prefix.size(); ++i) {
-        if (all[i] != prefix[i])
-            return false;
+    return memcmp(all.data(), prefix.data(), prefix.size()) == 0;
+}
+
+bool ProcessorParseTimestampNative::ParseNanosecond(StringView str, long& nanosecond) {
+    if (str.empty() || str[0] < '0' || str[0] > '9') {
+        return false;
+    }
+    long result = 0;
+    size_t digitNum = 0;
+    // digits beyond nanosecond precision are ignored
+    for (size_t i = 0; i < str.size() && str[i] >= '0' && str[i] <= '9'; ++i) {
+        if (digitNum < 9) {
+            result = result * 10 + (str[i] - '0');
+            ++digitNum;
+        }
+    }
+    for (; digitNum < 9; ++digitNum) {
+        result *= 10;
     }
+    nanosecond = result;
     return true;
 }
 
@@ -42,6 +42,9 @@ protected:
 private:
     /// @return false if data need to be discarded
     bool ProcessEvent(StringView logPath, PipelineEventPtr& e, LogtailTime& logTime, StringView& timeStrCache);
+    /// @return false if the event has no valid time
+    bool ParseEventTime(StringView logPath, PipelineEventPtr& e, LogtailTime& logTime, StringView& timeStrCache);
+    void DiscardOutdatedEvent(StringView logPath, time_t logTime);
     /// @return false if parse time failed
     bool ParseLogTime(const StringView& curTimeStr, // str to parse
                       const StringView& logPath,
@@ -50,8 +53,18 @@ private:
                       StringView& timeStr // cache
     );
     bool IsPrefixString(const StringView& all, const StringView& prefix);
+    /// @return false if str does not start with a digit
+    static bool ParseNanosecond(StringView str, long& nanosecond);
+    /// events with log time earlier than the returned one are discarded
+    static time_t GetMinValidLogTime();
 
     int32_t mLogTimeZoneOffsetSecond = 0;
+    // Second-level cache only work when:
+    // 1. No %f in the time format
+    // 2. The %f is at the end of the time format
+    bool mHaveNanosecond = false;
+    bool mEndWithNanosecond = false;
+    bool mIsTimestampFormat = false;
 
     CounterPtr mDiscardedEventsTotal;
     CounterPtr mOutFailedEventsTotal;
@@ -18,6 +18,8 @@
 
 #include <cstdint>
 
+#include <algorithm>
+
 #include "prometheus/Constants.h"
 
 using namespace std;
@@ -61,13 +63,18 @@ size_t Labels::Size() const {
 }
 
 std::string Labels::Get(const string& name) {
+    return GetView(name).to_string();
+}
+
+StringView Labels::GetView(StringView name) const {
     if (mMetricEventPtr) {
-        return mMetricEventPtr->GetTag(name).to_string();
+        return mMetricEventPtr->GetTag(name);
     }
-    if (mLabels.count(name)) {
-        return mLabels[name];
+    auto it = Find(name);
+    if (it != mLabels.end() && it->first == name) {
+        return it->second;
     }
-    return "";
+    return StringView();
 }
 
 void Labels::Reset(MetricEvent* metricEvent) {
@@ -80,7 +87,12 @@ void Labels::Set(const string& k, const string& v) {
         mMetricEventPtr->SetTag(k, v);
         return;
     }
-    mLabels[k] = v;
+    auto it = Find(k);
+    if (it != mLabels.end() && it->first == k) {
+        it->second = v;
+    } else {
+        mLabels.emplace(it, k, v);
+    }
 }
 
 void Labels::Del(const string& k) {
@@ -90,11 +102,21 @@ void Labels::Del(const string& k) {
         }
         return;
     }
-    if (mLabels.count(k)) {
-        mLabels.erase(k);
+    auto it = Find(k);
+    if (it != mLabels.end() && it->first == k) {
+        mLabels.erase(it);
     }
 }
 
+LabelVector::iterator Labels::Find(StringView name) {
+    return lower_bound(
+        mLabels.begin(), mLabels.end(), name, [](const pair<string, string>& l, StringView n) { return l.first < n; });
+}
+
+LabelVector::const_iterator Labels::Find(StringView name) const {
+    return lower_bound(
+        mLabels.begin(), mLabels.end(), name, [](const pair<string, string>& l, StringView n) { return l.first < n; });
+}
 
 void Labels::Range(const std::function<void(const string& k, const string& v)>& f) const {
     if (mMetricEventPtr) {
@@ -108,26 +130,41 @@ void Labels::Range(const std::function<void(const string& k, const string& v)>&
     }
 }
 
+void Labels::RangeView(const std::function<void(StringView k, StringView v)>& f) const {
+    if (mMetricEventPtr) {
+        for (auto l = mMetricEventPtr->TagsBegin(); l != mMetricEventPtr->TagsEnd(); l++) {
+            f(l->first, l->second);
+        }
+        return;
+    }
+    for (const auto& l : mLabels) {
+        f(l.first, l.second);
+    }
+}
+
 uint64_t Labels::Hash() {
-    string hash;
     uint64_t sum = prometheus::OFFSET64;
-    Range([&hash](const string& k, const string& v) { hash += k + "\xff" + v + "\xff"; });
-    for (auto i : hash) {
-        sum ^= (uint64_t)i;
+    auto add = [&sum](StringView str) {
+        for (auto i : str) {
+            sum ^= (uint64_t)i;
+            sum *= prometheus::PRIME64;
+        }
+        sum ^= (uint64_t)'\xff';
         sum *= prometheus::PRIME64;
-    }
+    };
+    RangeView([&add](StringView k, StringView v) {
+        add(k);
+        add(v);
+    });
     return sum;
 }
 
 void Labels::RemoveMetaLabels() {
     // for mLabels only
-    for (auto it = mLabels.begin(); it != mLabels.end();) {
-        if (it->first.find(prometheus::META) == 0) {
-            it = mLabels.erase(it);
-        } else {
-            ++it;
-        }
-    }
+    mLabels.erase(remove_if(mLabels.begin(),
+                            mLabels.end(),
+                            [](const pair<string, string>& l) { return l.first.find(prometheus::META) == 0; }),
+                  mLabels.end());
 }
 
 } // namespace logtail
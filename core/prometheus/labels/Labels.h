@@ -19,15 +19,19 @@
 #include <cstdint>
 
 #include <functional>
-#include <map>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "models/MetricEvent.h"
+#include "models/StringView.h"
 
 namespace logtail {
 
 
-using LabelMap = std::map<std::string, std::string>;
+// A target has a few dozens of labels at most, so a flat vector sorted by name is both smaller and faster to search
+// than a node based map.
+using LabelVector = std::vector<std::pair<std::string, std::string>>;
 /// @brief Labels is a sorted set of labels. Order has to be guaranteed upon instantiation
 class Labels {
 public:
@@ -43,15 +47,22 @@ public:
     void RemoveMetaLabels();
 
     std::string Get(const std::string&);
+    // the view is invalidated once the labels are modified
+    StringView GetView(StringView) const;
     void Set(const std::string&, const std::string&);
     void Del(const std::string&);
 
     void Reset(MetricEvent*);
 
     void Range(const std::function<void(const std::string&, const std::string&)>&) const;
+    // the same as Range, without copying the labels of a metric event
+    void RangeView(const std::function<void(StringView, StringView)>&) const;
 
 private:
-    LabelMap mLabels;
+    LabelVector::iterator Find(StringView name);
+    LabelVector::const_iterator Find(StringView name) const;
+
+    LabelVector mLabels;
 
     MetricEvent* mMetricEventPtr = nullptr;
 
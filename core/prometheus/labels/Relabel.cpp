@@ -18,9 +18,8 @@
 
 #include <openssl/md5.h>
 
-#include <boost/algorithm/string.hpp>
-#include <boost/algorithm/string/join.hpp>
-#include <boost/regex.hpp>
+#include <algorithm>
+#include <cctype>
 #include <string>
 #include <vector>
 
@@ -80,7 +79,8 @@ const std::string& ActionToString(Action action) {
     return sUndefined;
 }
 RelabelConfig::RelabelConfig() : mSeparator(";"), mReplacement("$1"), mAction(Action::REPLACE) {
-    mRegex = boost::regex("().*");
+    CompileRegex("().*");
+    mReplacementParts = CompileTemplate(mReplacement);
 }
 bool RelabelConfig::Init(const Json::Value& config) {
     string errorMsg;
@@ -99,7 +99,10 @@ bool RelabelConfig::Init(const Json::Value& config) {
 
     if (config.isMember(prometheus::REGEX) && config[prometheus::REGEX].isString()) {
         string re = config[prometheus::REGEX].asString();
-        mRegex = boost::regex(re);
+        if (!CompileRegex(re)) {
+            LOG_ERROR(sLogger, ("invalid relabel regex", re)("error", mRegex->error()));
+            return false;
+        }
     }
 
     if (config.isMember(prometheus::REPLACEMENT) && config[prometheus::REPLACEMENT].isString()) {
@@ -134,69 +137,164 @@ bool RelabelConfig::Init(const Json::Value& config) {
     if (config.isMember(prometheus::MODULUS) && config[prometheus::MODULUS].isUInt64()) {
         mModulus = config[prometheus::MODULUS].asUInt64();
     }
+
+    mReplacementParts = CompileTemplate(mReplacement);
+    mTargetLabelParts = CompileTemplate(mTargetLabel);
     return true;
 }
 
+bool RelabelConfig::CompileRegex(const string& pattern) {
+    RE2::Options options;
+    options.set_log_errors(false);
+    mRegex = make_shared<re2::RE2>(pattern, options);
+    mIsLiteralRegex = pattern.find_first_of("\\^$.|?*+()[]{}") == string::npos;
+    mRegexLiteral = pattern;
+    return mRegex->ok();
+}
+
+vector<RelabelConfig::TemplatePart> RelabelConfig::CompileTemplate(const string& tmpl) const {
+    vector<TemplatePart> parts;
+    auto addLiteral = [&parts](const string& str) {
+        if (parts.empty() || parts.back().mGroup != -1) {
+            parts.emplace_back();
+        }
+        parts.back().mLiteral += str;
+    };
+    const auto& names = mRegex->NamedCapturingGroups();
+    size_t i = 0;
+    while (i < tmpl.size()) {
+        if (tmpl[i] != '$' || i + 1 == tmpl.size()) {
+            addLiteral(string(1, tmpl[i++]));
+            continue;
+        }
+        char next = tmpl[i + 1];
+        if (next == '$') {
+            addLiteral("$");
+            i += 2;
+        } else if (next == '&') {
+            parts.push_back({"", 0});
+            i += 2;
+        } else if (isdigit(static_cast<unsigned char>(next))) {
+            size_t end = i + 1;
+            while (end < tmpl.size() && isdigit(static_cast<unsigned char>(tmpl[end]))) {
+                ++end;
+            }
+            parts.push_back({"", atoi(tmpl.substr(i + 1, end - i - 1).c_str())});
+            i = end;
+        } else if (next == '{' && tmpl.find('}', i + 2) != string::npos) {
+            size_t end = tmpl.find('}', i + 2);
+            string name = tmpl.substr(i + 2, end - i - 2);
+            if (!name.empty() && all_of(name.begin(), name.end(), [](unsigned char c) { return isdigit(c); })) {
+                parts.push_back({"", atoi(name.c_str())});
+            } else {
+                auto it = names.find(name);
+                // unknown names are expanded to empty strings
+                parts.push_back({"", it == names.end() ? INT32_MAX : it->second});
+            }
+            i = end + 1;
+        } else {
+            addLiteral("$");
+            ++i;
+        }
+    }
+    return parts;
+}
+
+bool RelabelConfig::FullMatch(StringView val) const {
+    if (mIsLiteralRegex) {
+        return val == mRegexLiteral;
+    }
+    return RE2::FullMatch(re2::StringPiece(val.data(), val.size()), *mRegex);
+}
+
+void RelabelConfig::Expand(const vector<TemplatePart>& parts, const vector<re2::StringPiece>& groups, string& res) {
+    for (const auto& part : parts) {
+        if (part.mGroup == -1) {
+            res += part.mLiteral;
+        } else if (static_cast<size_t>(part.mGroup) < groups.size()) {
+            res.append(groups[part.mGroup].data(), groups[part.mGroup].size());
+        }
+    }
+}
+
 bool RelabelConfig::Process(Labels& l, vector<string>& toDelete) const {
-    vector<string> values;
-    values.reserve(mSourceLabels.size());
-    for (const auto& item : mSourceLabels) {
-        values.push_back(l.Get(item));
+    // buffers are reused across calls to avoid allocation for each sample
+    static thread_local string sVal;
+    static thread_local string sTarget;
+    static thread_local string sRes;
+    static thread_local vector<re2::StringPiece> sGroups;
+    static thread_local vector<pair<string, string>> sPending;
+
+    sVal.clear();
+    for (size_t i = 0; i < mSourceLabels.size(); ++i) {
+        if (i != 0) {
+            sVal += mSeparator;
+        }
+        StringView v = l.GetView(mSourceLabels[i]);
+        sVal.append(v.data(), v.size());
     }
-    string val = boost::algorithm::join(values, mSeparator);
     CollectLabelsToDelete(mTargetLabel, toDelete);
     switch (mAction) {
         case Action::DROP: {
-            if (boost::regex_match(val, mRegex)) {
+            if (FullMatch(sVal)) {
                 return false;
             }
             break;
         }
         case Action::KEEP: {
-            if (!boost::regex_match(val, mRegex)) {
+            if (!FullMatch(sVal)) {
                 return false;
             }
             break;
         }
         case Action::DROPEQUAL: {
-            if (l.Get(mTargetLabel) == val) {
+            if (l.GetView(mTargetLabel) == sVal) {
                 return false;
             }
             break;
         }
         case Action::KEEPEQUAL: {
-            if (l.Get(mTargetLabel) != val) {
+            if (l.GetView(mTargetLabel) != sVal) {
                 return false;
             }
             break;
         }
         case Action::REPLACE: {
-            bool indexes = boost::regex_search(val, mRegex);
+            sGroups.resize(mRegex->NumberOfCapturingGroups() + 1);
             // If there is no match no replacement must take place.
-            if (!indexes) {
+            if (!mRegex->Match(sVal, 0, sVal.size(), RE2::UNANCHORED, sGroups.data(), sGroups.size())) {
                 break;
             }
-            string target = string(boost::regex_replace(val, mRegex, mTargetLabel, boost::format_first_only));
-            string res = boost::regex_replace(val, mRegex, mReplacement, boost::format_first_only);
-            if (res.size() == 0) {
-                l.Del(target);
+            // only the first match is replaced, and the rest of the value is kept
+            size_t matchBegin = sGroups[0].data() - sVal.data();
+            size_t matchEnd = matchBegin + sGroups[0].size();
+            sTarget.assign(sVal, 0, matchBegin);
+            Expand(mTargetLabelParts, sGroups, sTarget);
+            sTarget.append(sVal, matchEnd, string::npos);
+            sRes.assign(sVal, 0, matchBegin);
+            Expand(mReplacementParts, sGroups, sRes);
+            sRes.append(sVal, matchEnd, string::npos);
+            if (sRes.size() == 0) {
+                l.Del(sTarget);
                 break;
             }
-            l.Set(target, string(res));
-            CollectLabelsToDelete(target, toDelete);
+            l.Set(sTarget, sRes);
+            CollectLabelsToDelete(sTarget, toDelete);
             break;
         }
         case Action::LOWERCASE: {
-            l.Set(mTargetLabel, boost::to_lower_copy(val));
+            transform(sVal.begin(), sVal.end(), sVal.begin(), [](unsigned char c) { return tolower(c); });
+            l.Set(mTargetLabel, sVal);
             break;
         }
         case Action::UPPERCASE: {
-            l.Set(mTargetLabel, boost::to_upper_copy(val));
+            transform(sVal.begin(), sVal.end(), sVal.begin(), [](unsigned char c) { return toupper(c); });
+            l.Set(mTargetLabel, sVal);
             break;
         }
         case Action::HASHMOD: {
             uint8_t digest[MD5_DIGEST_LENGTH];
-            MD5((uint8_t*)val.c_str(), val.length(), (uint8_t*)&digest);
+            MD5((uint8_t*)sVal.c_str(), sVal.length(), (uint8_t*)&digest);
             // Use only the last 8 bytes of the hash to give the same result as earlier versions of this code.
             uint64_t hashVal = 0;
             for (int i = 8; i < MD5_DIGEST_LENGTH; ++i) {
@@ -207,42 +305,42 @@ bool RelabelConfig::Process(Labels& l, vector<string>& toDelete) const {
             break;
         }
         case Action::LABELMAP: {
-            l.Range([&](const string& key, const string& value) {
-                if (boost::regex_match(key, mRegex)) {
-                    string res
-                        = boost::regex_replace(key, mRegex, mReplacement, boost::match_default | boost::format_all);
-                    l.Set(res, value);
-                    CollectLabelsToDelete(res, toDelete);
-                }
-            });
-            break;
-        }
-        case Action::LABELDROP: {
-            vector<string> toDel;
-            l.Range([&](const string& key, const string& value) {
-                if (boost::regex_match(key, mRegex)) {
-                    toDel.push_back(key);
+            sGroups.resize(mRegex->NumberOfCapturingGroups() + 1);
+            sPending.clear();
+            // labels cannot be modified while being ranged
+            l.RangeView([&](StringView key, StringView value) {
+                if (mRegex->Match(re2::StringPiece(key.data(), key.size()),
+                                  0,
+                                  key.size(),
+                                  RE2::ANCHOR_BOTH,
+                                  sGroups.data(),
+                                  sGroups.size())) {
+                    sPending.emplace_back(string(), value.to_string());
+                    Expand(mReplacementParts, sGroups, sPending.back().first);
                 }
             });
-            for (const auto& item : toDel) {
-                l.Del(item);
+            for (const auto& item : sPending) {
+                l.Set(item.first, item.second);
+                CollectLabelsToDelete(item.first, toDelete);
             }
             break;
         }
+        case Action::LABELDROP:
         case Action::LABELKEEP: {
-            vector<string> toDel;
-            l.Range([&](const string& key, const string& value) {
-                if (!boost::regex_match(key, mRegex)) {
-                    toDel.push_back(key);
+            sPending.clear();
+            bool drop = mAction == Action::LABELDROP;
+            l.RangeView([&](StringView key, StringView value) {
+                if (FullMatch(key) == drop) {
+                    sPending.emplace_back(key.to_string(), string());
                 }
             });
-            for (const auto& item : toDel) {
-                l.Del(item);
+            for (const auto& item : sPending) {
+                l.Del(item.first);
             }
             break;
         }
         case Action::DROPMETRIC: {
-            if (mMatchList.find(val) != mMatchList.end()) {
+            if (mMatchList.find(sVal) != mMatchList.end()) {
                 return false;
             }
             break;
@@ -17,8 +17,12 @@
 #pragma once
 #include <json/json.h>
 
-#include <boost/regex.hpp>
+#include <memory>
+#include <set>
 #include <string>
+#include <vector>
+
+#include "re2/re2.h"
 
 #include "prometheus/labels/Labels.h"
 
@@ -55,7 +59,7 @@ public:
     // Separator is the string between concatenated values from the source labels.
     std::string mSeparator;
     // Regex against which the concatenation is matched.
-    boost::regex mRegex;
+    std::shared_ptr<re2::RE2> mRegex;
     // Modulus to take of the hash of concatenated values from the source labels.
     uint64_t mModulus = 0;
     // TargetLabel is the label to which the resulting string is written in a replacement.
@@ -69,7 +73,30 @@ public:
     std::set<std::string> mMatchList;
 
 private:
+    // A replacement template is split into literals and references to capturing groups, i.e. $1, ${1}, ${name} and $&.
+    struct TemplatePart {
+        std::string mLiteral;
+        // -1 for a literal
+        int mGroup = -1;
+    };
+
+    bool CompileRegex(const std::string& pattern);
+    std::vector<TemplatePart> CompileTemplate(const std::string& tmpl) const;
+    bool FullMatch(StringView val) const;
+    // the result is written to res, which is not cleared beforehand
+    static void
+    Expand(const std::vector<TemplatePart>& parts, const std::vector<re2::StringPiece>& groups, std::string& res);
     void CollectLabelsToDelete(const std::string& labelName, std::vector<std::string>& toDelete) const;
+
+    // the regex contains no meta characters, so that full matching is the same as string comparison
+    bool mIsLiteralRegex = false;
+    std::string mRegexLiteral;
+    std::vector<TemplatePart> mReplacementParts;
+    std::vector<TemplatePart> mTargetLabelParts;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class RelabelConfigUnittest;
+#endif
 };
 
 class RelabelConfigList {
@@ -85,6 +112,7 @@ private:
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class RelabelConfigListTest;
+    friend class RelabelConfigUnittest;
     friend class InputPrometheusUnittest;
     friend class ScrapeConfigUnittest;
 #endif
@@ -36,8 +36,13 @@ void BaseScheduler::DelayExecTime(uint64_t delaySeconds) {
 }
 
 void BaseScheduler::Cancel() {
-    WriteLock lock(mLock);
-    mValidState = false;
+    {
+        WriteLock lock(mLock);
+        mValidState = false;
+    }
+    if (mTimer) {
+        mTimer->CancelEvent(mTimerEventId);
+    }
 }
 
 bool BaseScheduler::IsCancelled() {
@@ -1,6 +1,7 @@
 #pragma once
 
 
+#include <atomic>
 #include <memory>
 
 #include "common/http/HttpResponse.h"
@@ -48,6 +49,8 @@ protected:
     std::shared_ptr<PromFuture<>> mIsContextValidFuture;
 
     std::shared_ptr<Timer> mTimer;
+    // the latest event pushed to the timer, cancelled together with the scheduler
+    std::atomic<TimerEventId> mTimerEventId = 0;
     EventPool* mEventPool = nullptr;
 };
 } // namespace logtail
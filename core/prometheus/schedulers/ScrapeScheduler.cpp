@@ -147,7 +147,7 @@ void ScrapeScheduler::ScheduleNext() {
     }
 
     auto event = BuildScrapeTimerEvent(GetNextExecTime());
-    mTimer->PushEvent(std::move(event));
+    mTimerEventId = mTimer->PushEvent(std::move(event));
 }
 
 void ScrapeScheduler::ScrapeOnce(std::chrono::steady_clock::time_point execTime) {
@@ -204,6 +204,9 @@ void ScrapeScheduler::Cancel() {
         WriteLock lock(mLock);
         mValidState = false;
     }
+    if (mTimer) {
+        mTimer->CancelEvent(mTimerEventId);
+    }
 }
 
 void ScrapeScheduler::InitSelfMonitor(const MetricLabels& defaultLabels) {
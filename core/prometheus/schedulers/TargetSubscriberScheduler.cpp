@@ -262,7 +262,7 @@ void TargetSubscriberScheduler::ScheduleNext() {
     }
 
     auto event = BuildSubscriberTimerEvent(GetNextExecTime());
-    mTimer->PushEvent(std::move(event));
+    mTimerEventId = mTimer->PushEvent(std::move(event));
 }
 
 void TargetSubscriberScheduler::Cancel() {
@@ -271,6 +271,9 @@ void TargetSubscriberScheduler::Cancel() {
         WriteLock lock(mLock);
         mValidState = false;
     }
+    if (mTimer) {
+        mTimer->CancelEvent(mTimerEventId);
+    }
     CancelAllScrapeScheduler();
 }
 
@@ -14,6 +14,8 @@
 
 #include "protobuf/sls/LogGroupSerializer.h"
 
+#include <algorithm>
+
 #include "common/TimeUtil.h"
 
 using namespace std;
@@ -102,6 +104,19 @@ void LogGroupSerializer::Prepare(size_t size) {
     mRes.reserve(size);
 }
 
+void LogGroupSerializer::StartToAddLogGroup(StringView packId, size_t size) {
+    size_t required = mRes.size() + GetLogGroupHeaderSize(packId.size(), size) + size;
+    if (required > mRes.capacity()) {
+        mRes.reserve(max(required, mRes.capacity() * 2));
+    }
+    // field = 1, wire_type = 2
+    mRes.push_back(0x0A);
+    AddString(packId);
+    // field = 2, wire_type = 2
+    mRes.push_back(0x12);
+    uint32_pack(size, mRes);
+}
+
 void LogGroupSerializer::StartToAddLog(size_t size) {
     // field = 1, wire_type = 2
     mRes.push_back(0x0A);
@@ -142,6 +157,12 @@ void LogGroupSerializer::AddLogTimeNs(uint32_t logTimeNs) {
     fixed32_pack(logTimeNs, mRes);
 }
 
+void LogGroupSerializer::AddCategory(StringView category) {
+    // field = 2, wire_type = 2
+    mRes.push_back(0x12);
+    AddString(category);
+}
+
 void LogGroupSerializer::AddTopic(StringView topic) {
     // field = 3, wire_type = 2
     mRes.push_back(0x1A);
@@ -258,6 +279,10 @@ size_t GetLogTagSize(size_t keySZ, size_t valueSZ) {
     return res;
 }
 
+size_t GetLogGroupHeaderSize(size_t packIdSZ, size_t logGroupSZ) {
+    return GetStringSize(packIdSZ) + 1 + uint32_size(logGroupSZ);
+}
+
 size_t GetMetricLabelSize(const MetricEvent& e) {
     static size_t labelSepSZ = METRIC_LABELS_SEPARATOR.size();
     static size_t keyValSepSZ = METRIC_LABELS_KEY_VALUE_SEPARATOR.size();
@@ -41,12 +41,17 @@ public:
     void AddLogTime(uint32_t logTime);
     void AddLogContent(StringView key, StringView value);
     void AddLogTimeNs(uint32_t logTimeNs);
+    void AddCategory(StringView category);
     void AddTopic(StringView topic);
     void AddSource(StringView source);
     void AddMachineUUID(StringView machineUUID);
     void AddLogTag(StringView key, StringView value);
     std::string& GetResult() { return mRes; }
 
+    // Several log groups can be serialized into one buffer, each of which starts with a header written by
+    // StartToAddLogGroup, see LogtailPlugin::ProcessLogGroups for detail.
+    void StartToAddLogGroup(StringView packId, size_t size);
+
     void AddLogContentMetricLabel(const MetricEvent& e, size_t valueSZ);
     void AddLogContentMetricTimeNano(const MetricEvent& e);
 
@@ -60,6 +65,7 @@ size_t GetLogContentSize(size_t keySZ, size_t valueSZ);
 size_t GetLogSize(size_t contentSZ, bool hasNs, size_t& logSZ);
 size_t GetStringSize(size_t size);
 size_t GetLogTagSize(size_t keySZ, size_t valueSZ);
+size_t GetLogGroupHeaderSize(size_t packIdSZ, size_t logGroupSZ);
 
 size_t GetMetricLabelSize(const MetricEvent& e);
 
@@ -18,14 +18,16 @@
 #include "batch/TimeoutFlushManager.h"
 #include "collection_pipeline/CollectionPipelineManager.h"
 #include "common/Flags.h"
+#include "common/HashUtil.h"
+#include "common/StringTools.h"
 #include "go_pipeline/LogtailPlugin.h"
 #include "models/EventPool.h"
 #include "monitor/AlarmManager.h"
 #include "monitor/metric_constants/MetricConstants.h"
 #include "queue/ProcessQueueManager.h"
 #include "queue/QueueKeyManager.h"
+#include "runner/SerializerRunner.h"
 
-DEFINE_FLAG_INT32(default_flush_merged_buffer_interval, "default flush merged buffer, seconds", 1);
 DEFINE_FLAG_INT32(processor_runner_exit_timeout_sec, "", 60);
 
 DECLARE_FLAG_INT32(max_send_log_group_size);
@@ -45,9 +47,11 @@ ProcessorRunner::ProcessorRunner()
 }
 
 void ProcessorRunner::Init() {
+    SerializerRunner::GetInstance()->Init();
     for (uint32_t threadNo = 0; threadNo < mThreadCount; ++threadNo) {
         mThreadRes[threadNo] = async(launch::async, &ProcessorRunner::Run, this, threadNo);
     }
+    TimeoutFlushManager::GetInstance()->Init();
     mIsFlush = false;
 }
 
@@ -65,6 +69,9 @@ void ProcessorRunner::Stop() {
             LOG_WARNING(sLogger, ("processor runner", "forced to stopped")("threadNo", threadNo));
         }
     }
+    TimeoutFlushManager::GetInstance()->Stop();
+    // batches left in the batchers are flushed on the caller thread afterwards
+    SerializerRunner::GetInstance()->Stop();
 }
 
 bool ProcessorRunner::PushQueue(QueueKey key, size_t inputIndex, PipelineEventGroup&& group, uint32_t retryTimes) {
@@ -99,15 +106,8 @@ void ProcessorRunner::Run(uint32_t threadNo) {
     sInGroupDataSizeBytes = sMetricsRecordRef.CreateCounter(METRIC_RUNNER_IN_SIZE_BYTES);
     sLastRunTime = sMetricsRecordRef.CreateIntGauge(METRIC_RUNNER_LAST_RUN_TIME);
 
-    static int32_t lastFlushBatchTime = 0;
     while (true) {
-        int32_t curTime = time(nullptr);
-        if (threadNo == 0 && curTime - lastFlushBatchTime >= INT32_FLAG(default_flush_merged_buffer_interval)) {
-            TimeoutFlushManager::GetInstance()->FlushTimeoutBatch();
-            lastFlushBatchTime = curTime;
-        }
-
-        sLastRunTime->Set(curTime);
+        sLastRunTime->Set(time(nullptr));
         unique_ptr<ProcessQueueItem> item;
         string configName;
         if (!ProcessQueueManager::GetInstance()->PopItem(threadNo, item, configName)) {
@@ -155,12 +155,16 @@ void ProcessorRunner::Run(uint32_t threadNo) {
             // 1. allow all event types to be sent to Go pipelines
             // 2. use event group protobuf instead
             if (isLog) {
+                // all groups are passed to Go pipelines at once, and the buffer is reused across rounds
+                static thread_local LogGroupSerializer sBatchSerializer;
+                sBatchSerializer.GetResult().clear();
+                size_t groupCnt = 0;
                 for (auto& group : eventGroupList) {
-                    string res, errorMsg;
+                    string errorMsg;
                     if (!Serialize(group,
                                    pipeline->GetContext().GetGlobalConfig().mEnableTimestampNanosecond,
                                    pipeline->GetContext().GetLogstoreName(),
-                                   res,
+                                   sBatchSerializer,
                                    errorMsg)) {
                         LOG_WARNING(pipeline->GetContext().GetLogger(),
                                     ("failed to serialize event group",
@@ -174,10 +178,11 @@ void ProcessorRunner::Run(uint32_t threadNo) {
                                                                     pipeline->GetContext().GetRegion());
                         continue;
                     }
-                    LogtailPlugin::GetInstance()->ProcessLogGroup(
-                        pipeline->GetContext().GetConfigName(),
-                        res,
-                        group.GetMetadata(EventGroupMetaKey::SOURCE_ID).to_string());
+                    ++groupCnt;
+                }
+                if (groupCnt > 0) {
+                    LogtailPlugin::GetInstance()->ProcessLogGroups(pipeline->GetContext().GetConfigName(),
+                                                                   sBatchSerializer.GetResult());
                 }
             }
         } else {
@@ -189,44 +194,63 @@ void ProcessorRunner::Run(uint32_t threadNo) {
     }
 }
 
-bool ProcessorRunner::Serialize(
-    const PipelineEventGroup& group, bool enableNanosecond, const string& logstore, string& res, string& errorMsg) {
-    sls_logs::LogGroup logGroup;
-    for (const auto& e : group.GetEvents()) {
-        if (e.Is<LogEvent>()) {
-            const auto& logEvent = e.Cast<LogEvent>();
-            auto log = logGroup.add_logs();
-            for (const auto& kv : logEvent) {
-                auto contPtr = log->add_contents();
-                contPtr->set_key(kv.first.to_string());
-                contPtr->set_value(kv.second.to_string());
-            }
-            log->set_time(logEvent.GetTimestamp());
-            if (enableNanosecond && logEvent.GetTimestampNanosecond()) {
-                log->set_time_ns(logEvent.GetTimestampNanosecond().value());
-            }
-        } else {
+bool ProcessorRunner::Serialize(const PipelineEventGroup& group,
+                                bool enableNanosecond,
+                                const string& logstore,
+                                LogGroupSerializer& serializer,
+                                string& errorMsg) {
+    // caculate serialized logGroup size first, so that the group can be written into the batch directly
+    static thread_local vector<size_t> sLogSZ;
+    const auto& events = group.GetEvents();
+    sLogSZ.resize(events.size());
+    size_t logGroupSZ = 0;
+    for (size_t i = 0; i < events.size(); ++i) {
+        if (!events[i].Is<LogEvent>()) {
             errorMsg = "unsupported event type in event group";
             return false;
         }
+        const auto& e = events[i].Cast<LogEvent>();
+        size_t contentSZ = 0;
+        for (const auto& kv : e) {
+            contentSZ += GetLogContentSize(kv.first.size(), kv.second.size());
+        }
+        logGroupSZ += GetLogSize(contentSZ, enableNanosecond && e.GetTimestampNanosecond(), sLogSZ[i]);
     }
     for (const auto& tag : group.GetTags()) {
         if (tag.first == LOG_RESERVED_KEY_TOPIC) {
-            logGroup.set_topic(tag.second.to_string());
+            logGroupSZ += GetStringSize(tag.second.size());
         } else {
-            auto logTag = logGroup.add_logtags();
-            logTag->set_key(tag.first.to_string());
-            logTag->set_value(tag.second.to_string());
+            logGroupSZ += GetLogTagSize(tag.first.size(), tag.second.size());
         }
     }
-    logGroup.set_category(logstore);
-    size_t size = logGroup.ByteSizeLong();
-    if (static_cast<int32_t>(size) > INT32_FLAG(max_send_log_group_size)) {
-        errorMsg = "log group exceeds size limit\tgroup size: " + ToString(size)
+    logGroupSZ += GetStringSize(logstore.size());
+    if (static_cast<int32_t>(logGroupSZ) > INT32_FLAG(max_send_log_group_size)) {
+        errorMsg = "log group exceeds size limit\tgroup size: " + ToString(logGroupSZ)
             + "\tsize limit: " + ToString(INT32_FLAG(max_send_log_group_size));
         return false;
     }
-    res = logGroup.SerializeAsString();
+
+    serializer.StartToAddLogGroup(ToHexString(HashString(group.GetMetadata(EventGroupMetaKey::SOURCE_ID).to_string())),
+                                  logGroupSZ);
+    for (size_t i = 0; i < events.size(); ++i) {
+        const auto& e = events[i].Cast<LogEvent>();
+        serializer.StartToAddLog(sLogSZ[i]);
+        serializer.AddLogTime(e.GetTimestamp());
+        for (const auto& kv : e) {
+            serializer.AddLogContent(kv.first, kv.second);
+        }
+        if (enableNanosecond && e.GetTimestampNanosecond()) {
+            serializer.AddLogTimeNs(e.GetTimestampNanosecond().value());
+        }
+    }
+    serializer.AddCategory(logstore);
+    for (const auto& tag : group.GetTags()) {
+        if (tag.first == LOG_RESERVED_KEY_TOPIC) {
+            serializer.AddTopic(tag.second);
+        } else {
+            serializer.AddLogTag(tag.first, tag.second);
+        }
+    }
     return true;
 }
 
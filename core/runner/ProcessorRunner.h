@@ -26,6 +26,7 @@
 #include "collection_pipeline/queue/QueueKey.h"
 #include "models/PipelineEventGroup.h"
 #include "monitor/MetricManager.h"
+#include "protobuf/sls/LogGroupSerializer.h"
 
 namespace logtail {
 
@@ -50,10 +51,11 @@ private:
 
     void Run(uint32_t threadNo);
 
+    // append the group to the batch passed to Go pipelines
     bool Serialize(const PipelineEventGroup& group,
                    bool enableNanosecond,
                    const std::string& logstore,
-                   std::string& res,
+                   LogGroupSerializer& serializer,
                    std::string& errorMsg);
 
     uint32_t mThreadCount = 1;
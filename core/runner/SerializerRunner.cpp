@@ -0,0 +1,233 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "runner/SerializerRunner.h"
+
+#include "common/Flags.h"
+#include "logger/Logger.h"
+#include "monitor/metric_constants/MetricConstants.h"
+
+DEFINE_FLAG_INT32(serializer_runner_thread_num,
+                  "number of threads serializing and compressing flushed batches, 0 means running on processor threads",
+                  0);
+DEFINE_FLAG_INT32(serializer_runner_max_pending_items_per_queue,
+                  "submission blocks when more items of the same sender queue are pending",
+                  8);
+DEFINE_FLAG_INT32(serializer_runner_exit_timeout_sec, "", 60);
+
+using namespace std;
+
+namespace logtail {
+
+void SerializerRunner::Init() {
+    if (INT32_FLAG(serializer_runner_thread_num) <= 0) {
+        return;
+    }
+    WriteMetrics::GetInstance()->PrepareMetricsRecordRef(
+        mMetricsRecordRef,
+        MetricCategory::METRIC_CATEGORY_RUNNER,
+        {{METRIC_LABEL_KEY_RUNNER_NAME, METRIC_LABEL_VALUE_RUNNER_NAME_SERIALIZER}});
+    mInItemsTotal = mMetricsRecordRef.CreateCounter(METRIC_RUNNER_IN_ITEMS_TOTAL);
+    mOutItemsTotal = mMetricsRecordRef.CreateCounter(METRIC_RUNNER_OUT_ITEMS_TOTAL);
+    mStolenItemsTotal = mMetricsRecordRef.CreateCounter(METRIC_RUNNER_SERIALIZER_STOLEN_ITEMS_TOTAL);
+    mPendingItemsTotal = mMetricsRecordRef.CreateIntGauge(METRIC_RUNNER_SERIALIZER_PENDING_ITEMS_TOTAL);
+    mFailedItemsTotal = mMetricsRecordRef.CreateCounter(METRIC_RUNNER_SERIALIZER_FAILED_ITEMS_TOTAL);
+
+    size_t threadNum = INT32_FLAG(serializer_runner_thread_num);
+    {
+        lock_guard<mutex> lock(mMux);
+        mIsRunning = true;
+    }
+    mWorkers.clear();
+    for (size_t i = 0; i < threadNum; ++i) {
+        mWorkers.emplace_back(make_unique<Worker>());
+    }
+    mThreadRes.clear();
+    for (size_t i = 0; i < threadNum; ++i) {
+        mThreadRes.emplace_back(async(launch::async, &SerializerRunner::Run, this, i));
+    }
+    LOG_INFO(sLogger, ("serializer runner", "started")("thread num", threadNum));
+}
+
+void SerializerRunner::Stop() {
+    {
+        lock_guard<mutex> lock(mMux);
+        if (!mIsRunning) {
+            return;
+        }
+        mIsRunning = false;
+    }
+    mCond.notify_all();
+    bool allStopped = true;
+    for (size_t i = 0; i < mThreadRes.size(); ++i) {
+        if (!mThreadRes[i].valid()) {
+            continue;
+        }
+        future_status s = mThreadRes[i].wait_for(chrono::seconds(INT32_FLAG(serializer_runner_exit_timeout_sec)));
+        if (s == future_status::ready) {
+            LOG_INFO(sLogger, ("serializer runner", "stopped successfully")("threadNo", i));
+        } else {
+            LOG_WARNING(sLogger, ("serializer runner", "forced to stopped")("threadNo", i));
+            allStopped = false;
+        }
+    }
+    if (!allStopped) {
+        // items queued behind a stuck worker would never be run, and would keep their flushers waiting
+        DropPendingItems();
+    }
+}
+
+bool SerializerRunner::IsRunning() const {
+    lock_guard<mutex> lock(mMux);
+    return mIsRunning;
+}
+
+bool SerializerRunner::Submit(const Flusher* flusher, QueueKey key, bool ordered, Task&& task) {
+    unique_lock<mutex> lock(mMux);
+    mCond.wait(lock, [&]() {
+        if (!mIsRunning) {
+            return true;
+        }
+        auto it = mQueuePendingCnt.find(key);
+        return it == mQueuePendingCnt.end()
+            || it->second < static_cast<size_t>(INT32_FLAG(serializer_runner_max_pending_items_per_queue));
+    });
+    if (!mIsRunning) {
+        return false;
+    }
+    ++mPendingCnt;
+    ++mQueuePendingCnt[key];
+    ++mFlusherPendingCnt[flusher];
+    {
+        auto& worker = *mWorkers[static_cast<size_t>(key) % mWorkers.size()];
+        lock_guard<mutex> workerLock(worker.mMux);
+        worker.mItems.push_back({flusher, key, ordered, std::move(task)});
+    }
+    ++mSubmitSeq;
+    mInItemsTotal->Add(1);
+    mPendingItemsTotal->Set(mPendingCnt);
+    lock.unlock();
+    mCond.notify_all();
+    return true;
+}
+
+bool SerializerRunner::WaitForFlusher(const Flusher* flusher) {
+    unique_lock<mutex> lock(mMux);
+    // the item being run by a worker forced to stop may never finish
+    if (!mCond.wait_for(lock, chrono::seconds(INT32_FLAG(serializer_runner_exit_timeout_sec)), [&]() {
+            return mFlusherPendingCnt.find(flusher) == mFlusherPendingCnt.end();
+        })) {
+        LOG_WARNING(sLogger,
+                    ("failed to wait for pending items of flusher", "timeout")("pending items",
+                                                                              mFlusherPendingCnt[flusher]));
+        return false;
+    }
+    return true;
+}
+
+void SerializerRunner::Run(size_t workerNo) {
+    LOG_INFO(sLogger, ("serializer runner", "started")("threadNo", workerNo));
+    while (true) {
+        uint64_t seq = 0;
+        {
+            lock_guard<mutex> lock(mMux);
+            seq = mSubmitSeq;
+        }
+        Item item;
+        if (PopItem(workerNo, item)) {
+            if (!item.mTask()) {
+                // the caller is no longer there to be told, so the failure is only visible in metrics
+                mFailedItemsTotal->Add(1);
+            }
+            OnItemDone(item);
+            continue;
+        }
+        unique_lock<mutex> lock(mMux);
+        if (!mIsRunning) {
+            // no more submissions, and items left in other workers are drained by themselves
+            return;
+        }
+        mCond.wait(lock, [&]() { return !mIsRunning || mSubmitSeq != seq; });
+    }
+}
+
+bool SerializerRunner::PopItem(size_t workerNo, Item& item) {
+    {
+        auto& worker = *mWorkers[workerNo];
+        lock_guard<mutex> lock(worker.mMux);
+        if (!worker.mItems.empty()) {
+            item = std::move(worker.mItems.front());
+            worker.mItems.pop_front();
+            return true;
+        }
+    }
+    for (size_t i = 1; i < mWorkers.size(); ++i) {
+        auto& victim = *mWorkers[(workerNo + i) % mWorkers.size()];
+        lock_guard<mutex> lock(victim.mMux);
+        // steal from the back, which is the least likely to be popped by the owner soon
+        for (auto it = victim.mItems.rbegin(); it != victim.mItems.rend(); ++it) {
+            if (!it->mOrdered) {
+                item = std::move(*it);
+                victim.mItems.erase(std::next(it).base());
+                mStolenItemsTotal->Add(1);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void SerializerRunner::OnItemDone(const Item& item) {
+    {
+        lock_guard<mutex> lock(mMux);
+        RemovePendingItem(item);
+        mOutItemsTotal->Add(1);
+    }
+    mCond.notify_all();
+}
+
+void SerializerRunner::DropPendingItems() {
+    size_t cnt = 0;
+    {
+        lock_guard<mutex> lock(mMux);
+        for (auto& worker : mWorkers) {
+            lock_guard<mutex> workerLock(worker->mMux);
+            for (const auto& item : worker->mItems) {
+                RemovePendingItem(item);
+            }
+            cnt += worker->mItems.size();
+            worker->mItems.clear();
+        }
+        mFailedItemsTotal->Add(cnt);
+    }
+    if (cnt > 0) {
+        LOG_WARNING(sLogger, ("serializer runner", "discard pending items")("count", cnt));
+    }
+    mCond.notify_all();
+}
+
+void SerializerRunner::RemovePendingItem(const Item& item) {
+    --mPendingCnt;
+    auto it = mQueuePendingCnt.find(item.mKey);
+    if (it != mQueuePendingCnt.end() && --it->second == 0) {
+        mQueuePendingCnt.erase(it);
+    }
+    auto iter = mFlusherPendingCnt.find(item.mFlusher);
+    if (iter != mFlusherPendingCnt.end() && --iter->second == 0) {
+        mFlusherPendingCnt.erase(iter);
+    }
+    mPendingItemsTotal->Set(mPendingCnt);
+}
+
+} // namespace logtail
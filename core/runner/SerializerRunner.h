@@ -0,0 +1,114 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "collection_pipeline/queue/QueueKey.h"
+#include "monitor/MetricManager.h"
+
+namespace logtail {
+
+class Flusher;
+
+// Runs serialization and compression of flushed batches off the processor threads, so that processing of the next
+// group is not blocked by large batches.
+//
+// Each worker owns a task deque. A task is dispatched to the worker chosen by the key of the sender queue it is pushed
+// to, and an idle worker steals unordered tasks from the others. Ordered tasks, i.e. those of exactly once queues, are
+// never stolen, so that they reach the sender queue in the order they are submitted. Submission blocks when too many
+// tasks of the same sender queue are pending, which passes the backpressure of the sender queue to the processor.
+class SerializerRunner {
+public:
+    // @return false if any data is discarded, e.g. serialization fails or the sender queue is full
+    using Task = std::function<bool()>;
+
+    SerializerRunner(const SerializerRunner&) = delete;
+    SerializerRunner& operator=(const SerializerRunner&) = delete;
+
+    static SerializerRunner* GetInstance() {
+        static SerializerRunner instance;
+        return &instance;
+    }
+
+    void Init();
+    void Stop();
+
+    // @return false if the runner is not started, in which case the task should be run by the caller
+    bool Submit(const Flusher* flusher, QueueKey key, bool ordered, Task&& task);
+    // wait for all pending tasks of the flusher to finish, must be called before the flusher is stopped
+    // @return false if they are not finished within serializer_runner_exit_timeout_sec
+    bool WaitForFlusher(const Flusher* flusher);
+    bool IsRunning() const;
+
+private:
+    struct Item {
+        const Flusher* mFlusher = nullptr;
+        QueueKey mKey = 0;
+        bool mOrdered = false;
+        Task mTask;
+    };
+
+    struct Worker {
+        std::mutex mMux;
+        std::deque<Item> mItems;
+    };
+
+    SerializerRunner() = default;
+    ~SerializerRunner() = default;
+
+    void Run(size_t workerNo);
+    bool PopItem(size_t workerNo, Item& item);
+    void OnItemDone(const Item& item);
+    void DropPendingItems();
+    // must be called with mMux held
+    void RemovePendingItem(const Item& item);
+
+    std::vector<std::unique_ptr<Worker>> mWorkers;
+    std::vector<std::future<void>> mThreadRes;
+
+    mutable std::mutex mMux;
+    std::condition_variable mCond;
+    bool mIsRunning = false;
+    // bumped on each submission, so that idle workers know when to look for tasks again
+    uint64_t mSubmitSeq = 0;
+    size_t mPendingCnt = 0;
+    std::unordered_map<QueueKey, size_t> mQueuePendingCnt;
+    std::unordered_map<const Flusher*, size_t> mFlusherPendingCnt;
+
+    mutable MetricsRecordRef mMetricsRecordRef;
+    CounterPtr mInItemsTotal;
+    CounterPtr mOutItemsTotal;
+    CounterPtr mStolenItemsTotal;
+    CounterPtr mFailedItemsTotal;
+    IntGaugePtr mPendingItemsTotal;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class SerializerRunnerUnittest;
+#endif
+};
+
+} // namespace logtail
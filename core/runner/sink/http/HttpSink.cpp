@@ -21,6 +21,7 @@
 #include "common/Flags.h"
 #include "common/StringTools.h"
 #include "common/http/Curl.h"
+#include "common/http/CurlHandlerPool.h"
 #include "logger/Logger.h"
 #include "monitor/metric_constants/MetricConstants.h"
 #include "runner/FlusherRunner.h"
@@ -62,6 +63,8 @@ bool HttpSink::Init() {
         = mMetricsRecordRef.CreateTimeCounter(METRIC_RUNNER_SINK_SUCCESSFUL_ITEM_TOTAL_RESPONSE_TIME_MS);
     mFailedItemTotalResponseTimeMs
         = mMetricsRecordRef.CreateTimeCounter(METRIC_RUNNER_SINK_FAILED_ITEM_TOTAL_RESPONSE_TIME_MS);
+    mResponseLatencyMs = mMetricsRecordRef.CreateHistogram(METRIC_RUNNER_SINK_RESPONSE_LATENCY_MS);
+    mDeliveryLatencyMs = mMetricsRecordRef.CreateHistogram(METRIC_RUNNER_SINK_DELIVERY_LATENCY_MS);
     mSendingItemsTotal = mMetricsRecordRef.CreateIntGauge(METRIC_RUNNER_SINK_SENDING_ITEMS_TOTAL);
     mSendConcurrency = mMetricsRecordRef.CreateIntGauge(METRIC_RUNNER_SINK_SEND_CONCURRENCY);
 
@@ -154,7 +157,7 @@ bool HttpSink::AddRequestToClient(unique_ptr<HttpSinkRequest>&& request) {
         request->mItem->mStatus = SendingStatus::IDLE;
         request->mResponse.SetNetworkStatus(NetworkCode::Other, "failed to add the easy curl handle to multi_handle");
         FlusherRunner::GetInstance()->DecreaseHttpSendingCnt();
-        curl_easy_cleanup(curl);
+        CurlHandlerPool::GetInstance()->Release(curl);
         mOutFailedItemsTotal->Add(1);
         LOG_ERROR(sLogger,
                   ("failed to send request",
@@ -262,6 +265,11 @@ void HttpSink::HandleCompletedRequests(int& runningHandlers) {
                     request->mResponse.SetNetworkStatus(NetworkCode::Ok, "");
                     request->mResponse.SetStatusCode(statusCode);
                     request->mResponse.SetResponseTime(responseTimeMs);
+                    // only acked items are delivered, others may be sent again by the flusher. Recorded before
+                    // OnSendDone, since the item may be released there
+                    if (statusCode >= 200 && statusCode < 300) {
+                        mDeliveryLatencyMs->Record(chrono::system_clock::now() - request->mItem->mFirstEnqueTime);
+                    }
                     LOG_DEBUG(sLogger,
                               ("send http request succeeded, item address",
                                request->mItem)("config-flusher-dst",
@@ -273,6 +281,7 @@ void HttpSink::HandleCompletedRequests(int& runningHandlers) {
                     FlusherRunner::GetInstance()->DecreaseHttpSendingCnt();
                     mOutSuccessfulItemsTotal->Add(1);
                     mSuccessfulItemTotalResponseTimeMs->Add(responseTime);
+                    mResponseLatencyMs->Record(responseTime);
                     mSendingItemsTotal->Sub(1);
                     break;
                 }
@@ -310,11 +319,12 @@ void HttpSink::HandleCompletedRequests(int& runningHandlers) {
                     }
                     mOutFailedItemsTotal->Add(1);
                     mFailedItemTotalResponseTimeMs->Add(responseTime);
+                    mResponseLatencyMs->Record(responseTime);
                     mSendingItemsTotal->Sub(1);
                     break;
             }
             curl_multi_remove_handle(mClient, handler);
-            curl_easy_cleanup(handler);
+            CurlHandlerPool::GetInstance()->Release(handler);
             if (!requestReused) {
                 if (request->mPrivateData) {
                     curl_slist_free_all((curl_slist*)request->mPrivateData);
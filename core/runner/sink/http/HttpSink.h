@@ -59,6 +59,9 @@ private:
     CounterPtr mOutFailedItemsTotal;
     TimeCounterPtr mSuccessfulItemTotalResponseTimeMs;
     TimeCounterPtr mFailedItemTotalResponseTimeMs;
+    HistogramPtr mResponseLatencyMs;
+    // from the first time the item is pushed into the sender queue to the completion of the request
+    HistogramPtr mDeliveryLatencyMs;
     IntGaugePtr mSendingItemsTotal;
     IntGaugePtr mSendConcurrency;
     IntGaugePtr mLastRunTime;
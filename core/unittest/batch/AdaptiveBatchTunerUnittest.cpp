@@ -0,0 +1,110 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "collection_pipeline/batch/AdaptiveBatchTuner.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class AdaptiveBatchTunerUnittest : public ::testing::Test {
+public:
+    void TestAdjustInterval();
+    void TestGrowUnderPressure();
+    void TestShrinkWhenIdle();
+    void TestCompressionRatio();
+
+protected:
+    // adjustment is allowed at most once per second
+    chrono::steady_clock::time_point NextAdjustTime() {
+        mNow += chrono::seconds(2);
+        return mNow;
+    }
+
+    chrono::steady_clock::time_point mNow = chrono::steady_clock::now();
+};
+
+void AdaptiveBatchTunerUnittest::TestAdjustInterval() {
+    AdaptiveBatchTuner tuner(100, 1600, 400);
+    uint32_t target = 0;
+    tuner.OnSendDone(chrono::milliseconds(10), chrono::milliseconds(10), true);
+    APSARA_TEST_FALSE(tuner.Adjust(chrono::steady_clock::now(), target));
+    APSARA_TEST_EQUAL(400U, tuner.GetTargetSizeBytes());
+}
+
+void AdaptiveBatchTunerUnittest::TestGrowUnderPressure() {
+    AdaptiveBatchTuner tuner(100, 1600, 400);
+    uint32_t target = 0;
+    // throttled
+    tuner.OnSendDone(chrono::milliseconds(10), chrono::milliseconds(10), true);
+    APSARA_TEST_TRUE(tuner.Adjust(NextAdjustTime(), target));
+    APSARA_TEST_EQUAL(800U, target);
+    // items wait too long in sender queue
+    tuner.OnSendDone(chrono::milliseconds(10), chrono::milliseconds(5000), false);
+    APSARA_TEST_TRUE(tuner.Adjust(NextAdjustTime(), target));
+    APSARA_TEST_EQUAL(1600U, target);
+    // bounded by max size
+    tuner.OnSendDone(chrono::milliseconds(5000), chrono::milliseconds(10), false);
+    APSARA_TEST_FALSE(tuner.Adjust(NextAdjustTime(), target));
+    APSARA_TEST_EQUAL(1600U, tuner.GetTargetSizeBytes());
+
+    // moderate queue time keeps the target unchanged
+    tuner.OnSendDone(chrono::milliseconds(10), chrono::milliseconds(500), false);
+    APSARA_TEST_FALSE(tuner.Adjust(NextAdjustTime(), target));
+    APSARA_TEST_EQUAL(1600U, tuner.GetTargetSizeBytes());
+}
+
+void AdaptiveBatchTunerUnittest::TestShrinkWhenIdle() {
+    AdaptiveBatchTuner tuner(100, 1600, 400);
+    uint32_t target = 0;
+    tuner.OnSendDone(chrono::milliseconds(10), chrono::milliseconds(10), false);
+    APSARA_TEST_TRUE(tuner.Adjust(NextAdjustTime(), target));
+    APSARA_TEST_EQUAL(300U, target);
+    // no send at all is also regarded as idle
+    for (size_t i = 0; i < 10; ++i) {
+        tuner.Adjust(NextAdjustTime(), target);
+    }
+    APSARA_TEST_EQUAL(100U, tuner.GetTargetSizeBytes());
+}
+
+void AdaptiveBatchTunerUnittest::TestCompressionRatio() {
+    AdaptiveBatchTuner tuner(100, 10000, 400);
+    uint32_t target = 0;
+    // raw target is unchanged on first observation
+    tuner.OnCompressed(1000, 100);
+    APSARA_TEST_EQUAL(400U, tuner.GetTargetSizeBytes());
+
+    tuner.OnSendDone(chrono::milliseconds(10), chrono::milliseconds(10), true);
+    APSARA_TEST_TRUE(tuner.Adjust(NextAdjustTime(), target));
+    APSARA_TEST_EQUAL(800U, target);
+
+    // raw target follows the compression ratio, with the compressed one unchanged
+    for (size_t i = 0; i < 100; ++i) {
+        tuner.OnCompressed(2000, 100);
+    }
+    tuner.OnSendDone(chrono::milliseconds(10), chrono::milliseconds(500), false);
+    APSARA_TEST_TRUE(tuner.Adjust(NextAdjustTime(), target));
+    APSARA_TEST_TRUE(target > 1500U);
+    APSARA_TEST_TRUE(target <= 1600U);
+}
+
+UNIT_TEST_CASE(AdaptiveBatchTunerUnittest, TestAdjustInterval)
+UNIT_TEST_CASE(AdaptiveBatchTunerUnittest, TestGrowUnderPressure)
+UNIT_TEST_CASE(AdaptiveBatchTunerUnittest, TestShrinkWhenIdle)
+UNIT_TEST_CASE(AdaptiveBatchTunerUnittest, TestCompressionRatio)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
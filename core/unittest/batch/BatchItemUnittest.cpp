@@ -132,7 +132,7 @@ void EventBatchItemUnittest::TestFlushGroupBatchItem() {
     APSARA_TEST_TRUE(mItem.mSourceBuffers.empty());
     APSARA_TEST_EQUAL(0U, mItem.GetStatus().GetCnt());
     APSARA_TEST_EQUAL(0U, mItem.GetStatus().GetSize());
-    APSARA_TEST_EQUAL(0, mItem.GetStatus().GetCreateTime());
+    APSARA_TEST_EQUAL(0U, mItem.GetStatus().GetCreateTimeMs());
     // APSARA_TEST_EQUAL(0, mItem.mTotalEnqueTimeMs);
 }
 
@@ -160,7 +160,7 @@ void EventBatchItemUnittest::TestFlushBatchedEvensList() {
     APSARA_TEST_TRUE(mItem.mSourceBuffers.empty());
     APSARA_TEST_EQUAL(0U, mItem.GetStatus().GetCnt());
     APSARA_TEST_EQUAL(0U, mItem.GetStatus().GetSize());
-    APSARA_TEST_EQUAL(0, mItem.GetStatus().GetCreateTime());
+    APSARA_TEST_EQUAL(0U, mItem.GetStatus().GetCreateTimeMs());
     // APSARA_TEST_EQUAL(0, mItem.mTotalEnqueTimeMs);
 }
 
@@ -189,7 +189,7 @@ void EventBatchItemUnittest::TestFlushBatchedEvensLists() {
     APSARA_TEST_TRUE(mItem.mSourceBuffers.empty());
     APSARA_TEST_EQUAL(0U, mItem.GetStatus().GetCnt());
     APSARA_TEST_EQUAL(0U, mItem.GetStatus().GetSize());
-    APSARA_TEST_EQUAL(0, mItem.GetStatus().GetCreateTime());
+    APSARA_TEST_EQUAL(0U, mItem.GetStatus().GetCreateTimeMs());
     // APSARA_TEST_EQUAL(0, mItem.mTotalEnqueTimeMs);
 }
 
@@ -280,7 +280,7 @@ void GroupBatchItemUnittest::TestFlushBatchedEvensList() {
 
     APSARA_TEST_TRUE(mItem.IsEmpty());
     APSARA_TEST_EQUAL(0U, mItem.GetStatus().GetSize());
-    APSARA_TEST_EQUAL(0, mItem.GetStatus().GetCreateTime());
+    APSARA_TEST_EQUAL(0U, mItem.GetStatus().GetCreateTimeMs());
     APSARA_TEST_EQUAL(0, mItem.TotalEnqueTimeMs());
     APSARA_TEST_EQUAL(0U, mItem.EventSize());
     APSARA_TEST_EQUAL(0U, mItem.GroupSize());
@@ -297,7 +297,7 @@ void GroupBatchItemUnittest::TestFlushBatchedEvensLists() {
 
     APSARA_TEST_TRUE(mItem.IsEmpty());
     APSARA_TEST_EQUAL(0U, mItem.GetStatus().GetSize());
-    APSARA_TEST_EQUAL(0, mItem.GetStatus().GetCreateTime());
+    APSARA_TEST_EQUAL(0U, mItem.GetStatus().GetCreateTimeMs());
     APSARA_TEST_EQUAL(0, mItem.TotalEnqueTimeMs());
     APSARA_TEST_EQUAL(0U, mItem.EventSize());
     APSARA_TEST_EQUAL(0U, mItem.GroupSize());
@@ -49,19 +49,19 @@ PipelineEventPtr EventBatchStatusUnittest::sEvent;
 void EventBatchStatusUnittest::TestReset() {
     APSARA_TEST_EQUAL(0U, mStatus.GetCnt());
     APSARA_TEST_EQUAL(0U, mStatus.GetSize());
-    APSARA_TEST_EQUAL(0, mStatus.GetCreateTime());
+    APSARA_TEST_EQUAL(0U, mStatus.GetCreateTimeMs());
 }
 
 void EventBatchStatusUnittest::TestUpdate() {
     mStatus.Update(sEvent);
-    time_t createTime = mStatus.GetCreateTime();
+    uint64_t createTime = mStatus.GetCreateTimeMs();
     APSARA_TEST_EQUAL(1U, mStatus.GetCnt());
     APSARA_TEST_EQUAL(sEvent->DataSize(), mStatus.GetSize());
 
     mStatus.Update(sEvent);
     APSARA_TEST_EQUAL(2U, mStatus.GetCnt());
     APSARA_TEST_EQUAL(2 * sEvent->DataSize(), mStatus.GetSize());
-    APSARA_TEST_EQUAL(createTime, mStatus.GetCreateTime());
+    APSARA_TEST_EQUAL(createTime, mStatus.GetCreateTimeMs());
 }
 
 UNIT_TEST_CASE(EventBatchStatusUnittest, TestReset)
@@ -93,7 +93,7 @@ unique_ptr<PipelineEventGroup> SLSEventBatchStatusUnittest::sEventGroup;
 void SLSEventBatchStatusUnittest::TestReset() {
     APSARA_TEST_EQUAL(0U, mStatus.GetCnt());
     APSARA_TEST_EQUAL(0U, mStatus.GetSize());
-    APSARA_TEST_EQUAL(0, mStatus.GetCreateTime());
+    APSARA_TEST_EQUAL(0U, mStatus.GetCreateTimeMs());
     APSARA_TEST_EQUAL(0, mStatus.GetCreateTimeMinute());
 }
 
@@ -101,7 +101,7 @@ void SLSEventBatchStatusUnittest::TestUpdate() {
     PipelineEventPtr e1(sEventGroup->CreateLogEvent(), false, nullptr);
     e1->SetTimestamp(1717398001);
     mStatus.Update(e1);
-    time_t createTime = mStatus.GetCreateTime();
+    uint64_t createTime = mStatus.GetCreateTimeMs();
     APSARA_TEST_EQUAL(1U, mStatus.GetCnt());
     APSARA_TEST_EQUAL(e1->DataSize(), mStatus.GetSize());
     APSARA_TEST_EQUAL(1717398001 / 60, mStatus.GetCreateTimeMinute());
@@ -111,7 +111,7 @@ void SLSEventBatchStatusUnittest::TestUpdate() {
     mStatus.Update(e2);
     APSARA_TEST_EQUAL(2U, mStatus.GetCnt());
     APSARA_TEST_EQUAL(e1->DataSize() + e2->DataSize(), mStatus.GetSize());
-    APSARA_TEST_EQUAL(createTime, mStatus.GetCreateTime());
+    APSARA_TEST_EQUAL(createTime, mStatus.GetCreateTimeMs());
     APSARA_TEST_EQUAL(1717398000 / 60, mStatus.GetCreateTimeMinute());
 }
 
@@ -137,17 +137,17 @@ BatchedEvents GroupBatchStatusUnittest::sBatch;
 
 void GroupBatchStatusUnittest::TestReset() {
     APSARA_TEST_EQUAL(0U, mStatus.GetSize());
-    APSARA_TEST_EQUAL(0, mStatus.GetCreateTime());
+    APSARA_TEST_EQUAL(0U, mStatus.GetCreateTimeMs());
 }
 
 void GroupBatchStatusUnittest::TestUpdate() {
     mStatus.Update(sBatch);
-    time_t createTime = mStatus.GetCreateTime();
+    uint64_t createTime = mStatus.GetCreateTimeMs();
     APSARA_TEST_EQUAL(sBatch.mSizeBytes, mStatus.GetSize());
 
     mStatus.Update(sBatch);
     APSARA_TEST_EQUAL(2 * sBatch.mSizeBytes, mStatus.GetSize());
-    APSARA_TEST_EQUAL(createTime, mStatus.GetCreateTime());
+    APSARA_TEST_EQUAL(createTime, mStatus.GetCreateTimeMs());
 }
 
 UNIT_TEST_CASE(GroupBatchStatusUnittest, TestReset)
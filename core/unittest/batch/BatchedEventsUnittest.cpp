@@ -69,25 +69,28 @@ void BatchedEventsUnittest::TestDestructor() {
         log = g.AddLogEvent(true, &mPool);
         log->SetTimestamp(1234567890);
     }
-    APSARA_TEST_EQUAL(1U, mPool.mLogEventPoolBak.size());
-    APSARA_TEST_EQUAL(log, mPool.mLogEventPoolBak.back());
+    APSARA_TEST_EQUAL(1U, mPool.mReturnedLogEvents.Size());
+    APSARA_TEST_EQUAL(log, mPool.AcquireLogEvent(nullptr));
     APSARA_TEST_EQUAL(0, log->GetTimestamp());
+    mPool.Release({log});
     {
         PipelineEventGroup g(make_shared<SourceBuffer>());
         metric = g.AddMetricEvent(true, &mPool);
         metric->SetTimestamp(1234567890);
     }
-    APSARA_TEST_EQUAL(1U, mPool.mMetricEventPoolBak.size());
-    APSARA_TEST_EQUAL(metric, mPool.mMetricEventPoolBak.back());
+    APSARA_TEST_EQUAL(1U, mPool.mReturnedMetricEvents.Size());
+    APSARA_TEST_EQUAL(metric, mPool.AcquireMetricEvent(nullptr));
     APSARA_TEST_EQUAL(0, metric->GetTimestamp());
+    mPool.Release({metric});
     {
         PipelineEventGroup g(make_shared<SourceBuffer>());
         span = g.AddSpanEvent(true, &mPool);
         span->SetTimestamp(1234567890);
     }
-    APSARA_TEST_EQUAL(1U, mPool.mSpanEventPoolBak.size());
-    APSARA_TEST_EQUAL(span, mPool.mSpanEventPoolBak.back());
+    APSARA_TEST_EQUAL(1U, mPool.mReturnedSpanEvents.Size());
+    APSARA_TEST_EQUAL(span, mPool.AcquireSpanEvent(nullptr));
     APSARA_TEST_EQUAL(0, span->GetTimestamp());
+    mPool.Release({span});
 }
 
 UNIT_TEST_CASE(BatchedEventsUnittest, TestDestructor)
@@ -35,6 +35,7 @@ public:
     void TestFlushAllWithoutGroupBatch();
     void TestFlushAllWithGroupBatch();
     void TestMetric();
+    void TestAdaptiveSize();
 
 protected:
     static void SetUpTestCase() { sFlusher = make_unique<FlusherMock>(); }
@@ -93,6 +94,22 @@ void BatcherUnittest::TestParamInit() {
         APSARA_TEST_EQUAL(3U, batch.mEventFlushStrategy.GetTimeoutSecs());
         APSARA_TEST_EQUAL(300U, batch.mEventFlushStrategy.GetMaxSizeBytes());
     }
+    {
+        // sub-second timeout
+        Json::Value configJson;
+        string configStr, errorMsg;
+        configStr = R"(
+            {
+                "TimeoutSecs": 5,
+                "TimeoutMs": 100
+            }
+        )";
+        APSARA_TEST_TRUE(ParseJsonTable(configStr, configJson, errorMsg));
+
+        Batcher<> batch;
+        batch.Init(configJson, sFlusher.get(), strategy);
+        APSARA_TEST_EQUAL(100U, batch.mEventFlushStrategy.GetTimeoutMs());
+    }
 }
 
 void BatcherUnittest::TestInitWithoutGroupBatch() {
@@ -132,11 +149,11 @@ void BatcherUnittest::TestInitWithGroupBatch() {
     batch.Init(configJson, sFlusher.get(), DefaultFlushStrategyOptions(), true);
     APSARA_TEST_EQUAL(10U, batch.mEventFlushStrategy.GetMinCnt());
     APSARA_TEST_EQUAL(1000U, batch.mEventFlushStrategy.GetMinSizeBytes());
-    APSARA_TEST_EQUAL(3U, batch.mEventFlushStrategy.GetTimeoutSecs());
+    APSARA_TEST_EQUAL(2500U, batch.mEventFlushStrategy.GetTimeoutMs());
     APSARA_TEST_EQUAL(numeric_limits<uint32_t>::max(), batch.mEventFlushStrategy.GetMaxSizeBytes());
     APSARA_TEST_TRUE(batch.mGroupFlushStrategy);
     APSARA_TEST_EQUAL(1000U, batch.mGroupFlushStrategy->GetMinSizeBytes());
-    APSARA_TEST_EQUAL(2U, batch.mGroupFlushStrategy->GetTimeoutSecs());
+    APSARA_TEST_EQUAL(2500U, batch.mGroupFlushStrategy->GetTimeoutMs());
     APSARA_TEST_TRUE(batch.mGroupQueue);
     APSARA_TEST_EQUAL(sFlusher.get(), batch.mFlusher);
 }
@@ -163,11 +180,11 @@ void BatcherUnittest::TestAddWithoutGroupBatch() {
     APSARA_TEST_EQUAL(1U, TimeoutFlushManager::GetInstance()->mTimeoutRecords.size());
     APSARA_TEST_EQUAL(1U, TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].size());
     TimeoutRecord& record = TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key));
-    time_t updateTime = record.mUpdateTime;
-    APSARA_TEST_EQUAL(3U, record.mTimeoutSecs);
+    uint64_t updateTime = record.mUpdateTimeMs;
+    APSARA_TEST_EQUAL(3000U, record.mTimeoutMs);
     APSARA_TEST_EQUAL(sFlusher.get(), record.mFlusher);
     APSARA_TEST_EQUAL(key, record.mKey);
-    APSARA_TEST_GT(updateTime, 0);
+    APSARA_TEST_GT(updateTime, 0U);
 
     // flush by cnt && one batch item contains more than 1 original event group
     PipelineEventGroup group2 = CreateEventGroup(2);
@@ -186,7 +203,7 @@ void BatcherUnittest::TestAddWithoutGroupBatch() {
     APSARA_TEST_EQUAL(buffer2, res[0][0].mSourceBuffers[1].get());
     APSARA_TEST_EQUAL(eoo1, res[0][0].mExactlyOnceCheckpoint.get());
     APSARA_TEST_STREQ("pack_id", res[0][0].mPackIdPrefix.data());
-    APSARA_TEST_GT(TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key)).mUpdateTime,
+    APSARA_TEST_GT(TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key)).mUpdateTimeMs,
                    updateTime - 1);
 
     // flush by time then by size
@@ -208,7 +225,7 @@ void BatcherUnittest::TestAddWithoutGroupBatch() {
     APSARA_TEST_EQUAL(buffer2, res[0][0].mSourceBuffers[0].get());
     APSARA_TEST_EQUAL(eoo2, res[0][0].mExactlyOnceCheckpoint.get());
     APSARA_TEST_STREQ("pack_id", res[0][0].mPackIdPrefix.data());
-    APSARA_TEST_GT(TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key)).mUpdateTime,
+    APSARA_TEST_GT(TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key)).mUpdateTimeMs,
                    updateTime - 1);
     APSARA_TEST_EQUAL(1U, res[1].size());
     APSARA_TEST_EQUAL(1U, res[1][0].mEvents.size());
@@ -218,7 +235,7 @@ void BatcherUnittest::TestAddWithoutGroupBatch() {
     APSARA_TEST_EQUAL(buffer3, res[1][0].mSourceBuffers[0].get());
     APSARA_TEST_EQUAL(eoo3, res[1][0].mExactlyOnceCheckpoint.get());
     APSARA_TEST_STREQ("pack_id", res[1][0].mPackIdPrefix.data());
-    APSARA_TEST_GT(TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key)).mUpdateTime,
+    APSARA_TEST_GT(TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key)).mUpdateTimeMs,
                    updateTime - 1);
 }
 
@@ -244,11 +261,11 @@ void BatcherUnittest::TestAddWithGroupBatch() {
     APSARA_TEST_EQUAL(1U, TimeoutFlushManager::GetInstance()->mTimeoutRecords.size());
     APSARA_TEST_EQUAL(1U, TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].size());
     TimeoutRecord& record = TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key));
-    time_t updateTime = record.mUpdateTime;
-    APSARA_TEST_EQUAL(2U, record.mTimeoutSecs);
+    uint64_t updateTime = record.mUpdateTimeMs;
+    APSARA_TEST_EQUAL(1500U, record.mTimeoutMs);
     APSARA_TEST_EQUAL(sFlusher.get(), record.mFlusher);
     APSARA_TEST_EQUAL(key, record.mKey);
-    APSARA_TEST_GT(updateTime, 0);
+    APSARA_TEST_GT(updateTime, 0U);
 
     // flush by cnt && one batch item contains more than 1 original event group
     PipelineEventGroup group2 = CreateEventGroup(2);
@@ -267,7 +284,7 @@ void BatcherUnittest::TestAddWithGroupBatch() {
     APSARA_TEST_EQUAL(buffer2, res[0][0].mSourceBuffers[1].get());
     APSARA_TEST_EQUAL(eoo1, res[0][0].mExactlyOnceCheckpoint.get());
     APSARA_TEST_STREQ("pack_id", res[0][0].mPackIdPrefix.data());
-    APSARA_TEST_GT(TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key)).mUpdateTime,
+    APSARA_TEST_GT(TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key)).mUpdateTimeMs,
                    updateTime - 1);
 
     // flush by time to group batch
@@ -298,7 +315,7 @@ void BatcherUnittest::TestAddWithGroupBatch() {
     APSARA_TEST_EQUAL(buffer2, res[0][0].mSourceBuffers[0].get());
     APSARA_TEST_EQUAL(eoo2, res[0][0].mExactlyOnceCheckpoint.get());
     APSARA_TEST_STREQ("pack_id", res[0][0].mPackIdPrefix.data());
-    APSARA_TEST_GT(TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key)).mUpdateTime,
+    APSARA_TEST_GT(TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key)).mUpdateTimeMs,
                    updateTime - 1);
 
     // flush by time to group batch, and then group flush by size
@@ -320,7 +337,7 @@ void BatcherUnittest::TestAddWithGroupBatch() {
     APSARA_TEST_EQUAL(buffer3, res[0][0].mSourceBuffers[0].get());
     APSARA_TEST_EQUAL(eoo3, res[0][0].mExactlyOnceCheckpoint.get());
     APSARA_TEST_STREQ("pack_id", res[0][0].mPackIdPrefix.data());
-    APSARA_TEST_GT(TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key)).mUpdateTime,
+    APSARA_TEST_GT(TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key)).mUpdateTimeMs,
                    updateTime - 1);
     APSARA_TEST_EQUAL(1U, res[0][1].mEvents.size());
     APSARA_TEST_EQUAL(1U, res[0][1].mTags.mInner.size());
@@ -329,7 +346,7 @@ void BatcherUnittest::TestAddWithGroupBatch() {
     APSARA_TEST_EQUAL(buffer4, res[0][1].mSourceBuffers[0].get());
     APSARA_TEST_EQUAL(eoo4, res[0][1].mExactlyOnceCheckpoint.get());
     APSARA_TEST_STREQ("pack_id", res[0][1].mPackIdPrefix.data());
-    APSARA_TEST_GT(TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key)).mUpdateTime,
+    APSARA_TEST_GT(TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key)).mUpdateTimeMs,
                    updateTime - 1);
 
     // flush by size
@@ -355,7 +372,7 @@ void BatcherUnittest::TestAddWithGroupBatch() {
     APSARA_TEST_EQUAL(buffer7, res[0][0].mSourceBuffers[2].get());
     APSARA_TEST_EQUAL(eoo5, res[0][0].mExactlyOnceCheckpoint.get());
     APSARA_TEST_STREQ("pack_id", res[0][0].mPackIdPrefix.data());
-    APSARA_TEST_GT(TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key)).mUpdateTime,
+    APSARA_TEST_GT(TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, key)).mUpdateTimeMs,
                    updateTime - 1);
 }
 
@@ -444,11 +461,11 @@ void BatcherUnittest::TestFlushEventQueueWithGroupBatch() {
     APSARA_TEST_EQUAL(1U, TimeoutFlushManager::GetInstance()->mTimeoutRecords.size());
     APSARA_TEST_EQUAL(2U, TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].size());
     TimeoutRecord& record = TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, 0));
-    time_t updateTime = record.mUpdateTime;
-    APSARA_TEST_EQUAL(1U, record.mTimeoutSecs);
+    uint64_t updateTime = record.mUpdateTimeMs;
+    APSARA_TEST_EQUAL(1500U, record.mTimeoutMs);
     APSARA_TEST_EQUAL(sFlusher.get(), record.mFlusher);
     APSARA_TEST_EQUAL(0U, record.mKey);
-    APSARA_TEST_GT(updateTime, 0);
+    APSARA_TEST_GT(updateTime, 0U);
     APSARA_TEST_EQUAL(1U, batch.mGroupQueue->mGroups.size());
 
     // flush to group item, and group is flushed by time then by size
@@ -656,6 +673,75 @@ void BatcherUnittest::TestMetric() {
     }
 }
 
+void BatcherUnittest::TestAdaptiveSize() {
+    Json::Value config;
+    config["EnableAdaptiveSize"] = true;
+    config["MinSizeBytes"] = 1000;
+    config["MinCnt"] = 100;
+    DefaultFlushStrategyOptions strategy;
+    strategy.mMaxSizeBytes = 100000;
+    strategy.mMinCnt = 10;
+    strategy.mMinSizeBytes = 10;
+    strategy.mTimeoutSecs = 3;
+
+    Batcher<> batch;
+    APSARA_TEST_TRUE(batch.Init(config, sFlusher.get(), strategy));
+    APSARA_TEST_TRUE(batch.mAdaptiveTuner.has_value());
+    APSARA_TEST_EQUAL(250U, batch.mAdaptiveTuner->GetMinSizeBytes());
+    APSARA_TEST_EQUAL(8000U, batch.mAdaptiveTuner->GetMaxSizeBytes());
+    APSARA_TEST_EQUAL(1000U, batch.mTargetSizeBytes->GetValue());
+
+    // grow under pressure
+    batch.mAdaptiveTuner->mLastAdjustTime -= chrono::seconds(2);
+    batch.OnSendDone(chrono::milliseconds(10), chrono::milliseconds(10), true);
+    APSARA_TEST_EQUAL(2000U, batch.mEventFlushStrategy.GetMinSizeBytes());
+    APSARA_TEST_EQUAL(200U, batch.mEventFlushStrategy.GetMinCnt());
+    APSARA_TEST_EQUAL(2000U, batch.mTargetSizeBytes->GetValue());
+
+    // shrink when idle, and min cnt is scaled down accordingly
+    for (size_t i = 0; i < 3; ++i) {
+        batch.mAdaptiveTuner->mLastAdjustTime -= chrono::seconds(2);
+        batch.OnSendDone(chrono::milliseconds(10), chrono::milliseconds(10), false);
+    }
+    APSARA_TEST_EQUAL(843U, batch.mEventFlushStrategy.GetMinSizeBytes());
+    APSARA_TEST_EQUAL(84U, batch.mEventFlushStrategy.GetMinCnt());
+    APSARA_TEST_EQUAL(84U, batch.mTargetCnt->GetValue());
+
+    // fewer and larger batches are flushed under pressure
+    {
+        size_t eventSize = CreateEventGroup(1).GetEvents()[0]->DataSize();
+        Json::Value sizeConfig;
+        sizeConfig["EnableAdaptiveSize"] = true;
+        sizeConfig["MinSizeBytes"] = static_cast<uint32_t>(100 * eventSize);
+        sizeConfig["MinCnt"] = 100;
+        Batcher<> sizeBatch;
+        APSARA_TEST_TRUE(sizeBatch.Init(sizeConfig, sFlusher.get(), strategy));
+        auto flush = [&]() {
+            vector<BatchedEventsList> res;
+            for (size_t i = 0; i < 200; ++i) {
+                sizeBatch.Add(CreateEventGroup(10), res);
+            }
+            return res;
+        };
+        auto res = flush();
+        APSARA_TEST_EQUAL(20U, res.size());
+        APSARA_TEST_EQUAL(100U, res[0][0].mEvents.size());
+
+        sizeBatch.mAdaptiveTuner->mLastAdjustTime -= chrono::seconds(2);
+        sizeBatch.OnSendDone(chrono::milliseconds(10), chrono::milliseconds(10), true);
+        res = flush();
+        APSARA_TEST_EQUAL(10U, res.size());
+        APSARA_TEST_EQUAL(200U, res[0][0].mEvents.size());
+    }
+
+    // feedback is ignored when disabled
+    Batcher<> plain;
+    APSARA_TEST_TRUE(plain.Init(Json::Value(), sFlusher.get(), strategy));
+    APSARA_TEST_FALSE(plain.mAdaptiveTuner.has_value());
+    plain.OnSendDone(chrono::milliseconds(10), chrono::milliseconds(10), true);
+    APSARA_TEST_EQUAL(10U, plain.mEventFlushStrategy.GetMinSizeBytes());
+}
+
 PipelineEventGroup BatcherUnittest::CreateEventGroup(size_t cnt) {
     PipelineEventGroup group(make_shared<SourceBuffer>());
     group.SetTag(string("key"), string("val"));
@@ -680,6 +766,7 @@ UNIT_TEST_CASE(BatcherUnittest, TestFlushGroupQueue)
 UNIT_TEST_CASE(BatcherUnittest, TestFlushAllWithoutGroupBatch)
 UNIT_TEST_CASE(BatcherUnittest, TestFlushAllWithGroupBatch)
 UNIT_TEST_CASE(BatcherUnittest, TestMetric)
+UNIT_TEST_CASE(BatcherUnittest, TestAdaptiveSize)
 
 } // namespace logtail
 
@@ -42,7 +42,7 @@ void EventFlushStrategyUnittest::TestNeedFlush() {
 
     status.mCnt = 2;
     status.mSizeBytes = 50;
-    status.mCreateTime = time(nullptr) - 1;
+    status.mCreateTimeMs = GetCoarseSteadyTimeInMilliSeconds() - 1 * 1000;
     APSARA_TEST_TRUE(mStrategy.NeedFlushByCnt(status));
     APSARA_TEST_FALSE(mStrategy.NeedFlushBySize(status));
     APSARA_TEST_FALSE(mStrategy.NeedFlushByTime(status, PipelineEventPtr()));
@@ -50,7 +50,7 @@ void EventFlushStrategyUnittest::TestNeedFlush() {
 
     status.mCnt = 1;
     status.mSizeBytes = 100;
-    status.mCreateTime = time(nullptr) - 1;
+    status.mCreateTimeMs = GetCoarseSteadyTimeInMilliSeconds() - 1 * 1000;
     APSARA_TEST_FALSE(mStrategy.NeedFlushByCnt(status));
     APSARA_TEST_TRUE(mStrategy.NeedFlushBySize(status));
     APSARA_TEST_FALSE(mStrategy.NeedFlushByTime(status, PipelineEventPtr()));
@@ -58,14 +58,14 @@ void EventFlushStrategyUnittest::TestNeedFlush() {
 
     status.mCnt = 1;
     status.mSizeBytes = 50;
-    status.mCreateTime = time(nullptr) - 4;
+    status.mCreateTimeMs = GetCoarseSteadyTimeInMilliSeconds() - 4 * 1000;
     APSARA_TEST_FALSE(mStrategy.NeedFlushByCnt(status));
     APSARA_TEST_FALSE(mStrategy.NeedFlushBySize(status));
     APSARA_TEST_TRUE(mStrategy.NeedFlushByTime(status, PipelineEventPtr()));
     APSARA_TEST_FALSE(mStrategy.SizeReachingUpperLimit(status));
 
     status.mSizeBytes = 300;
-    status.mCreateTime = time(nullptr) - 1;
+    status.mCreateTimeMs = GetCoarseSteadyTimeInMilliSeconds() - 1 * 1000;
     APSARA_TEST_FALSE(mStrategy.NeedFlushByTime(status, PipelineEventPtr()));
     APSARA_TEST_TRUE(mStrategy.SizeReachingUpperLimit(status));
 }
@@ -78,16 +78,16 @@ public:
 };
 
 void GroupFlushStrategyUnittest::TestNeedFlush() {
-    GroupFlushStrategy strategy(100, 3);
+    GroupFlushStrategy strategy(100, 3000);
     GroupBatchStatus status;
 
     status.mSizeBytes = 100;
-    status.mCreateTime = time(nullptr) - 1;
+    status.mCreateTimeMs = GetCoarseSteadyTimeInMilliSeconds() - 1 * 1000;
     APSARA_TEST_TRUE(strategy.NeedFlushBySize(status));
     APSARA_TEST_FALSE(strategy.NeedFlushByTime(status));
 
     status.mSizeBytes = 50;
-    status.mCreateTime = time(nullptr) - 4;
+    status.mCreateTimeMs = GetCoarseSteadyTimeInMilliSeconds() - 4 * 1000;
     APSARA_TEST_FALSE(strategy.NeedFlushBySize(status));
     APSARA_TEST_TRUE(strategy.NeedFlushByTime(status));
 }
@@ -117,7 +117,7 @@ void SLSEventFlushStrategyUnittest::TestNeedFlush() {
     SLSEventBatchStatus status;
     status.mCnt = 2;
     status.mSizeBytes = 50;
-    status.mCreateTime = time(nullptr) - 1;
+    status.mCreateTimeMs = GetCoarseSteadyTimeInMilliSeconds() - 1 * 1000;
     status.mCreateTimeMinute = 1717398001 / 60;
     APSARA_TEST_TRUE(mStrategy.NeedFlushByCnt(status));
     APSARA_TEST_FALSE(mStrategy.NeedFlushBySize(status));
@@ -125,7 +125,7 @@ void SLSEventFlushStrategyUnittest::TestNeedFlush() {
 
     status.mCnt = 1;
     status.mSizeBytes = 100;
-    status.mCreateTime = time(nullptr) - 1;
+    status.mCreateTimeMs = GetCoarseSteadyTimeInMilliSeconds() - 1 * 1000;
     status.mCreateTimeMinute = 1717398001 / 60;
     APSARA_TEST_FALSE(mStrategy.NeedFlushByCnt(status));
     APSARA_TEST_TRUE(mStrategy.NeedFlushBySize(status));
@@ -133,7 +133,7 @@ void SLSEventFlushStrategyUnittest::TestNeedFlush() {
 
     status.mCnt = 1;
     status.mSizeBytes = 50;
-    status.mCreateTime = time(nullptr) - 4;
+    status.mCreateTimeMs = GetCoarseSteadyTimeInMilliSeconds() - 4 * 1000;
     status.mCreateTimeMinute = 1717398001 / 60;
     APSARA_TEST_FALSE(mStrategy.NeedFlushByCnt(status));
     APSARA_TEST_FALSE(mStrategy.NeedFlushBySize(status));
@@ -141,7 +141,7 @@ void SLSEventFlushStrategyUnittest::TestNeedFlush() {
 
     status.mCnt = 1;
     status.mSizeBytes = 50;
-    status.mCreateTime = time(nullptr) - 1;
+    status.mCreateTimeMs = GetCoarseSteadyTimeInMilliSeconds() - 1 * 1000;
     status.mCreateTimeMinute = 1717398071 / 60;
     APSARA_TEST_FALSE(mStrategy.NeedFlushByCnt(status));
     APSARA_TEST_FALSE(mStrategy.NeedFlushBySize(status));
@@ -12,6 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <chrono>
+#include <thread>
+
 #include "collection_pipeline/batch/TimeoutFlushManager.h"
 #include "unittest/Unittest.h"
 #include "unittest/plugin/PluginMock.h"
@@ -25,6 +28,7 @@ public:
     void TestUpdateRecord();
     void TestFlushTimeoutBatch();
     void TestClearRecords();
+    void TestFlushOnDeadline();
 
 protected:
     static void SetUpTestCase() {
@@ -34,7 +38,11 @@ protected:
         sFlusher->SetMetricsRecordRef(FlusherMock::sName, "1");
     }
 
-    void TearDown() override { TimeoutFlushManager::GetInstance()->mTimeoutRecords.clear(); }
+    void TearDown() override {
+        TimeoutFlushManager::GetInstance()->mTimeoutRecords.clear();
+        TimeoutFlushManager::GetInstance()->mDeadlines = {};
+        sFlusher->mFlushedQueues.clear();
+    }
 
 private:
     static unique_ptr<FlusherMock> sFlusher;
@@ -46,30 +54,30 @@ CollectionPipelineContext TimeoutFlushManagerUnittest::sCtx;
 
 void TimeoutFlushManagerUnittest::TestUpdateRecord() {
     // new batch queue
-    TimeoutFlushManager::GetInstance()->UpdateRecord("test_config", 0, 1, 3, sFlusher.get());
+    TimeoutFlushManager::GetInstance()->UpdateRecord("test_config", 0, 1, 3000, sFlusher.get());
     APSARA_TEST_EQUAL(1U, TimeoutFlushManager::GetInstance()->mTimeoutRecords.size());
     APSARA_TEST_EQUAL(1U, TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].size());
     auto& record1 = TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, 1));
     APSARA_TEST_EQUAL(1U, record1.mKey);
-    APSARA_TEST_EQUAL(3U, record1.mTimeoutSecs);
+    APSARA_TEST_EQUAL(3000U, record1.mTimeoutMs);
     APSARA_TEST_EQUAL(sFlusher.get(), record1.mFlusher);
-    APSARA_TEST_GT(record1.mUpdateTime, 0);
+    APSARA_TEST_GT(record1.mUpdateTimeMs, 0U);
 
     // existed batch queue
-    time_t lastTime = record1.mUpdateTime;
-    TimeoutFlushManager::GetInstance()->UpdateRecord("test_config", 0, 1, 3, sFlusher.get());
+    uint64_t lastTime = record1.mUpdateTimeMs;
+    TimeoutFlushManager::GetInstance()->UpdateRecord("test_config", 0, 1, 3000, sFlusher.get());
     APSARA_TEST_EQUAL(1U, TimeoutFlushManager::GetInstance()->mTimeoutRecords.size());
     APSARA_TEST_EQUAL(1U, TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].size());
     auto& record2 = TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].at(make_pair(0, 1));
     APSARA_TEST_EQUAL(1U, record2.mKey);
-    APSARA_TEST_EQUAL(3U, record2.mTimeoutSecs);
+    APSARA_TEST_EQUAL(3000U, record2.mTimeoutMs);
     APSARA_TEST_EQUAL(sFlusher.get(), record2.mFlusher);
-    APSARA_TEST_GT(record2.mUpdateTime, lastTime - 1);
+    APSARA_TEST_GT(record2.mUpdateTimeMs, lastTime - 1);
 }
 
 void TimeoutFlushManagerUnittest::TestFlushTimeoutBatch() {
     TimeoutFlushManager::GetInstance()->UpdateRecord("test_config", 0, 0, 0, sFlusher.get());
-    TimeoutFlushManager::GetInstance()->UpdateRecord("test_config", 0, 1, 3, sFlusher.get());
+    TimeoutFlushManager::GetInstance()->UpdateRecord("test_config", 0, 1, 3000, sFlusher.get());
     TimeoutFlushManager::GetInstance()->UpdateRecord("test_config", 0, 2, 0, sFlusher.get());
 
     TimeoutFlushManager::GetInstance()->FlushTimeoutBatch();
@@ -78,15 +86,39 @@ void TimeoutFlushManagerUnittest::TestFlushTimeoutBatch() {
 }
 
 void TimeoutFlushManagerUnittest::TestClearRecords() {
-    TimeoutFlushManager::GetInstance()->UpdateRecord("test_config", 0, 1, 3, sFlusher.get());
+    TimeoutFlushManager::GetInstance()->UpdateRecord("test_config", 0, 1, 3000, sFlusher.get());
     TimeoutFlushManager::GetInstance()->ClearRecords("test_config");
 
     APSARA_TEST_EQUAL(0U, TimeoutFlushManager::GetInstance()->mTimeoutRecords.size());
 }
 
+void TimeoutFlushManagerUnittest::TestFlushOnDeadline() {
+    TimeoutFlushManager::GetInstance()->Init();
+    auto start = chrono::steady_clock::now();
+    TimeoutFlushManager::GetInstance()->UpdateRecord("test_config", 0, 1, 3000, sFlusher.get());
+    TimeoutFlushManager::GetInstance()->UpdateRecord("test_config", 0, 2, 100, sFlusher.get());
+    for (size_t i = 0; i < 100; ++i) {
+        {
+            lock_guard<mutex> lock(TimeoutFlushManager::GetInstance()->mMux);
+            if (TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].size() == 1U) {
+                break;
+            }
+        }
+        this_thread::sleep_for(chrono::milliseconds(10));
+    }
+    auto cost = chrono::steady_clock::now() - start;
+    TimeoutFlushManager::GetInstance()->Stop();
+
+    // only the batch with sub-second timeout is flushed, without waiting for a whole second
+    APSARA_TEST_EQUAL(1U, sFlusher->mFlushedQueues.size());
+    APSARA_TEST_EQUAL(2U, sFlusher->mFlushedQueues[0]);
+    APSARA_TEST_TRUE(cost < chrono::milliseconds(1000));
+}
+
 UNIT_TEST_CASE(TimeoutFlushManagerUnittest, TestUpdateRecord)
 UNIT_TEST_CASE(TimeoutFlushManagerUnittest, TestFlushTimeoutBatch)
 UNIT_TEST_CASE(TimeoutFlushManagerUnittest, TestClearRecords)
+UNIT_TEST_CASE(TimeoutFlushManagerUnittest, TestFlushOnDeadline)
 
 } // namespace logtail
 
@@ -0,0 +1,218 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "app_config/AppConfig.h"
+#include "checkpoint/CheckpointManagerV2.h"
+#include "common/Flags.h"
+#include "common/RuntimeUtil.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_INT32(checkpoint_group_commit_async_interval_ms);
+
+using namespace std;
+
+namespace logtail {
+
+class CheckpointGroupCommitUnittest : public ::testing::Test {
+public:
+    void TestReadPendingWrites();
+    void TestAsyncWrite();
+    void TestDeleteDropsPendingWrites();
+    void TestGroupCommit();
+    void TestFlushWaitsForCommittingWrites();
+    void TestCommitResultPerBatch();
+
+protected:
+    static void SetUpTestCase() {
+        sRootDir = (filesystem::path(GetProcessExecutionDir()) / "CheckpointGroupCommitUnittest").string();
+        filesystem::remove_all(sRootDir);
+        filesystem::create_directories(sRootDir);
+        AppConfig::GetInstance()->SetLoongcollectorConfDir(sRootDir);
+        // async writes are committed only on flush or with sync writes during the tests
+        INT32_FLAG(checkpoint_group_commit_async_interval_ms) = 1000 * 1000;
+    }
+
+    static void TearDownTestCase() { filesystem::remove_all(sRootDir); }
+
+    static string sRootDir;
+};
+
+string CheckpointGroupCommitUnittest::sRootDir;
+
+void CheckpointGroupCommitUnittest::TestReadPendingWrites() {
+    CheckpointManagerV2 m;
+    APSARA_TEST_TRUE(m.mCommitThreadPtr != nullptr);
+
+    APSARA_TEST_TRUE(m.write("range_key", "v1", false));
+    string value;
+    APSARA_TEST_FALSE(m.readDatabase("range_key", value));
+    APSARA_TEST_TRUE(m.read("range_key", value));
+    APSARA_TEST_EQUAL("v1", value);
+
+    // the latest update of the key wins
+    APSARA_TEST_TRUE(m.write("range_key", "v2", false));
+    APSARA_TEST_TRUE(m.read("range_key", value));
+    APSARA_TEST_EQUAL("v2", value);
+    m.Flush();
+    APSARA_TEST_TRUE(m.readDatabase("range_key", value));
+    APSARA_TEST_EQUAL("v2", value);
+    m.DeleteCheckpoints({"range_key"});
+}
+
+void CheckpointGroupCommitUnittest::TestAsyncWrite() {
+    CheckpointManagerV2 m;
+    APSARA_TEST_TRUE(m.write("async_key", "async", false));
+    // a sync write commits all pending updates together
+    APSARA_TEST_TRUE(m.write("sync_key", "sync"));
+    string value;
+    APSARA_TEST_TRUE(m.readDatabase("async_key", value));
+    APSARA_TEST_EQUAL("async", value);
+    APSARA_TEST_TRUE(m.readDatabase("sync_key", value));
+    APSARA_TEST_EQUAL("sync", value);
+    {
+        lock_guard<mutex> lock(m.mCommitMutex);
+        APSARA_TEST_TRUE(m.mPendingWrites.empty());
+    }
+    m.DeleteCheckpoints({"async_key", "sync_key"});
+}
+
+void CheckpointGroupCommitUnittest::TestDeleteDropsPendingWrites() {
+    CheckpointManagerV2 m;
+    APSARA_TEST_TRUE(m.write("deleted_key", "v", false));
+    m.DeleteCheckpoints({"deleted_key"});
+    m.Flush();
+    string value;
+    APSARA_TEST_FALSE(m.read("deleted_key", value));
+}
+
+void CheckpointGroupCommitUnittest::TestGroupCommit() {
+    CheckpointManagerV2 m;
+    auto commitsBefore = m.mCommitsTotal->GetValue();
+    auto checkpointsBefore = m.mCommittedCheckpointsTotal->GetValue();
+
+    const size_t kWriterCnt = 8;
+    for (size_t i = 0; i < kWriterCnt; ++i) {
+        APSARA_TEST_TRUE(m.write("batch_key_" + to_string(i), "v", false));
+    }
+    vector<thread> writers;
+    for (size_t i = 0; i < kWriterCnt; ++i) {
+        writers.emplace_back([&m, i]() { m.write("sync_batch_key_" + to_string(i), "v"); });
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+
+    auto commits = m.mCommitsTotal->GetValue() - commitsBefore;
+    APSARA_TEST_TRUE(commits >= 1U);
+    APSARA_TEST_TRUE(commits <= kWriterCnt);
+    APSARA_TEST_EQUAL(2 * kWriterCnt, m.mCommittedCheckpointsTotal->GetValue() - checkpointsBefore);
+    vector<string> keys;
+    for (size_t i = 0; i < kWriterCnt; ++i) {
+        string value;
+        APSARA_TEST_TRUE(m.readDatabase("sync_batch_key_" + to_string(i), value));
+        keys.push_back("batch_key_" + to_string(i));
+        keys.push_back("sync_batch_key_" + to_string(i));
+    }
+    m.DeleteCheckpoints(keys);
+}
+
+void CheckpointGroupCommitUnittest::TestFlushWaitsForCommittingWrites() {
+    CheckpointManagerV2 m;
+    APSARA_TEST_TRUE(m.write("committing_key", "v", false));
+    uint64_t batchNo = 0;
+    {
+        // the commit thread cannot take another batch, while this one is being committed
+        lock_guard<mutex> batchLock(m.mBatchWriteMutex);
+        {
+            lock_guard<mutex> lock(m.mCommitMutex);
+            batchNo = m.mPendingBatchNo++;
+            m.mCommittingWrites.swap(m.mPendingWrites);
+        }
+        atomic_bool flushed = false;
+        thread flusher([&]() {
+            m.Flush();
+            flushed = true;
+        });
+        this_thread::sleep_for(chrono::milliseconds(100));
+        APSARA_TEST_FALSE(flushed.load());
+        m.finishCommit(batchNo, true);
+        flusher.join();
+        APSARA_TEST_TRUE(flushed.load());
+    }
+}
+
+void CheckpointGroupCommitUnittest::TestCommitResultPerBatch() {
+    CheckpointManagerV2 m;
+    auto waitForWaiter = [&m](uint64_t batchNo) {
+        for (size_t i = 0; i < 500; ++i) {
+            {
+                lock_guard<mutex> lock(m.mCommitMutex);
+                if (m.mCommitResults.count(batchNo) > 0) {
+                    return;
+                }
+            }
+            this_thread::sleep_for(chrono::milliseconds(10));
+        }
+    };
+    bool failedRes = true;
+    bool succeededRes = false;
+    thread failedWriter;
+    thread succeededWriter;
+    {
+        lock_guard<mutex> batchLock(m.mBatchWriteMutex);
+        uint64_t failedBatchNo = 0;
+        {
+            lock_guard<mutex> lock(m.mCommitMutex);
+            failedBatchNo = m.mPendingBatchNo;
+        }
+        failedWriter = thread([&]() { failedRes = m.write("failed_key", "v"); });
+        waitForWaiter(failedBatchNo);
+        {
+            lock_guard<mutex> lock(m.mCommitMutex);
+            ++m.mPendingBatchNo;
+            m.mCommittingWrites.swap(m.mPendingWrites);
+        }
+        succeededWriter = thread([&]() { succeededRes = m.write("succeeded_key", "v"); });
+        waitForWaiter(failedBatchNo + 1);
+        m.finishCommit(failedBatchNo, false);
+    }
+    // the result of a batch is not overwritten by the following ones
+    failedWriter.join();
+    succeededWriter.join();
+    APSARA_TEST_FALSE(failedRes);
+    APSARA_TEST_TRUE(succeededRes);
+    {
+        lock_guard<mutex> lock(m.mCommitMutex);
+        APSARA_TEST_TRUE(m.mCommitResults.empty());
+    }
+    m.DeleteCheckpoints({"succeeded_key"});
+}
+
+UNIT_TEST_CASE(CheckpointGroupCommitUnittest, TestReadPendingWrites)
+UNIT_TEST_CASE(CheckpointGroupCommitUnittest, TestAsyncWrite)
+UNIT_TEST_CASE(CheckpointGroupCommitUnittest, TestDeleteDropsPendingWrites)
+UNIT_TEST_CASE(CheckpointGroupCommitUnittest, TestGroupCommit)
+UNIT_TEST_CASE(CheckpointGroupCommitUnittest, TestFlushWaitsForCommittingWrites)
+UNIT_TEST_CASE(CheckpointGroupCommitUnittest, TestCommitResultPerBatch)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -0,0 +1,189 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <thread>
+
+#include "common/Flags.h"
+#include "common/memory/ChunkPool.h"
+#include "common/memory/SourceBuffer.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_BOOL(enable_chunk_pool);
+DECLARE_FLAG_INT32(chunk_pool_max_cached_size_mb);
+DECLARE_FLAG_INT32(chunk_pool_thread_cached_size_kb);
+
+using namespace std;
+
+namespace logtail {
+
+class ChunkPoolUnittest : public ::testing::Test {
+public:
+    void TestSizeClass();
+    void TestAcquireAndRelease();
+    void TestCrossThreadRelease();
+    void TestSharedCacheLimit();
+    void TestDisabled();
+    void TestSourceBuffer();
+
+protected:
+    void SetUp() override {
+        BOOL_FLAG(enable_chunk_pool) = true;
+        INT32_FLAG(chunk_pool_max_cached_size_mb) = 64;
+        INT32_FLAG(chunk_pool_thread_cached_size_kb) = 2048;
+    }
+
+    void TearDown() override {
+        // move chunks cached by the current thread to the shared cache before trimming
+        auto& cache = ChunkPool::GetThreadCache();
+        for (size_t idx = 0; idx < ChunkPool::kSizeClassCnt; ++idx) {
+            ChunkPool::GetInstance()->ReturnToSharedCache(idx, cache, cache.mChunks[idx].size());
+        }
+        ChunkPool::GetInstance()->Trim();
+    }
+};
+
+void ChunkPoolUnittest::TestSizeClass() {
+    APSARA_TEST_EQUAL(0U, ChunkPool::GetSizeClass(1));
+    APSARA_TEST_EQUAL(0U, ChunkPool::GetSizeClass(4096));
+    APSARA_TEST_EQUAL(1U, ChunkPool::GetSizeClass(4097));
+    APSARA_TEST_EQUAL(5U, ChunkPool::GetSizeClass(128 * 1024));
+    APSARA_TEST_EQUAL(6U, ChunkPool::GetSizeClass(128 * 1024 + 1));
+    APSARA_TEST_EQUAL(ChunkPool::kSizeClassCnt - 1, ChunkPool::GetSizeClass(1024 * 1024));
+    for (size_t idx = 0; idx < ChunkPool::kSizeClassCnt; ++idx) {
+        APSARA_TEST_EQUAL(idx, ChunkPool::GetSizeClass(ChunkPool::GetSizeClassCapacity(idx)));
+    }
+    // reader buffers
+    APSARA_TEST_EQUAL(640U * 1024, ChunkPool::GetSizeClassCapacity(ChunkPool::GetSizeClass(512 * 1024 + 2)));
+}
+
+void ChunkPoolUnittest::TestAcquireAndRelease() {
+    auto pool = ChunkPool::GetInstance();
+    auto inUse = pool->GetInUseSize();
+    auto missCnt = pool->GetAcquireMissCnt();
+
+    size_t size = 5000;
+    uint8_t* chunk = pool->Acquire(size);
+    APSARA_TEST_EQUAL(8192U, size);
+    APSARA_TEST_EQUAL(inUse + 8192, pool->GetInUseSize());
+    APSARA_TEST_EQUAL(missCnt + 1, pool->GetAcquireMissCnt());
+    chunk[size - 1] = 'a';
+
+    pool->Release(chunk, size);
+    APSARA_TEST_EQUAL(inUse, pool->GetInUseSize());
+    APSARA_TEST_EQUAL(8192U, ChunkPool::GetThreadCache().mCachedSize);
+
+    size_t newSize = 8000;
+    uint8_t* newChunk = pool->Acquire(newSize);
+    APSARA_TEST_EQUAL(chunk, newChunk);
+    APSARA_TEST_EQUAL(8192U, newSize);
+    APSARA_TEST_EQUAL(missCnt + 1, pool->GetAcquireMissCnt());
+    pool->Release(newChunk, newSize);
+
+    // oversized chunks are not pooled
+    size_t hugeSize = 2 * 1024 * 1024;
+    uint8_t* hugeChunk = pool->Acquire(hugeSize);
+    APSARA_TEST_EQUAL(2U * 1024 * 1024, hugeSize);
+    pool->Release(hugeChunk, hugeSize);
+    APSARA_TEST_EQUAL(8192U, ChunkPool::GetThreadCache().mCachedSize);
+}
+
+void ChunkPoolUnittest::TestCrossThreadRelease() {
+    auto pool = ChunkPool::GetInstance();
+    INT32_FLAG(chunk_pool_thread_cached_size_kb) = 0;
+
+    vector<pair<uint8_t*, size_t>> chunks;
+    for (size_t i = 0; i < 10; ++i) {
+        size_t size = 64 * 1024;
+        chunks.emplace_back(pool->Acquire(size), size);
+    }
+    thread t([&]() {
+        for (auto& item : chunks) {
+            pool->Release(item.first, item.second);
+        }
+    });
+    t.join();
+    APSARA_TEST_EQUAL(10U * 64 * 1024, pool->mSharedCachedSize.load());
+    APSARA_TEST_EQUAL(10U * 64 * 1024, pool->GetCachedSize());
+
+    auto missCnt = pool->GetAcquireMissCnt();
+    size_t size = 64 * 1024;
+    uint8_t* chunk = pool->Acquire(size);
+    APSARA_TEST_EQUAL(missCnt, pool->GetAcquireMissCnt());
+    APSARA_TEST_EQUAL(9U * 64 * 1024, pool->mSharedCachedSize.load());
+    pool->Release(chunk, size);
+}
+
+void ChunkPoolUnittest::TestSharedCacheLimit() {
+    auto pool = ChunkPool::GetInstance();
+    INT32_FLAG(chunk_pool_thread_cached_size_kb) = 0;
+    INT32_FLAG(chunk_pool_max_cached_size_mb) = 1;
+
+    vector<pair<uint8_t*, size_t>> chunks;
+    for (size_t i = 0; i < 4; ++i) {
+        size_t size = 512 * 1024 + 2;
+        chunks.emplace_back(pool->Acquire(size), size);
+    }
+    for (auto& item : chunks) {
+        pool->Release(item.first, item.second);
+    }
+    // only one 640KB chunk can be kept within 1MB
+    APSARA_TEST_EQUAL(640U * 1024, pool->mSharedCachedSize.load());
+    APSARA_TEST_EQUAL(640U * 1024, pool->GetCachedSize());
+}
+
+void ChunkPoolUnittest::TestDisabled() {
+    auto pool = ChunkPool::GetInstance();
+    BOOL_FLAG(enable_chunk_pool) = false;
+    auto cached = pool->GetCachedSize();
+
+    size_t size = 5000;
+    uint8_t* chunk = pool->Acquire(size);
+    APSARA_TEST_EQUAL(5000U, size);
+    pool->Release(chunk, size);
+    APSARA_TEST_EQUAL(cached, pool->GetCachedSize());
+}
+
+void ChunkPoolUnittest::TestSourceBuffer() {
+    auto pool = ChunkPool::GetInstance();
+    auto inUse = pool->GetInUseSize();
+    {
+        auto sourceBuffer = make_shared<SourceBuffer>();
+        sourceBuffer->CopyString(string(3000, 'a'));
+        sourceBuffer->CopyString(string(3000, 'b'));
+        sourceBuffer->CopyString(string(20000, 'c'));
+        // the second string is too large for the remaining space and is allocated separately
+        APSARA_TEST_EQUAL(inUse + 4096 + 4096 + 32768, pool->GetInUseSize());
+    }
+    APSARA_TEST_EQUAL(inUse, pool->GetInUseSize());
+    APSARA_TEST_EQUAL(4096U + 4096 + 32768, ChunkPool::GetThreadCache().mCachedSize);
+
+    auto missCnt = pool->GetAcquireMissCnt();
+    {
+        auto sourceBuffer = make_shared<SourceBuffer>();
+        sourceBuffer->CopyString(string(3000, 'a'));
+        sourceBuffer->CopyString(string(3000, 'b'));
+    }
+    APSARA_TEST_EQUAL(missCnt, pool->GetAcquireMissCnt());
+}
+
+UNIT_TEST_CASE(ChunkPoolUnittest, TestSizeClass)
+UNIT_TEST_CASE(ChunkPoolUnittest, TestAcquireAndRelease)
+UNIT_TEST_CASE(ChunkPoolUnittest, TestCrossThreadRelease)
+UNIT_TEST_CASE(ChunkPoolUnittest, TestSharedCacheLimit)
+UNIT_TEST_CASE(ChunkPoolUnittest, TestDisabled)
+UNIT_TEST_CASE(ChunkPoolUnittest, TestSourceBuffer)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
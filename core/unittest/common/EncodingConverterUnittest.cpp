@@ -12,9 +12,15 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <random>
+#include <string>
+#include <vector>
+
 #include "common/EncodingConverter.h"
 #include "unittest/Unittest.h"
 #if defined(__linux__)
+#include <iconv.h>
+
 #include "unittest/UnittestHelper.h"
 #endif
 
@@ -23,9 +29,20 @@ namespace logtail {
 class EncodingConverterUnittest : public ::testing::Test {
 public:
     void ConvertGbk2Utf8();
+#if defined(__linux__)
+    void ConvertInvalidLine();
+    void ConvertSameAsIconv();
+
+private:
+    static std::string Convert(const std::string& src, const std::vector<long>& linePosVec);
+#endif
 };
 
 APSARA_UNIT_TEST_CASE(EncodingConverterUnittest, ConvertGbk2Utf8, 0);
+#if defined(__linux__)
+APSARA_UNIT_TEST_CASE(EncodingConverterUnittest, ConvertInvalidLine, 0);
+APSARA_UNIT_TEST_CASE(EncodingConverterUnittest, ConvertSameAsIconv, 0);
+#endif
 
 void EncodingConverterUnittest::ConvertGbk2Utf8() {
     char gbkStr[] = "ilogtail\xbf\xc9\xb9\xdb\xb2\xe2\xd0\xd4\xb2\xc9\xbc\xaf\xc6\xf7";
@@ -41,6 +58,76 @@ void EncodingConverterUnittest::ConvertGbk2Utf8() {
     APSARA_TEST_STREQ("ilogtail可观测性采集器", destChar.get());
 }
 
+#if defined(__linux__)
+std::string EncodingConverterUnittest::Convert(const std::string& src, const std::vector<long>& linePosVec) {
+    size_t srcLen = src.size();
+    std::string res(src.size() * 2 + 1, '\0');
+    size_t size
+        = EncodingConverter::GetInstance()->ConvertGbk2Utf8(src.data(), &srcLen, res.data(), res.size(), linePosVec);
+    res.resize(size);
+    return res;
+}
+
+void EncodingConverterUnittest::ConvertInvalidLine() {
+    // the second line has an invalid trail byte, and the third line ends with an incomplete character
+    std::string src = "ascii\n\xbf\xc9\xb9\x7f\n\xb2\xe2\xd0\n\xd0\xd4";
+    std::vector<long> linePosVec = {-1, 5, 10, 14, 16};
+    APSARA_TEST_EQUAL(std::string("ascii\n\xbf\xc9\xb9\x7f\n\xb2\xe2\xd0\n性"), Convert(src, linePosVec));
+
+    // bytes after the last line are ignored
+    linePosVec = {-1, 5};
+    APSARA_TEST_EQUAL(std::string("ascii\n"), Convert(src, linePosVec));
+
+    // the output of a line cannot exceed the destination buffer, so the line is copied as it is
+    src = "\x80\x80\x80";
+    linePosVec = {-1, 2};
+    APSARA_TEST_EQUAL(src, Convert(src, linePosVec));
+}
+
+void EncodingConverterUnittest::ConvertSameAsIconv() {
+    iconv_t cd = iconv_open("UTF-8", "GBK");
+    APSARA_TEST_TRUE_FATAL(cd != (iconv_t)(-1));
+    std::mt19937 gen(0);
+    std::uniform_int_distribution<int> dist(0, 255);
+    for (int round = 0; round < 200; ++round) {
+        std::string src;
+        std::vector<long> linePosVec = {-1};
+        std::string expected;
+        for (int line = 0; line < 10; ++line) {
+            std::string content;
+            size_t len = dist(gen) % 64;
+            for (size_t i = 0; i < len; ++i) {
+                int c = dist(gen);
+                if (c < 128 || round % 4 == 0) {
+                    // mostly valid characters
+                    content.push_back(static_cast<char>(c < 128 ? c % 96 + 32 : c));
+                } else {
+                    content.push_back(static_cast<char>(0x81 + c % 0x7e));
+                    content.push_back(static_cast<char>(0xa1 + dist(gen) % 0x5e));
+                }
+            }
+            content.push_back('\n');
+            src += content;
+            linePosVec.push_back(src.size() - 1);
+
+            std::string converted(content.size() * 3, '\0');
+            char* in = content.data();
+            size_t inLen = content.size();
+            char* out = converted.data();
+            size_t outLen = converted.size();
+            if (iconv(cd, &in, &inLen, &out, &outLen) == (size_t)(-1)) {
+                iconv(cd, NULL, NULL, NULL, NULL);
+                expected += content;
+            } else {
+                expected.append(converted.data(), out - converted.data());
+            }
+        }
+        APSARA_TEST_EQUAL(expected, Convert(src, linePosVec));
+    }
+    iconv_close(cd);
+}
+#endif
+
 } // namespace logtail
 
 int main(int argc, char** argv) {
@@ -0,0 +1,68 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fnmatch.h>
+
+#include <string>
+#include <vector>
+
+#include "common/GlobMatcher.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class GlobMatcherUnittest : public ::testing::Test {
+public:
+    void TestKind();
+    void TestMatch();
+};
+
+void GlobMatcherUnittest::TestKind() {
+    APSARA_TEST_TRUE(GlobMatcher("*").mKind == GlobMatcher::Kind::ALL);
+    APSARA_TEST_TRUE(GlobMatcher("**").mKind == GlobMatcher::Kind::ALL);
+    APSARA_TEST_TRUE(GlobMatcher("a.log").mKind == GlobMatcher::Kind::EXACT);
+    APSARA_TEST_TRUE(GlobMatcher("a.log*").mKind == GlobMatcher::Kind::PREFIX);
+    APSARA_TEST_TRUE(GlobMatcher("*.log").mKind == GlobMatcher::Kind::SUFFIX);
+    APSARA_TEST_TRUE(GlobMatcher("app*.log").mKind == GlobMatcher::Kind::PREFIX_SUFFIX);
+    APSARA_TEST_TRUE(GlobMatcher("*error*").mKind == GlobMatcher::Kind::CONTAINS);
+    APSARA_TEST_TRUE(GlobMatcher("a*b*c").mKind == GlobMatcher::Kind::FNMATCH);
+    APSARA_TEST_TRUE(GlobMatcher("a?.log").mKind == GlobMatcher::Kind::FNMATCH);
+    APSARA_TEST_TRUE(GlobMatcher("[ab].log").mKind == GlobMatcher::Kind::FNMATCH);
+    APSARA_TEST_TRUE(GlobMatcher("a\\*.log").mKind == GlobMatcher::Kind::FNMATCH);
+}
+
+void GlobMatcherUnittest::TestMatch() {
+    vector<string> patterns = {"*",      "**",     "a.log",  "a.log*",   "*.log", "app*.log",
+                               "app**log", "*error*", "a*b*c", "a?.log", "[ab].log", "",
+                               "*a",     "a*a",    "**.log", "*.log*"};
+    vector<string> names = {"",         "a.log",      "a.log.1",  "b.log", "app.log", "applog", "app-error.log",
+                            "abc",      "axbyc",      "ab.log",   ".log",  "a",       "aa",     "error",
+                            ".hidden",  "app.log.gz", "x.log.log"};
+    for (const auto& pattern : patterns) {
+        GlobMatcher matcher(pattern);
+        for (const auto& name : names) {
+            EXPECT_EQ(fnmatch(pattern.c_str(), name.c_str(), 0) == 0, matcher.Match(name))
+                << "pattern: " << pattern << ", name: " << name;
+        }
+    }
+}
+
+UNIT_TEST_CASE(GlobMatcherUnittest, TestKind)
+UNIT_TEST_CASE(GlobMatcherUnittest, TestMatch)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -0,0 +1,126 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "json/json.h"
+
+#include "common/JsonWriter.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class JsonWriterUnittest : public ::testing::Test {
+public:
+    void TestObject();
+    void TestString();
+    void TestNumber();
+
+private:
+    static string WriteByJsoncpp(const Json::Value& value) {
+        Json::StreamWriterBuilder writer;
+        writer["indentation"] = "";
+        return Json::writeString(writer, value);
+    }
+};
+
+void JsonWriterUnittest::TestObject() {
+    JsonWriter tagWriter;
+    tagWriter.Key("tag1");
+    tagWriter.String("value1");
+    tagWriter.Key("tag2");
+    tagWriter.String("value2");
+    APSARA_TEST_EQUAL("\"tag1\":\"value1\",\"tag2\":\"value2\"", tagWriter.GetResult());
+
+    JsonWriter writer;
+    writer.StartObject();
+    writer.RawMembers(tagWriter.GetResult());
+    writer.Key("time");
+    writer.Int(-1234567890);
+    writer.Key("nested");
+    writer.StartObject();
+    writer.EndObject();
+    writer.Key("value");
+    writer.Double(0.5);
+    writer.EndObject();
+    writer.NewLine();
+    writer.StartObject();
+    writer.RawMembers("");
+    writer.Key("key");
+    writer.String("value");
+    writer.EndObject();
+    writer.NewLine();
+    APSARA_TEST_EQUAL("{\"tag1\":\"value1\",\"tag2\":\"value2\",\"time\":-1234567890,\"nested\":{},\"value\":0.5}\n"
+                      "{\"key\":\"value\"}\n",
+                      writer.GetResult());
+
+    writer.Clear();
+    writer.StartObject();
+    writer.EndObject();
+    APSARA_TEST_EQUAL("{}", writer.GetResult());
+}
+
+void JsonWriterUnittest::TestString() {
+    vector<string> values = {"",
+                             "plain text",
+                             "quote\" backslash\\ slash/",
+                             "\b\f\n\r\t",
+                             string("\x00\x01\x1f\x7f", 4),
+                             "中文 text",
+                             "emoji \xf0\x9f\x98\x80",
+                             "\xff invalid"};
+    for (const auto& value : values) {
+        JsonWriter writer;
+        writer.String(value);
+        APSARA_TEST_EQUAL(WriteByJsoncpp(Json::Value(value)), writer.GetResult());
+    }
+}
+
+void JsonWriterUnittest::TestNumber() {
+    vector<double> doubles = {0.0,
+                              -0.0,
+                              1.0,
+                              0.1,
+                              -2.5,
+                              1e20,
+                              1.2345678901234567e-300,
+                              numeric_limits<double>::max(),
+                              numeric_limits<double>::quiet_NaN(),
+                              numeric_limits<double>::infinity(),
+                              -numeric_limits<double>::infinity()};
+    for (auto value : doubles) {
+        JsonWriter writer;
+        writer.Double(value);
+        APSARA_TEST_EQUAL(WriteByJsoncpp(Json::Value(value)), writer.GetResult());
+    }
+    vector<int64_t> ints = {0, 1, -1, 1234567890, numeric_limits<int64_t>::max(), numeric_limits<int64_t>::min()};
+    for (auto value : ints) {
+        JsonWriter writer;
+        writer.Int(value);
+        APSARA_TEST_EQUAL(WriteByJsoncpp(Json::Value(Json::Int64(value))), writer.GetResult());
+    }
+}
+
+UNIT_TEST_CASE(JsonWriterUnittest, TestObject)
+UNIT_TEST_CASE(JsonWriterUnittest, TestString)
+UNIT_TEST_CASE(JsonWriterUnittest, TestNumber)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -12,7 +12,20 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <openssl/evp.h>
+#include <openssl/ssl.h>
+#include <openssl/x509.h>
+
+#include <atomic>
+#include <thread>
+
 #include "common/http/Curl.h"
+#include "common/http/CurlHandlerPool.h"
 #include "common/http/HttpRequest.h"
 #include "common/http/HttpResponse.h"
 #include "unittest/Unittest.h"
@@ -22,11 +35,217 @@ using namespace std;
 
 namespace logtail {
 
+// A minimal keep-alive http server answering every request with 200, which counts the accepted connections.
+class KeepAliveServer {
+public:
+    bool Start() {
+        mFd = socket(AF_INET, SOCK_STREAM, 0);
+        if (mFd < 0) {
+            return false;
+        }
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+        socklen_t len = sizeof(addr);
+        if (::bind(mFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || listen(mFd, 16) != 0
+            || getsockname(mFd, reinterpret_cast<sockaddr*>(&addr), &len) != 0) {
+            close(mFd);
+            return false;
+        }
+        mPort = ntohs(addr.sin_port);
+        mThread = thread(&KeepAliveServer::Run, this);
+        return true;
+    }
+
+    void Stop() {
+        shutdown(mFd, SHUT_RDWR);
+        if (mThread.joinable()) {
+            mThread.join();
+        }
+        close(mFd);
+    }
+
+    int32_t GetPort() const { return mPort; }
+    size_t GetConnectionCnt() const { return mConnectionCnt.load(); }
+
+private:
+    void Run() {
+        while (true) {
+            int conn = accept(mFd, nullptr, nullptr);
+            if (conn < 0) {
+                break;
+            }
+            ++mConnectionCnt;
+            HandleConnection(conn);
+            close(conn);
+        }
+    }
+
+    void HandleConnection(int conn) {
+        string data;
+        char buf[4096];
+        while (true) {
+            auto pos = data.find("\r\n\r\n");
+            if (pos != string::npos) {
+                data.erase(0, pos + 4);
+                const string resp = "HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\nok";
+                send(conn, resp.data(), resp.size(), 0);
+                continue;
+            }
+            auto n = recv(conn, buf, sizeof(buf), 0);
+            if (n <= 0) {
+                return;
+            }
+            data.append(buf, n);
+        }
+    }
+
+    int mFd = -1;
+    int32_t mPort = 0;
+    atomic_size_t mConnectionCnt = 0;
+    thread mThread;
+};
+
+// A minimal keep-alive https server with a self-signed certificate, which counts the full and the resumed handshakes.
+// TLS 1.2 is used so that sessions are resumed by session ids stored in the server-side cache.
+class TLSServer {
+public:
+    ~TLSServer() {
+        SSL_CTX_free(mCtx);
+        X509_free(mCert);
+        EVP_PKEY_free(mKey);
+    }
+
+    bool Start() {
+        if (!InitCtx()) {
+            return false;
+        }
+        mFd = socket(AF_INET, SOCK_STREAM, 0);
+        if (mFd < 0) {
+            return false;
+        }
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+        socklen_t len = sizeof(addr);
+        if (::bind(mFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || listen(mFd, 16) != 0
+            || getsockname(mFd, reinterpret_cast<sockaddr*>(&addr), &len) != 0) {
+            close(mFd);
+            return false;
+        }
+        mPort = ntohs(addr.sin_port);
+        mThread = thread(&TLSServer::Run, this);
+        return true;
+    }
+
+    void Stop() {
+        shutdown(mFd, SHUT_RDWR);
+        if (mThread.joinable()) {
+            mThread.join();
+        }
+        close(mFd);
+    }
+
+    int32_t GetPort() const { return mPort; }
+    size_t GetHandshakeCnt() const { return mHandshakeCnt.load(); }
+    size_t GetResumedCnt() const { return mResumedCnt.load(); }
+
+private:
+    bool InitCtx() {
+        EVP_PKEY_CTX* keyCtx = EVP_PKEY_CTX_new_id(EVP_PKEY_EC, nullptr);
+        bool succeeded = keyCtx != nullptr && EVP_PKEY_keygen_init(keyCtx) > 0
+            && EVP_PKEY_CTX_set_ec_paramgen_curve_nid(keyCtx, NID_X9_62_prime256v1) > 0
+            && EVP_PKEY_keygen(keyCtx, &mKey) > 0;
+        EVP_PKEY_CTX_free(keyCtx);
+        if (!succeeded) {
+            return false;
+        }
+
+        mCert = X509_new();
+        X509_set_version(mCert, 2);
+        ASN1_INTEGER_set(X509_get_serialNumber(mCert), 1);
+        X509_gmtime_adj(X509_getm_notBefore(mCert), 0);
+        X509_gmtime_adj(X509_getm_notAfter(mCert), 3600);
+        X509_set_pubkey(mCert, mKey);
+        X509_NAME* name = X509_get_subject_name(mCert);
+        X509_NAME_add_entry_by_txt(
+            name, "CN", MBSTRING_ASC, reinterpret_cast<const unsigned char*>("127.0.0.1"), -1, -1, 0);
+        X509_set_issuer_name(mCert, name);
+        if (X509_sign(mCert, mKey, EVP_sha256()) <= 0) {
+            return false;
+        }
+
+        mCtx = SSL_CTX_new(TLS_server_method());
+        if (mCtx == nullptr) {
+            return false;
+        }
+        static const unsigned char sSessionIdCtx[] = "CurlUnittest";
+        SSL_CTX_set_session_id_context(mCtx, sSessionIdCtx, sizeof(sSessionIdCtx) - 1);
+        SSL_CTX_set_session_cache_mode(mCtx, SSL_SESS_CACHE_SERVER);
+        return SSL_CTX_set_max_proto_version(mCtx, TLS1_2_VERSION) > 0 && SSL_CTX_use_certificate(mCtx, mCert) > 0
+            && SSL_CTX_use_PrivateKey(mCtx, mKey) > 0;
+    }
+
+    void Run() {
+        while (true) {
+            int conn = accept(mFd, nullptr, nullptr);
+            if (conn < 0) {
+                break;
+            }
+            SSL* ssl = SSL_new(mCtx);
+            SSL_set_fd(ssl, conn);
+            if (SSL_accept(ssl) > 0) {
+                ++mHandshakeCnt;
+                if (SSL_session_reused(ssl)) {
+                    ++mResumedCnt;
+                }
+                HandleConnection(ssl);
+                SSL_shutdown(ssl);
+            }
+            SSL_free(ssl);
+            close(conn);
+        }
+    }
+
+    void HandleConnection(SSL* ssl) {
+        string data;
+        char buf[4096];
+        while (true) {
+            auto pos = data.find("\r\n\r\n");
+            if (pos != string::npos) {
+                data.erase(0, pos + 4);
+                const string resp = "HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\nok";
+                SSL_write(ssl, resp.data(), resp.size());
+                continue;
+            }
+            auto n = SSL_read(ssl, buf, sizeof(buf));
+            if (n <= 0) {
+                return;
+            }
+            data.append(buf, n);
+        }
+    }
+
+    SSL_CTX* mCtx = nullptr;
+    EVP_PKEY* mKey = nullptr;
+    X509* mCert = nullptr;
+    int mFd = -1;
+    int32_t mPort = 0;
+    atomic_size_t mHandshakeCnt = 0;
+    atomic_size_t mResumedCnt = 0;
+    thread mThread;
+};
+
 class CurlUnittest : public ::testing::Test {
 public:
     void TestSendHttpRequest();
     void TestCurlTLS();
     void TestFollowRedirect();
+    void TestConnectionReuse();
+    void TestHandlerPool();
+    void TestTLSSessionReuse();
 };
 
 
@@ -73,9 +292,86 @@ void CurlUnittest::TestFollowRedirect() {
     APSARA_TEST_EQUAL(404, res.GetStatusCode());
 }
 
+void CurlUnittest::TestConnectionReuse() {
+    KeepAliveServer server;
+    APSARA_TEST_TRUE_FATAL(server.Start());
+    for (size_t i = 0; i < 3; ++i) {
+        HttpResponse res;
+        auto request = std::make_unique<HttpRequest>(
+            "GET", false, "127.0.0.1", server.GetPort(), "/", "", map<string, string>(), "", 10, 1);
+        APSARA_TEST_TRUE(SendHttpRequest(std::move(request), res));
+        APSARA_TEST_EQUAL(200, res.GetStatusCode());
+    }
+    // the connection is kept by the pooled handler
+    APSARA_TEST_EQUAL(1U, server.GetConnectionCnt());
+
+    // the connection is closed together with the handler
+    CurlHandlerPool::GetInstance()->Clear();
+    server.Stop();
+}
+
+void CurlUnittest::TestHandlerPool() {
+    auto pool = CurlHandlerPool::GetInstance();
+    pool->Clear();
+    auto curl1 = pool->Acquire(false, "host1", 80);
+    auto curl2 = pool->Acquire(false, "host1", 80);
+    APSARA_TEST_NOT_EQUAL(curl1, curl2);
+    pool->Release(curl1);
+    pool->Release(curl2);
+    APSARA_TEST_EQUAL(2U, pool->IdleSize());
+
+    // handlers are reused for the same host only
+    auto curl3 = pool->Acquire(true, "host1", 80);
+    APSARA_TEST_NOT_EQUAL(curl1, curl3);
+    APSARA_TEST_NOT_EQUAL(curl2, curl3);
+    APSARA_TEST_EQUAL(curl2, pool->Acquire(false, "host1", 80));
+    APSARA_TEST_EQUAL(1U, pool->IdleSize());
+    pool->Release(curl2);
+    pool->Release(curl3);
+    APSARA_TEST_EQUAL(3U, pool->IdleSize());
+
+    // idle handlers are cleaned up after timeout
+    {
+        lock_guard<mutex> lock(pool->mMux);
+        for (auto& item : pool->mIdleHandlers) {
+            for (auto& handler : item.second) {
+                handler.mReleaseTime -= chrono::hours(1);
+            }
+        }
+        pool->mLastEvictTime -= chrono::hours(1);
+    }
+    pool->Release(pool->Acquire(false, "host2", 80));
+    APSARA_TEST_EQUAL(1U, pool->IdleSize());
+    pool->Clear();
+    APSARA_TEST_EQUAL(0U, pool->IdleSize());
+}
+
+void CurlUnittest::TestTLSSessionReuse() {
+    TLSServer server;
+    APSARA_TEST_TRUE_FATAL(server.Start());
+    auto pool = CurlHandlerPool::GetInstance();
+    pool->Clear();
+    for (size_t i = 0; i < 3; ++i) {
+        HttpResponse res;
+        auto request = std::make_unique<HttpRequest>(
+            "GET", true, "127.0.0.1", server.GetPort(), "/", "", map<string, string>(), "", 10, 1);
+        APSARA_TEST_TRUE(SendHttpRequest(std::move(request), res));
+        APSARA_TEST_EQUAL(200, res.GetStatusCode());
+        // the connection is closed together with the handler, so the next request is sent by a new handler
+        pool->Clear();
+    }
+    // the session of the first handshake is resumed by the new handlers through the share object
+    APSARA_TEST_EQUAL(3U, server.GetHandshakeCnt());
+    APSARA_TEST_EQUAL(2U, server.GetResumedCnt());
+    server.Stop();
+}
+
 UNIT_TEST_CASE(CurlUnittest, TestSendHttpRequest)
 UNIT_TEST_CASE(CurlUnittest, TestCurlTLS)
 UNIT_TEST_CASE(CurlUnittest, TestFollowRedirect)
+UNIT_TEST_CASE(CurlUnittest, TestConnectionReuse)
+UNIT_TEST_CASE(CurlUnittest, TestHandlerPool)
+UNIT_TEST_CASE(CurlUnittest, TestTLSSessionReuse)
 
 } // namespace logtail
 
@@ -12,6 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <atomic>
+#include <thread>
+
 #include "common/timer/Timer.h"
 #include "unittest/Unittest.h"
 
@@ -23,33 +26,183 @@ struct TimerEventMock : public TimerEvent {
     TimerEventMock(const chrono::steady_clock::time_point& execTime) : TimerEvent(execTime) {}
 
     bool IsValid() const override { return mIsValid; }
-    bool Execute() { return true; }
+    bool Execute() {
+        if (mCnt) {
+            mCnt->fetch_add(1);
+        }
+        return true;
+    }
 
     bool mIsValid = false;
+    atomic_int* mCnt = nullptr;
+};
+
+struct SlowTimerEventMock : public TimerEventMock {
+    SlowTimerEventMock(const chrono::steady_clock::time_point& execTime) : TimerEventMock(execTime) {}
+
+    bool Execute() {
+        this_thread::sleep_for(chrono::milliseconds(500));
+        return TimerEventMock::Execute();
+    }
 };
 
 class TimerUnittest : public ::testing::Test {
 public:
     void TestPushEvent();
+    void TestCancelEvent();
+    void TestCascade();
+    void TestJitter();
+    void TestExecute();
+    void TestSlowEvent();
+    void TestPushAfterIdle();
+
+private:
+    unique_ptr<TimerEvent> MakeEvent(chrono::steady_clock::time_point execTime, atomic_int* cnt = nullptr) {
+        auto e = make_unique<TimerEventMock>(execTime);
+        e->mIsValid = true;
+        e->mCnt = cnt;
+        return e;
+    }
 };
 
 void TimerUnittest::TestPushEvent() {
+    Timer timer;
+    auto now = timer.mStartTime;
+    auto id1 = timer.PushEvent(MakeEvent(now + chrono::seconds(2)));
+    auto id2 = timer.PushEvent(MakeEvent(now + chrono::seconds(100)));
+    auto id3 = timer.PushEvent(MakeEvent(now + chrono::hours(2)));
+    auto id4 = timer.PushEvent(MakeEvent(now + chrono::hours(24 * 30)));
+    auto id5 = timer.PushEvent(MakeEvent(now - chrono::seconds(1)));
+
+    APSARA_TEST_EQUAL(5U, timer.GetEventCnt());
+    APSARA_TEST_EQUAL(0U, timer.mEventIndex[id1]->mLevel);
+    APSARA_TEST_EQUAL(200U, timer.mEventIndex[id1]->mSlot);
+    APSARA_TEST_EQUAL(1U, timer.mEventIndex[id2]->mLevel);
+    APSARA_TEST_EQUAL(2U, timer.mEventIndex[id3]->mLevel);
+    APSARA_TEST_EQUAL(3U, timer.mEventIndex[id4]->mLevel);
+    // expired events are fired at the next tick
+    APSARA_TEST_EQUAL(0U, timer.mEventIndex[id5]->mLevel);
+    APSARA_TEST_EQUAL(1U, timer.mEventIndex[id5]->mSlot);
+    APSARA_TEST_EQUAL(now + chrono::seconds(2), timer.mEventIndex[id1]->mEvent->GetExecTime());
+}
+
+void TimerUnittest::TestCancelEvent() {
+    Timer timer;
+    auto now = timer.mStartTime;
+    auto id1 = timer.PushEvent(MakeEvent(now + chrono::seconds(1)));
+    auto id2 = timer.PushEvent(MakeEvent(now + chrono::seconds(1)));
+    APSARA_TEST_EQUAL(2U, timer.GetEventCnt());
+
+    APSARA_TEST_TRUE(timer.CancelEvent(id1));
+    APSARA_TEST_FALSE(timer.CancelEvent(id1));
+    APSARA_TEST_EQUAL(1U, timer.GetEventCnt());
+    APSARA_TEST_EQUAL(1U, timer.mWheels[0][100].size());
+    APSARA_TEST_EQUAL(id2, timer.mWheels[0][100].front().mId);
+}
+
+void TimerUnittest::TestCascade() {
+    Timer timer;
+    auto now = timer.mStartTime;
+    vector<uint64_t> ticks = {1, 255, 256, 257, 1000, 16383, 16384, 16385, 100000, 2000000};
+    for (auto tick : ticks) {
+        timer.PushEvent(MakeEvent(now + Timer::kTickInterval * tick));
+    }
+
+    vector<unique_ptr<TimerEvent>> expired;
+    size_t idx = 0;
+    while (timer.GetEventCnt() > 0) {
+        timer.Advance(expired);
+        if (!expired.empty()) {
+            APSARA_TEST_EQUAL(1U, expired.size());
+            APSARA_TEST_EQUAL(ticks[idx], timer.mCurrentTick);
+            APSARA_TEST_EQUAL(now + Timer::kTickInterval * ticks[idx], expired[0]->GetExecTime());
+            expired.clear();
+            ++idx;
+        }
+    }
+    APSARA_TEST_EQUAL(ticks.size(), idx);
+}
+
+void TimerUnittest::TestJitter() {
+    Timer timer;
+    auto now = timer.mStartTime;
+    for (size_t i = 0; i < 100; ++i) {
+        timer.PushEvent(MakeEvent(now + chrono::seconds(1)), chrono::seconds(1));
+    }
+    size_t nonEmptySlotCnt = 0;
+    for (size_t slot = 0; slot < Timer::GetSlotCnt(0); ++slot) {
+        for (const auto& entry : timer.mWheels[0][slot]) {
+            APSARA_TEST_TRUE(entry.mExpireTick >= 100 && entry.mExpireTick <= 200);
+            APSARA_TEST_EQUAL(now + chrono::seconds(1), entry.mEvent->GetExecTime());
+        }
+        if (!timer.mWheels[0][slot].empty()) {
+            ++nonEmptySlotCnt;
+        }
+    }
+    APSARA_TEST_TRUE(nonEmptySlotCnt > 1);
+}
+
+void TimerUnittest::TestExecute() {
+    Timer timer;
+    timer.Init();
+    atomic_int cnt = 0;
     auto now = chrono::steady_clock::now();
+    timer.PushEvent(MakeEvent(now + chrono::milliseconds(100), &cnt));
+    timer.PushEvent(MakeEvent(now + chrono::milliseconds(50), &cnt));
+    auto id = timer.PushEvent(MakeEvent(now + chrono::milliseconds(50), &cnt));
+    auto invalid = make_unique<TimerEventMock>(now);
+    invalid->mCnt = &cnt;
+    timer.PushEvent(std::move(invalid));
+    timer.CancelEvent(id);
+
+    this_thread::sleep_for(chrono::milliseconds(500));
+    APSARA_TEST_EQUAL(2, cnt.load());
+    APSARA_TEST_EQUAL(0U, timer.GetEventCnt());
+    timer.Stop();
+}
+
+void TimerUnittest::TestSlowEvent() {
     Timer timer;
-    timer.PushEvent(make_unique<TimerEventMock>(now + chrono::seconds(2)));
-    timer.PushEvent(make_unique<TimerEventMock>(now + chrono::seconds(1)));
-    timer.PushEvent(make_unique<TimerEventMock>(now + chrono::seconds(3)));
-
-    APSARA_TEST_EQUAL(3U, timer.mQueue.size());
-    APSARA_TEST_EQUAL(now + chrono::seconds(1), timer.mQueue.top()->GetExecTime());
-    timer.mQueue.pop();
-    APSARA_TEST_EQUAL(now + chrono::seconds(2), timer.mQueue.top()->GetExecTime());
-    timer.mQueue.pop();
-    APSARA_TEST_EQUAL(now + chrono::seconds(3), timer.mQueue.top()->GetExecTime());
-    timer.mQueue.pop();
+    timer.Init();
+    atomic_int cnt = 0;
+    auto now = chrono::steady_clock::now();
+    auto slow = make_unique<SlowTimerEventMock>(now);
+    slow->mIsValid = true;
+    slow->mCnt = &cnt;
+    timer.PushEvent(std::move(slow));
+    timer.PushEvent(MakeEvent(now + chrono::milliseconds(20), &cnt));
+
+    // the slow event does not delay the others
+    this_thread::sleep_for(chrono::milliseconds(200));
+    APSARA_TEST_EQUAL(1, cnt.load());
+    this_thread::sleep_for(chrono::milliseconds(500));
+    APSARA_TEST_EQUAL(2, cnt.load());
+    timer.Stop();
+}
+
+void TimerUnittest::TestPushAfterIdle() {
+    Timer timer;
+    this_thread::sleep_for(chrono::milliseconds(300));
+    atomic_int cnt = 0;
+    auto now = chrono::steady_clock::now();
+    auto id = timer.PushEvent(MakeEvent(now + chrono::milliseconds(50), &cnt));
+    // the current tick catches up with now, so that idle ticks are not advanced one by one
+    APSARA_TEST_TRUE(timer.mCurrentTick >= 30);
+    APSARA_TEST_EQUAL(0U, timer.mEventIndex[id]->mLevel);
+
+    timer.Init();
+    this_thread::sleep_for(chrono::milliseconds(300));
+    APSARA_TEST_EQUAL(1, cnt.load());
+    timer.Stop();
 }
 
 UNIT_TEST_CASE(TimerUnittest, TestPushEvent)
+UNIT_TEST_CASE(TimerUnittest, TestCancelEvent)
+UNIT_TEST_CASE(TimerUnittest, TestCascade)
+UNIT_TEST_CASE(TimerUnittest, TestJitter)
+UNIT_TEST_CASE(TimerUnittest, TestExecute)
+UNIT_TEST_CASE(TimerUnittest, TestSlowEvent)
+UNIT_TEST_CASE(TimerUnittest, TestPushAfterIdle)
 
 } // namespace logtail
 
@@ -0,0 +1,130 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "json/json.h"
+
+#include "collection_pipeline/CollectionPipelineContext.h"
+#include "common/FileSystemUtil.h"
+#include "common/Flags.h"
+#include "file_server/ConfigManager.h"
+#include "file_server/EventDispatcher.h"
+#include "file_server/FileDiscoveryOptions.h"
+#include "file_server/event/Event.h"
+#include "file_server/event_listener/EventListener.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_BOOL(fs_events_inotify_coalesce_modify);
+
+using namespace std;
+
+namespace logtail {
+
+class EventListenerUnittest : public testing::Test {
+public:
+    void TestCoalesceModifyEvents();
+    void TestCoalesceDisabled();
+
+protected:
+    static void SetUpTestCase() { sRootDir = GetProcessExecutionDir() + "EventListenerUnittest"; }
+
+    void SetUp() override {
+        filesystem::remove_all(sRootDir);
+        filesystem::create_directories(sRootDir);
+        Json::Value configJson;
+        configJson["FilePaths"].append(Json::Value(PathJoin(sRootDir, "*.log")));
+        mOpts.Init(configJson, mCtx, "test");
+        EventHandler* handler = ConfigManager::GetInstance()->GetSharedHandler();
+        APSARA_TEST_TRUE_FATAL(
+            EventDispatcher::GetInstance()->RegisterEventHandler(sRootDir, make_pair(&mOpts, &mCtx), handler));
+        vector<Event*> events;
+        EventListener::GetInstance()->ReadEvents(events);
+        ReleaseEvents(events);
+    }
+
+    void TearDown() override {
+        EventDispatcher::GetInstance()->UnregisterEventHandler(sRootDir);
+        filesystem::remove_all(sRootDir);
+        BOOL_FLAG(fs_events_inotify_coalesce_modify) = true;
+    }
+
+    static void Append(const string& name) {
+        ofstream fout(PathJoin(sRootDir, name), ios::app);
+        fout << "line\n";
+    }
+
+    static void ReleaseEvents(vector<Event*>& events) {
+        for (auto event : events) {
+            delete event;
+        }
+        events.clear();
+    }
+
+    static string sRootDir;
+    FileDiscoveryOptions mOpts;
+    CollectionPipelineContext mCtx;
+};
+
+string EventListenerUnittest::sRootDir;
+
+void EventListenerUnittest::TestCoalesceModifyEvents() {
+    Append("a.log");
+    Append("b.log");
+    Append("a.log");
+    Append("b.log");
+    // modify events after other events of the same file are kept
+    filesystem::remove(PathJoin(sRootDir, "a.log"));
+    Append("a.log");
+
+    vector<Event*> events;
+    EventListener::GetInstance()->ReadEvents(events);
+    vector<pair<string, EventType>> expected{{"a.log", EVENT_CREATE},
+                                             {"a.log", EVENT_MODIFY},
+                                             {"b.log", EVENT_CREATE},
+                                             {"b.log", EVENT_MODIFY},
+                                             {"a.log", EVENT_DELETE},
+                                             {"a.log", EVENT_CREATE},
+                                             {"a.log", EVENT_MODIFY}};
+    APSARA_TEST_EQUAL(expected.size(), events.size());
+    for (size_t i = 0; i < expected.size() && i < events.size(); ++i) {
+        APSARA_TEST_EQUAL(sRootDir, events[i]->GetSource());
+        APSARA_TEST_EQUAL(expected[i].first, events[i]->GetObject());
+        APSARA_TEST_EQUAL(expected[i].second, events[i]->GetType());
+    }
+    ReleaseEvents(events);
+}
+
+void EventListenerUnittest::TestCoalesceDisabled() {
+    BOOL_FLAG(fs_events_inotify_coalesce_modify) = false;
+    Append("a.log");
+    Append("b.log");
+    Append("a.log");
+
+    vector<Event*> events;
+    EventListener::GetInstance()->ReadEvents(events);
+    APSARA_TEST_EQUAL(5U, events.size());
+    ReleaseEvents(events);
+}
+
+UNIT_TEST_CASE(EventListenerUnittest, TestCoalesceModifyEvents)
+UNIT_TEST_CASE(EventListenerUnittest, TestCoalesceDisabled)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -37,9 +37,23 @@ public:
         Event event1("/source", "object", EVENT_CONTAINER_STOPPED, 0);
         APSARA_TEST_TRUE_FATAL(event1.IsContainerStopped());
     }
+
+    void TestPool() {
+        Event* event0 = new Event("/source", "object", EVENT_MODIFY, 0);
+        delete event0;
+        // memory of deleted events is reused
+        Event* event1 = new Event("/source", "another", EVENT_CREATE, 1);
+        APSARA_TEST_EQUAL(event0, event1);
+        APSARA_TEST_EQUAL("another", event1->GetObject());
+        APSARA_TEST_TRUE(event1->IsCreate());
+        auto event2 = make_unique<Event>("/source", "object", EVENT_MODIFY, 0);
+        APSARA_TEST_NOT_EQUAL(event1, event2.get());
+        delete event1;
+    }
 };
 
 APSARA_UNIT_TEST_CASE(EventUnittest, TestIsContainerStopped, 0);
+APSARA_UNIT_TEST_CASE(EventUnittest, TestPool, 0);
 } // end of namespace logtail
 
 int main(int argc, char** argv) {
@@ -0,0 +1,222 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "json/json.h"
+
+#include "collection_pipeline/CollectionPipelineContext.h"
+#include "file_server/ConfigMatchIndex.h"
+#include "file_server/FileDiscoveryOptions.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class ConfigMatchIndexUnittest : public testing::Test {
+public:
+    void TestGetAnchors();
+    void TestFindCandidates();
+    void TestUpdateAndRemove();
+
+protected:
+    unique_ptr<FileDiscoveryOptions> CreateOptions(const string& filePath, int maxDepth = 0) {
+        Json::Value configJson;
+        configJson["FilePaths"].append(Json::Value(filePath));
+        configJson["MaxDirSearchDepth"] = Json::Value(maxDepth);
+        auto opts = make_unique<FileDiscoveryOptions>();
+        opts->Init(configJson, ctx, "test");
+        return opts;
+    }
+
+    unique_ptr<FileDiscoveryOptions> CreateContainerOptions(const string& filePath, const vector<string>& baseDirs) {
+        auto opts = CreateOptions(filePath, -1);
+        opts->SetEnableContainerDiscoveryFlag(true);
+        auto infos = make_shared<vector<ContainerInfo>>();
+        for (const auto& dir : baseDirs) {
+            ContainerInfo info;
+            info.mID = dir;
+            info.mRealBaseDir = dir;
+            infos->push_back(info);
+        }
+        opts->SetContainerInfo(infos);
+        return opts;
+    }
+
+    static bool Contains(const vector<FileDiscoveryConfig>& configs, const FileDiscoveryOptions* opts) {
+        for (const auto& config : configs) {
+            if (config.first == opts) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    CollectionPipelineContext ctx;
+};
+
+void ConfigMatchIndexUnittest::TestGetAnchors() {
+    vector<string> anchors;
+    auto opts = CreateOptions("/var/log/app/*.log");
+    APSARA_TEST_TRUE(ConfigMatchIndex::GetAnchors(*opts, anchors));
+    APSARA_TEST_EQUAL(vector<string>({"/var/log/app"}), anchors);
+
+    // wildcard path: the constant prefix
+    anchors.clear();
+    opts = CreateOptions("/var/*/app/*.log");
+    APSARA_TEST_TRUE(ConfigMatchIndex::GetAnchors(*opts, anchors));
+    APSARA_TEST_EQUAL(vector<string>({"/var"}), anchors);
+
+    // the root dir
+    anchors.clear();
+    opts = CreateOptions("/*/app/*.log");
+    APSARA_TEST_TRUE(ConfigMatchIndex::GetAnchors(*opts, anchors));
+    APSARA_TEST_EQUAL(vector<string>({""}), anchors);
+
+    // prefix with fnmatch special characters
+    anchors.clear();
+    opts = CreateOptions("/var/[ab]/*/*.log");
+    APSARA_TEST_FALSE(ConfigMatchIndex::GetAnchors(*opts, anchors));
+
+    // container: the real base dirs
+    anchors.clear();
+    opts = CreateContainerOptions("/home/admin/*.log", {"/host/c1/home/admin", "/host/c2/home/admin/"});
+    APSARA_TEST_TRUE(ConfigMatchIndex::GetAnchors(*opts, anchors));
+    APSARA_TEST_EQUAL(vector<string>({"/host/c1/home/admin", "/host/c2/home/admin"}), anchors);
+
+    APSARA_TEST_TRUE(ConfigMatchIndex::IsUnderAnchor("/var/log", "/var/log"));
+    APSARA_TEST_TRUE(ConfigMatchIndex::IsUnderAnchor("/var/log", "/var/log/app"));
+    APSARA_TEST_FALSE(ConfigMatchIndex::IsUnderAnchor("/var/log", "/var/logs"));
+    APSARA_TEST_FALSE(ConfigMatchIndex::IsUnderAnchor("/var/log", "/var"));
+    APSARA_TEST_TRUE(ConfigMatchIndex::IsUnderAnchor("", "/var"));
+}
+
+void ConfigMatchIndexUnittest::TestFindCandidates() {
+    vector<unique_ptr<FileDiscoveryOptions>> allOpts;
+    allOpts.emplace_back(CreateOptions("/var/log/app/*.log", 2));
+    allOpts.emplace_back(CreateOptions("/var/log/*/x/*.log", 1));
+    allOpts.emplace_back(CreateOptions("/var/log/app/sub/*.log"));
+    allOpts.emplace_back(CreateOptions("/*/admin/*.log"));
+    allOpts.emplace_back(CreateOptions("/home/admin/logs/*.log", -1));
+    allOpts.emplace_back(CreateContainerOptions("/home/admin/*.log", {"/host/c1/home/admin", "/host/c2/home/admin"}));
+
+    ConfigMatchIndex index;
+    vector<string> affected;
+    for (size_t i = 0; i < allOpts.size(); ++i) {
+        APSARA_TEST_TRUE(index.Update("config" + to_string(i), make_pair(allOpts[i].get(), &ctx), affected));
+    }
+    APSARA_TEST_EQUAL(allOpts.size(), index.GetConfigCnt());
+
+    vector<FileDiscoveryConfig> candidates;
+    index.FindCandidates("/var/log/app/sub", candidates);
+    APSARA_TEST_EQUAL(4U, candidates.size());
+    APSARA_TEST_TRUE(Contains(candidates, allOpts[0].get()));
+    APSARA_TEST_TRUE(Contains(candidates, allOpts[1].get()));
+    APSARA_TEST_TRUE(Contains(candidates, allOpts[2].get()));
+    APSARA_TEST_TRUE(Contains(candidates, allOpts[3].get()));
+
+    candidates.clear();
+    index.FindCandidates("/var/logs", candidates);
+    APSARA_TEST_EQUAL(1U, candidates.size());
+    APSARA_TEST_TRUE(Contains(candidates, allOpts[3].get()));
+
+    candidates.clear();
+    index.FindCandidates("/host/c2/home/admin/a", candidates);
+    APSARA_TEST_EQUAL(2U, candidates.size());
+    APSARA_TEST_TRUE(Contains(candidates, allOpts[5].get()));
+
+    // candidates must be a superset of the configs matching the path
+    vector<string> paths = {"/",
+                            "/var",
+                            "/var/log",
+                            "/var/log/app",
+                            "/var/log/app/a/b",
+                            "/var/log/app/a/b/c",
+                            "/var/log/app/sub",
+                            "/var/log/y/x",
+                            "/var/log/y/x/z",
+                            "/var/logs/app",
+                            "/home/admin",
+                            "/home/admin/logs/a/b/c",
+                            "/root/admin",
+                            "/host/c1/home/admin",
+                            "/host/c1/home/admin/a",
+                            "/host/c1/home/admins",
+                            "/host/c3/home/admin"};
+    vector<string> names = {"", "a.log", "a.txt"};
+    for (const auto& path : paths) {
+        candidates.clear();
+        index.FindCandidates(path, candidates);
+        for (const auto& opts : allOpts) {
+            for (const auto& name : names) {
+                if (opts->IsMatch(path, name)) {
+                    EXPECT_TRUE(Contains(candidates, opts.get())) << path << "/" << name;
+                }
+            }
+        }
+    }
+}
+
+void ConfigMatchIndexUnittest::TestUpdateAndRemove() {
+    auto opts1 = CreateOptions("/var/log/app/*.log");
+    auto opts2 = CreateContainerOptions("/home/admin/*.log", {"/host/c1/home/admin"});
+    auto opts3 = CreateOptions("/var/[ab]/*/*.log");
+
+    ConfigMatchIndex index;
+    vector<string> affected;
+    APSARA_TEST_TRUE(index.Update("config1", make_pair(opts1.get(), &ctx), affected));
+    APSARA_TEST_EQUAL(vector<string>({"/var/log/app"}), affected);
+
+    // container changed
+    affected.clear();
+    APSARA_TEST_TRUE(index.Update("config2", make_pair(opts2.get(), &ctx), affected));
+    opts2->GetContainerInfo()->front().mRealBaseDir = "/host/c2/home/admin";
+    affected.clear();
+    APSARA_TEST_TRUE(index.Update("config2", make_pair(opts2.get(), &ctx), affected));
+    APSARA_TEST_EQUAL(vector<string>({"/host/c1/home/admin", "/host/c2/home/admin"}), affected);
+    vector<FileDiscoveryConfig> candidates;
+    index.FindCandidates("/host/c1/home/admin", candidates);
+    APSARA_TEST_TRUE(candidates.empty());
+    index.FindCandidates("/host/c2/home/admin", candidates);
+    APSARA_TEST_EQUAL(1U, candidates.size());
+
+    // config that cannot be indexed is always a candidate
+    affected.clear();
+    APSARA_TEST_FALSE(index.Update("config3", make_pair(opts3.get(), &ctx), affected));
+    candidates.clear();
+    index.FindCandidates("/tmp", candidates);
+    APSARA_TEST_EQUAL(1U, candidates.size());
+    APSARA_TEST_TRUE(Contains(candidates, opts3.get()));
+    APSARA_TEST_FALSE(index.Remove("config3", affected));
+
+    affected.clear();
+    APSARA_TEST_TRUE(index.Remove("config1", affected));
+    APSARA_TEST_EQUAL(vector<string>({"/var/log/app"}), affected);
+    APSARA_TEST_TRUE(index.Remove("config2", affected));
+    APSARA_TEST_TRUE(index.Remove("config4", affected));
+    APSARA_TEST_EQUAL(0U, index.GetConfigCnt());
+    APSARA_TEST_TRUE(index.mRoot.mChildren.empty());
+    APSARA_TEST_TRUE(index.mUnindexedConfigs.empty());
+}
+
+UNIT_TEST_CASE(ConfigMatchIndexUnittest, TestGetAnchors)
+UNIT_TEST_CASE(ConfigMatchIndexUnittest, TestFindCandidates)
+UNIT_TEST_CASE(ConfigMatchIndexUnittest, TestUpdateAndRemove)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -0,0 +1,178 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "json/json.h"
+
+#include "collection_pipeline/CollectionPipelineContext.h"
+#include "common/FileSystemUtil.h"
+#include "file_server/ConfigManager.h"
+#include "file_server/EventDispatcher.h"
+#include "file_server/FileDiscoveryOptions.h"
+#include "file_server/FileServer.h"
+#include "file_server/event/Event.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class ContainerPathUpdateUnittest : public testing::Test {
+public:
+    void TestAddContainer();
+    void TestDeleteContainer();
+    void TestSharedBaseDir();
+
+protected:
+    static void SetUpTestCase() {
+        sRootDir = GetProcessExecutionDir() + "ContainerPathUpdateUnittest";
+        filesystem::remove_all(sRootDir);
+        for (const auto& id : {"c1", "c2"}) {
+            filesystem::create_directories(PathJoin(sRootDir, id));
+        }
+    }
+
+    static void TearDownTestCase() { filesystem::remove_all(sRootDir); }
+
+    void SetUp() override {
+        mOpts1 = CreateOptions();
+        mOpts2 = CreateOptions();
+        FileServer::GetInstance()->AddFileDiscoveryConfig("config1", mOpts1.get(), &ctx);
+        FileServer::GetInstance()->AddFileDiscoveryConfig("config2", mOpts2.get(), &ctx);
+    }
+
+    void TearDown() override {
+        FileServer::GetInstance()->RemoveFileDiscoveryConfig("config1");
+        FileServer::GetInstance()->RemoveFileDiscoveryConfig("config2");
+        EventDispatcher::GetInstance()->UnregisterEventHandler(PathJoin(sRootDir, "c1"));
+        EventDispatcher::GetInstance()->UnregisterEventHandler(PathJoin(sRootDir, "c2"));
+    }
+
+    static bool DeduceBaseDir(ContainerInfo& info, const CollectionPipelineContext*, const FileDiscoveryOptions*) {
+        info.mRealBaseDir = PathJoin(sRootDir, info.mID);
+        return true;
+    }
+
+    unique_ptr<FileDiscoveryOptions> CreateOptions() {
+        Json::Value configJson;
+        configJson["FilePaths"].append(Json::Value("/home/admin/*.log"));
+        auto opts = make_unique<FileDiscoveryOptions>();
+        opts->Init(configJson, ctx, "test");
+        opts->SetEnableContainerDiscoveryFlag(true);
+        opts->SetContainerInfo(make_shared<vector<ContainerInfo>>());
+        opts->SetDeduceAndSetContainerBaseDirFunc(DeduceBaseDir);
+        return opts;
+    }
+
+    static void AddCmd(const string& configName, const string& id, bool deleteFlag) {
+        Json::Value params;
+        params["ID"] = Json::Value(id);
+        auto cmd = new ConfigContainerInfoUpdateCmd(configName, deleteFlag, params);
+        ConfigManager::GetInstance()->UpdateContainerPath(cmd);
+    }
+
+    static void Apply(vector<Event*>& events) {
+        ConfigManager::GetInstance()->ApplyContainerPathUpdates(events, nullptr);
+    }
+
+    static string sRootDir;
+    unique_ptr<FileDiscoveryOptions> mOpts1;
+    unique_ptr<FileDiscoveryOptions> mOpts2;
+    CollectionPipelineContext ctx;
+};
+
+string ContainerPathUpdateUnittest::sRootDir;
+
+void ContainerPathUpdateUnittest::TestAddContainer() {
+    vector<Event*> events;
+    AddCmd("config1", "c1", false);
+    AddCmd("unknown", "c2", false);
+    Apply(events);
+    APSARA_TEST_TRUE(events.empty());
+    APSARA_TEST_EQUAL(1U, mOpts1->GetContainerInfo()->size());
+    // only the base dir of the added container is registered
+    APSARA_TEST_TRUE(EventDispatcher::GetInstance()->IsRegistered(PathJoin(sRootDir, "c1")));
+    APSARA_TEST_FALSE(EventDispatcher::GetInstance()->IsRegistered(PathJoin(sRootDir, "c2")));
+    vector<FileDiscoveryConfig> configs;
+    ConfigManager::GetInstance()->GetRelatedConfigs(PathJoin(sRootDir, "c1"), configs);
+    APSARA_TEST_EQUAL(1U, configs.size());
+
+    // cmds identical to the current container info change nothing
+    AddCmd("config1", "c1", false);
+    Apply(events);
+    APSARA_TEST_TRUE(events.empty());
+    APSARA_TEST_EQUAL(1U, mOpts1->GetContainerInfo()->size());
+    {
+        PTScopedLock lock(ConfigManager::GetInstance()->mContainerInfoCmdLock);
+        APSARA_TEST_TRUE(ConfigManager::GetInstance()->mContainerInfoCmdVec.empty());
+    }
+}
+
+void ContainerPathUpdateUnittest::TestDeleteContainer() {
+    vector<Event*> events;
+    AddCmd("config1", "c1", false);
+    AddCmd("config1", "c2", false);
+    Apply(events);
+    APSARA_TEST_TRUE(events.empty());
+    APSARA_TEST_EQUAL(2U, mOpts1->GetContainerInfo()->size());
+
+    AddCmd("config1", "c1", true);
+    Apply(events);
+    APSARA_TEST_EQUAL(1U, mOpts1->GetContainerInfo()->size());
+    APSARA_TEST_EQUAL(1U, events.size());
+    APSARA_TEST_EQUAL(PathJoin(sRootDir, "c1"), events[0]->GetSource());
+    APSARA_TEST_TRUE(events[0]->IsDir());
+    APSARA_TEST_TRUE(events[0]->IsContainerStopped());
+    vector<FileDiscoveryConfig> configs;
+    ConfigManager::GetInstance()->GetRelatedConfigs(PathJoin(sRootDir, "c1"), configs);
+    APSARA_TEST_TRUE(configs.empty());
+    APSARA_TEST_TRUE(EventDispatcher::GetInstance()->IsRegistered(PathJoin(sRootDir, "c2")));
+    for (auto event : events) {
+        delete event;
+    }
+}
+
+void ContainerPathUpdateUnittest::TestSharedBaseDir() {
+    vector<Event*> events;
+    AddCmd("config1", "c1", false);
+    AddCmd("config2", "c1", false);
+    Apply(events);
+    APSARA_TEST_TRUE(events.empty());
+
+    // the base dir is still covered by the other config
+    AddCmd("config1", "c1", true);
+    Apply(events);
+    APSARA_TEST_TRUE(events.empty());
+    APSARA_TEST_TRUE(mOpts1->GetContainerInfo()->empty());
+    APSARA_TEST_EQUAL(1U, mOpts2->GetContainerInfo()->size());
+
+    AddCmd("config2", "c1", true);
+    Apply(events);
+    APSARA_TEST_EQUAL(1U, events.size());
+    for (auto event : events) {
+        delete event;
+    }
+}
+
+UNIT_TEST_CASE(ContainerPathUpdateUnittest, TestAddContainer)
+UNIT_TEST_CASE(ContainerPathUpdateUnittest, TestDeleteContainer)
+UNIT_TEST_CASE(ContainerPathUpdateUnittest, TestSharedBaseDir)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -133,13 +133,13 @@ void FlusherSLSUnittest::OnSuccessfulInit() {
         flusher->mBatcher.GetEventFlushStrategy().GetMaxSizeBytes());
     APSARA_TEST_EQUAL(static_cast<uint32_t>(INT32_FLAG(batch_send_metric_size)),
                       flusher->mBatcher.GetEventFlushStrategy().GetMinSizeBytes());
-    uint32_t timeout = static_cast<uint32_t>(INT32_FLAG(batch_send_interval)) / 2;
-    APSARA_TEST_EQUAL(static_cast<uint32_t>(INT32_FLAG(batch_send_interval)) - timeout,
-                      flusher->mBatcher.GetEventFlushStrategy().GetTimeoutSecs());
+    uint32_t timeout = static_cast<uint32_t>(INT32_FLAG(batch_send_interval)) * 1000 / 2;
+    APSARA_TEST_EQUAL(static_cast<uint32_t>(INT32_FLAG(batch_send_interval)) * 1000 - timeout,
+                      flusher->mBatcher.GetEventFlushStrategy().GetTimeoutMs());
     APSARA_TEST_TRUE(flusher->mBatcher.GetGroupFlushStrategy().has_value());
     APSARA_TEST_EQUAL(static_cast<uint32_t>(INT32_FLAG(batch_send_metric_size)),
                       flusher->mBatcher.GetGroupFlushStrategy()->GetMinSizeBytes());
-    APSARA_TEST_EQUAL(timeout, flusher->mBatcher.GetGroupFlushStrategy()->GetTimeoutSecs());
+    APSARA_TEST_EQUAL(timeout, flusher->mBatcher.GetGroupFlushStrategy()->GetTimeoutMs());
     APSARA_TEST_TRUE(flusher->mGroupSerializer);
     APSARA_TEST_TRUE(flusher->mGroupListSerializer);
     APSARA_TEST_EQUAL(CompressType::LZ4, flusher->mCompressor->GetCompressType());
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include "go_pipeline/LogtailPlugin.h"
 #include "protobuf/sls/LogGroupSerializer.h"
 #include "protobuf/sls/sls_logs.pb.h"
 #include "unittest/Unittest.h"
@@ -23,6 +24,7 @@ namespace logtail {
 class LogGroupSerializerUnittest : public ::testing::Test {
 public:
     void TestSerialize();
+    void TestSerializeBatch();
 };
 
 void LogGroupSerializerUnittest::TestSerialize() {
@@ -96,7 +98,43 @@ void LogGroupSerializerUnittest::TestSerialize() {
     APSARA_TEST_EQUAL("value_6", logGroupPb.logtags(1).value());
 }
 
+void LogGroupSerializerUnittest::TestSerializeBatch() {
+    LogGroupSerializer batch;
+    batch.Prepare(0);
+    vector<string> packIds = {"pack_id_1", string(200, 'a')};
+    size_t batchSZ = 0;
+    for (size_t i = 0; i < packIds.size(); ++i) {
+        size_t logSZ = 0;
+        size_t groupSZ = GetLogSize(GetLogContentSize(strlen("key"), 200 * i), false, logSZ);
+        groupSZ += GetStringSize(strlen("category"));
+        batch.StartToAddLogGroup(packIds[i], groupSZ);
+        batch.StartToAddLog(logSZ);
+        batch.AddLogTime(1234567890);
+        batch.AddLogContent("key", string(200 * i, 'v'));
+        batch.AddCategory("category");
+        batchSZ += GetLogGroupHeaderSize(packIds[i].size(), groupSZ) + groupSZ;
+        APSARA_TEST_EQUAL(batchSZ, batch.GetResult().size());
+    }
+
+    vector<pair<StringView, StringView>> groups;
+    APSARA_TEST_TRUE(LogtailPlugin::ParseLogGroupBatch(batch.GetResult(), groups));
+    APSARA_TEST_EQUAL(2U, groups.size());
+    for (size_t i = 0; i < groups.size(); ++i) {
+        APSARA_TEST_EQUAL(packIds[i], groups[i].first.to_string());
+        sls_logs::LogGroup logGroupPb;
+        APSARA_TEST_TRUE(logGroupPb.ParseFromString(groups[i].second.to_string()));
+        APSARA_TEST_EQUAL(1L, logGroupPb.logs_size());
+        APSARA_TEST_EQUAL(string(200 * i, 'v'), logGroupPb.logs(0).contents(0).value());
+        APSARA_TEST_EQUAL("category", logGroupPb.category());
+    }
+
+    groups.clear();
+    string truncated = batch.GetResult().substr(0, batch.GetResult().size() - 1);
+    APSARA_TEST_FALSE(LogtailPlugin::ParseLogGroupBatch(truncated, groups));
+}
+
 UNIT_TEST_CASE(LogGroupSerializerUnittest, TestSerialize)
+UNIT_TEST_CASE(LogGroupSerializerUnittest, TestSerializeBatch)
 
 } // namespace logtail
 
@@ -0,0 +1,358 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "json/json.h"
+
+#include "common/Flags.h"
+#include "metadata/K8sMetadata.h"
+#include "metadata/LabelingK8sMetadata.h"
+#include "models/PipelineEventGroup.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_INT32(k8s_metadata_batch_interval_ms);
+DECLARE_FLAG_INT32(k8s_metadata_negative_cache_ttl_sec);
+
+using namespace std;
+
+namespace logtail {
+
+// A minimal stand-in for the metadata operator. Each request is answered with the info of the known keys only.
+class FakeOperator {
+public:
+    struct Request {
+        string mPath;
+        vector<string> mKeys;
+    };
+
+    bool Start() {
+        mFd = socket(AF_INET, SOCK_STREAM, 0);
+        if (mFd < 0) {
+            return false;
+        }
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+        socklen_t len = sizeof(addr);
+        if (::bind(mFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || listen(mFd, 16) != 0
+            || getsockname(mFd, reinterpret_cast<sockaddr*>(&addr), &len) != 0) {
+            close(mFd);
+            return false;
+        }
+        mPort = ntohs(addr.sin_port);
+        mThread = thread(&FakeOperator::Run, this);
+        return true;
+    }
+
+    void Stop() {
+        mIsRunning = false;
+        shutdown(mFd, SHUT_RDWR);
+        if (mThread.joinable()) {
+            mThread.join();
+        }
+        close(mFd);
+    }
+
+    void AddInfo(const string& key, const string& workloadName) {
+        lock_guard<mutex> lock(mMux);
+        Json::Value info;
+        info[namespaceKey] = "default";
+        info[workloadNameKey] = workloadName;
+        info[workloadKindKey] = "deployment";
+        info[serviceNameKey] = "";
+        info[labelsKey] = Json::Value(Json::objectValue);
+        info[imageKey] = Json::Value(Json::objectValue);
+        mInfos[key] = info;
+    }
+
+    // the following requests are answered with 500
+    void SetFailedCnt(size_t cnt) {
+        lock_guard<mutex> lock(mMux);
+        mFailedCnt = cnt;
+    }
+
+    vector<Request> GetRequests() {
+        lock_guard<mutex> lock(mMux);
+        return mRequests;
+    }
+
+    int32_t GetPort() const { return mPort; }
+
+private:
+    void Run() {
+        while (mIsRunning) {
+            int conn = accept(mFd, nullptr, nullptr);
+            if (conn < 0) {
+                break;
+            }
+            HandleConnection(conn);
+            close(conn);
+        }
+    }
+
+    void HandleConnection(int conn) {
+        string data;
+        char buf[4096];
+        size_t headerEnd = string::npos;
+        size_t contentLength = 0;
+        while (true) {
+            if (headerEnd == string::npos) {
+                headerEnd = data.find("\r\n\r\n");
+                if (headerEnd != string::npos) {
+                    auto pos = data.find("Content-Length:");
+                    if (pos != string::npos && pos < headerEnd) {
+                        contentLength = stoul(data.substr(pos + 15, data.find("\r\n", pos) - pos - 15));
+                    }
+                }
+            }
+            if (headerEnd != string::npos && data.size() >= headerEnd + 4 + contentLength) {
+                break;
+            }
+            auto n = recv(conn, buf, sizeof(buf), 0);
+            if (n <= 0) {
+                return;
+            }
+            data.append(buf, n);
+        }
+
+        Request req;
+        auto pathBegin = data.find(' ') + 1;
+        req.mPath = data.substr(pathBegin, data.find(' ', pathBegin) - pathBegin);
+        Json::Value body;
+        Json::CharReaderBuilder builder;
+        unique_ptr<Json::CharReader> reader(builder.newCharReader());
+        string errors;
+        const char* bodyBegin = data.data() + headerEnd + 4;
+        Json::Value resp(Json::objectValue);
+        bool failed = false;
+        {
+            lock_guard<mutex> lock(mMux);
+            if (mFailedCnt > 0) {
+                --mFailedCnt;
+                failed = true;
+            }
+        }
+        if (reader->parse(bodyBegin, bodyBegin + contentLength, &body, &errors)) {
+            lock_guard<mutex> lock(mMux);
+            for (const auto& key : body["keys"]) {
+                req.mKeys.push_back(key.asString());
+                auto it = mInfos.find(key.asString());
+                if (!failed && it != mInfos.end()) {
+                    resp[it->first] = it->second;
+                }
+            }
+        }
+        {
+            lock_guard<mutex> lock(mMux);
+            mRequests.push_back(std::move(req));
+        }
+
+        string respBody = Json::writeString(Json::StreamWriterBuilder(), resp);
+        string respStr = string(failed ? "HTTP/1.1 500 Internal Server Error" : "HTTP/1.1 200 OK")
+            + "\r\nContent-Type: application/json\r\nConnection: close\r\nContent-Length: "
+            + to_string(respBody.size()) + "\r\n\r\n" + respBody;
+        send(conn, respStr.data(), respStr.size(), 0);
+    }
+
+    int mFd = -1;
+    int32_t mPort = 0;
+    atomic_bool mIsRunning = true;
+    thread mThread;
+    mutex mMux;
+    map<string, Json::Value> mInfos;
+    vector<Request> mRequests;
+    size_t mFailedCnt = 0;
+};
+
+class K8sMetadataAsyncUnittest : public ::testing::Test {
+public:
+    void TestBatchAndSingleFlight();
+    void TestNegativeCache();
+    void TestRequestFailure();
+    void TestLabeling();
+
+protected:
+    static void SetUpTestCase() {
+        INT32_FLAG(k8s_metadata_batch_interval_ms) = 200;
+        INT32_FLAG(k8s_metadata_negative_cache_ttl_sec) = 60;
+    }
+
+    void SetUp() override {
+        APSARA_TEST_TRUE_FATAL(mOperator.Start());
+        auto& metadata = K8sMetadata::GetInstance();
+        metadata.mServiceHost = "127.0.0.1";
+        metadata.mServicePort = mOperator.GetPort();
+        metadata.containerCache.clear();
+        metadata.ipCache.clear();
+        lock_guard<mutex> lock(metadata.mQueryMux);
+        for (auto& state : metadata.mQueryStates) {
+            state.mMissingKeys.clear();
+            state.mNextQueryTime = chrono::steady_clock::time_point();
+            state.mFailedCnt = 0;
+        }
+    }
+
+    void TearDown() override { mOperator.Stop(); }
+
+    // wait until all queued keys have been queried
+    void WaitForQueries() {
+        auto& metadata = K8sMetadata::GetInstance();
+        for (size_t i = 0; i < 500; ++i) {
+            {
+                lock_guard<mutex> lock(metadata.mQueryMux);
+                bool done = true;
+                for (const auto& state : metadata.mQueryStates) {
+                    done = done && state.mPendingKeys.empty();
+                }
+                if (done) {
+                    return;
+                }
+            }
+            this_thread::sleep_for(chrono::milliseconds(10));
+        }
+    }
+
+    FakeOperator mOperator;
+};
+
+void K8sMetadataAsyncUnittest::TestBatchAndSingleFlight() {
+    mOperator.AddInfo("c1", "w1");
+    mOperator.AddInfo("c2", "w2");
+    mOperator.AddInfo("10.0.0.1", "w3");
+    auto& metadata = K8sMetadata::GetInstance();
+
+    vector<thread> threads;
+    for (size_t i = 0; i < 4; ++i) {
+        threads.emplace_back([&metadata]() {
+            for (size_t j = 0; j < 10; ++j) {
+                APSARA_TEST_EQUAL(nullptr, metadata.GetInfoByContainerIdAsync("c1"));
+                APSARA_TEST_EQUAL(nullptr, metadata.GetInfoByContainerIdAsync("c2"));
+                APSARA_TEST_EQUAL(nullptr, metadata.GetInfoByIpAsync("10.0.0.1"));
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    WaitForQueries();
+
+    // all misses within the batch interval are sent in one request for each info type
+    auto requests = mOperator.GetRequests();
+    APSARA_TEST_EQUAL(2U, requests.size());
+    for (const auto& req : requests) {
+        if (req.mPath == "/metadata/containerid") {
+            APSARA_TEST_EQUAL(2U, req.mKeys.size());
+        } else {
+            APSARA_TEST_EQUAL("/metadata/ip", req.mPath);
+            APSARA_TEST_EQUAL(1U, req.mKeys.size());
+        }
+    }
+
+    auto info = metadata.GetInfoByContainerIdAsync("c1");
+    APSARA_TEST_NOT_EQUAL(nullptr, info);
+    APSARA_TEST_EQUAL("w1", info->workloadName);
+    APSARA_TEST_NOT_EQUAL(nullptr, metadata.GetInfoByContainerIdAsync("c2"));
+    APSARA_TEST_NOT_EQUAL(nullptr, metadata.GetInfoByIpAsync("10.0.0.1"));
+    APSARA_TEST_EQUAL(2U, mOperator.GetRequests().size());
+}
+
+void K8sMetadataAsyncUnittest::TestNegativeCache() {
+    auto& metadata = K8sMetadata::GetInstance();
+    APSARA_TEST_EQUAL(nullptr, metadata.GetInfoByContainerIdAsync("unknown"));
+    WaitForQueries();
+    APSARA_TEST_EQUAL(1U, mOperator.GetRequests().size());
+
+    // the unknown key is not queried again before the negative cache expires
+    APSARA_TEST_EQUAL(nullptr, metadata.GetInfoByContainerIdAsync("unknown"));
+    WaitForQueries();
+    this_thread::sleep_for(chrono::milliseconds(300));
+    APSARA_TEST_EQUAL(1U, mOperator.GetRequests().size());
+
+    {
+        lock_guard<mutex> lock(metadata.mQueryMux);
+        auto& state = metadata.mQueryStates[static_cast<size_t>(containerInfoType::ContainerIdInfo)];
+        state.mMissingKeys["unknown"] = chrono::steady_clock::now();
+    }
+    APSARA_TEST_EQUAL(nullptr, metadata.GetInfoByContainerIdAsync("unknown"));
+    WaitForQueries();
+    APSARA_TEST_EQUAL(2U, mOperator.GetRequests().size());
+}
+
+void K8sMetadataAsyncUnittest::TestRequestFailure() {
+    mOperator.AddInfo("c4", "w4");
+    mOperator.SetFailedCnt(2);
+    auto& metadata = K8sMetadata::GetInstance();
+    auto start = chrono::steady_clock::now();
+    APSARA_TEST_EQUAL(nullptr, metadata.GetInfoByContainerIdAsync("c4"));
+    WaitForQueries();
+
+    // the keys of failed requests are queried again with backoff, instead of being cached as missing
+    auto requests = mOperator.GetRequests();
+    APSARA_TEST_EQUAL(3U, requests.size());
+    for (const auto& req : requests) {
+        APSARA_TEST_EQUAL(vector<string>{"c4"}, req.mKeys);
+    }
+    // the batch interval before each request, and 200ms and 400ms of backoff before the retries
+    APSARA_TEST_TRUE(chrono::steady_clock::now() - start >= chrono::milliseconds(1200));
+    auto info = metadata.GetInfoByContainerIdAsync("c4");
+    APSARA_TEST_NOT_EQUAL(nullptr, info);
+    APSARA_TEST_EQUAL("w4", info->workloadName);
+    {
+        lock_guard<mutex> lock(metadata.mQueryMux);
+        auto& state = metadata.mQueryStates[static_cast<size_t>(containerInfoType::ContainerIdInfo)];
+        APSARA_TEST_EQUAL(0U, state.mMissingKeys.count("c4"));
+        APSARA_TEST_EQUAL(0U, state.mFailedCnt);
+    }
+}
+
+void K8sMetadataAsyncUnittest::TestLabeling() {
+    mOperator.AddInfo("c3", "w3");
+    auto sourceBuffer = make_shared<SourceBuffer>();
+    PipelineEventGroup eventGroup(sourceBuffer);
+    auto event = eventGroup.AddSpanEvent();
+    event->SetTag(containerIdKey, string("c3"));
+
+    LabelingK8sMetadata labeling;
+    // the event is passed on without the labels while the metadata is being queried
+    labeling.AddLabelToLogGroup(eventGroup);
+    APSARA_TEST_FALSE(event->HasTag(workloadNameKey));
+    WaitForQueries();
+
+    labeling.AddLabelToLogGroup(eventGroup);
+    APSARA_TEST_EQUAL("w3", event->GetTag(workloadNameKey).to_string());
+    APSARA_TEST_EQUAL(1U, mOperator.GetRequests().size());
+}
+
+UNIT_TEST_CASE(K8sMetadataAsyncUnittest, TestBatchAndSingleFlight)
+UNIT_TEST_CASE(K8sMetadataAsyncUnittest, TestNegativeCache)
+UNIT_TEST_CASE(K8sMetadataAsyncUnittest, TestRequestFailure)
+UNIT_TEST_CASE(K8sMetadataAsyncUnittest, TestLabeling)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -14,6 +14,11 @@
 
 #include <cstdlib>
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
 #include "common/JsonUtil.h"
 #include "common/TimeUtil.h"
 #include "models/LogEvent.h"
@@ -35,6 +40,7 @@ class EventGroupBenchmark {
 public:
     void TestEraseInLoop();
     void TestWriteIndexInLoop();
+    void TestProducerConsumer(size_t producerCnt, size_t consumerCnt);
 };
 
 void EraseInLoop(PipelineEventGroup& logGroup) {
@@ -102,12 +108,66 @@ void EventGroupBenchmark::TestWriteIndexInLoop() {
     printf("%s costs %lums\n", __func__, timeelapsed);
 }
 
+// events are acquired from the threaded pools of producer threads and released on consumer threads, which is the
+// case for input/processor threads and flusher threads.
+void EventGroupBenchmark::TestProducerConsumer(size_t producerCnt, size_t consumerCnt) {
+    const size_t groupCnt = 2000;
+    const size_t eventCnt = 1000;
+    std::mutex mux;
+    std::condition_variable cv;
+    std::deque<PipelineEventGroup> queue;
+    size_t finishedProducerCnt = 0;
+
+    uint64_t starttime = GetCurrentTimeInMilliSeconds();
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < producerCnt; ++i) {
+        threads.emplace_back([&]() {
+            for (size_t j = 0; j < groupCnt / producerCnt; ++j) {
+                PipelineEventGroup group(std::make_shared<SourceBuffer>());
+                group.ReserveEvents(eventCnt);
+                for (size_t k = 0; k < eventCnt; ++k) {
+                    auto e = group.AddLogEvent(true);
+                    e->SetContentNoCopy(StringView("key"), StringView("value"));
+                }
+                std::lock_guard<std::mutex> lock(mux);
+                queue.emplace_back(std::move(group));
+                cv.notify_one();
+            }
+            std::lock_guard<std::mutex> lock(mux);
+            ++finishedProducerCnt;
+            cv.notify_all();
+        });
+    }
+    for (size_t i = 0; i < consumerCnt; ++i) {
+        threads.emplace_back([&]() {
+            while (true) {
+                std::unique_lock<std::mutex> lock(mux);
+                cv.wait(lock, [&]() { return !queue.empty() || finishedProducerCnt == producerCnt; });
+                if (queue.empty()) {
+                    return;
+                }
+                PipelineEventGroup group = std::move(queue.front());
+                queue.pop_front();
+                lock.unlock();
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    uint64_t timeelapsed = GetCurrentTimeInMilliSeconds() - starttime;
+    printf("%s with %lu producers and %lu consumers costs %lums\n", __func__, producerCnt, consumerCnt, timeelapsed);
+}
+
 } // namespace logtail
 
 int main(int argc, char* argv[]) {
     logtail::EventGroupBenchmark benchmark;
     benchmark.TestEraseInLoop();
     benchmark.TestWriteIndexInLoop();
+    benchmark.TestProducerConsumer(1, 1);
+    benchmark.TestProducerConsumer(2, 2);
+    benchmark.TestProducerConsumer(4, 4);
     /* Result:
        TestEraseInLoop costs 453ms
        TestWriteIndexInLoop costs 22ms
@@ -12,10 +12,18 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <set>
+#include <thread>
+
+#include "common/Flags.h"
 #include "models/EventPool.h"
 #include "models/PipelineEventGroup.h"
 #include "unittest/Unittest.h"
 
+DECLARE_FLAG_INT32(event_pool_thread_cache_size);
+DECLARE_FLAG_INT32(event_pool_depot_max_size);
+DECLARE_FLAG_INT32(event_pool_event_lifetime_sec);
+
 using namespace std;
 
 namespace logtail {
@@ -24,11 +32,24 @@ class EventPoolUnittest : public ::testing::Test {
 public:
     void TestNoLock();
     void TestLock();
+    void TestCrossThreadRelease();
+    void TestDepot();
     void TestGC();
 
 protected:
     void SetUp() override { mGroup.reset(new PipelineEventGroup(make_shared<SourceBuffer>())); }
 
+    void TearDown() override {
+        INT32_FLAG(event_pool_thread_cache_size) = 10000;
+        INT32_FLAG(event_pool_depot_max_size) = 100000;
+        INT32_FLAG(event_pool_event_lifetime_sec) = 10;
+        vector<LogEvent*> events;
+        EventPool::sLogEventDepot.PopAll(events);
+        for (auto& item : events) {
+            delete item;
+        }
+    }
+
 private:
     unique_ptr<PipelineEventGroup> mGroup;
 };
@@ -38,6 +59,7 @@ void EventPoolUnittest::TestNoLock() {
     APSARA_TEST_FALSE(pool.mEnableLock);
     {
         auto e = pool.AcquireLogEvent(mGroup.get());
+        APSARA_TEST_EQUAL(1U, pool.mLogEventStat.mAllocatedCnt);
         pool.Release({e});
         APSARA_TEST_EQUAL(1U, pool.mLogEventPool.size());
         APSARA_TEST_EQUAL(e, pool.mLogEventPool[0]);
@@ -46,12 +68,14 @@ void EventPoolUnittest::TestNoLock() {
         PipelineEventGroup g(make_shared<SourceBuffer>());
         e = pool.AcquireLogEvent(&g);
         APSARA_TEST_EQUAL(0U, pool.mLogEventPool.size());
-        APSARA_TEST_EQUAL(0U, pool.mMinUnusedLogEventsCnt);
+        APSARA_TEST_EQUAL(2U, pool.mLogEventStat.mAcquiredCnt);
+        APSARA_TEST_EQUAL(1U, pool.mLogEventStat.mAllocatedCnt);
         APSARA_TEST_EQUAL(&g, e->GetPipelineEventGroupPtr());
         delete e;
     }
     {
         auto e = pool.AcquireMetricEvent(mGroup.get());
+        APSARA_TEST_EQUAL(1U, pool.mMetricEventStat.mAllocatedCnt);
         pool.Release({e});
         APSARA_TEST_EQUAL(1U, pool.mMetricEventPool.size());
         APSARA_TEST_EQUAL(e, pool.mMetricEventPool[0]);
@@ -60,12 +84,14 @@ void EventPoolUnittest::TestNoLock() {
         PipelineEventGroup g(make_shared<SourceBuffer>());
         e = pool.AcquireMetricEvent(&g);
         APSARA_TEST_EQUAL(0U, pool.mMetricEventPool.size());
-        APSARA_TEST_EQUAL(0U, pool.mMinUnusedMetricEventsCnt);
+        APSARA_TEST_EQUAL(2U, pool.mMetricEventStat.mAcquiredCnt);
+        APSARA_TEST_EQUAL(1U, pool.mMetricEventStat.mAllocatedCnt);
         APSARA_TEST_EQUAL(&g, e->GetPipelineEventGroupPtr());
         delete e;
     }
     {
         auto e = pool.AcquireSpanEvent(mGroup.get());
+        APSARA_TEST_EQUAL(1U, pool.mSpanEventStat.mAllocatedCnt);
         pool.Release({e});
         APSARA_TEST_EQUAL(1U, pool.mSpanEventPool.size());
         APSARA_TEST_EQUAL(e, pool.mSpanEventPool[0]);
@@ -74,12 +100,14 @@ void EventPoolUnittest::TestNoLock() {
         PipelineEventGroup g(make_shared<SourceBuffer>());
         e = pool.AcquireSpanEvent(&g);
         APSARA_TEST_EQUAL(0U, pool.mSpanEventPool.size());
-        APSARA_TEST_EQUAL(0U, pool.mMinUnusedSpanEventsCnt);
+        APSARA_TEST_EQUAL(2U, pool.mSpanEventStat.mAcquiredCnt);
+        APSARA_TEST_EQUAL(1U, pool.mSpanEventStat.mAllocatedCnt);
         APSARA_TEST_EQUAL(&g, e->GetPipelineEventGroupPtr());
         delete e;
     }
     {
         auto e = pool.AcquireRawEvent(mGroup.get());
+        APSARA_TEST_EQUAL(1U, pool.mRawEventStat.mAllocatedCnt);
         pool.Release({e});
         APSARA_TEST_EQUAL(1U, pool.mRawEventPool.size());
         APSARA_TEST_EQUAL(e, pool.mRawEventPool[0]);
@@ -88,7 +116,8 @@ void EventPoolUnittest::TestNoLock() {
         PipelineEventGroup g(make_shared<SourceBuffer>());
         e = pool.AcquireRawEvent(&g);
         APSARA_TEST_EQUAL(0U, pool.mRawEventPool.size());
-        APSARA_TEST_EQUAL(0U, pool.mMinUnusedRawEventsCnt);
+        APSARA_TEST_EQUAL(2U, pool.mRawEventStat.mAcquiredCnt);
+        APSARA_TEST_EQUAL(1U, pool.mRawEventStat.mAllocatedCnt);
         APSARA_TEST_EQUAL(&g, e->GetPipelineEventGroupPtr());
         delete e;
     }
@@ -102,18 +131,18 @@ void EventPoolUnittest::TestLock() {
         auto e = pool.AcquireLogEvent(mGroup.get());
         auto e1 = pool.AcquireLogEvent(mGroup.get());
         pool.Release({e});
-        APSARA_TEST_EQUAL(1U, pool.mLogEventPoolBak.size());
-        APSARA_TEST_EQUAL(e, pool.mLogEventPoolBak[0]);
+        APSARA_TEST_EQUAL(1U, pool.mReturnedLogEvents.Size());
+        APSARA_TEST_EQUAL(0U, pool.mLogEventPool.size());
         APSARA_TEST_EQUAL(mGroup.get(), e->GetPipelineEventGroupPtr());
 
-        e = pool.AcquireLogEvent(mGroup.get());
-        APSARA_TEST_EQUAL(0U, pool.mLogEventPoolBak.size());
+        APSARA_TEST_EQUAL(e, pool.AcquireLogEvent(mGroup.get()));
+        APSARA_TEST_EQUAL(0U, pool.mReturnedLogEvents.Size());
         APSARA_TEST_EQUAL(0U, pool.mLogEventPool.size());
         APSARA_TEST_EQUAL(mGroup.get(), e->GetPipelineEventGroupPtr());
 
         pool.Release(vector<LogEvent*>{e, e1});
         auto e2 = pool.AcquireLogEvent(mGroup.get());
-        APSARA_TEST_EQUAL(0U, pool.mLogEventPoolBak.size());
+        APSARA_TEST_EQUAL(0U, pool.mReturnedLogEvents.Size());
         APSARA_TEST_EQUAL(1U, pool.mLogEventPool.size());
         delete e2;
     }
@@ -121,18 +150,18 @@ void EventPoolUnittest::TestLock() {
         auto e = pool.AcquireMetricEvent(mGroup.get());
         auto e1 = pool.AcquireMetricEvent(mGroup.get());
         pool.Release({e});
-        APSARA_TEST_EQUAL(1U, pool.mMetricEventPoolBak.size());
-        APSARA_TEST_EQUAL(e, pool.mMetricEventPoolBak[0]);
+        APSARA_TEST_EQUAL(1U, pool.mReturnedMetricEvents.Size());
+        APSARA_TEST_EQUAL(0U, pool.mMetricEventPool.size());
         APSARA_TEST_EQUAL(mGroup.get(), e->GetPipelineEventGroupPtr());
 
-        e = pool.AcquireMetricEvent(mGroup.get());
-        APSARA_TEST_EQUAL(0U, pool.mMetricEventPoolBak.size());
+        APSARA_TEST_EQUAL(e, pool.AcquireMetricEvent(mGroup.get()));
+        APSARA_TEST_EQUAL(0U, pool.mReturnedMetricEvents.Size());
         APSARA_TEST_EQUAL(0U, pool.mMetricEventPool.size());
         APSARA_TEST_EQUAL(mGroup.get(), e->GetPipelineEventGroupPtr());
 
         pool.Release(vector<MetricEvent*>{e, e1});
         auto e2 = pool.AcquireMetricEvent(mGroup.get());
-        APSARA_TEST_EQUAL(0U, pool.mMetricEventPoolBak.size());
+        APSARA_TEST_EQUAL(0U, pool.mReturnedMetricEvents.Size());
         APSARA_TEST_EQUAL(1U, pool.mMetricEventPool.size());
         delete e2;
     }
@@ -140,18 +169,18 @@ void EventPoolUnittest::TestLock() {
         auto e = pool.AcquireSpanEvent(mGroup.get());
         auto e1 = pool.AcquireSpanEvent(mGroup.get());
         pool.Release({e});
-        APSARA_TEST_EQUAL(1U, pool.mSpanEventPoolBak.size());
-        APSARA_TEST_EQUAL(e, pool.mSpanEventPoolBak[0]);
+        APSARA_TEST_EQUAL(1U, pool.mReturnedSpanEvents.Size());
+        APSARA_TEST_EQUAL(0U, pool.mSpanEventPool.size());
         APSARA_TEST_EQUAL(mGroup.get(), e->GetPipelineEventGroupPtr());
 
-        e = pool.AcquireSpanEvent(mGroup.get());
-        APSARA_TEST_EQUAL(0U, pool.mSpanEventPoolBak.size());
+        APSARA_TEST_EQUAL(e, pool.AcquireSpanEvent(mGroup.get()));
+        APSARA_TEST_EQUAL(0U, pool.mReturnedSpanEvents.Size());
         APSARA_TEST_EQUAL(0U, pool.mSpanEventPool.size());
         APSARA_TEST_EQUAL(mGroup.get(), e->GetPipelineEventGroupPtr());
 
         pool.Release(vector<SpanEvent*>{e, e1});
         auto e2 = pool.AcquireSpanEvent(mGroup.get());
-        APSARA_TEST_EQUAL(0U, pool.mSpanEventPoolBak.size());
+        APSARA_TEST_EQUAL(0U, pool.mReturnedSpanEvents.Size());
         APSARA_TEST_EQUAL(1U, pool.mSpanEventPool.size());
         delete e2;
     }
@@ -159,87 +188,141 @@ void EventPoolUnittest::TestLock() {
         auto e = pool.AcquireRawEvent(mGroup.get());
         auto e1 = pool.AcquireRawEvent(mGroup.get());
         pool.Release({e});
-        APSARA_TEST_EQUAL(1U, pool.mRawEventPoolBak.size());
-        APSARA_TEST_EQUAL(e, pool.mRawEventPoolBak[0]);
+        APSARA_TEST_EQUAL(1U, pool.mReturnedRawEvents.Size());
+        APSARA_TEST_EQUAL(0U, pool.mRawEventPool.size());
         APSARA_TEST_EQUAL(mGroup.get(), e->GetPipelineEventGroupPtr());
 
-        e = pool.AcquireRawEvent(mGroup.get());
-        APSARA_TEST_EQUAL(0U, pool.mRawEventPoolBak.size());
+        APSARA_TEST_EQUAL(e, pool.AcquireRawEvent(mGroup.get()));
+        APSARA_TEST_EQUAL(0U, pool.mReturnedRawEvents.Size());
         APSARA_TEST_EQUAL(0U, pool.mRawEventPool.size());
         APSARA_TEST_EQUAL(mGroup.get(), e->GetPipelineEventGroupPtr());
 
         pool.Release(vector<RawEvent*>{e, e1});
         auto e2 = pool.AcquireRawEvent(mGroup.get());
-        APSARA_TEST_EQUAL(0U, pool.mRawEventPoolBak.size());
+        APSARA_TEST_EQUAL(0U, pool.mReturnedRawEvents.Size());
         APSARA_TEST_EQUAL(1U, pool.mRawEventPool.size());
         delete e2;
     }
     pool.Clear();
 }
 
-void EventPoolUnittest::TestGC() {
-    {
-        EventPool pool(false);
+void EventPoolUnittest::TestCrossThreadRelease() {
+    EventPool pool;
+    vector<LogEvent*> events;
+    for (size_t i = 0; i < 100; ++i) {
+        events.push_back(pool.AcquireLogEvent(mGroup.get()));
+    }
 
-        vector<LogEvent*> events;
-        for (size_t i = 0; i < 3; ++i) {
-            events.push_back(pool.AcquireLogEvent(mGroup.get()));
-        }
+    vector<thread> threads;
+    for (size_t i = 0; i < 4; ++i) {
+        threads.emplace_back([&pool, &events, i]() {
+            for (size_t j = i * 25; j < (i + 1) * 25; ++j) {
+                pool.Release({events[j]});
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    APSARA_TEST_EQUAL(100U, pool.mReturnedLogEvents.Size());
 
-        pool.Release(std::move(events));
-        pool.CheckGC();
-        APSARA_TEST_EQUAL(0U, pool.mLogEventPool.size());
-        APSARA_TEST_EQUAL(numeric_limits<size_t>::max(), pool.mMinUnusedLogEventsCnt);
+    set<LogEvent*> reused;
+    for (size_t i = 0; i < 100; ++i) {
+        reused.insert(pool.AcquireLogEvent(mGroup.get()));
+    }
+    APSARA_TEST_EQUAL(set<LogEvent*>(events.begin(), events.end()), reused);
+    APSARA_TEST_EQUAL(100U, pool.mLogEventStat.mAllocatedCnt);
+    for (auto& item : reused) {
+        delete item;
     }
+}
+
+void EventPoolUnittest::TestDepot() {
+    INT32_FLAG(event_pool_thread_cache_size) = 10;
+    vector<LogEvent*> events;
     {
+        // the consumer pool only releases events
+        EventPool consumerPool(false);
+        EventPool producerPool(false);
+        for (size_t i = 0; i < 20; ++i) {
+            events.push_back(producerPool.AcquireLogEvent(mGroup.get()));
+        }
+        consumerPool.Release(vector<LogEvent*>(events));
+        APSARA_TEST_EQUAL(5U, consumerPool.mLogEventPool.size());
+        APSARA_TEST_EQUAL(15U, EventPool::sLogEventDepot.Size());
+
+        // the producer pool refills from the depot
+        auto e = producerPool.AcquireLogEvent(mGroup.get());
+        APSARA_TEST_EQUAL(20U, producerPool.mLogEventStat.mAllocatedCnt);
+        APSARA_TEST_EQUAL(0U, EventPool::sLogEventDepot.Size());
+        APSARA_TEST_EQUAL(14U, producerPool.mLogEventPool.size());
+        delete e;
+    }
+    {
+        // events are destroyed when the depot is full
+        INT32_FLAG(event_pool_depot_max_size) = 10;
         EventPool pool(false);
-
-        vector<LogEvent*> events;
-        for (size_t i = 0; i < 3; ++i) {
-            events.push_back(pool.AcquireLogEvent(mGroup.get()));
+        EventPool sourcePool(false);
+        events.clear();
+        for (size_t i = 0; i < 20; ++i) {
+            events.push_back(sourcePool.AcquireLogEvent(mGroup.get()));
         }
-
         pool.Release(std::move(events));
-        auto e = pool.AcquireLogEvent(mGroup.get());
-        pool.Release({e});
-        pool.CheckGC();
-        APSARA_TEST_EQUAL(1U, pool.mLogEventPool.size());
-        APSARA_TEST_EQUAL(numeric_limits<size_t>::max(), pool.mMinUnusedLogEventsCnt);
+        APSARA_TEST_EQUAL(5U, pool.mLogEventPool.size());
+        APSARA_TEST_EQUAL(0U, EventPool::sLogEventDepot.Size());
     }
-    {
-        EventPool pool;
+}
 
+void EventPoolUnittest::TestGC() {
+    INT32_FLAG(event_pool_event_lifetime_sec) = 1;
+    {
+        // the pool is still growing
+        EventPool pool(false);
         vector<LogEvent*> events;
-        for (size_t i = 0; i < 3; ++i) {
+        for (size_t i = 0; i < 10; ++i) {
             events.push_back(pool.AcquireLogEvent(mGroup.get()));
         }
-
         pool.Release(std::move(events));
-        pool.CheckGC();
+        pool.GC(10);
+        APSARA_TEST_EQUAL(10U, pool.mLogEventPool.size());
+        APSARA_TEST_EQUAL(1.0, pool.mLogEventStat.mAcquireRate);
+        APSARA_TEST_EQUAL(0U, pool.mLogEventStat.mAcquiredCnt);
+        APSARA_TEST_EQUAL(0U, pool.mLogEventStat.mAllocatedCnt);
+
+        // no event is acquired, so the pool shrinks gradually
+        pool.GC(10);
+        APSARA_TEST_EQUAL(0.5, pool.mLogEventStat.mAcquireRate);
+        APSARA_TEST_EQUAL(5U, pool.mLogEventPool.size());
+        pool.GC(10);
+        APSARA_TEST_EQUAL(2U, pool.mLogEventPool.size());
+        for (size_t i = 0; i < 10; ++i) {
+            pool.GC(10);
+        }
         APSARA_TEST_EQUAL(0U, pool.mLogEventPool.size());
-        APSARA_TEST_EQUAL(0U, pool.mLogEventPoolBak.size());
-        APSARA_TEST_EQUAL(numeric_limits<size_t>::max(), pool.mMinUnusedLogEventsCnt);
     }
     {
+        // events in use are kept
+        INT32_FLAG(event_pool_event_lifetime_sec) = 10;
         EventPool pool;
-
         vector<LogEvent*> events;
-        for (size_t i = 0; i < 3; ++i) {
-            events.push_back(pool.AcquireLogEvent(mGroup.get()));
+        for (size_t i = 0; i < 10; ++i) {
+            for (size_t j = 0; j < 100; ++j) {
+                events.push_back(pool.AcquireLogEvent(mGroup.get()));
+            }
+            pool.Release(std::move(events));
+            events.clear();
+            pool.GC(10);
+            APSARA_TEST_EQUAL(100U, pool.mLogEventPool.size());
+            APSARA_TEST_EQUAL(0U, pool.mReturnedLogEvents.Size());
         }
-
-        pool.Release(std::move(events));
-        auto e = pool.AcquireLogEvent(mGroup.get());
-        pool.Release({e});
-        pool.CheckGC();
-        APSARA_TEST_EQUAL(0U, pool.mLogEventPool.size());
-        APSARA_TEST_EQUAL(0U, pool.mLogEventPoolBak.size());
-        APSARA_TEST_EQUAL(numeric_limits<size_t>::max(), pool.mMinUnusedLogEventsCnt);
+        APSARA_TEST_EQUAL(10.0, pool.mLogEventStat.mAcquireRate);
     }
 }
 
 UNIT_TEST_CASE(EventPoolUnittest, TestNoLock)
 UNIT_TEST_CASE(EventPoolUnittest, TestLock)
+UNIT_TEST_CASE(EventPoolUnittest, TestCrossThreadRelease)
+UNIT_TEST_CASE(EventPoolUnittest, TestDepot)
 UNIT_TEST_CASE(EventPoolUnittest, TestGC)
 
 } // namespace logtail
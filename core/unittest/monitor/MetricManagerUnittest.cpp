@@ -41,11 +41,17 @@ public:
     void TestCreateMetricAutoDelete();
     void TestCreateMetricAutoDeleteMultiThread();
     void TestCreateAndDeleteMetric();
+    void TestShardedCounter();
+    void TestSnapshotReuse();
+    void TestHistogram();
 };
 
 APSARA_UNIT_TEST_CASE(MetricManagerUnittest, TestCreateMetricAutoDelete, 0);
 APSARA_UNIT_TEST_CASE(MetricManagerUnittest, TestCreateMetricAutoDeleteMultiThread, 1);
 APSARA_UNIT_TEST_CASE(MetricManagerUnittest, TestCreateAndDeleteMetric, 2);
+APSARA_UNIT_TEST_CASE(MetricManagerUnittest, TestShardedCounter, 3);
+APSARA_UNIT_TEST_CASE(MetricManagerUnittest, TestSnapshotReuse, 4);
+APSARA_UNIT_TEST_CASE(MetricManagerUnittest, TestHistogram, 5);
 
 
 void MetricManagerUnittest::TestCreateMetricAutoDelete() {
@@ -78,12 +84,7 @@ void MetricManagerUnittest::TestCreateMetricAutoDelete() {
 
 
     // assert ReadMetrics count
-    tmp = ReadMetrics::GetInstance()->GetHead();
-    count = 0;
-    while (tmp) {
-        tmp = tmp->GetNext();
-        count++;
-    }
+    count = ReadMetrics::GetInstance()->mSnapshots.size();
     APSARA_TEST_EQUAL(count, 1);
 
     // mock create in other class, should be delete after
@@ -125,12 +126,7 @@ void MetricManagerUnittest::TestCreateMetricAutoDelete() {
 
 
     // assert ReadMetrics count
-    tmp = ReadMetrics::GetInstance()->GetHead();
-    count = 0;
-    while (tmp) {
-        tmp = tmp->GetNext();
-        count++;
-    }
+    count = ReadMetrics::GetInstance()->mSnapshots.size();
     APSARA_TEST_EQUAL(count, 1);
 }
 
@@ -187,12 +183,7 @@ void MetricManagerUnittest::TestCreateMetricAutoDeleteMultiThread() {
     APSARA_TEST_EQUAL(count, 0);
 
     // assert ReadMetrics count
-    tmp = ReadMetrics::GetInstance()->GetHead();
-    count = 0;
-    while (tmp) {
-        tmp = tmp->GetNext();
-        count++;
-    }
+    count = ReadMetrics::GetInstance()->mSnapshots.size();
     APSARA_TEST_EQUAL(count, 0);
 }
 
@@ -282,21 +273,15 @@ void MetricManagerUnittest::TestCreateAndDeleteMetric() {
     }
 
     // assert ReadMetrics count
-    tmp = ReadMetrics::GetInstance()->GetHead();
-    count = 0;
-    while (tmp) {
-        tmp = tmp->GetNext();
-        count++;
-    }
+    count = ReadMetrics::GetInstance()->mSnapshots.size();
     APSARA_TEST_EQUAL(count, 1);
 
     // assert readMetric value
     if (count == 1) {
-        tmp = ReadMetrics::GetInstance()->GetHead();
-        std::vector<CounterPtr> values = tmp->GetCounters();
+        const auto& values = ReadMetrics::GetInstance()->mSnapshots[0].GetCounters();
         APSARA_TEST_EQUAL(values.size(), 1);
         if (values.size() == 1) {
-            APSARA_TEST_EQUAL(values.at(0)->GetValue(), 111);
+            APSARA_TEST_EQUAL(values.at(0).second, 111);
         }
     }
 
@@ -309,26 +294,136 @@ void MetricManagerUnittest::TestCreateAndDeleteMetric() {
 
     ReadMetrics::GetInstance()->UpdateMetrics();
     // assert ReadMetrics count
-    tmp = ReadMetrics::GetInstance()->GetHead();
-    count = 0;
-    while (tmp) {
-        tmp = tmp->GetNext();
-        count++;
-    }
+    count = ReadMetrics::GetInstance()->mSnapshots.size();
     APSARA_TEST_EQUAL(count, 1);
 
     // assert readMetric value
     if (count == 1) {
-        tmp = ReadMetrics::GetInstance()->GetHead();
-        std::vector<CounterPtr> values = tmp->GetCounters();
+        const auto& values = ReadMetrics::GetInstance()->mSnapshots[0].GetCounters();
         APSARA_TEST_EQUAL(values.size(), 1);
         if (values.size() == 1) {
-            APSARA_TEST_EQUAL(values.at(0)->GetValue(), 333);
+            APSARA_TEST_EQUAL(values.at(0).second, 333);
         }
     }
     delete fileMetric1;
 }
 
+void MetricManagerUnittest::TestShardedCounter() {
+    MetricsRecordRef ref;
+    WriteMetrics::GetInstance()->PrepareMetricsRecordRef(ref, MetricCategory::METRIC_CATEGORY_UNKNOWN, {});
+    CounterPtr counter = ref.CreateCounter("counter");
+    ShardedCounterPtr shardedCounter = ref.CreateShardedCounter("sharded_counter");
+    ShardedTimeCounterPtr shardedTimeCounter = ref.CreateShardedTimeCounter("sharded_time_counter");
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < 2 * CounterShards::kShardCnt; ++i) {
+        threads.emplace_back([&]() {
+            for (size_t j = 0; j < 1000; ++j) {
+                counter->Add(1);
+                shardedCounter->Add(1);
+                shardedTimeCounter->Add(std::chrono::microseconds(1));
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    APSARA_TEST_EQUAL(2 * CounterShards::kShardCnt * 1000, counter->GetValue());
+    APSARA_TEST_EQUAL(2 * CounterShards::kShardCnt * 1000, shardedCounter->GetValue());
+    APSARA_TEST_EQUAL(2 * CounterShards::kShardCnt, shardedTimeCounter->GetValue());
+
+    // sharded counters are collected together with the plain ones
+    ReadMetrics::GetInstance()->UpdateMetrics();
+    const auto& values = ReadMetrics::GetInstance()->mSnapshots[0].GetCounters();
+    APSARA_TEST_EQUAL(3U, values.size());
+    for (const auto& item : values) {
+        if (item.first == "sharded_time_counter") {
+            APSARA_TEST_EQUAL(2 * CounterShards::kShardCnt, item.second);
+        } else {
+            APSARA_TEST_EQUAL(2 * CounterShards::kShardCnt * 1000, item.second);
+        }
+    }
+    APSARA_TEST_EQUAL(0U, counter->GetValue());
+    APSARA_TEST_EQUAL(0U, shardedCounter->GetValue());
+}
+
+void MetricManagerUnittest::TestSnapshotReuse() {
+    MetricsRecordRef ref;
+    WriteMetrics::GetInstance()->PrepareMetricsRecordRef(
+        ref, MetricCategory::METRIC_CATEGORY_UNKNOWN, {{"project", "project1"}});
+    CounterPtr counter = ref.CreateCounter("counter");
+    IntGaugePtr gauge = ref.CreateIntGauge("gauge");
+
+    counter->Add(10);
+    gauge->Set(5);
+    ReadMetrics::GetInstance()->UpdateMetrics();
+    auto& snapshots = ReadMetrics::GetInstance()->mSnapshots;
+    APSARA_TEST_EQUAL(1U, snapshots.size());
+    APSARA_TEST_EQUAL(10U, snapshots[0].GetCounters()[0].second);
+    APSARA_TEST_EQUAL(5U, snapshots[0].GetIntGauges()[0].second);
+    const auto* snapshotData = snapshots.data();
+    const auto* countersData = snapshots[0].GetCounters().data();
+
+    ReadMetrics::GetInstance()->UpdateMetrics();
+    APSARA_TEST_EQUAL(0U, snapshots[0].GetCounters()[0].second);
+
+    // the buffers are swapped on each update, so the first one is reused by the third update
+    counter->Add(20);
+    ReadMetrics::GetInstance()->UpdateMetrics();
+    APSARA_TEST_EQUAL(snapshotData, snapshots.data());
+    APSARA_TEST_EQUAL(countersData, snapshots[0].GetCounters().data());
+    APSARA_TEST_EQUAL(20U, snapshots[0].GetCounters()[0].second);
+    APSARA_TEST_EQUAL(5U, snapshots[0].GetIntGauges()[0].second);
+
+    std::vector<SelfMonitorMetricEvent> events;
+    ReadMetrics::GetInstance()->ReadAsSelfMonitorMetricEvents(events);
+    APSARA_TEST_EQUAL(1U, events.size());
+}
+
+void MetricManagerUnittest::TestHistogram() {
+    APSARA_TEST_EQUAL(0U, Histogram::GetBucketIndex(0));
+    APSARA_TEST_EQUAL(3U, Histogram::GetBucketIndex(3));
+    APSARA_TEST_EQUAL(4U, Histogram::GetBucketIndex(4));
+    APSARA_TEST_EQUAL(8U, Histogram::GetBucketIndex(8));
+    APSARA_TEST_EQUAL(8U, Histogram::GetBucketIndex(9));
+    APSARA_TEST_EQUAL(Histogram::kBucketCnt - 1, Histogram::GetBucketIndex(UINT64_MAX));
+    for (uint64_t us = 1; us < 100000; us = us * 3 / 2 + 1) {
+        size_t idx = Histogram::GetBucketIndex(us);
+        APSARA_TEST_TRUE(us < Histogram::GetBucketUpperBound(idx));
+        if (idx > 0) {
+            APSARA_TEST_TRUE(us >= Histogram::GetBucketUpperBound(idx - 1));
+        }
+    }
+
+    MetricsRecordRef ref;
+    WriteMetrics::GetInstance()->PrepareMetricsRecordRef(ref, MetricCategory::METRIC_CATEGORY_UNKNOWN, {});
+    HistogramPtr histogram = ref.CreateHistogram("latency_ms");
+    for (size_t i = 1; i <= 100; ++i) {
+        histogram->Record(std::chrono::milliseconds(i));
+    }
+    HistogramValue value;
+    histogram->Read(value);
+    APSARA_TEST_EQUAL(100U, value.mCount);
+    APSARA_TEST_EQUAL(50.5, value.mAvgMs);
+    // percentiles are reported as bucket upper bounds, which are at most 25% larger than the recorded values
+    APSARA_TEST_TRUE(value.mP50Ms >= 50 && value.mP50Ms <= 50 * 1.25);
+    APSARA_TEST_TRUE(value.mP90Ms >= 90 && value.mP90Ms <= 90 * 1.25);
+    APSARA_TEST_TRUE(value.mP99Ms >= 99 && value.mP99Ms <= 99 * 1.25);
+    APSARA_TEST_TRUE(value.mMaxMs >= 100 && value.mMaxMs <= 100 * 1.25);
+
+    ReadMetrics::GetInstance()->UpdateMetrics();
+    auto& snapshots = ReadMetrics::GetInstance()->mSnapshots;
+    APSARA_TEST_EQUAL(1U, snapshots.size());
+    APSARA_TEST_EQUAL(1U, snapshots[0].GetHistograms().size());
+    APSARA_TEST_EQUAL(100U, snapshots[0].GetHistograms()[0].second.mCount);
+    histogram->Read(value);
+    APSARA_TEST_EQUAL(0U, value.mCount);
+
+    std::vector<SelfMonitorMetricEvent> events;
+    ReadMetrics::GetInstance()->ReadAsSelfMonitorMetricEvents(events);
+    APSARA_TEST_EQUAL(1U, events.size());
+}
+
 } // namespace logtail
 
 int main(int argc, char** argv) {
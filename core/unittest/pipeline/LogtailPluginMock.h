@@ -81,6 +81,17 @@ public:
                                                                                           logGroup)("packId", packId));
     }
 
+    void ProcessLogGroups(const std::string& configName, const std::string& batch) {
+        std::vector<std::pair<StringView, StringView>> groups;
+        if (!LogtailPlugin::ParseLogGroupBatch(batch, groups)) {
+            LOG_ERROR(sLogger, ("LogtailPluginMock process log groups", "invalid batch")("config", configName));
+            return;
+        }
+        for (const auto& group : groups) {
+            ProcessLogGroup(configName, group.second.to_string(), group.first.to_string());
+        }
+    }
+
     bool IsStarted() const { return startFlag; }
 
 private:
@@ -108,6 +108,7 @@ public:
     void TestPipelineTopoUpdateCase11() const;
     void TestPipelineTopoUpdateCase12() const;
     void TestPipelineInputBlock() const;
+    void TestPipelineHotSwap() const;
     void TestPipelineGoInputBlockCase1() const;
     void TestPipelineGoInputBlockCase2() const;
     void TestPipelineIsolationCase1() const;
@@ -1428,6 +1429,55 @@ void PipelineUpdateUnittest::TestPipelineInputBlock() const {
     VerifyData("test_logstore_2", 5, 10);
 }
 
+void PipelineUpdateUnittest::TestPipelineHotSwap() const {
+    // C++ -> C++ -> C++
+    const std::string configName = "test1";
+    // load old pipeline
+    Json::Value pipelineConfigJson
+        = GeneratePipelineConfigJson(nativeInputConfig, nativeProcessorConfig, nativeFlusherConfig);
+    auto pipelineManager = CollectionPipelineManager::GetInstance();
+    CollectionConfigDiff diff;
+    CollectionConfig pipelineConfigObj = CollectionConfig(configName, make_unique<Json::Value>(pipelineConfigJson));
+    pipelineConfigObj.Parse();
+    diff.mAdded.push_back(std::move(pipelineConfigObj));
+    pipelineManager->UpdatePipelines(diff);
+    APSARA_TEST_EQUAL_FATAL(1U, pipelineManager->GetAllPipelines().size());
+
+    // keep an item in process of the old pipeline
+    auto oldPipeline = pipelineManager->GetAllPipelines().at(configName);
+    auto processor
+        = static_cast<ProcessorMock*>(const_cast<Processor*>(oldPipeline->mProcessorLine[0].get()->mPlugin.get()));
+    processor->Block();
+    AddDataToProcessor(configName, "test-data-1");
+    for (size_t i = 0; i < 50 && oldPipeline->mInProcessCnt.load() == 0; ++i) {
+        this_thread::sleep_for(chrono::milliseconds(100));
+    }
+    APSARA_TEST_EQUAL_FATAL(1U, oldPipeline->mInProcessCnt.load());
+
+    // load new pipeline
+    Json::Value pipelineConfigJsonUpdate
+        = GeneratePipelineConfigJson(nativeInputConfig2, nativeProcessorConfig2, nativeFlusherConfig2);
+    CollectionConfigDiff diffUpdate;
+    CollectionConfig pipelineConfigObjUpdate
+        = CollectionConfig(configName, make_unique<Json::Value>(pipelineConfigJsonUpdate));
+    pipelineConfigObjUpdate.Parse();
+    diffUpdate.mModified.push_back(std::move(pipelineConfigObjUpdate));
+    auto result = async(launch::async, [&]() { pipelineManager->UpdatePipelines(diffUpdate); });
+    this_thread::sleep_for(chrono::milliseconds(1000));
+    // the new pipeline has taken over while the old one is still being drained
+    APSARA_TEST_NOT_EQUAL_FATAL(future_status::ready, result.wait_for(chrono::milliseconds(0)));
+    APSARA_TEST_NOT_EQUAL(oldPipeline.get(), pipelineManager->FindConfigByName(configName).get());
+    processor->Unblock();
+    result.get();
+    APSARA_TEST_EQUAL_FATAL(1U, pipelineManager->GetAllPipelines().size());
+
+    AddDataToProcessor(configName, "test-data-2");
+    HttpSink::GetInstance()->Init();
+    FlusherRunner::GetInstance()->Init();
+    VerifyData("test_logstore_1", 1, 1);
+    VerifyData("test_logstore_2", 2, 2);
+}
+
 void PipelineUpdateUnittest::TestPipelineGoInputBlockCase1() const {
     // Go -> Go -> C++ => Go -> Go -> C++
     const std::string configName = "test1";
@@ -2399,6 +2449,7 @@ UNIT_TEST_CASE(PipelineUpdateUnittest, TestPipelineTopoUpdateCase10)
 UNIT_TEST_CASE(PipelineUpdateUnittest, TestPipelineTopoUpdateCase11)
 UNIT_TEST_CASE(PipelineUpdateUnittest, TestPipelineTopoUpdateCase12)
 UNIT_TEST_CASE(PipelineUpdateUnittest, TestPipelineInputBlock)
+UNIT_TEST_CASE(PipelineUpdateUnittest, TestPipelineHotSwap)
 UNIT_TEST_CASE(PipelineUpdateUnittest, TestPipelineGoInputBlockCase1)
 UNIT_TEST_CASE(PipelineUpdateUnittest, TestPipelineGoInputBlockCase2)
 UNIT_TEST_CASE(PipelineUpdateUnittest, TestPipelineIsolationCase1)
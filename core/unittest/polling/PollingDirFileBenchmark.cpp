@@ -0,0 +1,154 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdio>
+#include <cstdlib>
+
+#include <filesystem>
+#include <memory>
+#include <string>
+
+#include "json/json.h"
+
+#include "collection_pipeline/CollectionPipelineContext.h"
+#include "common/FileSystemUtil.h"
+#include "common/Flags.h"
+#include "common/RuntimeUtil.h"
+#include "common/TimeUtil.h"
+#include "file_server/FileDiscoveryOptions.h"
+#include "file_server/FileServer.h"
+#include "file_server/polling/PollingDirFile.h"
+
+DECLARE_FLAG_INT32(dirfile_stat_sleep);
+DECLARE_FLAG_INT32(polling_max_stat_count);
+DECLARE_FLAG_INT32(polling_max_stat_count_per_dir);
+DECLARE_FLAG_INT32(polling_dir_relist_round);
+
+namespace logtail {
+
+// PollingDirFileBenchmark polls a synthetic tree of @dirCnt directories with @fileCnt entries each, half of which
+// match the config.
+class PollingDirFileBenchmark {
+public:
+    PollingDirFileBenchmark(size_t dirCnt, size_t fileCnt);
+    ~PollingDirFileBenchmark();
+
+    void TestPolling(size_t threadCnt);
+
+private:
+    // @return the time of polling the tree once, in ms
+    uint64_t Poll();
+
+    std::string mRootDir;
+    FileDiscoveryOptions mOpts;
+    CollectionPipelineContext mCtx;
+};
+
+PollingDirFileBenchmark::PollingDirFileBenchmark(size_t dirCnt, size_t fileCnt) {
+    mRootDir = GetProcessExecutionDir() + "PollingDirFileBenchmark";
+    std::filesystem::remove_all(mRootDir);
+    uint64_t starttime = GetCurrentTimeInMilliSeconds();
+    for (size_t i = 0; i < dirCnt; ++i) {
+        auto dir = PathJoin(mRootDir, "d" + std::to_string(i));
+        std::filesystem::create_directories(dir);
+        for (size_t j = 0; j < fileCnt; ++j) {
+            auto name = std::to_string(j) + (j % 2 == 0 ? ".log" : ".txt");
+            FILE* file = fopen(PathJoin(dir, name).c_str(), "w");
+            if (file != nullptr) {
+                fclose(file);
+            }
+        }
+    }
+    printf("creating %zu entries costs %lums\n", dirCnt * fileCnt, GetCurrentTimeInMilliSeconds() - starttime);
+
+    Json::Value configJson;
+    configJson["FilePaths"].append(Json::Value(PathJoin(PathJoin(mRootDir, "**"), "*.log")));
+    configJson["MaxDirSearchDepth"] = Json::Value(5);
+    mOpts.Init(configJson, mCtx, "benchmark");
+    FileServer::GetInstance()->AddFileDiscoveryConfig("benchmark", &mOpts, &mCtx);
+
+    // the whole tree is polled in one round without sleeping
+    INT32_FLAG(dirfile_stat_sleep) = 0;
+    INT32_FLAG(polling_max_stat_count) = INT32_MAX;
+    INT32_FLAG(polling_max_stat_count_per_dir) = INT32_MAX;
+    PollingDirFile::GetInstance()->mRuningFlag = true;
+    PollingDirFile::GetInstance()->mHoldOnFlag = false;
+}
+
+PollingDirFileBenchmark::~PollingDirFileBenchmark() {
+    auto poller = PollingDirFile::GetInstance();
+    poller->mRuningFlag = false;
+    poller->ClearCache();
+    FileServer::GetInstance()->RemoveFileDiscoveryConfig("benchmark");
+    std::filesystem::remove_all(mRootDir);
+}
+
+uint64_t PollingDirFileBenchmark::Poll() {
+    auto poller = PollingDirFile::GetInstance();
+    ++poller->mCurrentRound;
+    poller->mStatCount = 0;
+    uint64_t starttime = GetCurrentTimeInMilliSeconds();
+    fsutil::PathStat buf;
+    if (fsutil::PathStat::stat(mRootDir, buf)) {
+        poller->PollingNormalConfigPath(std::make_pair(&mOpts, &mCtx), mRootDir, std::string(), buf, 0);
+        poller->WaitForPendingDirs();
+    }
+    return GetCurrentTimeInMilliSeconds() - starttime;
+}
+
+void PollingDirFileBenchmark::TestPolling(size_t threadCnt) {
+    auto poller = PollingDirFile::GetInstance();
+    poller->ClearCache();
+    if (threadCnt > 1) {
+        poller->mWalkerPool = std::make_unique<ThreadPool>(threadCnt);
+        poller->mWalkerPool->Start();
+    }
+
+    INT32_FLAG(polling_dir_relist_round) = 10;
+    uint64_t firstTime = Poll();
+    uint64_t reuseTime = Poll();
+    // listing every round, as before listings were reused
+    INT32_FLAG(polling_dir_relist_round) = 0;
+    uint64_t relistTime = Poll();
+    printf("%s with %zu threads: first round costs %lums, unchanged round costs %lums, relisting round costs %lums, "
+           "%zu files cached\n",
+           __func__,
+           threadCnt,
+           firstTime,
+           reuseTime,
+           relistTime,
+           poller->mFileCacheMap.size());
+
+    if (poller->mWalkerPool) {
+        poller->mWalkerPool->Stop();
+        poller->mWalkerPool.reset();
+    }
+}
+
+} // namespace logtail
+
+int main(int argc, char* argv[]) {
+    size_t dirCnt = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000;
+    size_t fileCnt = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 1000;
+    logtail::PollingDirFileBenchmark benchmark(dirCnt, fileCnt);
+    benchmark.TestPolling(1);
+    benchmark.TestPolling(4);
+    benchmark.TestPolling(8);
+    /* Result of 1000 dirs with 1000 files each:
+       TestPolling with 1 threads: first round costs 2465ms, unchanged round costs 1868ms, relisting round costs 2236ms
+       TestPolling with 4 threads: first round costs 1943ms, unchanged round costs 1434ms, relisting round costs 1562ms
+       TestPolling with 8 threads: first round costs 1703ms, unchanged round costs 1441ms, relisting round costs 1894ms
+     */
+    return 0;
+}
@@ -0,0 +1,182 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <set>
+#include <string>
+
+#include "json/json.h"
+
+#include "collection_pipeline/CollectionPipelineContext.h"
+#include "common/FileSystemUtil.h"
+#include "common/Flags.h"
+#include "file_server/FileDiscoveryOptions.h"
+#include "file_server/FileServer.h"
+#include "file_server/polling/PollingDirFile.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_INT32(polling_dir_relist_round);
+
+using namespace std;
+
+namespace logtail {
+
+class PollingDirFileUnittest : public testing::Test {
+public:
+    void TestParallelPolling();
+    void TestReuseListing();
+    void TestStoppedWalkerPool();
+
+protected:
+    static void SetUpTestCase() { sRootDir = GetProcessExecutionDir() + "PollingDirFileUnittest"; }
+
+    void SetUp() override {
+        filesystem::remove_all(sRootDir);
+        CreateFile("a/0.log");
+        CreateFile("a/0.txt");
+        CreateFile("a/b/1.log");
+        CreateFile("c/2.log");
+        // directories modified long ago can be reused
+        mOldTime = filesystem::file_time_type::clock::now() - chrono::seconds(10);
+        for (const auto& dir : {"", "a", "a/b", "c"}) {
+            filesystem::last_write_time(PathJoin(sRootDir, dir), mOldTime);
+        }
+
+        Json::Value configJson;
+        configJson["FilePaths"].append(Json::Value(PathJoin(PathJoin(sRootDir, "**"), "*.log")));
+        configJson["MaxDirSearchDepth"] = Json::Value(5);
+        APSARA_TEST_TRUE_FATAL(mOpts.Init(configJson, mCtx, "test"));
+        FileServer::GetInstance()->AddFileDiscoveryConfig("test", &mOpts, &mCtx);
+
+        auto poller = PollingDirFile::GetInstance();
+        poller->ClearCache();
+        poller->mRuningFlag = true;
+        poller->mHoldOnFlag = false;
+    }
+
+    void TearDown() override {
+        auto poller = PollingDirFile::GetInstance();
+        if (poller->mWalkerPool) {
+            poller->mWalkerPool->Stop();
+            poller->mWalkerPool.reset();
+        }
+        poller->mRuningFlag = false;
+        poller->ClearCache();
+        FileServer::GetInstance()->RemoveFileDiscoveryConfig("test");
+        filesystem::remove_all(sRootDir);
+        INT32_FLAG(polling_dir_relist_round) = 10;
+    }
+
+    static void CreateFile(const string& name) {
+        auto path = PathJoin(sRootDir, name);
+        filesystem::create_directories(filesystem::path(path).parent_path());
+        ofstream fout(path, ios::app);
+        fout << "line\n";
+    }
+
+    void Poll() {
+        auto poller = PollingDirFile::GetInstance();
+        ++poller->mCurrentRound;
+        poller->mStatCount = 0;
+        fsutil::PathStat buf;
+        APSARA_TEST_TRUE_FATAL(fsutil::PathStat::stat(sRootDir, buf));
+        APSARA_TEST_TRUE(poller->PollingNormalConfigPath(make_pair(&mOpts, &mCtx), sRootDir, string(), buf, 0));
+        poller->WaitForPendingDirs();
+    }
+
+    static set<string> GetMatchedFiles() {
+        set<string> res;
+        for (const auto& item : PollingDirFile::GetInstance()->mFileCacheMap) {
+            if (item.second.HasMatchedConfig()) {
+                res.insert(item.first);
+            }
+        }
+        return res;
+    }
+
+    static string sRootDir;
+    filesystem::file_time_type mOldTime;
+    FileDiscoveryOptions mOpts;
+    CollectionPipelineContext mCtx;
+};
+
+string PollingDirFileUnittest::sRootDir;
+
+void PollingDirFileUnittest::TestParallelPolling() {
+    auto poller = PollingDirFile::GetInstance();
+    poller->mWalkerPool = make_unique<ThreadPool>(4);
+    poller->mWalkerPool->Start();
+    Poll();
+
+    set<string> expected{PathJoin(sRootDir, "a/0.log"), PathJoin(sRootDir, "a/b/1.log"), PathJoin(sRootDir, "c/2.log")};
+    APSARA_TEST_EQUAL(expected, GetMatchedFiles());
+    APSARA_TEST_EQUAL(4U, poller->mDirCacheMap.size());
+    // root: a, c; a: 0.log, 0.txt, b; b: 1.log; c: 2.log
+    APSARA_TEST_EQUAL(7, poller->mStatCount.load());
+}
+
+void PollingDirFileUnittest::TestReuseListing() {
+    auto poller = PollingDirFile::GetInstance();
+    Poll();
+    {
+        auto& listing = poller->mDirCacheMap[PathJoin(sRootDir, "a")].GetListing();
+        APSARA_TEST_TRUE_FATAL(listing != nullptr);
+        // unmatched files are not recorded
+        APSARA_TEST_EQUAL(2U, listing->mEntries.size());
+    }
+
+    // the directory looks unchanged, so the new file is not found
+    CreateFile("c/3.log");
+    filesystem::last_write_time(PathJoin(sRootDir, "c"), mOldTime);
+    Poll();
+    APSARA_TEST_EQUAL(3U, GetMatchedFiles().size());
+    // 0.txt is not checked again
+    APSARA_TEST_EQUAL(6, poller->mStatCount.load());
+
+    // the directory is modified
+    filesystem::last_write_time(PathJoin(sRootDir, "c"), mOldTime + chrono::seconds(1));
+    Poll();
+    APSARA_TEST_EQUAL(4U, GetMatchedFiles().size());
+    APSARA_TEST_EQUAL(1U, GetMatchedFiles().count(PathJoin(sRootDir, "c/3.log")));
+
+    // listing every round
+    INT32_FLAG(polling_dir_relist_round) = 0;
+    Poll();
+    APSARA_TEST_EQUAL(8, poller->mStatCount.load());
+}
+
+void PollingDirFileUnittest::TestStoppedWalkerPool() {
+    auto poller = PollingDirFile::GetInstance();
+    poller->mWalkerPool = make_unique<ThreadPool>(4);
+    poller->mWalkerPool->Start();
+    // tasks are dropped by a stopped pool, the polling thread polls the queued subdirectories itself
+    poller->mWalkerPool->Stop();
+    Poll();
+
+    set<string> expected{PathJoin(sRootDir, "a/0.log"), PathJoin(sRootDir, "a/b/1.log"), PathJoin(sRootDir, "c/2.log")};
+    APSARA_TEST_EQUAL(expected, GetMatchedFiles());
+    APSARA_TEST_EQUAL(0U, poller->mPendingDirCnt);
+    APSARA_TEST_TRUE(poller->mPendingDirs.empty());
+}
+
+UNIT_TEST_CASE(PollingDirFileUnittest, TestParallelPolling)
+UNIT_TEST_CASE(PollingDirFileUnittest, TestReuseListing)
+UNIT_TEST_CASE(PollingDirFileUnittest, TestStoppedWalkerPool)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
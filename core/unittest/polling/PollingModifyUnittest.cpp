@@ -0,0 +1,201 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/FileSystemUtil.h"
+#include "common/Flags.h"
+#include "file_server/FileServer.h"
+#include "file_server/event/Event.h"
+#include "file_server/polling/PollingEventQueue.h"
+#include "file_server/polling/PollingModify.h"
+#include "monitor/metric_constants/MetricConstants.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_INT32(polling_modify_thread_num);
+DECLARE_FLAG_INT32(polling_modify_max_backoff_round);
+DECLARE_FLAG_INT32(max_file_not_exist_times);
+
+using namespace std;
+
+namespace logtail {
+
+class PollingModifyUnittest : public testing::Test {
+public:
+    void TestBackoff();
+    void TestParallelSweep();
+    void TestStoppedSweeperPool();
+
+protected:
+    static void SetUpTestCase() { sRootDir = GetProcessExecutionDir() + "PollingModifyUnittest"; }
+
+    void SetUp() override {
+        filesystem::remove_all(sRootDir);
+        filesystem::create_directories(sRootDir);
+        auto poller = PollingModify::GetInstance();
+        poller->ClearCache();
+        poller->mCurrentRound = 0;
+        poller->mRuningFlag = true;
+        poller->mHoldOnFlag = false;
+        auto& metricsRecordRef = FileServer::GetInstance()->GetMetricsRecordRef();
+        poller->mPollingModifySize = metricsRecordRef.CreateIntGauge(METRIC_RUNNER_FILE_POLLING_MODIFY_CACHE_SIZE);
+        poller->mPollingModifyCycleTimeMs
+            = metricsRecordRef.CreateHistogram(METRIC_RUNNER_FILE_POLLING_MODIFY_CYCLE_TIME_MS);
+        poller->mPollingModifyCheckedFilesTotal
+            = metricsRecordRef.CreateCounter(METRIC_RUNNER_FILE_POLLING_MODIFY_CHECKED_FILES_TOTAL);
+    }
+
+    void TearDown() override {
+        auto poller = PollingModify::GetInstance();
+        if (poller->mSweeperPool) {
+            poller->mSweeperPool->Stop();
+            poller->mSweeperPool.reset();
+        }
+        poller->mRuningFlag = false;
+        poller->ClearCache();
+        vector<Event*> events;
+        PopEvents(events);
+        filesystem::remove_all(sRootDir);
+        INT32_FLAG(polling_modify_thread_num) = 1;
+        INT32_FLAG(polling_modify_max_backoff_round) = 4;
+        INT32_FLAG(max_file_not_exist_times) = 10;
+    }
+
+    static void Append(const string& name) {
+        ofstream fout(PathJoin(sRootDir, name), ios::app);
+        fout << "line\n";
+    }
+
+    // @return the number of files checked in the round
+    static uint64_t Poll() {
+        auto poller = PollingModify::GetInstance();
+        auto lastCnt = poller->mPollingModifyCheckedFilesTotal->GetValue();
+        poller->PollingIteration();
+        return poller->mPollingModifyCheckedFilesTotal->GetValue() - lastCnt;
+    }
+
+    static void PopEvents(vector<Event*>& events) {
+        for (auto event : events) {
+            delete event;
+        }
+        events.clear();
+        PollingEventQueue::GetInstance()->PopAllEvents(events);
+    }
+
+    static string sRootDir;
+};
+
+string PollingModifyUnittest::sRootDir;
+
+void PollingModifyUnittest::TestBackoff() {
+    Append("a.log");
+    // too old to generate event at first check
+    filesystem::last_write_time(PathJoin(sRootDir, "a.log"),
+                                filesystem::file_time_type::clock::now() - chrono::seconds(3600));
+    PollingModify::GetInstance()->AddNewFile({SplitedFilePath(sRootDir, "a.log")});
+
+    vector<uint64_t> checkedRounds;
+    vector<Event*> events;
+    for (uint64_t round = 1; round <= 17; ++round) {
+        if (round == 12) {
+            Append("a.log");
+        }
+        if (Poll() == 1) {
+            checkedRounds.push_back(round);
+        }
+        PopEvents(events);
+        if (round == 16) {
+            APSARA_TEST_EQUAL(1U, events.size());
+        } else {
+            APSARA_TEST_EQUAL(0U, events.size());
+        }
+    }
+    // skip 1, 2, 4, 4 rounds while unchanged, and check every round once changed
+    vector<uint64_t> expected{1, 3, 6, 11, 16, 17};
+    APSARA_TEST_EQUAL(expected, checkedRounds);
+    PopEvents(events);
+}
+
+void PollingModifyUnittest::TestParallelSweep() {
+    INT32_FLAG(polling_modify_thread_num) = 4;
+    INT32_FLAG(max_file_not_exist_times) = 1;
+    auto poller = PollingModify::GetInstance();
+    poller->mSweeperPool = make_unique<ThreadPool>(3);
+    poller->mSweeperPool->Start();
+
+    vector<SplitedFilePath> files;
+    for (int i = 0; i < 500; ++i) {
+        auto name = to_string(i) + ".log";
+        Append(name);
+        files.emplace_back(sRootDir, name);
+    }
+    poller->AddNewFile(files);
+
+    vector<Event*> events;
+    APSARA_TEST_EQUAL(500U, Poll());
+    PopEvents(events);
+    APSARA_TEST_EQUAL(500U, events.size());
+    for (auto event : events) {
+        APSARA_TEST_TRUE(event->IsModify());
+    }
+
+    for (int i = 0; i < 100; ++i) {
+        filesystem::remove(PathJoin(sRootDir, to_string(i) + ".log"));
+    }
+    // files changed last round are checked again
+    APSARA_TEST_EQUAL(500U, Poll());
+    PopEvents(events);
+    APSARA_TEST_EQUAL(100U, events.size());
+    for (auto event : events) {
+        APSARA_TEST_TRUE(event->IsDeleted());
+    }
+    APSARA_TEST_EQUAL(400U, poller->mModifyCacheMap.size());
+    PopEvents(events);
+}
+
+void PollingModifyUnittest::TestStoppedSweeperPool() {
+    INT32_FLAG(polling_modify_thread_num) = 4;
+    auto poller = PollingModify::GetInstance();
+    poller->mSweeperPool = make_unique<ThreadPool>(3);
+    poller->mSweeperPool->Start();
+    // tasks are dropped by a stopped pool, the polling thread sweeps their ranges itself
+    poller->mSweeperPool->Stop();
+
+    vector<SplitedFilePath> files;
+    for (int i = 0; i < 500; ++i) {
+        auto name = to_string(i) + ".log";
+        Append(name);
+        files.emplace_back(sRootDir, name);
+    }
+    poller->AddNewFile(files);
+
+    vector<Event*> events;
+    APSARA_TEST_EQUAL(500U, Poll());
+    PopEvents(events);
+    APSARA_TEST_EQUAL(500U, events.size());
+    PopEvents(events);
+}
+
+UNIT_TEST_CASE(PollingModifyUnittest, TestBackoff)
+UNIT_TEST_CASE(PollingModifyUnittest, TestParallelSweep)
+UNIT_TEST_CASE(PollingModifyUnittest, TestStoppedSweeperPool)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -31,6 +31,8 @@ public:
     void TestLogFilterRule();
     void TestBaseFilter();
     void TestFilterNoneUtf8();
+    void TestFilterMatcher();
+    void TestConditionOrder();
 
     CollectionPipelineContext mContext;
 };
@@ -40,6 +42,8 @@ UNIT_TEST_CASE(ProcessorFilterNativeUnittest, OnFailedInit)
 UNIT_TEST_CASE(ProcessorFilterNativeUnittest, TestLogFilterRule)
 UNIT_TEST_CASE(ProcessorFilterNativeUnittest, TestBaseFilter)
 UNIT_TEST_CASE(ProcessorFilterNativeUnittest, TestFilterNoneUtf8)
+UNIT_TEST_CASE(ProcessorFilterNativeUnittest, TestFilterMatcher)
+UNIT_TEST_CASE(ProcessorFilterNativeUnittest, TestConditionOrder)
 
 PluginInstance::PluginMeta getPluginMeta() {
     PluginInstance::PluginMeta pluginMeta{"1"};
@@ -69,7 +73,7 @@ void ProcessorFilterNativeUnittest::OnSuccessfulInit() {
     processor->SetMetricsRecordRef(ProcessorFilterNative::sName, "1");
     APSARA_TEST_TRUE(processor->Init(configJson));
     APSARA_TEST_EQUAL(1, processor->mFilterRule->FilterKeys.size());
-    APSARA_TEST_EQUAL(1, processor->mFilterRule->FilterRegs.size());
+    APSARA_TEST_EQUAL(1, processor->mFilterRule->FilterMatchers.size());
 }
 
 void ProcessorFilterNativeUnittest::OnFailedInit() {
@@ -1031,6 +1035,118 @@ void ProcessorFilterNativeUnittest::TestFilterNoneUtf8() {
     }
 } // end of case
 
+void ProcessorFilterNativeUnittest::TestFilterMatcher() {
+    string exception;
+    {
+        FilterMatcher matcher(".*");
+        APSARA_TEST_TRUE(matcher.GetType() == FilterMatcher::Type::ANY);
+        APSARA_TEST_TRUE(matcher.Match(StringView("a\nb"), exception));
+        APSARA_TEST_TRUE(matcher.Match(StringView(""), exception));
+    }
+    {
+        FilterMatcher matcher("^value$");
+        APSARA_TEST_TRUE(matcher.GetType() == FilterMatcher::Type::EXACT);
+        APSARA_TEST_EQUAL("value", matcher.mLiteral);
+        APSARA_TEST_TRUE(matcher.Match(StringView("value"), exception));
+        APSARA_TEST_FALSE(matcher.Match(StringView("value1"), exception));
+        APSARA_TEST_FALSE(matcher.Match(StringView("value\n"), exception));
+    }
+    {
+        FilterMatcher matcher("10\\.0\\.0\\.1.*");
+        APSARA_TEST_TRUE(matcher.GetType() == FilterMatcher::Type::PREFIX);
+        APSARA_TEST_EQUAL("10.0.0.1", matcher.mLiteral);
+        APSARA_TEST_TRUE(matcher.Match(StringView("10.0.0.1:80"), exception));
+        APSARA_TEST_FALSE(matcher.Match(StringView("10a0.0.1:80"), exception));
+        APSARA_TEST_FALSE(matcher.Match(StringView("10.0"), exception));
+    }
+    {
+        FilterMatcher matcher(".*value");
+        APSARA_TEST_TRUE(matcher.GetType() == FilterMatcher::Type::SUFFIX);
+        APSARA_TEST_TRUE(matcher.Match(StringView("a\nvalue"), exception));
+        APSARA_TEST_FALSE(matcher.Match(StringView("value1"), exception));
+    }
+    {
+        FilterMatcher matcher(".*ERROR.*");
+        APSARA_TEST_TRUE(matcher.GetType() == FilterMatcher::Type::CONTAINS);
+        APSARA_TEST_TRUE(matcher.Match(StringView("[ERROR] failed"), exception));
+        APSARA_TEST_FALSE(matcher.Match(StringView("[error] failed"), exception));
+    }
+    {
+        // patterns that are not literals fall back to regex
+        const vector<string> exps = {"a.c", "\\d+", "value\\.*", "(a|b)", "a\\<b", "[ab]"};
+        for (const auto& exp : exps) {
+            FilterMatcher matcher(exp);
+            APSARA_TEST_TRUE_DESC(matcher.GetType() == FilterMatcher::Type::REGEX, exp);
+            APSARA_TEST_EQUAL(regex_match(exp, regex(exp)), matcher.Match(StringView(exp), exception));
+        }
+        FilterMatcher matcher("value\\.*");
+        APSARA_TEST_TRUE(matcher.Match(StringView("value.."), exception));
+        APSARA_TEST_FALSE(matcher.Match(StringView("value1"), exception));
+    }
+    APSARA_TEST_TRUE(exception.empty());
+}
+
+void ProcessorFilterNativeUnittest::TestConditionOrder() {
+    Json::Value config;
+    config["FilterKey"] = Json::Value(Json::arrayValue);
+    config["FilterKey"].append("key1");
+    config["FilterKey"].append("key2");
+    config["FilterKey"].append("key3");
+    config["FilterRegex"] = Json::Value(Json::arrayValue);
+    config["FilterRegex"].append("\\d+");
+    config["FilterRegex"].append(".*value2.*");
+    config["FilterRegex"].append("value3");
+
+    ProcessorFilterNative& processor = *(new ProcessorFilterNative);
+    ProcessorInstance processorInstance(&processor, getPluginMeta());
+    APSARA_TEST_TRUE_FATAL(processorInstance.Init(config, mContext));
+    APSARA_TEST_EQUAL(vector<string>({"key3", "key2", "key1"}), processor.mFilterRule->FilterKeys);
+
+    auto sourceBuffer = std::make_shared<SourceBuffer>();
+    PipelineEventGroup eventGroup(sourceBuffer);
+    std::string inJson = R"({
+        "events" :
+        [
+            {
+                "contents" :
+                {
+                    "key1" : "123",
+                    "key2" : "avalue2b",
+                    "key3" : "value3"
+                },
+                "timestamp" : 12345678901,
+                "type" : 1
+            },
+            {
+                "contents" :
+                {
+                    "key1" : "abc",
+                    "key2" : "avalue2b",
+                    "key3" : "value3"
+                },
+                "timestamp" : 12345678901,
+                "type" : 1
+            },
+            {
+                "contents" :
+                {
+                    "key1" : "123",
+                    "key2" : "avalue2b"
+                },
+                "timestamp" : 12345678901,
+                "type" : 1
+            }
+        ]
+    })";
+    eventGroup.FromJsonString(inJson);
+    processor.Process(eventGroup);
+    APSARA_TEST_EQUAL(1U, eventGroup.GetEvents().size());
+    APSARA_TEST_EQUAL("123", eventGroup.GetEvents()[0].Cast<LogEvent>().GetContent("key1"));
+    APSARA_TEST_EQUAL(1U, processor.mMatchedEventsTotal->GetValue());
+    APSARA_TEST_EQUAL(2U, processor.mDiscardedEventsTotal->GetValue());
+    APSARA_TEST_EQUAL(1U, processor.mOutKeyNotFoundEventsTotal->GetValue());
+}
+
 } // namespace logtail
 
 UNIT_TEST_MAIN
@@ -38,6 +38,7 @@ public:
     void TestProcessNoYearFormat();
     void TestProcessRegularFormatFailed();
     void TestProcessHistoryDiscard();
+    void TestProcessBatch();
     void TestProcessEventPreciseTimestampLegacy();
     void TestCheckTime();
 
@@ -50,6 +51,7 @@ UNIT_TEST_CASE(ProcessorParseTimestampNativeUnittest, TestProcessRegularFormat);
 UNIT_TEST_CASE(ProcessorParseTimestampNativeUnittest, TestProcessNoYearFormat);
 UNIT_TEST_CASE(ProcessorParseTimestampNativeUnittest, TestProcessRegularFormatFailed);
 UNIT_TEST_CASE(ProcessorParseTimestampNativeUnittest, TestProcessHistoryDiscard);
+UNIT_TEST_CASE(ProcessorParseTimestampNativeUnittest, TestProcessBatch);
 UNIT_TEST_CASE(ProcessorParseTimestampNativeUnittest, TestProcessEventPreciseTimestampLegacy);
 UNIT_TEST_CASE(ProcessorParseTimestampNativeUnittest, TestCheckTime);
 
@@ -610,6 +612,85 @@ void ProcessorParseTimestampNativeUnittest::TestProcessHistoryDiscard() {
     APSARA_TEST_EQUAL_FATAL(0UL, processor.mOutFailedEventsTotal->GetValue());
 }
 
+void ProcessorParseTimestampNativeUnittest::TestProcessBatch() {
+    Json::Value config;
+    config["SourceKey"] = "time";
+    config["SourceFormat"] = "%Y-%m-%d %H:%M:%S.%f";
+    config["SourceTimezone"] = "GMT+00:00";
+    {
+        BOOL_FLAG(ilogtail_discard_old_data) = false;
+        auto sourceBuffer = std::make_shared<SourceBuffer>();
+        PipelineEventGroup eventGroup(sourceBuffer);
+        std::vector<std::string> timeStrs = {"2017-1-11 15:05:07.1",
+                                             "2017-1-11 15:05:07.012",
+                                             "2017-1-11 15:05:07.0123456789",
+                                             "2017-1-11 15:05:07.",
+                                             "2017-1-11 15:05:08.5",
+                                             "unknown",
+                                             ""};
+        for (const auto& timeStr : timeStrs) {
+            auto event = eventGroup.AddLogEvent();
+            event->SetTimestamp(12345678901);
+            if (!timeStr.empty()) {
+                event->SetContent(std::string("time"), timeStr);
+            }
+        }
+        ProcessorParseTimestampNative& processor = *(new ProcessorParseTimestampNative);
+        ProcessorInstance processorInstance(&processor, getPluginMeta());
+        APSARA_TEST_TRUE_FATAL(processorInstance.Init(config, mContext));
+        processor.Process(eventGroup);
+
+        auto& events = eventGroup.GetEvents();
+        APSARA_TEST_EQUAL_FATAL(7U, events.size());
+        std::vector<std::pair<time_t, long>> expected = {{1484147107, 100000000},
+                                                         {1484147107, 12000000},
+                                                         {1484147107, 12345678},
+                                                         {12345678901, 0},
+                                                         {1484147108, 500000000},
+                                                         {12345678901, 0},
+                                                         {12345678901, 0}};
+        for (size_t i = 0; i < events.size(); ++i) {
+            const auto& event = events[i].Cast<LogEvent>();
+            EXPECT_EQ(expected[i].first, event.GetTimestamp()) << "event " << i;
+            EXPECT_EQ(expected[i].second, event.GetTimestampNanosecond().value_or(0)) << "event " << i;
+        }
+        APSARA_TEST_EQUAL(4U, processor.mOutSuccessfulEventsTotal->GetValue());
+        APSARA_TEST_EQUAL(2U, processor.mOutFailedEventsTotal->GetValue());
+        APSARA_TEST_EQUAL(1U, processor.mOutKeyNotFoundEventsTotal->GetValue());
+    }
+    {
+        BOOL_FLAG(ilogtail_discard_old_data) = true;
+        auto sourceBuffer = std::make_shared<SourceBuffer>();
+        PipelineEventGroup eventGroup(sourceBuffer);
+        time_t now = time(nullptr);
+        time_t outdated = now - INT32_FLAG(ilogtail_discard_interval) - 1;
+        char nowBuf[32] = "";
+        char outdatedBuf[32] = "";
+        strftime(nowBuf, sizeof(nowBuf), "%Y-%m-%d %H:%M:%S", std::gmtime(&now));
+        strftime(outdatedBuf, sizeof(outdatedBuf), "%Y-%m-%d %H:%M:%S", std::gmtime(&outdated));
+        std::vector<std::string> timeStrs = {std::string(nowBuf) + ".1",
+                                             std::string(outdatedBuf) + ".2",
+                                             std::string(outdatedBuf) + ".3",
+                                             std::string(nowBuf) + ".4"};
+        for (const auto& timeStr : timeStrs) {
+            eventGroup.AddLogEvent()->SetContent(std::string("time"), timeStr);
+        }
+        ProcessorParseTimestampNative& processor = *(new ProcessorParseTimestampNative);
+        ProcessorInstance processorInstance(&processor, getPluginMeta());
+        APSARA_TEST_TRUE_FATAL(processorInstance.Init(config, mContext));
+        processor.Process(eventGroup);
+
+        auto& events = eventGroup.GetEvents();
+        APSARA_TEST_EQUAL_FATAL(2U, events.size());
+        APSARA_TEST_EQUAL(now, events[0].Cast<LogEvent>().GetTimestamp());
+        APSARA_TEST_EQUAL(100000000, events[0].Cast<LogEvent>().GetTimestampNanosecond().value_or(0));
+        APSARA_TEST_EQUAL(now, events[1].Cast<LogEvent>().GetTimestamp());
+        APSARA_TEST_EQUAL(400000000, events[1].Cast<LogEvent>().GetTimestampNanosecond().value_or(0));
+        APSARA_TEST_EQUAL(2U, processor.mOutSuccessfulEventsTotal->GetValue());
+        APSARA_TEST_EQUAL(2U, processor.mDiscardedEventsTotal->GetValue());
+    }
+}
+
 void ProcessorParseTimestampNativeUnittest::TestProcessEventPreciseTimestampLegacy() {
     // make config
     BOOL_FLAG(ilogtail_discard_old_data) = false;
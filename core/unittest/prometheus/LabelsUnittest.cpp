@@ -17,6 +17,7 @@
 #include <cstdint>
 
 #include <string>
+#include <vector>
 
 #include "prometheus/Constants.h"
 #include "prometheus/labels/Labels.h"
@@ -32,6 +33,7 @@ public:
     void TestRange();
     void TestHash();
     void TestRemoveMetaLabels();
+    void TestSorted();
 
 private:
 };
@@ -113,12 +115,33 @@ void LabelsUnittest::TestRange() {
     APSARA_TEST_EQUAL(testMap, resMap);
 }
 
+void LabelsUnittest::TestSorted() {
+    Labels labels;
+    labels.Set("port", "9100");
+    labels.Set("host", "172.17.0.3:9100");
+    labels.Set("ip", "172.17.0.3");
+    labels.Set("host", "172.17.0.4:9100");
+    labels.Del("unknown");
+    APSARA_TEST_EQUAL(3U, labels.Size());
+    APSARA_TEST_EQUAL("172.17.0.4:9100", labels.GetView("host").to_string());
+    APSARA_TEST_TRUE(labels.GetView("hosts").empty());
+
+    vector<string> keys;
+    labels.RangeView([&keys](StringView k, StringView v) { keys.emplace_back(k.to_string()); });
+    APSARA_TEST_EQUAL(vector<string>({"host", "ip", "port"}), keys);
+
+    labels.Del("ip");
+    APSARA_TEST_EQUAL(2U, labels.Size());
+    APSARA_TEST_EQUAL("", labels.Get("ip"));
+}
+
 
 UNIT_TEST_CASE(LabelsUnittest, TestGet)
 UNIT_TEST_CASE(LabelsUnittest, TestSet)
 UNIT_TEST_CASE(LabelsUnittest, TestRange)
 UNIT_TEST_CASE(LabelsUnittest, TestHash)
 UNIT_TEST_CASE(LabelsUnittest, TestRemoveMetaLabels)
+UNIT_TEST_CASE(LabelsUnittest, TestSorted)
 
 
 } // namespace logtail
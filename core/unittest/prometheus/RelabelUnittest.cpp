@@ -49,6 +49,9 @@ public:
     void TestLowerCase();
     void TestUpperCase();
     void TestMultiRelabel();
+    void TestLiteralRegex();
+    void TestReplacementTemplate();
+    void TestInvalidRegex();
 };
 
 
@@ -515,6 +518,86 @@ void RelabelConfigUnittest::TestMultiRelabel() {
     APSARA_TEST_TRUE(configList.Process(result, toDelete));
 }
 
+void RelabelConfigUnittest::TestLiteralRegex() {
+    Json::Value configJson;
+    string errorMsg;
+    string configStr = R"(
+        [{
+                "action": "keep",
+                "regex": "node-exporter",
+                "source_labels": [
+                    "__meta_kubernetes_pod_label_app"
+                ]
+        },
+        {
+                "action": "labeldrop",
+                "regex": "pod_ip"
+        }]
+    )";
+    APSARA_TEST_TRUE(ParseJsonTable(configStr, configJson, errorMsg));
+    RelabelConfigList configList;
+    APSARA_TEST_TRUE(configList.Init(configJson));
+    APSARA_TEST_TRUE(configList.mRelabelConfigs[0].mIsLiteralRegex);
+    APSARA_TEST_TRUE(configList.mRelabelConfigs[1].mIsLiteralRegex);
+
+    Labels labels;
+    labels.Set("__meta_kubernetes_pod_label_app", "node-exporter");
+    labels.Set("pod_ip", "172.17.0.3");
+    labels.Set("pod_ip_v6", "::1");
+    vector<string> toDelete;
+    APSARA_TEST_TRUE(configList.Process(labels, toDelete));
+    APSARA_TEST_EQUAL(2U, labels.Size());
+    APSARA_TEST_EQUAL("", labels.Get("pod_ip"));
+    APSARA_TEST_EQUAL("::1", labels.Get("pod_ip_v6"));
+
+    labels.Set("__meta_kubernetes_pod_label_app", "node-exporter-2");
+    APSARA_TEST_FALSE(configList.Process(labels, toDelete));
+}
+
+void RelabelConfigUnittest::TestReplacementTemplate() {
+    Json::Value configJson;
+    string errorMsg;
+    string configStr = R"JSON(
+        [{
+                "action": "replace",
+                "regex": "(?P<ip>[0-9.]+):([0-9]+)",
+                "replacement": "${ip}-$2-$$-${unknown}-$&",
+                "source_labels": [
+                    "__address__"
+                ],
+                "target_label": "target_$2"
+        }]
+    )JSON";
+    APSARA_TEST_TRUE(ParseJsonTable(configStr, configJson, errorMsg));
+    RelabelConfigList configList;
+    APSARA_TEST_TRUE(configList.Init(configJson));
+
+    Labels labels;
+    labels.Set("__address__", "http://172.17.0.3:9100/metrics");
+    vector<string> toDelete;
+    APSARA_TEST_TRUE(configList.Process(labels, toDelete));
+    // the unmatched prefix and suffix are kept
+    APSARA_TEST_EQUAL("http://172.17.0.3-9100-$--172.17.0.3:9100/metrics",
+                      labels.Get("http://target_9100/metrics"));
+}
+
+void RelabelConfigUnittest::TestInvalidRegex() {
+    Json::Value configJson;
+    string errorMsg;
+    string configStr = R"(
+        {
+                "action": "keep",
+                "regex": "(node",
+                "source_labels": [
+                    "app"
+                ]
+        }
+    )";
+    APSARA_TEST_TRUE(ParseJsonTable(configStr, configJson, errorMsg));
+    RelabelConfig config;
+    APSARA_TEST_FALSE(config.Init(configJson));
+}
+
 UNIT_TEST_CASE(ActionConverterUnittest, TestStringToAction)
 UNIT_TEST_CASE(ActionConverterUnittest, TestActionToString)
 
@@ -532,6 +615,9 @@ UNIT_TEST_CASE(RelabelConfigUnittest, TestKeepEqual)
 UNIT_TEST_CASE(RelabelConfigUnittest, TestLowerCase)
 UNIT_TEST_CASE(RelabelConfigUnittest, TestUpperCase)
 UNIT_TEST_CASE(RelabelConfigUnittest, TestMultiRelabel)
+UNIT_TEST_CASE(RelabelConfigUnittest, TestLiteralRegex)
+UNIT_TEST_CASE(RelabelConfigUnittest, TestReplacementTemplate)
+UNIT_TEST_CASE(RelabelConfigUnittest, TestInvalidRegex)
 
 } // namespace logtail
 
@@ -210,12 +210,13 @@ void ScrapeSchedulerUnittest::TestScheduler() {
     event.SetComponent(timer, &eventPool);
     event.ScheduleNext();
 
-    APSARA_TEST_TRUE(timer->mQueue.size() == 1);
+    APSARA_TEST_TRUE(timer->GetEventCnt() == 1);
 
     event.Cancel();
 
     APSARA_TEST_TRUE(event.mValidState == false);
     APSARA_TEST_TRUE(event.mFuture->mState == PromFutureState::Done);
+    APSARA_TEST_TRUE(timer->GetEventCnt() == 0);
 }
 
 void ScrapeSchedulerUnittest::TestQueueIsFull() {
@@ -232,15 +233,16 @@ void ScrapeSchedulerUnittest::TestQueueIsFull() {
     event.SetFirstExecTime(now, nowScrape);
     event.ScheduleNext();
 
-    APSARA_TEST_TRUE(timer->mQueue.size() == 1);
+    APSARA_TEST_TRUE(timer->GetEventCnt() == 1);
 
-    const auto& e = timer->mQueue.top();
+    auto id = event.mTimerEventId.load();
+    const auto& e = timer->mEventIndex[id]->mEvent;
     APSARA_TEST_EQUAL(now, e->GetExecTime());
     APSARA_TEST_FALSE(e->IsValid());
-    timer->mQueue.pop();
+    timer->CancelEvent(id);
     // queue is full, so it should schedule next after 1 second
-    APSARA_TEST_EQUAL(1UL, timer->mQueue.size());
-    const auto& next = timer->mQueue.top();
+    APSARA_TEST_EQUAL(1UL, timer->GetEventCnt());
+    const auto& next = timer->mEventIndex[event.mTimerEventId]->mEvent;
     APSARA_TEST_EQUAL(now + std::chrono::seconds(1), next->GetExecTime());
 }
 
@@ -14,7 +14,9 @@
 
 #include <stdio.h>
 
+#include <algorithm>
 #include <fstream>
+#include <sstream>
 
 #include "checkpoint/CheckPointManager.h"
 #include "common/FileSystemUtil.h"
@@ -26,6 +28,8 @@
 #include "unittest/Unittest.h"
 
 DECLARE_FLAG_INT32(force_release_deleted_file_fd_timeout);
+DECLARE_FLAG_BOOL(enable_reader_adaptive_read_size);
+DECLARE_FLAG_INT32(reader_large_backlog_threshold_kb);
 
 namespace logtail {
 
@@ -44,6 +48,9 @@ public:
     static void TearDownTestCase() {}
 
     void SetUp() override {
+        bufferSize = LogFileReader::BUFFER_SIZE;
+        enableAdaptiveReadSize = BOOL_FLAG(enable_reader_adaptive_read_size);
+        largeBacklogThresholdKb = INT32_FLAG(reader_large_backlog_threshold_kb);
         readerOpts.mInputType = FileReaderOptions::InputType::InputFile;
         std::string filepath = logPathDir + PATH_SEPARATOR + utf8File;
         std::unique_ptr<FILE, decltype(&std::fclose)> fp(std::fopen(filepath.c_str(), "r"), &std::fclose);
@@ -65,13 +72,21 @@ public:
         FileServer::GetInstance()->AddFileDiscoveryConfig("", &discoveryOpts, &ctx);
     }
     void TearDown() override {
-        LogFileReader::BUFFER_SIZE = 1024 * 512;
+        LogFileReader::BUFFER_SIZE = bufferSize;
+        BOOL_FLAG(enable_reader_adaptive_read_size) = enableAdaptiveReadSize;
+        INT32_FLAG(reader_large_backlog_threshold_kb) = largeBacklogThresholdKb;
         FileServer::GetInstance()->RemoveFileDiscoveryConfig("");
     }
     void TestReadGBK();
     void TestReadUTF8();
+    void TestAdaptiveReadSize();
+    void TestAdaptiveReadSizeOfContainerStdio();
+    void TestAdaptiveReadSizeOfLongLog();
 
     std::unique_ptr<char[]> expectedContent;
+    size_t bufferSize = 0;
+    bool enableAdaptiveReadSize = true;
+    int32_t largeBacklogThresholdKb = 0;
     static std::string logPathDir;
     static std::string gbkFile;
     static std::string utf8File;
@@ -83,6 +98,9 @@ public:
 
 UNIT_TEST_CASE(LogFileReaderUnittest, TestReadGBK);
 UNIT_TEST_CASE(LogFileReaderUnittest, TestReadUTF8);
+UNIT_TEST_CASE(LogFileReaderUnittest, TestAdaptiveReadSize);
+UNIT_TEST_CASE(LogFileReaderUnittest, TestAdaptiveReadSizeOfContainerStdio);
+UNIT_TEST_CASE(LogFileReaderUnittest, TestAdaptiveReadSizeOfLongLog);
 
 std::string LogFileReaderUnittest::logPathDir;
 std::string LogFileReaderUnittest::gbkFile;
@@ -571,6 +589,167 @@ void LogFileReaderUnittest::TestReadUTF8() {
     }
 }
 
+void LogFileReaderUnittest::TestAdaptiveReadSize() {
+    auto readAll = [&](std::vector<size_t>& limits) {
+        MultilineOptions multilineOpts;
+        LogFileReader reader(logPathDir,
+                             utf8File,
+                             DevInode(),
+                             std::make_pair(&readerOpts, &ctx),
+                             std::make_pair(&multilineOpts, &ctx),
+                             std::make_pair(&fileTagOpts, &ctx));
+        reader.UpdateReaderManual();
+        reader.InitReader(true, LogFileReader::BACKWARD_TO_BEGINNING);
+        reader.CheckFileSignatureAndOffset(true);
+        int64_t fileSize = reader.mLogFileOp.GetFileSize();
+        std::string content;
+        bool moreData = true;
+        while (moreData) {
+            LogBuffer logBuffer;
+            reader.ReadUTF8(logBuffer, fileSize, moreData);
+            limits.push_back(reader.mReadSizeLimit);
+            if (!content.empty()) {
+                content += '\n';
+            }
+            content.append(logBuffer.rawBuffer.data(), logBuffer.rawBuffer.size());
+        }
+        APSARA_TEST_EQUAL(fileSize, reader.mLastFilePos);
+        APSARA_TEST_STREQ(expectedContent.get(), content.c_str());
+    };
+    LogFileReader::BUFFER_SIZE = 256;
+    { // small backlog, read size is not enlarged
+        std::vector<size_t> limits;
+        readAll(limits);
+        APSARA_TEST_EQUAL(std::vector<size_t>({256, 256}), limits);
+    }
+    { // large backlog, read size is enlarged while the file falls behind
+        INT32_FLAG(reader_large_backlog_threshold_kb) = 0;
+        std::vector<size_t> limits;
+        readAll(limits);
+        APSARA_TEST_EQUAL(std::vector<size_t>({256, 512}), limits);
+    }
+    { // disabled
+        BOOL_FLAG(enable_reader_adaptive_read_size) = false;
+        std::vector<size_t> limits;
+        readAll(limits);
+        APSARA_TEST_EQUAL(std::vector<size_t>({256, 256}), limits);
+    }
+}
+
+void LogFileReaderUnittest::TestAdaptiveReadSizeOfContainerStdio() {
+    // the container type is only known after the first read with data, which should not be enlarged either, even if
+    // the file has been empty for a while
+    const std::string fileName = "containerd.log";
+    {
+        std::ofstream fout(logPathDir + PATH_SEPARATOR + fileName, std::ios::binary);
+    }
+    readerOpts.mInputType = FileReaderOptions::InputType::InputContainerStdio;
+    LogFileReader::BUFFER_SIZE = 256;
+    INT32_FLAG(reader_large_backlog_threshold_kb) = 0;
+    MultilineOptions multilineOpts;
+    LogFileReader reader(logPathDir,
+                         fileName,
+                         DevInode(),
+                         std::make_pair(&readerOpts, &ctx),
+                         std::make_pair(&multilineOpts, &ctx),
+                         std::make_pair(&fileTagOpts, &ctx));
+    reader.UpdateReaderManual();
+    reader.InitReader(true, LogFileReader::BACKWARD_TO_BEGINNING);
+    reader.CheckFileSignatureAndOffset(true);
+    for (size_t i = 0; i < 2; ++i) {
+        LogBuffer logBuffer;
+        bool moreData = false;
+        reader.ReadUTF8(logBuffer, 0, moreData);
+        APSARA_TEST_EQUAL(0U, logBuffer.readLength);
+    }
+    {
+        std::ofstream fout(logPathDir + PATH_SEPARATOR + fileName, std::ios::binary | std::ios::app);
+        for (size_t i = 0; i < 100; ++i) {
+            fout << "2021-08-25T07:00:00.000000000Z stdout F log " << i << "\n";
+        }
+    }
+    int64_t fileSize = reader.mLogFileOp.GetFileSize();
+    APSARA_TEST_TRUE(fileSize > 2 * 256);
+    for (size_t i = 0; i < 2; ++i) {
+        LogBuffer logBuffer;
+        bool moreData = false;
+        reader.ReadUTF8(logBuffer, fileSize, moreData);
+        APSARA_TEST_TRUE(reader.mFileLogFormat == LogFileReader::LogFormat::CONTAINERD_TEXT);
+        APSARA_TEST_EQUAL(256U, reader.mReadSizeLimit);
+        APSARA_TEST_TRUE(logBuffer.readLength > 0U);
+        APSARA_TEST_TRUE(logBuffer.readLength <= 256U);
+    }
+    reader.CloseFilePtr();
+    remove((logPathDir + PATH_SEPARATOR + fileName).c_str());
+}
+
+void LogFileReaderUnittest::TestAdaptiveReadSizeOfLongLog() {
+    // logs longer than BUFFER_SIZE should be split at the same offsets whatever the read size is
+    const std::string fileName = "long.log";
+    {
+        std::ofstream fout(logPathDir + PATH_SEPARATOR + fileName, std::ios::binary);
+        for (size_t i = 0; i < 20; ++i) {
+            fout << "short log " << i << "\n";
+        }
+        fout << std::string(600, 'a') << "\n";
+        for (size_t i = 0; i < 20; ++i) {
+            fout << "short log " << i << "\n";
+        }
+        fout << std::string(300, 'b') << "\n";
+        for (size_t i = 0; i < 20; ++i) {
+            fout << "short log " << i << "\n";
+        }
+    }
+    auto readAll = [&](std::vector<std::string>& logs, size_t& maxLimit) {
+        MultilineOptions multilineOpts;
+        LogFileReader reader(logPathDir,
+                             fileName,
+                             DevInode(),
+                             std::make_pair(&readerOpts, &ctx),
+                             std::make_pair(&multilineOpts, &ctx),
+                             std::make_pair(&fileTagOpts, &ctx));
+        reader.UpdateReaderManual();
+        reader.InitReader(true, LogFileReader::BACKWARD_TO_BEGINNING);
+        reader.CheckFileSignatureAndOffset(true);
+        int64_t fileSize = reader.mLogFileOp.GetFileSize();
+        bool moreData = true;
+        while (moreData) {
+            LogBuffer logBuffer;
+            reader.ReadUTF8(logBuffer, fileSize, moreData);
+            maxLimit = std::max(maxLimit, reader.mReadSizeLimit);
+            APSARA_TEST_TRUE(logBuffer.readLength <= reader.mReadSizeLimit);
+            if (logBuffer.rawBuffer.empty()) {
+                continue;
+            }
+            std::istringstream iss(std::string(logBuffer.rawBuffer.data(), logBuffer.rawBuffer.size()));
+            std::string log;
+            while (std::getline(iss, log)) {
+                logs.push_back(log);
+            }
+        }
+        APSARA_TEST_EQUAL(fileSize, reader.mLastFilePos);
+        reader.CloseFilePtr();
+    };
+    LogFileReader::BUFFER_SIZE = 256;
+    INT32_FLAG(reader_large_backlog_threshold_kb) = 0;
+    std::vector<std::string> expectedLogs;
+    size_t maxLimit = 0;
+    BOOL_FLAG(enable_reader_adaptive_read_size) = false;
+    readAll(expectedLogs, maxLimit);
+    APSARA_TEST_EQUAL(256U, maxLimit);
+    APSARA_TEST_EQUAL(std::string(256, 'a'), expectedLogs[20]);
+    APSARA_TEST_EQUAL(std::string(256, 'a'), expectedLogs[21]);
+    APSARA_TEST_EQUAL(std::string(88, 'a'), expectedLogs[22]);
+
+    std::vector<std::string> logs;
+    maxLimit = 0;
+    BOOL_FLAG(enable_reader_adaptive_read_size) = true;
+    readAll(logs, maxLimit);
+    APSARA_TEST_TRUE(maxLimit > 256U);
+    APSARA_TEST_EQUAL(expectedLogs, logs);
+    remove((logPathDir + PATH_SEPARATOR + fileName).c_str());
+}
+
 class LogMultiBytesUnittest : public ::testing::Test {
 public:
     static void SetUpTestCase() {
@@ -0,0 +1,200 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include "runner/SerializerRunner.h"
+#include "unittest/Unittest.h"
+#include "unittest/plugin/PluginMock.h"
+
+DECLARE_FLAG_INT32(serializer_runner_thread_num);
+DECLARE_FLAG_INT32(serializer_runner_max_pending_items_per_queue);
+DECLARE_FLAG_INT32(serializer_runner_exit_timeout_sec);
+
+using namespace std;
+
+namespace logtail {
+
+class SerializerRunnerUnittest : public ::testing::Test {
+public:
+    void TestDisabled();
+    void TestOrdered();
+    void TestSteal();
+    void TestBackpressure();
+    void TestWaitForFlusher();
+    void TestFailedItems();
+    void TestStopWithStuckWorker();
+
+protected:
+    void SetUp() override {
+        INT32_FLAG(serializer_runner_thread_num) = 2;
+        INT32_FLAG(serializer_runner_max_pending_items_per_queue) = 8;
+        SerializerRunner::GetInstance()->Init();
+    }
+
+    void TearDown() override {
+        SerializerRunner::GetInstance()->Stop();
+        INT32_FLAG(serializer_runner_thread_num) = 0;
+    }
+
+    FlusherMock mFlusher;
+};
+
+void SerializerRunnerUnittest::TestDisabled() {
+    SerializerRunner::GetInstance()->Stop();
+    APSARA_TEST_FALSE(SerializerRunner::GetInstance()->IsRunning());
+    bool run = false;
+    APSARA_TEST_FALSE(SerializerRunner::GetInstance()->Submit(&mFlusher, 0, false, [&run]() {
+        run = true;
+        return true;
+    }));
+    APSARA_TEST_FALSE(run);
+}
+
+void SerializerRunnerUnittest::TestOrdered() {
+    INT32_FLAG(serializer_runner_max_pending_items_per_queue) = 1000;
+    mutex mux;
+    vector<int> res;
+    for (int i = 0; i < 100; ++i) {
+        APSARA_TEST_TRUE(SerializerRunner::GetInstance()->Submit(&mFlusher, 1, true, [&mux, &res, i]() {
+            lock_guard<mutex> lock(mux);
+            res.push_back(i);
+            return true;
+        }));
+    }
+    SerializerRunner::GetInstance()->WaitForFlusher(&mFlusher);
+    APSARA_TEST_EQUAL(100U, res.size());
+    for (int i = 0; i < 100; ++i) {
+        APSARA_TEST_EQUAL(i, res[i]);
+    }
+    APSARA_TEST_EQUAL(0U, SerializerRunner::GetInstance()->mStolenItemsTotal->GetValue());
+}
+
+void SerializerRunnerUnittest::TestSteal() {
+    // all items are dispatched to the same worker, which is blocked by the first one that cannot be stolen
+    promise<void> blocker;
+    auto blocked = blocker.get_future().share();
+    APSARA_TEST_TRUE(SerializerRunner::GetInstance()->Submit(&mFlusher, 0, true, [blocked]() {
+        blocked.wait();
+        return true;
+    }));
+    atomic_int cnt = 0;
+    for (int i = 0; i < 3; ++i) {
+        APSARA_TEST_TRUE(SerializerRunner::GetInstance()->Submit(&mFlusher, 0, false, [&cnt]() {
+            ++cnt;
+            return true;
+        }));
+    }
+    for (size_t i = 0; i < 100 && cnt != 3; ++i) {
+        this_thread::sleep_for(chrono::milliseconds(10));
+    }
+    APSARA_TEST_EQUAL(3, cnt.load());
+    APSARA_TEST_EQUAL(3U, SerializerRunner::GetInstance()->mStolenItemsTotal->GetValue());
+    blocker.set_value();
+    SerializerRunner::GetInstance()->WaitForFlusher(&mFlusher);
+}
+
+void SerializerRunnerUnittest::TestBackpressure() {
+    INT32_FLAG(serializer_runner_max_pending_items_per_queue) = 1;
+    promise<void> blocker;
+    auto blocked = blocker.get_future().share();
+    APSARA_TEST_TRUE(SerializerRunner::GetInstance()->Submit(&mFlusher, 0, true, [blocked]() {
+        blocked.wait();
+        return true;
+    }));
+    // items of other queues are not affected
+    APSARA_TEST_TRUE(SerializerRunner::GetInstance()->Submit(&mFlusher, 1, true, []() { return true; }));
+
+    auto res = async(launch::async, [this]() {
+        return SerializerRunner::GetInstance()->Submit(&mFlusher, 0, true, []() { return true; });
+    });
+    APSARA_TEST_EQUAL(future_status::timeout, res.wait_for(chrono::milliseconds(100)));
+    blocker.set_value();
+    APSARA_TEST_TRUE(res.get());
+    SerializerRunner::GetInstance()->WaitForFlusher(&mFlusher);
+    APSARA_TEST_EQUAL(0U, SerializerRunner::GetInstance()->mPendingItemsTotal->GetValue());
+}
+
+void SerializerRunnerUnittest::TestWaitForFlusher() {
+    FlusherMock other;
+    promise<void> blocker;
+    auto blocked = blocker.get_future().share();
+    atomic_bool done = false;
+    APSARA_TEST_TRUE(SerializerRunner::GetInstance()->Submit(&mFlusher, 0, true, [blocked, &done]() {
+        blocked.wait();
+        done = true;
+        return true;
+    }));
+    // flushers without pending items are not blocked
+    SerializerRunner::GetInstance()->WaitForFlusher(&other);
+
+    auto res = async(launch::async, [this]() { return SerializerRunner::GetInstance()->WaitForFlusher(&mFlusher); });
+    APSARA_TEST_EQUAL(future_status::timeout, res.wait_for(chrono::milliseconds(100)));
+    blocker.set_value();
+    APSARA_TEST_TRUE(res.get());
+    APSARA_TEST_TRUE(done.load());
+}
+
+void SerializerRunnerUnittest::TestFailedItems() {
+    auto failedBefore = SerializerRunner::GetInstance()->mFailedItemsTotal->GetValue();
+    for (int i = 0; i < 4; ++i) {
+        APSARA_TEST_TRUE(SerializerRunner::GetInstance()->Submit(&mFlusher, 0, true, [i]() { return i % 2 == 0; }));
+    }
+    SerializerRunner::GetInstance()->WaitForFlusher(&mFlusher);
+    APSARA_TEST_EQUAL(2U, SerializerRunner::GetInstance()->mFailedItemsTotal->GetValue() - failedBefore);
+}
+
+void SerializerRunnerUnittest::TestStopWithStuckWorker() {
+    auto bakExitTimeout = INT32_FLAG(serializer_runner_exit_timeout_sec);
+    INT32_FLAG(serializer_runner_exit_timeout_sec) = 1;
+    auto failedBefore = SerializerRunner::GetInstance()->mFailedItemsTotal->GetValue();
+    promise<void> blocker;
+    auto blocked = blocker.get_future().share();
+    atomic_bool run = false;
+    APSARA_TEST_TRUE(SerializerRunner::GetInstance()->Submit(&mFlusher, 0, true, [blocked]() {
+        blocked.wait();
+        return true;
+    }));
+    APSARA_TEST_TRUE(SerializerRunner::GetInstance()->Submit(&mFlusher, 0, true, [&run]() {
+        run = true;
+        return true;
+    }));
+
+    // the item queued behind the stuck one is discarded
+    SerializerRunner::GetInstance()->Stop();
+    APSARA_TEST_EQUAL(1U, SerializerRunner::GetInstance()->mFailedItemsTotal->GetValue() - failedBefore);
+    APSARA_TEST_EQUAL(1U, SerializerRunner::GetInstance()->mPendingItemsTotal->GetValue());
+    // and the stuck one does not block the flusher forever
+    APSARA_TEST_FALSE(SerializerRunner::GetInstance()->WaitForFlusher(&mFlusher));
+
+    blocker.set_value();
+    APSARA_TEST_TRUE(SerializerRunner::GetInstance()->WaitForFlusher(&mFlusher));
+    APSARA_TEST_FALSE(run.load());
+    INT32_FLAG(serializer_runner_exit_timeout_sec) = bakExitTimeout;
+}
+
+UNIT_TEST_CASE(SerializerRunnerUnittest, TestDisabled)
+UNIT_TEST_CASE(SerializerRunnerUnittest, TestOrdered)
+UNIT_TEST_CASE(SerializerRunnerUnittest, TestSteal)
+UNIT_TEST_CASE(SerializerRunnerUnittest, TestBackpressure)
+UNIT_TEST_CASE(SerializerRunnerUnittest, TestWaitForFlusher)
+UNIT_TEST_CASE(SerializerRunnerUnittest, TestFailedItems)
+UNIT_TEST_CASE(SerializerRunnerUnittest, TestStopWithStuckWorker)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -0,0 +1,175 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "json/json.h"
+
+#include "collection_pipeline/serializer/JsonSerializer.h"
+#include "constants/TagConstants.h"
+#include "unittest/Unittest.h"
+#include "unittest/plugin/PluginMock.h"
+
+using namespace std;
+
+namespace logtail {
+
+class JsonSerializerUnittest : public ::testing::Test {
+public:
+    void TestSerializeLog();
+    void TestSerializeMetric();
+    void TestSerializeRaw();
+
+protected:
+    static void SetUpTestCase() { sFlusher = make_unique<FlusherMock>(); }
+
+    void SetUp() override {
+        mCtx.SetConfigName("test_config");
+        sFlusher->SetContext(mCtx);
+        sFlusher->SetMetricsRecordRef(FlusherMock::sName, "1");
+    }
+
+private:
+    static PipelineEventGroup CreateEventGroup();
+    static BatchedEvents ToBatchedEvents(PipelineEventGroup&& group);
+    static vector<Json::Value> ParseLines(const string& res);
+
+    static unique_ptr<Flusher> sFlusher;
+
+    CollectionPipelineContext mCtx;
+};
+
+unique_ptr<Flusher> JsonSerializerUnittest::sFlusher;
+
+void JsonSerializerUnittest::TestSerializeLog() {
+    JsonEventGroupSerializer serializer(sFlusher.get());
+    auto group = CreateEventGroup();
+    {
+        LogEvent* e = group.AddLogEvent();
+        e->SetTimestamp(1234567890);
+        e->SetContent(string("key"), string("value \"中文\"\n"));
+    }
+    {
+        // contents overwrite tags and time with the same key
+        LogEvent* e = group.AddLogEvent();
+        e->SetTimestamp(1234567891);
+        e->SetContent(string("__topic__"), string("new_topic"));
+        e->SetContent(string("__time__"), string("now"));
+    }
+    string res, errorMsg;
+    APSARA_TEST_TRUE(serializer.DoSerialize(ToBatchedEvents(std::move(group)), res, errorMsg));
+    APSARA_TEST_EQUAL("{\"__source__\":\"source\",\"__topic__\":\"topic\",\"__time__\":1234567890,"
+                      "\"key\":\"value \\\"\\u4e2d\\u6587\\\"\\n\"}\n"
+                      "{\"__source__\":\"source\",\"__topic__\":\"new_topic\",\"__time__\":\"now\"}\n",
+                      res);
+
+    auto events = ParseLines(res);
+    APSARA_TEST_EQUAL(2U, events.size());
+    APSARA_TEST_EQUAL("value \"中文\"\n", events[0]["key"].asString());
+    APSARA_TEST_EQUAL(1234567890, events[0]["__time__"].asInt64());
+    APSARA_TEST_EQUAL("new_topic", events[1]["__topic__"].asString());
+    APSARA_TEST_EQUAL(3U, events[1].size());
+}
+
+void JsonSerializerUnittest::TestSerializeMetric() {
+    JsonEventGroupSerializer serializer(sFlusher.get());
+    auto group = CreateEventGroup();
+    {
+        MetricEvent* e = group.AddMetricEvent();
+        e->SetTimestamp(1234567890);
+        e->SetName("test_gauge");
+        e->SetTag(string("key1"), string("value1"));
+        e->SetTag(string("key2"), string("value2"));
+        e->SetValue<UntypedSingleValue>(0.1);
+    }
+    {
+        MetricEvent* e = group.AddMetricEvent();
+        e->SetTimestamp(1234567890);
+        e->SetName("test_multi");
+        e->SetValue(map<StringView, UntypedMultiDoubleValue>{{"a", {UntypedValueMetricType::MetricTypeCounter, 1.0}},
+                                                             {"b", {UntypedValueMetricType::MetricTypeGauge, 2.5}}});
+    }
+    {
+        // events without value are ignored
+        MetricEvent* e = group.AddMetricEvent();
+        e->SetTimestamp(1234567890);
+        e->SetName("test_empty");
+    }
+    string res, errorMsg;
+    APSARA_TEST_TRUE(serializer.DoSerialize(ToBatchedEvents(std::move(group)), res, errorMsg));
+    APSARA_TEST_EQUAL("{\"__source__\":\"source\",\"__topic__\":\"topic\",\"__time__\":1234567890,"
+                      "\"__labels__\":{\"key1\":\"value1\",\"key2\":\"value2\"},\"__name__\":\"test_gauge\","
+                      "\"__value__\":0.10000000000000001}\n"
+                      "{\"__source__\":\"source\",\"__topic__\":\"topic\",\"__time__\":1234567890,"
+                      "\"__labels__\":{},\"__name__\":\"test_multi\",\"__value__\":{\"a\":1.0,\"b\":2.5}}\n",
+                      res);
+}
+
+void JsonSerializerUnittest::TestSerializeRaw() {
+    JsonEventGroupSerializer serializer(sFlusher.get());
+    auto group = CreateEventGroup();
+    // tags overwritten by reserved keys are dropped
+    group.SetTag(string("content"), string("tag"));
+    {
+        RawEvent* e = group.AddRawEvent();
+        e->SetTimestamp(1234567890);
+        e->SetContent(string("raw\tcontent"));
+    }
+    string res, errorMsg;
+    APSARA_TEST_TRUE(serializer.DoSerialize(ToBatchedEvents(std::move(group)), res, errorMsg));
+    APSARA_TEST_EQUAL("{\"__source__\":\"source\",\"__topic__\":\"topic\",\"__time__\":1234567890,"
+                      "\"content\":\"raw\\tcontent\"}\n",
+                      res);
+}
+
+PipelineEventGroup JsonSerializerUnittest::CreateEventGroup() {
+    PipelineEventGroup group(make_shared<SourceBuffer>());
+    group.SetTag(LOG_RESERVED_KEY_TOPIC, "topic");
+    group.SetTag(LOG_RESERVED_KEY_SOURCE, "source");
+    return group;
+}
+
+BatchedEvents JsonSerializerUnittest::ToBatchedEvents(PipelineEventGroup&& group) {
+    return BatchedEvents(std::move(group.MutableEvents()),
+                         std::move(group.GetSizedTags()),
+                         std::move(group.GetSourceBuffer()),
+                         group.GetMetadata(EventGroupMetaKey::SOURCE_ID),
+                         std::move(group.GetExactlyOnceCheckpoint()));
+}
+
+vector<Json::Value> JsonSerializerUnittest::ParseLines(const string& res) {
+    vector<Json::Value> events;
+    istringstream iss(res);
+    string line;
+    Json::CharReaderBuilder builder;
+    unique_ptr<Json::CharReader> reader(builder.newCharReader());
+    while (getline(iss, line)) {
+        Json::Value value;
+        string errorMsg;
+        APSARA_TEST_TRUE(reader->parse(line.data(), line.data() + line.size(), &value, &errorMsg));
+        events.push_back(value);
+    }
+    return events;
+}
+
+UNIT_TEST_CASE(JsonSerializerUnittest, TestSerializeLog)
+UNIT_TEST_CASE(JsonSerializerUnittest, TestSerializeMetric)
+UNIT_TEST_CASE(JsonSerializerUnittest, TestSerializeRaw)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -199,6 +199,21 @@ func ProcessLogGroup(configName string, logBytes []byte, packID string) int {
 	return config.ProcessLogGroup(logBytes, util.StringDeepCopy(packID))
 }
 
+// ProcessLogGroups is the batched version of ProcessLogGroup, the config is looked up once for all log groups in the
+// batch. See LogstoreConfig.ProcessLogGroups for the encoding of the batch.
+//
+//export ProcessLogGroups
+func ProcessLogGroups(configName string, batch []byte) int {
+	pluginmanager.LogtailConfigLock.RLock()
+	config, flag := pluginmanager.LogtailConfig[configName]
+	pluginmanager.LogtailConfigLock.RUnlock()
+	if !flag {
+		logger.Error(context.Background(), "PLUGIN_ALARM", "config not found", configName)
+		return -1
+	}
+	return config.ProcessLogGroups(batch)
+}
+
 //export StopAllPipelines
 func StopAllPipelines(withInputFlag int) {
 	logger.Info(context.Background(), "Stop all", "start", "with input", withInputFlag)
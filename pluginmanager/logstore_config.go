@@ -18,7 +18,9 @@ import (
 	"bytes"
 	"context"
 	"crypto/md5" //nolint:gosec
+	"encoding/binary"
 	"encoding/json"
+	"errors"
 	"fmt"
 	"strconv"
 	"strings"
@@ -297,6 +299,62 @@ func (lc *LogstoreConfig) ProcessLogGroup(logByte []byte, packID string) int {
 	return 0
 }
 
+// ProcessLogGroups handles a batch of log groups passed by core in one cgo call.
+// The batch is owned by core and only valid during the call, everything kept is copied by Unmarshal.
+func (lc *LogstoreConfig) ProcessLogGroups(batch []byte) int {
+	err := parseLogGroupBatch(batch, func(packID string, logByte []byte) error {
+		logGroup := &protocol.LogGroup{}
+		if err := logGroup.Unmarshal(logByte); err != nil {
+			return err
+		}
+		lc.PluginRunner.ReceiveLogGroup(pipeline.LogGroupWithContext{
+			LogGroup: logGroup,
+			Context:  map[string]interface{}{ctxKeySource: packID}},
+		)
+		return nil
+	})
+	if err != nil {
+		logger.Error(lc.Context.GetRuntimeContext(), "WRONG_PROTOBUF_ALARM",
+			"cannot process log group batch passed by core, err", err)
+		return -1
+	}
+	return 0
+}
+
+var errInvalidLogGroupBatch = errors.New("invalid log group batch")
+
+// parseLogGroupBatch walks through the batch encoded by core, which is a sequence of
+// 0x0A varint(len(packID)) packID 0x12 varint(len(logGroup)) logGroup
+// i.e. the protobuf encoding of repeated {string pack_id = 1; LogGroup log_group = 2;} without the outer message.
+func parseLogGroupBatch(batch []byte, fn func(packID string, logGroup []byte) error) error {
+	readField := func(tag byte) ([]byte, error) {
+		if len(batch) == 0 || batch[0] != tag {
+			return nil, errInvalidLogGroupBatch
+		}
+		size, n := binary.Uvarint(batch[1:])
+		if n <= 0 || uint64(len(batch)-1-n) < size {
+			return nil, errInvalidLogGroupBatch
+		}
+		field := batch[1+n : 1+n+int(size)]
+		batch = batch[1+n+int(size):]
+		return field, nil
+	}
+	for len(batch) > 0 {
+		packID, err := readField(0x0A)
+		if err != nil {
+			return err
+		}
+		logGroup, err := readField(0x12)
+		if err != nil {
+			return err
+		}
+		if err = fn(string(packID), logGroup); err != nil {
+			return err
+		}
+	}
+	return nil
+}
+
 func hasDockerStdoutInput(plugins map[string]interface{}) bool {
 	inputs, exists := plugins["inputs"]
 	if !exists {
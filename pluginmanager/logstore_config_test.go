@@ -19,7 +19,9 @@ package pluginmanager
 
 import (
 	"context"
+	"encoding/binary"
 	"strconv"
+	"strings"
 	"testing"
 	"time"
 
@@ -570,3 +572,43 @@ func Test_genPluginMeta(t *testing.T) {
 		assert.Equal(t, "customID", result.PluginID)
 	}
 }
+
+func Test_parseLogGroupBatch(t *testing.T) {
+	appendField := func(batch []byte, tag byte, data []byte) []byte {
+		batch = append(batch, tag)
+		batch = binary.AppendUvarint(batch, uint64(len(data)))
+		return append(batch, data...)
+	}
+	group1 := &protocol.LogGroup{Topic: "topic1", Logs: []*protocol.Log{{Time: 1}}}
+	group2 := &protocol.LogGroup{Topic: strings.Repeat("a", 200)}
+	var batch []byte
+	for _, group := range []*protocol.LogGroup{group1, group2} {
+		buf, err := group.Marshal()
+		require.NoError(t, err)
+		batch = appendField(batch, 0x0A, []byte("pack-"+group.Topic[:1]))
+		batch = appendField(batch, 0x12, buf)
+	}
+
+	var packIDs, topics []string
+	err := parseLogGroupBatch(batch, func(packID string, logGroup []byte) error {
+		res := &protocol.LogGroup{}
+		if err := res.Unmarshal(logGroup); err != nil {
+			return err
+		}
+		packIDs = append(packIDs, packID)
+		topics = append(topics, res.Topic)
+		return nil
+	})
+	require.NoError(t, err)
+	assert.Equal(t, []string{"pack-t", "pack-a"}, packIDs)
+	assert.Equal(t, []string{group1.Topic, group2.Topic}, topics)
+
+	cnt := 0
+	err = parseLogGroupBatch(batch[:len(batch)-1], func(string, []byte) error {
+		cnt++
+		return nil
+	})
+	assert.Equal(t, errInvalidLogGroupBatch, err)
+	assert.Equal(t, 1, cnt)
+	assert.NoError(t, parseLogGroupBatch(nil, nil))
+}